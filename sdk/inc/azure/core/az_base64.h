@@ -19,6 +19,7 @@
 #include <azure/core/az_result.h>
 #include <azure/core/az_span.h>
 
+#include <stdbool.h>
 #include <stdint.h>
 
 #include <azure/core/_az_cfg_prefix.h>
@@ -119,6 +120,181 @@ AZ_NODISCARD az_result az_base64_url_decode(
  */
 AZ_NODISCARD int32_t az_base64_url_get_max_decoded_size(int32_t source_base64_url_text_size);
 
+/**
+ * @brief The alphabets that base 64 text can be encoded with.
+ */
+typedef enum
+{
+  AZ_BASE64_ALPHABET_STANDARD, ///< The standard alphabet, using '+' and '/', with padding.
+  AZ_BASE64_ALPHABET_URL, ///< The URL and filename safe alphabet, using '-' and '_'.
+} az_base64_alphabet;
+
+/**
+ * @brief Encodes binary data into base 64 text incrementally, one chunk at a time, such as when
+ * encoding a large upload body in fixed-size windows, without needing the whole payload in memory.
+ *
+ * @remarks Each chunk is encoded as far as its whole groups of 3 bytes go, and the 1 or 2 bytes
+ * left over are kept until the next chunk, or encoded by #az_base64_encoder_final().
+ */
+typedef struct
+{
+  struct
+  {
+    /// The bytes left over from the previous chunks, which don't make up a whole group yet.
+    uint8_t pending[2];
+
+    /// The number of bytes within pending.
+    int32_t pending_size;
+
+    /// The alphabet the text is encoded with.
+    az_base64_alphabet alphabet;
+  } _internal;
+} az_base64_encoder;
+
+/**
+ * @brief Initializes an #az_base64_encoder, before any binary data has been provided.
+ *
+ * @param[out] out_encoder A pointer to an #az_base64_encoder instance to initialize.
+ * @param[in] alphabet The alphabet to encode with. Text encoded with #AZ_BASE64_ALPHABET_URL is
+ * not padded, as is customary for it.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_base64_encoder is initialized successfully.
+ */
+AZ_NODISCARD az_result
+az_base64_encoder_init(az_base64_encoder* out_encoder, az_base64_alphabet alphabet);
+
+/**
+ * @brief Encodes the next chunk of binary data.
+ *
+ * @param[in,out] ref_encoder A pointer to an #az_base64_encoder instance.
+ * @param destination_base64_text The output #az_span where the encoded base 64 text should be
+ * copied to as a result of the operation. A size of
+ * `az_base64_get_max_encoded_size(az_span_size(source_bytes))` is always large enough.
+ * @param[in] source_bytes The input #az_span that contains the next chunk of binary data, which
+ * may be empty.
+ * @param[out] out_written A pointer to an `int32_t` that receives the number of bytes written into
+ * the destination #az_span.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination_base64_text is not large enough to contain
+ * the encoded text, in which case none of \p source_bytes is consumed.
+ */
+AZ_NODISCARD az_result az_base64_encoder_update(
+    az_base64_encoder* ref_encoder,
+    az_span destination_base64_text,
+    az_span source_bytes,
+    int32_t* out_written);
+
+/**
+ * @brief Encodes the bytes left over from the previous chunks, once all the binary data has been
+ * provided, and resets the #az_base64_encoder so that it can be used again.
+ *
+ * @param[in,out] ref_encoder A pointer to an #az_base64_encoder instance.
+ * @param destination_base64_text The output #az_span where the encoded base 64 text should be
+ * copied to as a result of the operation. A size of 4 is always large enough.
+ * @param[out] out_written A pointer to an `int32_t` that receives the number of bytes written into
+ * the destination #az_span, which is 0 if there were no bytes left over.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination_base64_text is not large enough to contain
+ * the encoded text.
+ */
+AZ_NODISCARD az_result az_base64_encoder_final(
+    az_base64_encoder* ref_encoder,
+    az_span destination_base64_text,
+    int32_t* out_written);
+
+/**
+ * @brief Decodes base 64 text into binary data incrementally, one chunk at a time, such as when
+ * decoding a large response body in fixed-size windows, without needing the whole payload in
+ * memory.
+ *
+ * @remarks Each chunk is decoded as far as its whole groups of 4 characters go, and the 1 to 3
+ * characters left over are kept until the next chunk, or decoded by #az_base64_decoder_final().
+ */
+typedef struct
+{
+  struct
+  {
+    /// The characters left over from the previous chunks, which don't make up a whole group yet.
+    uint8_t pending[3];
+
+    /// The number of characters within pending.
+    int32_t pending_size;
+
+    /// The alphabet the text is encoded with.
+    az_base64_alphabet alphabet;
+
+    /// Whether a padded group, which ends the text, has been decoded.
+    bool is_padded;
+  } _internal;
+} az_base64_decoder;
+
+/**
+ * @brief Initializes an #az_base64_decoder, before any base 64 text has been provided.
+ *
+ * @param[out] out_decoder A pointer to an #az_base64_decoder instance to initialize.
+ * @param[in] alphabet The alphabet the text is encoded with. Just like with
+ * #az_base64_url_decode(), text encoded with #AZ_BASE64_ALPHABET_URL may omit its padding.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_base64_decoder is initialized successfully.
+ */
+AZ_NODISCARD az_result
+az_base64_decoder_init(az_base64_decoder* out_decoder, az_base64_alphabet alphabet);
+
+/**
+ * @brief Decodes the next chunk of base 64 text.
+ *
+ * @param[in,out] ref_decoder A pointer to an #az_base64_decoder instance.
+ * @param destination_bytes The output #az_span where the decoded binary data should be copied to as
+ * a result of the operation. A size of
+ * `az_base64_get_max_decoded_size(az_span_size(source_base64_text) + 3)` is always large enough.
+ * @param[in] source_base64_text The input #az_span that contains the next chunk of base 64 text,
+ * which may be empty.
+ * @param[out] out_written A pointer to an `int32_t` that receives the number of bytes written into
+ * the destination #az_span.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination_bytes is not large enough to contain the
+ * decoded data, in which case none of \p source_base64_text is consumed.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The input \p source_base64_text contains characters outside
+ * of the alphabet, has invalid padding, or follows padding.
+ */
+AZ_NODISCARD az_result az_base64_decoder_update(
+    az_base64_decoder* ref_decoder,
+    az_span destination_bytes,
+    az_span source_base64_text,
+    int32_t* out_written);
+
+/**
+ * @brief Decodes the characters left over from the previous chunks, once all the base 64 text has
+ * been provided, and resets the #az_base64_decoder so that it can be used again.
+ *
+ * @param[in,out] ref_decoder A pointer to an #az_base64_decoder instance.
+ * @param destination_bytes The output #az_span where the decoded binary data should be copied to as
+ * a result of the operation. A size of 2 is always large enough.
+ * @param[out] out_written A pointer to an `int32_t` that receives the number of bytes written into
+ * the destination #az_span, which is 0 if there were no characters left over.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination_bytes is not large enough to contain the
+ * decoded data.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The characters left over are invalid.
+ * @retval #AZ_ERROR_UNEXPECTED_END The text is incomplete, that is, its size isn't a multiple of 4
+ * with #AZ_BASE64_ALPHABET_STANDARD, or is one more than a multiple of 4 with
+ * #AZ_BASE64_ALPHABET_URL.
+ */
+AZ_NODISCARD az_result az_base64_decoder_final(
+    az_base64_decoder* ref_decoder,
+    az_span destination_bytes,
+    int32_t* out_written);
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_BASE64_H
@@ -0,0 +1,769 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file
+ *
+ * @brief This header defines the types and functions your application uses to read or write CBOR
+ * (Concise Binary Object Representation, https://tools.ietf.org/html/rfc8949) data items.
+ *
+ * @details The #az_cbor_writer and #az_cbor_reader mirror the #az_json_writer and #az_json_reader
+ * APIs, one function for one function, so that code which writes or reads JSON can switch to the
+ * more compact CBOR encoding by only renaming the types and functions it uses. CBOR maps (with text
+ * string keys) take the place of JSON objects, and results are reported using the same #az_result
+ * values as their JSON counterparts.
+ *
+ * @note You MUST NOT use any symbols (macros, functions, structures, enums, etc.)
+ * prefixed with an underscore ('_') directly in your application code. These symbols
+ * are part of Azure SDK's internal implementation; we do not document these symbols
+ * and they are subject to change in future versions of the SDK which would break your code.
+ */
+
+#ifndef _az_CBOR_H
+#define _az_CBOR_H
+
+#include <azure/core/az_json.h>
+#include <azure/core/az_result.h>
+#include <azure/core/az_span.h>
+
+#include <stdbool.h>
+#include <stdint.h>
+
+#include <azure/core/_az_cfg_prefix.h>
+
+enum
+{
+  // The maximum depth of nested CBOR maps and arrays that can be written or read. The reader keeps
+  // the number of items left within every map and array of definite length, so the limit is lower
+  // than the JSON one to keep the size of the #az_cbor_reader small. The device twin documents of
+  // Azure IoT Hub are limited to 10 levels.
+  _az_MAX_CBOR_NESTING_DEPTH = 16,
+};
+
+/**
+ * @brief Defines symbols for the various kinds of CBOR tokens returned by the #az_cbor_reader.
+ */
+typedef enum
+{
+  AZ_CBOR_TOKEN_NONE, ///< There is no value (as distinct from #AZ_CBOR_TOKEN_NULL).
+  AZ_CBOR_TOKEN_BEGIN_OBJECT, ///< The token kind is the start of a CBOR map.
+  AZ_CBOR_TOKEN_END_OBJECT, ///< The token kind is the end of a CBOR map.
+  AZ_CBOR_TOKEN_BEGIN_ARRAY, ///< The token kind is the start of a CBOR array.
+  AZ_CBOR_TOKEN_END_ARRAY, ///< The token kind is the end of a CBOR array.
+  AZ_CBOR_TOKEN_PROPERTY_NAME, ///< The token kind is a text string key of a CBOR map.
+  AZ_CBOR_TOKEN_STRING, ///< The token kind is a CBOR text string.
+  AZ_CBOR_TOKEN_BYTES, ///< The token kind is a CBOR byte string.
+  AZ_CBOR_TOKEN_NUMBER, ///< The token kind is a CBOR integer or floating-point number.
+  AZ_CBOR_TOKEN_TRUE, ///< The token kind is the CBOR simple value `true`.
+  AZ_CBOR_TOKEN_FALSE, ///< The token kind is the CBOR simple value `false`.
+  AZ_CBOR_TOKEN_NULL, ///< The token kind is the CBOR simple value `null`.
+} az_cbor_token_kind;
+
+/**
+ * @brief Represents a CBOR token. The kind field indicates the type of the CBOR token and the slice
+ * represents the portion of the CBOR data that points to the token value.
+ *
+ * @remarks An instance of #az_cbor_token must not outlive the lifetime of the #az_cbor_reader it
+ * came from.
+ */
+typedef struct
+{
+  /// This read-only field gives access to the slice of the CBOR data that represents the token
+  /// value, and it shouldn't be modified by the caller.
+  /// In the case of text and byte strings, the slice only contains their content. For all other
+  /// tokens, it contains the encoded data item.
+  /// If the token straddles non-contiguous buffers, this is set to the partial token value
+  /// available in the last segment.
+  /// The user can call #az_cbor_token_copy_into_span() to get the token value into a contiguous
+  /// buffer.
+  az_span slice;
+
+  // Avoid using enum as the first field within structs, to allow for { 0 } initialization.
+  // This is a workaround for IAR compiler warning [Pe188]: enumerated type mixed with another type.
+
+  /// This read-only field gives access to the type of the token returned by the #az_cbor_reader,
+  /// and it shouldn't be modified by the caller.
+  az_cbor_token_kind kind;
+
+  /// This read-only field gives access to the size of the CBOR data slice that represents the token
+  /// value, and it shouldn't be modified by the caller. This is useful if the token straddles
+  /// non-contiguous buffers, to figure out what sized destination buffer to provide when calling
+  /// #az_cbor_token_copy_into_span().
+  int32_t size;
+
+  struct
+  {
+    /// A flag to indicate whether the CBOR token straddles more than one buffer segment and is
+    /// split amongst non-contiguous buffers. For tokens created from input CBOR data within a
+    /// contiguous buffer, this field is always false.
+    bool is_multisegment;
+
+    /// The first byte of the data item, which holds its major type and how its argument is
+    /// encoded.
+    uint8_t initial_byte;
+
+    /// The argument of the data item: the value of an unsigned integer, the value minus one of a
+    /// negative integer, or the bits of a floating-point number.
+    uint64_t argument;
+
+    /// This is the first segment in the entire CBOR data, if it was non-contiguous. Otherwise, its
+    /// set to `NULL`.
+    az_span* pointer_to_first_buffer;
+
+    /// The segment index within the non-contiguous CBOR data where this token starts.
+    int32_t start_buffer_index;
+
+    /// The offset within the particular segment within which this token starts.
+    int32_t start_buffer_offset;
+  } _internal;
+} az_cbor_token;
+
+/**
+ * @brief Copies the content of the \p cbor_token #az_cbor_token to the \p destination #az_span.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance containing the CBOR data to copy to
+ * the \p destination.
+ * @param destination The #az_span whose bytes will be replaced by the CBOR data from the \p
+ * cbor_token.
+ *
+ * @return An #az_span that is a slice of the \p destination #az_span (i.e. the remainder) after the
+ * token bytes have been copied.
+ *
+ * @remarks The function assumes that the \p destination has a large enough size to hold the
+ * contents of \p cbor_token.
+ */
+az_span az_cbor_token_copy_into_span(az_cbor_token const* cbor_token, az_span destination);
+
+/**
+ * @brief Gets the CBOR token's boolean.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param[out] out_value A pointer to a variable to receive the value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The boolean value is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_TRUE or #AZ_CBOR_TOKEN_FALSE.
+ */
+AZ_NODISCARD az_result az_cbor_token_get_boolean(az_cbor_token const* cbor_token, bool* out_value);
+
+/**
+ * @brief Gets the CBOR token's number as a 64-bit unsigned integer.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param[out] out_value A pointer to a variable to receive the value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_NUMBER.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The number is negative or a floating-point number.
+ */
+AZ_NODISCARD az_result
+az_cbor_token_get_uint64(az_cbor_token const* cbor_token, uint64_t* out_value);
+
+/**
+ * @brief Gets the CBOR token's number as a 32-bit unsigned integer.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param[out] out_value A pointer to a variable to receive the value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_NUMBER.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The number is a floating-point number, or would overflow or
+ * underflow `uint32_t`.
+ */
+AZ_NODISCARD az_result
+az_cbor_token_get_uint32(az_cbor_token const* cbor_token, uint32_t* out_value);
+
+/**
+ * @brief Gets the CBOR token's number as a 64-bit signed integer.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param[out] out_value A pointer to a variable to receive the value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_NUMBER.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The number is a floating-point number, or would overflow or
+ * underflow `int64_t`.
+ */
+AZ_NODISCARD az_result az_cbor_token_get_int64(az_cbor_token const* cbor_token, int64_t* out_value);
+
+/**
+ * @brief Gets the CBOR token's number as a 32-bit signed integer.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param[out] out_value A pointer to a variable to receive the value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_NUMBER.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The number is a floating-point number, or would overflow or
+ * underflow `int32_t`.
+ */
+AZ_NODISCARD az_result az_cbor_token_get_int32(az_cbor_token const* cbor_token, int32_t* out_value);
+
+/**
+ * @brief Gets the CBOR token's number, whether an integer or a floating-point number, as a
+ * `double`.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param[out] out_value A pointer to a variable to receive the value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_NUMBER.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The resulting \p out_value wouldn't be a finite double number.
+ */
+AZ_NODISCARD az_result az_cbor_token_get_double(az_cbor_token const* cbor_token, double* out_value);
+
+/**
+ * @brief Gets the CBOR token's text string, followed by a null terminator.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance.
+ * @param destination A pointer to a buffer where the string should be copied into.
+ * @param[in] destination_max_size The maximum available space within the buffer referred to by
+ * \p destination.
+ * @param[out] out_string_length __[nullable]__ Contains the number of bytes written to the \p
+ * destination which denote the length of the string. If `NULL` is passed, the parameter is
+ * ignored.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The string is returned.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The kind is not #AZ_CBOR_TOKEN_STRING or
+ * #AZ_CBOR_TOKEN_PROPERTY_NAME.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE \p destination does not have enough size.
+ */
+AZ_NODISCARD az_result az_cbor_token_get_string(
+    az_cbor_token const* cbor_token,
+    char* destination,
+    int32_t destination_max_size,
+    int32_t* out_string_length);
+
+/**
+ * @brief Determines whether the CBOR text string that the #az_cbor_token points to is equal to the
+ * expected text within the provided byte span by doing a case-sensitive comparison.
+ *
+ * @param[in] cbor_token A pointer to an #az_cbor_token instance containing the CBOR text string.
+ * @param[in] expected_text The lookup text to compare the token against.
+ *
+ * @return `true` if the current CBOR token value matches the expected lookup text, with the exact
+ * casing; otherwise, `false`.
+ *
+ * @remarks This operation is only valid for the string and property name token kinds. For all other
+ * token kinds, it returns false.
+ */
+AZ_NODISCARD bool az_cbor_token_is_text_equal(
+    az_cbor_token const* cbor_token,
+    az_span expected_text);
+
+/************************************ CBOR WRITER ******************/
+
+/**
+ * @brief Allows the user to define custom behavior when writing CBOR using the #az_cbor_writer.
+ */
+typedef struct
+{
+  struct
+  {
+    /// Currently, this is unused, but needed as a placeholder since we can't have an empty struct.
+    bool unused;
+  } _internal;
+} az_cbor_writer_options;
+
+/**
+ * @brief Gets the default CBOR writer options.
+ *
+ * @details Call this to obtain an initialized #az_cbor_writer_options structure that can be
+ * modified and passed to #az_cbor_writer_init().
+ *
+ * @return The default #az_cbor_writer_options.
+ */
+AZ_NODISCARD AZ_INLINE az_cbor_writer_options az_cbor_writer_options_default()
+{
+  az_cbor_writer_options options = {
+    ._internal = {
+      .unused = false,
+    },
+  };
+
+  return options;
+}
+
+/**
+ * @brief Provides forward-only, non-cached writing of CBOR data items into the provided buffer.
+ *
+ * @remarks Maps and arrays are written with an indefinite length (i.e. closed by a "break" byte),
+ * so that their items can be appended without knowing how many there are ahead of time. Every
+ * other data item is written using the preferred serialization of RFC 8949, section 4.1, which is
+ * the shortest one.
+ */
+typedef struct
+{
+  /// The total number of bytes written by the #az_cbor_writer to the output destination buffer(s).
+  /// This read-only field tracks the number of bytes of CBOR written so far, and it shouldn't be
+  /// modified by the caller.
+  int32_t total_bytes_written;
+
+  struct
+  {
+    /// The destination to write the CBOR into.
+    az_span destination_buffer;
+
+    /// The bytes written in the current destination buffer.
+    int32_t bytes_written; // For single contiguous buffer, bytes_written == total_bytes_written
+
+    /// Allocator used to support non-contiguous buffer as a destination.
+    az_span_allocator_fn allocator_callback;
+
+    /// Any struct that was provided by the user for their specific implementation, passed through
+    /// to the #az_span_allocator_fn.
+    void* user_context;
+
+    /// The current state of the writer based on the last token written, used for validating the
+    /// correctness of the CBOR being written.
+    az_cbor_token_kind token_kind;
+
+    /// The current state of the writer based on the last CBOR container it is in (whether array or
+    /// map), used for validating the correctness of the CBOR being written, and so it doesn't
+    /// overflow the maximum supported depth.
+    _az_json_bit_stack bit_stack;
+
+    /// A copy of the options provided by the user.
+    az_cbor_writer_options options;
+  } _internal;
+} az_cbor_writer;
+
+/**
+ * @brief Initializes an #az_cbor_writer which writes CBOR data into a buffer.
+ *
+ * @param[out] out_cbor_writer A pointer to an #az_cbor_writer instance to initialize.
+ * @param destination_buffer An #az_span over the byte buffer where the CBOR data is to be written.
+ * @param[in] options __[nullable]__ A reference to an #az_cbor_writer_options
+ * structure which defines custom behavior of the #az_cbor_writer. If `NULL` is passed, the writer
+ * will use the default options (i.e. #az_cbor_writer_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK #az_cbor_writer is initialized successfully.
+ * @retval other Initialization failed.
+ */
+AZ_NODISCARD az_result az_cbor_writer_init(
+    az_cbor_writer* out_cbor_writer,
+    az_span destination_buffer,
+    az_cbor_writer_options const* options);
+
+/**
+ * @brief Initializes an #az_cbor_writer which writes CBOR data into a destination that can contain
+ * non-contiguous buffers.
+ *
+ * @param[out] out_cbor_writer A pointer to an #az_cbor_writer the instance to initialize.
+ * @param[in] first_destination_buffer An #az_span over the byte buffer where the CBOR data is to be
+ * written at the start.
+ * @param[in] allocator_callback An #az_span_allocator_fn callback function that provides the
+ * destination span to write the CBOR data to once the previous buffer is full or too small to
+ * contain the next token.
+ * @param user_context A context specific user-defined struct or set of fields that is passed
+ * through to calls to the #az_span_allocator_fn.
+ * @param[in] options __[nullable]__ A reference to an #az_cbor_writer_options
+ * structure which defines custom behavior of the #az_cbor_writer. If `NULL` is passed, the writer
+ * will use the default options (i.e. #az_cbor_writer_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_cbor_writer is initialized successfully.
+ * @retval other Failure.
+ *
+ * @remarks Text and byte strings are split across buffers when they don't fit within the current
+ * one, in which case the allocator is asked for at least 64 bytes.
+ */
+AZ_NODISCARD az_result az_cbor_writer_chunked_init(
+    az_cbor_writer* out_cbor_writer,
+    az_span first_destination_buffer,
+    az_span_allocator_fn allocator_callback,
+    void* user_context,
+    az_cbor_writer_options const* options);
+
+/**
+ * @brief Returns the #az_span containing the final CBOR data written by the #az_cbor_writer to the
+ * destination buffer.
+ *
+ * @param[in] cbor_writer A pointer to an #az_cbor_writer instance wrapping the destination buffer.
+ *
+ * @note Do NOT modify or override the contents of the returned #az_span unless you are no longer
+ * writing CBOR data into it.
+ *
+ * @return An #az_span containing the final CBOR data into the destination buffer written by the
+ * #az_cbor_writer.
+ *
+ * @remarks This function returns the entire CBOR data when it fits within the destination buffer
+ * (i.e. the destination was a contiguous buffer). If the destination was non-contiguous, this
+ * function returns the last chunk of CBOR data that was written.
+ */
+AZ_NODISCARD AZ_INLINE az_span
+az_cbor_writer_get_bytes_used_in_destination(az_cbor_writer const* cbor_writer)
+{
+  return az_span_slice(
+      cbor_writer->_internal.destination_buffer, 0, cbor_writer->_internal.bytes_written);
+}
+
+/**
+ * @brief Appends the UTF-8 text value as a CBOR text string.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the string value to.
+ * @param[in] value The UTF-8 encoded value to be written as a CBOR text string.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The string value was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remarks Unlike JSON, CBOR text strings are not escaped, so \p value is copied as is.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_string(az_cbor_writer* ref_cbor_writer, az_span value);
+
+/**
+ * @brief Appends the binary data as a CBOR byte string.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the bytes to.
+ * @param[in] value The binary data to be written as a CBOR byte string.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The bytes were appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remarks Binary data, which would need to be base64 encoded within JSON, is written as is.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_bytes(az_cbor_writer* ref_cbor_writer, az_span value);
+
+/**
+ * @brief Appends the UTF-8 property name (as a CBOR text string) which is the key of a CBOR map
+ * entry.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the property name to.
+ * @param[in] name The UTF-8 encoded property name of the CBOR map entry.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property name was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_cbor_writer_append_property_name(az_cbor_writer* ref_cbor_writer, az_span name);
+
+/**
+ * @brief Appends a boolean value (as a CBOR simple value `true` or `false`).
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the boolean to.
+ * @param[in] value The value to be written as a CBOR simple value.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The boolean was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_bool(az_cbor_writer* ref_cbor_writer, bool value);
+
+/**
+ * @brief Appends an `int32_t` number value.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a CBOR integer.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_int32(az_cbor_writer* ref_cbor_writer, int32_t value);
+
+/**
+ * @brief Appends an `int64_t` number value.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a CBOR integer.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_int64(az_cbor_writer* ref_cbor_writer, int64_t value);
+
+/**
+ * @brief Appends a `uint64_t` number value.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a CBOR unsigned integer.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result
+az_cbor_writer_append_uint64(az_cbor_writer* ref_cbor_writer, uint64_t value);
+
+/**
+ * @brief Appends a `double` number value.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a CBOR floating-point number.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remarks The exact binary value is written, so unlike az_json_writer_append_double(), there is
+ * no number of fractional digits to choose. It is written as a half, single or double precision
+ * floating-point number, whichever is the shortest to hold the value exactly.
+ *
+ * @remarks Only finite double values are supported. Values such as `NAN` and `INFINITY` are not
+ * allowed.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_double(az_cbor_writer* ref_cbor_writer, double value);
+
+/**
+ * @brief Appends the CBOR simple value `null`.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the `null` literal to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK `null` was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_null(az_cbor_writer* ref_cbor_writer);
+
+/**
+ * @brief Appends the beginning of a CBOR map, which takes the place of a JSON object.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the start of the map to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Map start was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The depth of the CBOR data exceeds the maximum allowed
+ * depth of 16 nested maps or arrays.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_begin_object(az_cbor_writer* ref_cbor_writer);
+
+/**
+ * @brief Appends the beginning of a CBOR array.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the start of the array to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Array start was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The depth of the CBOR data exceeds the maximum allowed
+ * depth of 16 nested maps or arrays.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_begin_array(az_cbor_writer* ref_cbor_writer);
+
+/**
+ * @brief Appends the end of the current CBOR map.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the end of the map to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Map end was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_end_object(az_cbor_writer* ref_cbor_writer);
+
+/**
+ * @brief Appends the end of the current CBOR array.
+ *
+ * @param[in,out] ref_cbor_writer A pointer to an #az_cbor_writer instance containing the buffer to
+ * append the end of the array to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Array end was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ */
+AZ_NODISCARD az_result az_cbor_writer_append_end_array(az_cbor_writer* ref_cbor_writer);
+
+/************************************ CBOR READER ******************/
+
+/**
+ * @brief Allows the user to define custom behavior when reading CBOR using the #az_cbor_reader.
+ */
+typedef struct
+{
+  struct
+  {
+    /// Currently, this is unused, but needed as a placeholder since we can't have an empty struct.
+    bool unused;
+  } _internal;
+} az_cbor_reader_options;
+
+/**
+ * @brief Gets the default CBOR reader options.
+ *
+ * @details Call this to obtain an initialized #az_cbor_reader_options structure that can be
+ * modified and passed to #az_cbor_reader_init().
+ *
+ * @return The default #az_cbor_reader_options.
+ */
+AZ_NODISCARD AZ_INLINE az_cbor_reader_options az_cbor_reader_options_default()
+{
+  az_cbor_reader_options options = {
+    ._internal = {
+      .unused = false,
+    },
+  };
+
+  return options;
+}
+
+/**
+ * @brief Returns the CBOR tokens contained within a buffer of CBOR data, one at a time.
+ *
+ * @remarks The token field is meant to be used as read-only to return the #az_cbor_token while
+ * reading the CBOR. Do NOT modify it.
+ *
+ * @remarks Maps and arrays can be of definite or indefinite length, and their end is returned as a
+ * #AZ_CBOR_TOKEN_END_OBJECT or #AZ_CBOR_TOKEN_END_ARRAY token either way. Only text strings are
+ * supported as map keys. Tags are skipped, and returned as the data item they enclose.
+ */
+typedef struct
+{
+  /// This read-only field gives access to the current token that the #az_cbor_reader has
+  /// processed, and it shouldn't be modified by the caller.
+  az_cbor_token token;
+
+  /// The depth of the current token. This read-only field tracks the recursive depth of the nested
+  /// maps or arrays within the CBOR data processed so far, and it shouldn't be modified by the
+  /// caller.
+  int32_t current_depth;
+
+  struct
+  {
+    /// The first buffer containing the CBOR data.
+    az_span cbor_buffer;
+
+    /// The array of non-contiguous buffers containing the CBOR data, which will be null for the
+    /// single buffer case.
+    az_span* cbor_buffers;
+
+    /// The number of non-contiguous buffer segments in the array. It is set to one for the single
+    /// buffer case.
+    int32_t number_of_buffers;
+
+    /// The current buffer segment being processed while reading the CBOR in non-contiguous buffer
+    /// segments.
+    int32_t buffer_index;
+
+    /// The number of bytes consumed so far in the current buffer segment.
+    int32_t bytes_consumed;
+
+    /// The total bytes consumed from the input CBOR data. In the case of a single buffer, this is
+    /// identical to bytes_consumed.
+    int32_t total_bytes_consumed;
+
+    /// A limited stack to track the depth and nested CBOR maps or arrays read so far.
+    _az_json_bit_stack bit_stack;
+
+    /// The number of data items left within each of the maps or arrays read so far (counting keys
+    /// and values separately), or -1 for those of indefinite length.
+    int32_t remaining_items[_az_MAX_CBOR_NESTING_DEPTH];
+
+    /// A copy of the options provided by the user.
+    az_cbor_reader_options options;
+  } _internal;
+} az_cbor_reader;
+
+/**
+ * @brief Initializes an #az_cbor_reader to read the CBOR data contained within the provided
+ * buffer.
+ *
+ * @param[out] out_cbor_reader A pointer to an #az_cbor_reader instance to initialize.
+ * @param[in] cbor_buffer An #az_span over the byte buffer containing the CBOR data to read.
+ * @param[in] options __[nullable]__ A reference to an #az_cbor_reader_options structure which
+ * defines custom behavior of the #az_cbor_reader. If `NULL` is passed, the reader will use the
+ * default options (i.e. #az_cbor_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_cbor_reader is initialized successfully.
+ * @retval other Initialization failed.
+ *
+ * @remarks The provided CBOR buffer must not be empty.
+ *
+ * @remarks An instance of #az_cbor_reader must not outlive the lifetime of the CBOR data within
+ * the \p cbor_buffer.
+ */
+AZ_NODISCARD az_result az_cbor_reader_init(
+    az_cbor_reader* out_cbor_reader,
+    az_span cbor_buffer,
+    az_cbor_reader_options const* options);
+
+/**
+ * @brief Initializes an #az_cbor_reader to read the CBOR data contained within the provided set
+ * of discontiguous buffers.
+ *
+ * @param[out] out_cbor_reader A pointer to an #az_cbor_reader instance to initialize.
+ * @param[in] cbor_buffers An array of non-contiguous byte buffers, as spans, containing the CBOR
+ * data to read.
+ * @param[in] number_of_buffers The number of buffer segments provided, i.e. the length of the \p
+ * cbor_buffers array.
+ * @param[in] options __[nullable]__ A reference to an #az_cbor_reader_options
+ * structure which defines custom behavior of the #az_cbor_reader. If `NULL` is passed, the reader
+ * will use the default options (i.e. #az_cbor_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_cbor_reader is initialized successfully.
+ * @retval other Initialization failed.
+ *
+ * @remarks The provided array of CBOR buffers must not be empty, and therefore \p number_of_buffers
+ * must also be greater than 0. The array must also not contain any empty span segments.
+ *
+ * @remarks An instance of #az_cbor_reader must not outlive the lifetime of the CBOR data within
+ * the \p cbor_buffers.
+ */
+AZ_NODISCARD az_result az_cbor_reader_chunked_init(
+    az_cbor_reader* out_cbor_reader,
+    az_span cbor_buffers[],
+    int32_t number_of_buffers,
+    az_cbor_reader_options const* options);
+
+/**
+ * @brief Reads the next token in the CBOR data and updates the reader state.
+ *
+ * @param[in,out] ref_cbor_reader A pointer to an #az_cbor_reader instance containing the CBOR to
+ * read.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The token was read successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the CBOR data is reached in the middle of a data
+ * item, or of a map or array.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR A malformed or unsupported data item is detected, such as a
+ * map key which isn't a text string, or data following the end of the top-level data item.
+ * @retval #AZ_ERROR_NOT_SUPPORTED A text or byte string of indefinite length is detected.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The CBOR data has more than 16 nested maps or arrays.
+ * @retval #AZ_ERROR_JSON_READER_DONE No more CBOR data left to process.
+ */
+AZ_NODISCARD az_result az_cbor_reader_next_token(az_cbor_reader* ref_cbor_reader);
+
+/**
+ * @brief Reads and skips over any nested CBOR elements.
+ *
+ * @param[in,out] ref_cbor_reader A pointer to an #az_cbor_reader instance containing the CBOR to
+ * read.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The children of the current CBOR token are skipped successfully.
+ * @retval other The CBOR data is invalid, see #az_cbor_reader_next_token().
+ *
+ * @remarks If the current token kind is a property name, the reader first moves to the property
+ * value. Then, if the token kind is start of a map or array, the reader moves to the matching end
+ * map or array. For all other token kinds, the reader doesn't move and returns #AZ_OK.
+ */
+AZ_NODISCARD az_result az_cbor_reader_skip_children(az_cbor_reader* ref_cbor_reader);
+
+#include <azure/core/_az_cfg_suffix.h>
+
+#endif // _az_CBOR_H
@@ -260,6 +260,118 @@ AZ_NODISCARD bool az_json_token_is_text_equal(
     az_json_token const* json_token,
     az_span expected_text);
 
+/**
+ * @brief A lookup table over a set of names, such as the property names a JSON payload is
+ * expected to contain, which finds the name matching an #az_json_token without comparing it against
+ * every name in the set.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The names provided by the user.
+    az_span const* names;
+
+    /// The number of names in the table.
+    int32_t number_of_names;
+
+    /// The hash table, where each bucket contains the index of a name plus one, or 0 if it is
+    /// empty.
+    uint16_t* buckets;
+
+    /// The number of buckets, which is a power of two.
+    int32_t number_of_buckets;
+  } _internal;
+} az_json_name_table;
+
+/**
+ * @brief Initializes an #az_json_name_table over a set of names.
+ *
+ * @param[out] out_name_table A pointer to an #az_json_name_table instance to initialize.
+ * @param[in] names An array of names to look up, without any JSON escaping.
+ * @param[in] number_of_names The number of names in the \p names array.
+ * @param[in] buckets A caller-provided buffer used to hold the hash table.
+ * @param[in] number_of_buckets The number of entries in the \p buckets buffer. It must be a power
+ * of two, and greater than \p number_of_names. Twice the number of names (rounded up to a power of
+ * two) is recommended.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_name_table is initialized successfully.
+ *
+ * @remarks The \p names array, the content of each name, and the \p buckets buffer must outlive the
+ * #az_json_name_table. If \p names contains duplicates, the first one is found.
+ */
+AZ_NODISCARD az_result az_json_name_table_init(
+    az_json_name_table* out_name_table,
+    az_span const names[],
+    int32_t number_of_names,
+    uint16_t buckets[],
+    int32_t number_of_buckets);
+
+/**
+ * @brief Finds the name within an #az_json_name_table which is equal to the unescaped JSON token
+ * value, by doing a case-sensitive comparison.
+ *
+ * @param[in] name_table A pointer to an initialized #az_json_name_table.
+ * @param[in] json_token A pointer to an #az_json_token instance containing the JSON string or
+ * property name token.
+ * @param[out] out_index The index, within the names the \p name_table was initialized with, of the
+ * name matching the token.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK A matching name was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND None of the names match the token, or the token kind is not
+ * #AZ_JSON_TOKEN_STRING nor #AZ_JSON_TOKEN_PROPERTY_NAME.
+ */
+AZ_NODISCARD az_result az_json_name_table_find(
+    az_json_name_table const* name_table,
+    az_json_token const* json_token,
+    int32_t* out_index);
+
+/************************************ JSON VALIDATOR ******************/
+
+/**
+ * @brief A single, possibly nested, JSON value which is known to be valid, such as a section of a
+ * payload that is built once and appended many times.
+ *
+ * @remarks It can only be initialized by #az_json_validate(), and refers to the JSON text it
+ * validated, which must not be modified afterwards.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The JSON text that was validated.
+    az_span json_text;
+
+    /// The kind of the last token within the JSON text (a value, or the end of an object or array).
+    az_json_token_kind last_token_kind;
+  } _internal;
+} az_json_validated_text;
+
+/**
+ * @brief Validates that \p json_text is a single, possibly nested, JSON value, with optional
+ * whitespace around it.
+ *
+ * @param[in] json_text The UTF-8 encoded JSON text to validate.
+ * @param[out] out_validated_text __[nullable]__ If the JSON text is valid, an
+ * #az_json_validated_text that refers to it, which can be appended by
+ * #az_json_writer_append_validated_json_text() without validating it again. Can be `NULL`.
+ * @pre \p json_text must be a valid span of size greater than 0.
+ *
+ * @remarks The JSON text is checked against the same grammar as the #az_json_reader, with the same
+ * limit of 64 nested objects or arrays, but without producing any tokens, which makes it faster
+ * than reading the JSON text to the end.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON text is valid.
+ * @retval #AZ_ERROR_UNEXPECTED_END The JSON text is incomplete and ends too early.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The JSON text has an unexpected character.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The JSON text has more than 64 nested objects or arrays.
+ */
+AZ_NODISCARD az_result
+az_json_validate(az_span json_text, az_json_validated_text* out_validated_text);
+
 /************************************ JSON WRITER ******************/
 
 /**
@@ -385,6 +497,88 @@ AZ_NODISCARD az_result az_json_writer_chunked_init(
     void* user_context,
     az_json_writer_options const* options);
 
+/**
+ * @brief Defines the signature of the callback function that the caller must implement to send (or
+ * store) each completed chunk of JSON text written by an #az_json_writer initialized with
+ * #az_json_writer_sink_init().
+ *
+ * @param[in] user_context The user-defined context passed to #az_json_writer_sink_init().
+ * @param[in] json_chunk The next chunk of JSON text, which is never empty.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval other Failure, which makes the write that needed the space fail with
+ * #AZ_ERROR_NOT_ENOUGH_SPACE.
+ *
+ * @remarks The callback may start sending the chunk and return before it is sent, since the
+ * writer moves on to the other buffer. However, the next call must not return until the previous
+ * chunk has been sent, since its buffer is written into again once the callback returns.
+ */
+typedef az_result (*az_json_writer_flush_fn)(void* user_context, az_span json_chunk);
+
+/**
+ * @brief The state of an #az_json_writer which writes JSON text into a pair of buffers, in turn,
+ * and flushes each of them once it is full.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The buffers provided by the user, written into in turn.
+    az_span buffers[2];
+
+    /// The index, within buffers, of the buffer currently written into.
+    int32_t current_buffer;
+
+    /// The callback which is given each completed chunk of JSON text.
+    az_json_writer_flush_fn flush_callback;
+
+    /// Any struct that was provided by the user for their specific implementation, passed through
+    /// to the #az_json_writer_flush_fn.
+    void* user_context;
+  } _internal;
+} az_json_writer_sink;
+
+/**
+ * @brief Initializes an #az_json_writer which writes JSON text into two buffers, in turn, and
+ * passes each of them to a callback once it is full, so that large payloads can be streamed (such
+ * as to a socket or a file) using a fixed amount of memory.
+ *
+ * @param[out] out_json_writer A pointer to an #az_json_writer the instance to initialize.
+ * @param[out] out_json_writer_sink A pointer to an #az_json_writer_sink instance to initialize,
+ * which holds the state of the buffers. It must outlive the \p out_json_writer.
+ * @param[in] first_buffer An #az_span over the byte buffer where the JSON text is to be written at
+ * the start.
+ * @param[in] second_buffer An #az_span over the byte buffer where the JSON text is written while
+ * the \p first_buffer is being flushed. It must not overlap with the \p first_buffer.
+ * @param[in] flush_callback An #az_json_writer_flush_fn callback function which is given each
+ * completed chunk of JSON text.
+ * @param user_context A context specific user-defined struct or set of fields that is passed
+ * through to calls to the #az_json_writer_flush_fn.
+ * @param[in] options __[nullable]__ A reference to an #az_json_writer_options
+ * structure which defines custom behavior of the #az_json_writer. If `NULL` is passed, the writer
+ * will use the default options (i.e. #az_json_writer_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_writer is initialized successfully.
+ * @retval other Failure.
+ *
+ * @remarks Each buffer must be at least 64 bytes, which is the largest amount of space the writer
+ * asks for at once. Longer strings, property names, and JSON text are split across chunks, so the
+ * size of the JSON text isn't limited by the size of the buffers.
+ *
+ * @remarks Once everything has been written, #az_json_writer_sink_flush() must be called to flush
+ * the last chunk.
+ */
+AZ_NODISCARD az_result az_json_writer_sink_init(
+    az_json_writer* out_json_writer,
+    az_json_writer_sink* out_json_writer_sink,
+    az_span first_buffer,
+    az_span second_buffer,
+    az_json_writer_flush_fn flush_callback,
+    void* user_context,
+    az_json_writer_options const* options);
+
 /**
  * @brief Returns the #az_span containing the JSON text written to the underlying buffer so far, in
  * the last provided destination buffer.
@@ -409,6 +603,21 @@ az_json_writer_get_bytes_used_in_destination(az_json_writer const* json_writer)
       json_writer->_internal.destination_buffer, 0, json_writer->_internal.bytes_written);
 }
 
+/**
+ * @brief Flushes the JSON text written so far, and not flushed yet, by an #az_json_writer
+ * initialized with #az_json_writer_sink_init().
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance initialized with
+ * #az_json_writer_sink_init().
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON text was flushed successfully, or there was nothing to flush.
+ * @retval other The #az_json_writer_flush_fn callback failed.
+ *
+ * @remarks The writer can keep on writing afterwards, into the other buffer.
+ */
+AZ_NODISCARD az_result az_json_writer_sink_flush(az_json_writer* ref_json_writer);
+
 /**
  * @brief Appends the UTF-8 text value (as a JSON string) into the buffer.
  *
@@ -467,6 +676,31 @@ AZ_NODISCARD az_result az_json_writer_append_string(az_json_writer* ref_json_wri
 AZ_NODISCARD az_result
 az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_text);
 
+/**
+ * @brief Appends JSON text which was already validated by #az_json_validate(), without validating
+ * it again.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the JSON text to.
+ * @param[in] validated_text The #az_json_validated_text to be written as is, without any formatting
+ * or spacing changes.
+ *
+ * @note If you receive an #AZ_ERROR_NOT_ENOUGH_SPACE result while appending data for which there is
+ * sufficient space, note that the JSON writer requires at least 64 bytes of slack within the
+ * output buffer, above the theoretical minimal space needed. The JSON writer pessimistically
+ * requires this extra space because it tries to write formatted text in chunks rather than one
+ * character at a time, whenever the input data is dynamic in size.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON text was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small for the JSON text.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The \p ref_json_writer is in a state where the JSON text
+ * cannot be appended because it would result in invalid JSON.
+ */
+AZ_NODISCARD az_result az_json_writer_append_validated_json_text(
+    az_json_writer* ref_json_writer,
+    az_json_validated_text const* validated_text);
+
 /**
  * @brief Appends the UTF-8 property name (as a JSON string) which is the first part of a name/value
  * pair of a JSON object.
@@ -521,6 +755,70 @@ AZ_NODISCARD az_result az_json_writer_append_bool(az_json_writer* ref_json_write
  */
 AZ_NODISCARD az_result az_json_writer_append_int32(az_json_writer* ref_json_writer, int32_t value);
 
+/**
+ * @brief Appends an `int64_t` number value.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @note If you receive an #AZ_ERROR_NOT_ENOUGH_SPACE result while appending data for which there is
+ * sufficient space, note that the JSON writer requires at least 64 bytes of slack within the
+ * output buffer, above the theoretical minimal space needed. The JSON writer pessimistically
+ * requires this extra space because it tries to write formatted text in chunks rather than one
+ * character at a time, whenever the input data is dynamic in size.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remark Readers which parse JSON numbers as `double` (such as JavaScript) lose precision for
+ * integers beyond `2^53`.
+ */
+AZ_NODISCARD az_result az_json_writer_append_int64(az_json_writer* ref_json_writer, int64_t value);
+
+/**
+ * @brief Appends a `uint64_t` number value.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @note If you receive an #AZ_ERROR_NOT_ENOUGH_SPACE result while appending data for which there is
+ * sufficient space, note that the JSON writer requires at least 64 bytes of slack within the
+ * output buffer, above the theoretical minimal space needed. The JSON writer pessimistically
+ * requires this extra space because it tries to write formatted text in chunks rather than one
+ * character at a time, whenever the input data is dynamic in size.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remark Readers which parse JSON numbers as `double` (such as JavaScript) lose precision for
+ * integers beyond `2^53`.
+ */
+AZ_NODISCARD az_result
+az_json_writer_append_uint64(az_json_writer* ref_json_writer, uint64_t value);
+
+/**
+ * @brief Appends an already formatted JSON number, as is.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] number_text The UTF-8 encoded text of a valid JSON number, such as `-12.5e3`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remark Unlike az_json_writer_append_json_text(), the \p number_text is NOT validated, which
+ * avoids reading it twice when it comes from a trusted source, such as az_span_i64toa() or
+ * az_span_dtoa_round_trip(). Passing anything other than a valid JSON number results in invalid
+ * JSON being written.
+ */
+AZ_NODISCARD az_result
+az_json_writer_append_number_text(az_json_writer* ref_json_writer, az_span number_text);
+
 /**
  * @brief Appends a `double` number value.
  *
@@ -556,6 +854,36 @@ AZ_NODISCARD az_result az_json_writer_append_double(
     double value,
     int32_t fractional_digits);
 
+/**
+ * @brief Appends a `double` number value, using a representation that reads back as the same
+ * `double`.
+ *
+ * @details The text is the same as written by #az_span_dtoa_round_trip(), which is usually, but not
+ * always, the shortest one possible.
+ *
+ * @param[in,out] ref_json_writer A pointer to an #az_json_writer instance containing the buffer to
+ * append the number to.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @note If you receive an #AZ_ERROR_NOT_ENOUGH_SPACE result while appending data for which there is
+ * sufficient space, note that the JSON writer requires at least 64 bytes of slack within the
+ * output buffer, above the theoretical minimal space needed. The JSON writer pessimistically
+ * requires this extra space because it tries to write formatted text in chunks rather than one
+ * character at a time, whenever the input data is dynamic in size.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The number was appended successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The buffer is too small.
+ *
+ * @remark Only finite double values are supported. Values such as `NAN` and `INFINITY` are not
+ * allowed and would lead to invalid JSON being written.
+ *
+ * @remark The number is formatted with az_span_dtoa_round_trip(), so very small or large values are
+ * written in exponential notation (such as `1.5e-7`).
+ */
+AZ_NODISCARD az_result
+az_json_writer_append_double_round_trip(az_json_writer* ref_json_writer, double value);
+
 /**
  * @brief Appends the JSON literal `null`.
  *
@@ -627,11 +955,33 @@ AZ_NODISCARD az_result az_json_writer_append_end_array(az_json_writer* ref_json_
  */
 typedef struct
 {
-  struct
-  {
-    /// Currently, this is unused, but needed as a placeholder since we can't have an empty struct.
-    bool unused;
-  } _internal;
+  /**
+   * __[nullable]__ A caller-provided buffer which, when set, is filled by #az_json_reader_init()
+   * with the offsets of the structural characters and the start of every token within the JSON
+   * text. The reader then uses it to jump over whitespace (such as in pretty-printed JSON) rather
+   * than reading it one byte at a time.
+   *
+   * @remarks This buffer must outlive the #az_json_reader. It is only used when reading from a
+   * single contiguous buffer (i.e. it is ignored by #az_json_reader_chunked_init()).
+   *
+   * @remarks One entry per JSON token, plus one per `:` and `,` separator, is always enough. If
+   * the JSON text contains more entries than fit within the buffer, the index is not used, and the
+   * JSON is read as though no buffer was provided.
+   */
+  int32_t* structural_index;
+
+  /**
+   * The number of `int32_t` entries available within the `structural_index` buffer.
+   */
+  int32_t structural_index_length;
+
+  /**
+   * When `true`, #az_json_reader_skip_children() moves to the matching end of the current object
+   * or array by only tracking strings and brackets, rather than reading and validating every
+   * nested token. This is much faster for large subtrees, but malformed JSON within the skipped
+   * subtree (other than mismatched brackets or an unterminated string) is not detected.
+   */
+  bool fast_skip_children;
 } az_json_reader_options;
 
 /**
@@ -646,9 +996,9 @@ typedef struct
 AZ_NODISCARD AZ_INLINE az_json_reader_options az_json_reader_options_default()
 {
   az_json_reader_options options = {
-    ._internal = {
-      .unused = false,
-    },
+    .structural_index = NULL,
+    .structural_index_length = 0,
+    .fast_skip_children = false,
   };
 
   return options;
@@ -704,6 +1054,12 @@ typedef struct
 
     /// A copy of the options provided by the user.
     az_json_reader_options options;
+
+    /// The number of offsets written to the structural index, or 0 if the index isn't used.
+    int32_t structural_index_count;
+
+    /// The position within the structural index of the next offset that hasn't been consumed yet.
+    int32_t structural_index_position;
   } _internal;
 } az_json_reader;
 
@@ -786,12 +1142,594 @@ AZ_NODISCARD az_result az_json_reader_next_token(az_json_reader* ref_json_reader
  * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON document is reached.
  * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
  *
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The nested JSON is deeper than the maximum supported
+ * depth of 64.
+ *
  * @remarks If the current token kind is a property name, the reader first moves to the property
  * value. Then, if the token kind is start of an object or array, the reader moves to the matching
  * end object or array. For all other token kinds, the reader doesn't move and returns #AZ_OK.
+ *
+ * @remarks If the reader was initialized with #az_json_reader_options.fast_skip_children set to
+ * `true`, the nested JSON elements are skipped without being validated.
  */
 AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_reader);
 
+/************************************ JSON PUSH READER ******************/
+
+/**
+ * @brief Reads JSON text which is provided incrementally, one fragment at a time, such as when
+ * parsing a payload straight from a network receive buffer, without needing the whole payload in
+ * memory.
+ *
+ * @remarks When the fragments provided so far end in the middle of a token,
+ * #az_json_push_reader_next_token() returns #AZ_ERROR_JSON_READER_NEED_MORE_INPUT, and keeps the
+ * start of that token within a small caller-provided carry-over buffer, until the next fragment is
+ * provided using #az_json_push_reader_feed().
+ */
+typedef struct
+{
+  /// This read-only field gives access to the current token that the #az_json_push_reader has
+  /// processed, and it shouldn't be modified by the caller. Its slice refers either to the current
+  /// fragment or to the carry-over buffer, and is only valid until the next call to
+  /// #az_json_push_reader_next_token().
+  az_json_token token;
+
+  /// The depth of the current token. This read-only field tracks the recursive depth of the nested
+  /// objects or arrays within the JSON text processed so far, and it shouldn't be modified by the
+  /// caller.
+  int32_t current_depth;
+
+  struct
+  {
+    /// The reader used to read the tokens, whose buffer is the current fragment or carry-over.
+    az_json_reader reader;
+
+    /// The buffer used to hold a token which is split across fragments.
+    az_span carry_buffer;
+
+    /// The offset of the bytes still to be read within the carry-over buffer.
+    int32_t carry_start;
+
+    /// The number of bytes still to be read within the carry-over buffer, which precede the
+    /// current fragment.
+    int32_t carry_size;
+
+    /// The current fragment of JSON text.
+    az_span input;
+
+    /// The number of bytes of the current fragment which have been read (or carried over).
+    int32_t input_consumed;
+
+    /// Whether the current fragment is the last one.
+    bool is_final_input;
+  } _internal;
+} az_json_push_reader;
+
+/**
+ * @brief Initializes an #az_json_push_reader, before any JSON text has been provided.
+ *
+ * @param[out] out_json_push_reader A pointer to an #az_json_push_reader instance to initialize.
+ * @param[in] carry_buffer A caller-provided buffer used to hold a token which is split across
+ * fragments. It must be at least as large as the largest token (along with the whitespace and
+ * separators that precede it, and one more byte after numbers) within the JSON text.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_push_reader is initialized successfully.
+ *
+ * @remarks The \p carry_buffer must outlive the #az_json_push_reader.
+ */
+AZ_NODISCARD az_result
+az_json_push_reader_init(az_json_push_reader* out_json_push_reader, az_span carry_buffer);
+
+/**
+ * @brief Provides the next fragment of JSON text to an #az_json_push_reader.
+ *
+ * @param[in,out] ref_json_push_reader A pointer to an #az_json_push_reader instance.
+ * @param[in] json_fragment The next fragment of JSON text, which may be empty.
+ * @param[in] is_final_fragment `true` if this is the last fragment of the JSON text.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The fragment was provided successfully.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE The previous fragment hasn't been read in full yet (i.e.
+ * #az_json_push_reader_next_token() hasn't returned #AZ_ERROR_JSON_READER_NEED_MORE_INPUT), or the
+ * final fragment was already provided.
+ *
+ * @remarks The \p json_fragment must remain valid until the next call to this function, and as
+ * long as the tokens read from it are in use.
+ */
+AZ_NODISCARD az_result az_json_push_reader_feed(
+    az_json_push_reader* ref_json_push_reader,
+    az_span json_fragment,
+    bool is_final_fragment);
+
+/**
+ * @brief Reads the next token in the JSON text, from the fragments provided so far, and updates
+ * the state of the push reader.
+ *
+ * @param[in,out] ref_json_push_reader A pointer to an #az_json_push_reader instance.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The token was read successfully.
+ * @retval #AZ_ERROR_JSON_READER_NEED_MORE_INPUT The fragments provided so far end before the next
+ * token does. The next fragment must be provided using #az_json_push_reader_feed(), and this
+ * function called again.
+ * @retval #AZ_ERROR_JSON_READER_DONE The end of the JSON text is reached, after the final
+ * fragment.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE A token split across fragments is too large to fit within
+ * the carry-over buffer.
+ * @retval #AZ_ERROR_UNEXPECTED_END The final fragment ends before the JSON text is complete.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The JSON text is nested too deeply.
+ */
+AZ_NODISCARD az_result az_json_push_reader_next_token(az_json_push_reader* ref_json_push_reader);
+
+/************************************ JSON PATH SET ******************/
+
+/**
+ * @brief The limits of an #az_json_path_set.
+ */
+enum
+{
+  /// The maximum number of paths within an #az_json_path_set.
+  AZ_JSON_PATH_SET_MAX_PATHS = 32,
+
+  /// The maximum number of reference tokens (i.e. levels of nesting) within each path of an
+  /// #az_json_path_set.
+  AZ_JSON_PATH_SET_MAX_DEPTH = 16,
+};
+
+/**
+ * @brief A set of JSON pointer (RFC 6901) paths, such as `/desired/thermostat1/targetTemperature`,
+ * which can be looked up within a JSON document, in a single pass, using
+ * #az_json_reader_find_paths().
+ *
+ * @remarks Array elements are referenced by their zero-based index, such as `/values/0`.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The paths provided by the user.
+    az_span const* paths;
+
+    /// The number of paths in the set.
+    int32_t number_of_paths;
+
+    /// For each number of reference tokens, the set of paths that have exactly that many, as a
+    /// bit mask where bit `i` corresponds to `paths[i]`.
+    uint32_t paths_ending_at_depth[AZ_JSON_PATH_SET_MAX_DEPTH + 1];
+  } _internal;
+} az_json_path_set;
+
+/**
+ * @brief Initializes an #az_json_path_set from a set of JSON pointer paths.
+ *
+ * @param[out] out_path_set A pointer to an #az_json_path_set instance to initialize.
+ * @param[in] paths An array of JSON pointer paths. Each path must either be empty, which refers to
+ * the whole JSON value, or start with `/`.
+ * @param[in] number_of_paths The number of paths in the \p paths array. Must be between 1 and
+ * #AZ_JSON_PATH_SET_MAX_PATHS (inclusive).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_path_set is initialized successfully.
+ * @retval #AZ_ERROR_ARG A path is neither empty nor starts with `/`.
+ * @retval #AZ_ERROR_NOT_SUPPORTED A path contains the `~0` or `~1` escape sequences, or has more
+ * than #AZ_JSON_PATH_SET_MAX_DEPTH reference tokens.
+ *
+ * @remarks The \p paths array, and the content of each path, must outlive the #az_json_path_set.
+ */
+AZ_NODISCARD az_result az_json_path_set_init(
+    az_json_path_set* out_path_set,
+    az_span const paths[],
+    int32_t number_of_paths);
+
+/**
+ * @brief Reads the JSON value at the current position of the reader, and finds the tokens
+ * referenced by each path within the \p path_set, in a single pass.
+ *
+ * @param[in,out] ref_json_reader A pointer to an #az_json_reader instance containing the JSON to
+ * read. If the current token kind is #AZ_JSON_TOKEN_NONE (i.e. nothing has been read yet) or a
+ * property name, the reader first moves to the next token, which is the value the paths are
+ * relative to.
+ * @param[in] path_set A pointer to an initialized #az_json_path_set.
+ * @param[out] out_tokens An array of #az_json_token, with one entry for each path in the
+ * \p path_set. Each entry is set to the token referenced by the matching path, or to a token
+ * whose kind is #AZ_JSON_TOKEN_NONE if the path wasn't found.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON value was read successfully, regardless of whether all the paths were
+ * found.
+ * @retval #AZ_ERROR_UNEXPECTED_END The end of the JSON document is reached.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR An invalid character is detected.
+ *
+ * @remarks Objects and arrays which can't contain any of the remaining paths are skipped using
+ * #az_json_reader_skip_children(), and reading stops as soon as every path has been found. When a
+ * path references an object or array, its token is the start of that object or array.
+ *
+ * @remarks If a path matches more than one property, because the JSON contains duplicate property
+ * names, the first one is returned.
+ */
+AZ_NODISCARD az_result az_json_reader_find_paths(
+    az_json_reader* ref_json_reader,
+    az_json_path_set const* path_set,
+    az_json_token out_tokens[]);
+
+/************************************ JSON TEMPLATE ******************/
+
+/**
+ * @brief A precompiled JSON payload, such as a telemetry message or a reported property, whose
+ * structure is known ahead of time and whose values are filled in for each payload using an
+ * #az_json_template_writer.
+ *
+ * @remarks The skeleton is a valid JSON text in which every `null` value is a slot, to be filled
+ * in the order it appears, for example `{"temperature":null,"unit":"celsius","alarm":null}`. Since
+ * the skeleton is validated once, by #az_json_template_init(), filling it only copies the literal
+ * text in between the slots, which is faster than writing the same payload using an
+ * #az_json_writer.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The JSON skeleton provided by the user.
+    az_span json_skeleton;
+
+    /// The offset of each slot (i.e. of each `null` value) within the skeleton.
+    int32_t* slot_offsets;
+
+    /// The number of slots found within the skeleton.
+    int32_t number_of_slots;
+  } _internal;
+} az_json_template;
+
+/**
+ * @brief Initializes an #az_json_template by validating a JSON skeleton and finding its slots.
+ *
+ * @param[out] out_json_template A pointer to an #az_json_template instance to initialize.
+ * @param[in] json_skeleton The JSON text in which every `null` value is a slot. It must not be
+ * empty.
+ * @param[out] slot_offsets An array which is filled with the offset of each slot.
+ * @param[in] slot_offsets_length The number of elements in the \p slot_offsets array.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_template is initialized successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The skeleton contains more than \p slot_offsets_length slots.
+ * @retval #AZ_ERROR_UNEXPECTED_END The skeleton is incomplete.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The skeleton isn't valid JSON.
+ *
+ * @remarks The \p json_skeleton and the \p slot_offsets array must outlive the #az_json_template.
+ */
+AZ_NODISCARD az_result az_json_template_init(
+    az_json_template* out_json_template,
+    az_span json_skeleton,
+    int32_t slot_offsets[],
+    int32_t slot_offsets_length);
+
+/**
+ * @brief Gets the number of slots within an #az_json_template.
+ *
+ * @param[in] json_template A pointer to an initialized #az_json_template.
+ *
+ * @return The number of `null` values found within the JSON skeleton.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+az_json_template_get_slot_count(az_json_template const* json_template)
+{
+  return json_template->_internal.number_of_slots;
+}
+
+/**
+ * @brief Writes a JSON payload by filling the slots of an #az_json_template, in order, into a
+ * caller-provided buffer.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The template whose slots are being filled.
+    az_json_template const* json_template;
+
+    /// The buffer the JSON payload is written into.
+    az_span destination;
+
+    /// The number of bytes written up to the end of the last filled slot.
+    int32_t bytes_written;
+
+    /// The index of the next slot to fill.
+    int32_t next_slot;
+  } _internal;
+} az_json_template_writer;
+
+/**
+ * @brief Initializes an #az_json_template_writer which writes the JSON payload of an
+ * #az_json_template into \p destination_buffer.
+ *
+ * @param[out] out_json_template_writer A pointer to an #az_json_template_writer instance to
+ * initialize.
+ * @param[in] json_template A pointer to an initialized #az_json_template, which must outlive the
+ * #az_json_template_writer.
+ * @param[in] destination_buffer An #az_span over the byte buffer where the JSON payload is to be
+ * written.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_template_writer is initialized successfully.
+ *
+ * @remarks The same #az_json_template can be used by any number of writers, and a writer can be
+ * initialized again to write another payload.
+ */
+AZ_NODISCARD az_result az_json_template_writer_init(
+    az_json_template_writer* out_json_template_writer,
+    az_json_template const* json_template,
+    az_span destination_buffer);
+
+/**
+ * @brief Fills the next slot with a JSON string, escaping it as needed.
+ *
+ * @param[in,out] ref_json_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The UTF-8 encoded value to be written as a JSON string. The value is escaped
+ * before writing.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was filled successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small, in which case the slot is left
+ * unfilled.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Every slot has already been filled.
+ */
+AZ_NODISCARD az_result az_json_template_writer_append_string(
+    az_json_template_writer* ref_json_template_writer,
+    az_span value);
+
+/**
+ * @brief Fills the next slot with a boolean value (i.e. `true` or `false`).
+ *
+ * @param[in,out] ref_json_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to be written as a JSON literal `true` or `false`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was filled successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small, in which case the slot is left
+ * unfilled.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Every slot has already been filled.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_bool(az_json_template_writer* ref_json_template_writer, bool value);
+
+/**
+ * @brief Fills the next slot with the JSON literal `null`, i.e. leaves it as is.
+ *
+ * @param[in,out] ref_json_template_writer A pointer to an #az_json_template_writer instance.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was filled successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small, in which case the slot is left
+ * unfilled.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Every slot has already been filled.
+ */
+AZ_NODISCARD az_result
+az_json_template_writer_append_null(az_json_template_writer* ref_json_template_writer);
+
+/**
+ * @brief Fills the next slot with an `int32_t` number.
+ *
+ * @param[in,out] ref_json_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was filled successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small, in which case the slot is left
+ * unfilled.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Every slot has already been filled.
+ */
+AZ_NODISCARD az_result az_json_template_writer_append_int32(
+    az_json_template_writer* ref_json_template_writer,
+    int32_t value);
+
+/**
+ * @brief Fills the next slot with an `int64_t` number.
+ *
+ * @param[in,out] ref_json_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to be written as a JSON number.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was filled successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small, in which case the slot is left
+ * unfilled.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Every slot has already been filled.
+ */
+AZ_NODISCARD az_result az_json_template_writer_append_int64(
+    az_json_template_writer* ref_json_template_writer,
+    int64_t value);
+
+/**
+ * @brief Fills the next slot with a `double` number, using the same format as
+ * #az_json_writer_append_double().
+ *
+ * @param[in,out] ref_json_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[in] value The value to be written as a JSON number.
+ * @param[in] fractional_digits The number of digits of the \p value to write after the decimal
+ * point and truncate the rest.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The slot was filled successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small, in which case the slot is left
+ * unfilled.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Every slot has already been filled.
+ *
+ * @remarks Only finite double values are supported. Values such as `NAN` and `INFINITY` are not
+ * allowed and would lead to invalid JSON being written.
+ *
+ * @remarks The \p fractional_digits must be between 0 and 15 (inclusive).
+ */
+AZ_NODISCARD az_result az_json_template_writer_append_double(
+    az_json_template_writer* ref_json_template_writer,
+    double value,
+    int32_t fractional_digits);
+
+/**
+ * @brief Completes the JSON payload, once every slot has been filled.
+ *
+ * @param[in] json_template_writer A pointer to an #az_json_template_writer instance.
+ * @param[out] out_json An #az_span over the JSON payload, within the destination buffer.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The JSON payload was completed successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The destination is too small to fit the end of the payload.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE Not every slot has been filled.
+ */
+AZ_NODISCARD az_result az_json_template_writer_get_json(
+    az_json_template_writer const* json_template_writer,
+    az_span* out_json);
+
+/************************************ JSON DOCUMENT ******************/
+
+/**
+ * @brief A token within an #az_json_document, along with the position of the end of its value.
+ */
+typedef struct
+{
+  /// The token, as read by #az_json_reader, which can be used with the #az_json_token accessors,
+  /// such as #az_json_token_get_int32() and #az_json_token_is_text_equal().
+  az_json_token token;
+
+  struct
+  {
+    /// The index of the last token of the value which starts with this token, i.e. of the matching
+    /// end of an object or array, or of the token itself for any other kind.
+    int32_t end_index;
+  } _internal;
+} az_json_document_node;
+
+/**
+ * @brief A JSON document which has been read once into a caller-provided array of
+ * #az_json_document_node, so that it can be navigated in any order, without reading it again.
+ *
+ * @remarks The nodes are in the order the tokens appear within the JSON text, including property
+ * names and the end of objects and arrays, and are referred to by their index. The root value is
+ * at index 0. The value of a property is at the index following its name, and the first element
+ * of an array (or property name of an object) is at the index following its start.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The nodes provided by the user.
+    az_json_document_node* nodes;
+
+    /// The number of nodes read from the JSON text.
+    int32_t number_of_nodes;
+  } _internal;
+} az_json_document;
+
+/**
+ * @brief Initializes an #az_json_document by reading the JSON text within \p json_buffer once.
+ *
+ * @param[out] out_document A pointer to an #az_json_document instance to initialize.
+ * @param[in] json_buffer An #az_span over the byte buffer containing the JSON text to read.
+ * @param[out] nodes An array which is filled with one #az_json_document_node per JSON token.
+ * @param[in] nodes_length The number of elements in the \p nodes array.
+ * @param[in] options __[nullable]__ A reference to an #az_json_reader_options structure which
+ * defines custom behavior of the #az_json_reader used to read the JSON text. If `NULL` is passed,
+ * the reader will use the default options (i.e. #az_json_reader_options_default()).
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_json_document is initialized successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The JSON text contains more than \p nodes_length tokens.
+ * @retval #AZ_ERROR_UNEXPECTED_END The JSON text is incomplete.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The JSON text is invalid.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The JSON text is nested too deeply.
+ *
+ * @remarks The \p json_buffer and the \p nodes array must outlive the #az_json_document, since the
+ * tokens refer to the JSON text.
+ */
+AZ_NODISCARD az_result az_json_document_init(
+    az_json_document* out_document,
+    az_span json_buffer,
+    az_json_document_node nodes[],
+    int32_t nodes_length,
+    az_json_reader_options const* options);
+
+/**
+ * @brief Gets the number of tokens within an #az_json_document.
+ *
+ * @param[in] document A pointer to an initialized #az_json_document.
+ *
+ * @return The number of nodes used by the document.
+ */
+AZ_NODISCARD AZ_INLINE int32_t az_json_document_get_node_count(az_json_document const* document)
+{
+  return document->_internal.number_of_nodes;
+}
+
+/**
+ * @brief Gets the token at \p index within an #az_json_document.
+ *
+ * @param[in] document A pointer to an initialized #az_json_document.
+ * @param[in] index The index of the token, which must be less than the number of nodes.
+ *
+ * @return A pointer to the token, which remains valid for the lifetime of the document.
+ */
+AZ_NODISCARD AZ_INLINE az_json_token const*
+az_json_document_get_token(az_json_document const* document, int32_t index)
+{
+  return &document->_internal.nodes[index].token;
+}
+
+/**
+ * @brief Gets the index of the token which follows the value starting at \p index, skipping over
+ * any nested tokens if the value is an object or array.
+ *
+ * @param[in] document A pointer to an initialized #az_json_document.
+ * @param[in] index The index of a token, which must not be a property name nor the end of an
+ * object or array.
+ *
+ * @return The index of the next sibling (i.e. of the next property name or array element), or of
+ * the end of the parent object or array if this was the last one.
+ *
+ * @remarks This is a constant-time operation, regardless of the size of the value.
+ */
+AZ_NODISCARD int32_t
+az_json_document_get_next_index(az_json_document const* document, int32_t index);
+
+/**
+ * @brief Finds the value of a property, by name, within an object of an #az_json_document.
+ *
+ * @param[in] document A pointer to an initialized #az_json_document.
+ * @param[in] object_index The index of the start of the object to search within.
+ * @param[in] name The name of the property, without any JSON escaping.
+ * @param[out] out_value_index The index of the value of the property, if found.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND The object doesn't contain a property with this name.
+ *
+ * @remarks Only the property names of the object itself are compared, since the values are skipped
+ * over without looking at their nested tokens. If the object contains duplicate property names,
+ * the first one is returned.
+ */
+AZ_NODISCARD az_result az_json_document_get_property(
+    az_json_document const* document,
+    int32_t object_index,
+    az_span name,
+    int32_t* out_value_index);
+
+/**
+ * @brief Finds an element, by position, within an array of an #az_json_document.
+ *
+ * @param[in] document A pointer to an initialized #az_json_document.
+ * @param[in] array_index The index of the start of the array to search within.
+ * @param[in] position The zero-based position of the element within the array.
+ * @param[out] out_element_index The index of the element, if found.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The element was found.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND The array has \p position elements or fewer.
+ */
+AZ_NODISCARD az_result az_json_document_get_array_element(
+    az_json_document const* document,
+    int32_t array_index,
+    int32_t position,
+    int32_t* out_element_index);
+
 /**
  * @brief Unescapes the JSON string within the provided #az_span.
  *
@@ -0,0 +1,135 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file
+ *
+ * @brief Defines a portable implementation of the SHA-256 hash (FIPS 180-4), and of HMAC-SHA256
+ * (RFC 2104), such as used to sign Shared Access Signature (SAS) tokens.
+ *
+ * @note This implementation is written for portability rather than speed or side-channel
+ * resistance beyond what SAS token signing needs. Applications with access to a hardware crypto
+ * engine or a vetted crypto library can use that instead.
+ *
+ * @note You MUST NOT use any symbols (macros, functions, structures, enums, etc.)
+ * prefixed with an underscore ('_') directly in your application code. These symbols
+ * are part of Azure SDK's internal implementation; we do not document these symbols
+ * and they are subject to change in future versions of the SDK which would break your code.
+ */
+
+#ifndef _az_SHA256_H
+#define _az_SHA256_H
+
+#include <azure/core/az_result.h>
+#include <azure/core/az_span.h>
+
+#include <stdint.h>
+
+#include <azure/core/_az_cfg_prefix.h>
+
+enum
+{
+  AZ_SHA256_HASH_SIZE = 32, ///< The size, in bytes, of a SHA-256 hash, and of an HMAC-SHA256.
+  AZ_SHA256_BLOCK_SIZE = 64, ///< The size, in bytes, of the blocks SHA-256 processes.
+};
+
+/**
+ * @brief Computes a SHA-256 hash incrementally, over data provided one chunk at a time.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The intermediate hash value.
+    uint32_t state[8];
+
+    /// The number of bytes hashed so far.
+    uint64_t length;
+
+    /// The bytes provided so far which don't make up a whole block yet.
+    uint8_t block[AZ_SHA256_BLOCK_SIZE];
+  } _internal;
+} az_sha256;
+
+/**
+ * @brief Initializes an #az_sha256, before any data has been provided.
+ *
+ * @param[out] out_sha256 A pointer to an #az_sha256 instance to initialize.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_sha256 is initialized successfully.
+ */
+AZ_NODISCARD az_result az_sha256_init(az_sha256* out_sha256);
+
+/**
+ * @brief Hashes the next chunk of data.
+ *
+ * @param[in,out] ref_sha256 A pointer to an #az_sha256 instance.
+ * @param[in] data The next chunk of data, which may be empty.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The data is hashed successfully.
+ */
+AZ_NODISCARD az_result az_sha256_update(az_sha256* ref_sha256, az_span data);
+
+/**
+ * @brief Completes the hash of the data provided so far.
+ *
+ * @param[in,out] ref_sha256 A pointer to an #az_sha256 instance, which must be initialized again
+ * to be reused.
+ * @param destination The output #az_span where the #AZ_SHA256_HASH_SIZE bytes of the hash are
+ * copied to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination is smaller than #AZ_SHA256_HASH_SIZE.
+ */
+AZ_NODISCARD az_result az_sha256_final(az_sha256* ref_sha256, az_span destination);
+
+/**
+ * @brief An HMAC-SHA256 key, which holds the hash state after the inner and outer padded keys, so
+ * that they are only hashed once per key, rather than once per message.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The hash state after the key XORed with the inner padding.
+    az_sha256 inner;
+
+    /// The hash state after the key XORed with the outer padding.
+    az_sha256 outer;
+  } _internal;
+} az_hmac_sha256_key;
+
+/**
+ * @brief Initializes an #az_hmac_sha256_key from the secret key.
+ *
+ * @param[out] out_key A pointer to an #az_hmac_sha256_key instance to initialize.
+ * @param[in] key The secret key, which may be of any size. It isn't referenced once the function
+ * returns.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The #az_hmac_sha256_key is initialized successfully.
+ */
+AZ_NODISCARD az_result az_hmac_sha256_key_init(az_hmac_sha256_key* out_key, az_span key);
+
+/**
+ * @brief Computes the HMAC-SHA256 of a message.
+ *
+ * @param[in] key A pointer to an initialized #az_hmac_sha256_key, which can be reused for any
+ * number of messages.
+ * @param[in] message The message to authenticate.
+ * @param destination The output #az_span where the #AZ_SHA256_HASH_SIZE bytes of the HMAC are
+ * copied to.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination is smaller than #AZ_SHA256_HASH_SIZE.
+ */
+AZ_NODISCARD az_result
+az_hmac_sha256_compute(az_hmac_sha256_key const* key, az_span message, az_span destination);
+
+#include <azure/core/_az_cfg_suffix.h>
+
+#endif // _az_SHA256_H
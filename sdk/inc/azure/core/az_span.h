@@ -483,6 +483,35 @@ AZ_NODISCARD az_result az_span_u64toa(az_span destination, uint64_t source, az_s
 AZ_NODISCARD az_result
 az_span_dtoa(az_span destination, double source, int32_t fractional_digits, az_span* out_span);
 
+/**
+ * @brief Converts a `double` into digit characters (base 10) that parse back to the exact same
+ * value, and copies them to the \p destination #az_span starting at its 0-th index.
+ *
+ * @details The digits are generated with Grisu2, which gives the shortest representation for the
+ * vast majority of values, but isn't guaranteed to for all of them.
+ *
+ * @param destination The #az_span where the bytes should be copied to.
+ * @param[in] source The `double` whose number is copied to the \p destination #az_span as ASCII
+ * digits and characters.
+ * @param[out] out_span A pointer to an #az_span that receives the remainder of the \p destination
+ * #az_span after the `double` has been copied.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK Success.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p destination is not big enough to contain the copied
+ * bytes.
+ * @retval #AZ_ERROR_NOT_SUPPORTED The \p source is not a finite decimal number.
+ *
+ * @remark Only finite `double` values are supported. Values such as `NaN` and `INFINITY` are not
+ * allowed.
+ *
+ * @remark Unlike az_span_dtoa(), the number isn't truncated, and there is no limit on its
+ * magnitude. Numbers whose magnitude is less than `1e-6`, or at least `1e21`, are written in
+ * exponential notation (such as `1.5e-7` or `1e+21`), and at most 25 bytes are written.
+ */
+AZ_NODISCARD az_result
+az_span_dtoa_round_trip(az_span destination, double source, az_span* out_span);
+
 /******************************  NON-CONTIGUOUS SPAN  */
 
 /**
@@ -54,6 +54,13 @@ AZ_INLINE AZ_NODISCARD int32_t _az_span_diff(az_span sliced_span, az_span origin
   return answer;
 }
 
+/**
+ * @brief Returns the number of decimal digits needed to write \p number, which is at least 1.
+ *
+ * @param[in] number The number to be written.
+ */
+AZ_NODISCARD int32_t _az_span_u64toa_size(uint64_t number);
+
 /**
  * @brief Copies character from the \p source #az_span to the \p destination #az_span by
  * URL-encoding the \p source span characters.
@@ -83,6 +90,27 @@ _az_span_url_encode(az_span destination, az_span source, int32_t* out_length);
  */
 AZ_NODISCARD int32_t _az_span_url_encode_calc_length(az_span source);
 
+/**
+ * @brief URL-encodes the \p source #az_span into the \p destination #az_span in a single pass,
+ * and gives the length of the encoded \p source even when it doesn't fit, so that callers don't
+ * have to call _az_span_url_encode_calc_length() first.
+ *
+ * @param destination The #az_span whose bytes will receive the URL-encoded \p source. It can be
+ * smaller than \p source, or empty.
+ * @param[in] source The #az_span containing the non-URL-encoded bytes.
+ * @param[out] out_length A pointer to an int32_t that is going to be assigned the length of
+ * URL-encoding the \p source, whether it fit into \p destination or not.
+ * @return An #az_result value indicating the result of the operation:
+ *         - #AZ_OK if successful
+ *         - #AZ_ERROR_NOT_ENOUGH_SPACE if the \p destination is not big enough to contain the
+ * encoded bytes
+ *
+ * @remark If \p destination can't fit the \p source, some data may still be written to it.
+ * @remark The \p destination and \p source must not overlap.
+ */
+AZ_NODISCARD az_result
+_az_span_url_encode_and_get_length(az_span destination, az_span source, int32_t* out_length);
+
 /**
  * @brief String tokenizer for #az_span.
  *
@@ -106,6 +134,16 @@ az_span _az_span_token(
     az_span* out_remainder,
     int32_t* out_index);
 
+/**
+ * @brief Fills \p destination with zeros, in a way the compiler can't remove as a dead store.
+ *
+ * @details Use it to wipe secrets, such as keys, from buffers that are about to go out of scope,
+ * where the compiler is otherwise free to drop a call to `memset()`.
+ *
+ * @param[out] destination The #az_span to fill with zeros. It may be empty.
+ */
+void _az_span_secure_zero(az_span destination);
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_SPAN_INTERNAL_H
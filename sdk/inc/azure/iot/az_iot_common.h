@@ -17,6 +17,7 @@
 
 #include <azure/core/az_log.h>
 #include <azure/core/az_result.h>
+#include <azure/core/az_sha256.h>
 #include <azure/core/az_span.h>
 
 #include <stdbool.h>
@@ -36,6 +37,9 @@ enum az_result_iot
 
   /// While iterating, there are no more properties to return.
   AZ_ERROR_IOT_END_OF_PROPERTIES = _az_RESULT_MAKE_ERROR(_az_FACILITY_IOT, 2),
+
+  /// A desired properties patch was missed, so the full properties document must be requested.
+  AZ_ERROR_IOT_PROPERTIES_VERSION_GAP = _az_RESULT_MAKE_ERROR(_az_FACILITY_IOT, 3),
 };
 
 /**
@@ -290,6 +294,152 @@ AZ_NODISCARD int32_t az_iot_calculate_retry_delay(
     int32_t max_retry_delay_msec,
     int32_t random_jitter_msec);
 
+/*
+ *
+ * SAS Token Manager APIs
+ *
+ *   The SAS token manager signs and caches the MQTT password used to authenticate with a Shared
+ *   Access Key, so the application doesn't have to bring its own HMAC-SHA256 and Base64
+ *   implementations, and the password is only regenerated when it is about to expire. It is used
+ *   with az_iot_hub_client_sas_token_get_password() and
+ *   az_iot_provisioning_client_sas_token_get_password().
+ */
+
+enum
+{
+  AZ_IOT_SAS_TOKEN_DEFAULT_DURATION_SECONDS = 3600,
+  AZ_IOT_SAS_TOKEN_DEFAULT_RENEWAL_MARGIN_SECONDS = 300,
+};
+
+/**
+ * @brief Signs a message with HMAC-SHA256, using a key the function has access to.
+ *
+ * @param[in] context The context given in #az_iot_sas_token_manager_options.
+ * @param[in] message The message to sign.
+ * @param destination The output #az_span where the #AZ_SHA256_HASH_SIZE bytes of the HMAC are
+ * copied to. It is at least #AZ_SHA256_HASH_SIZE bytes.
+ *
+ * @return An #az_result value indicating the result of the operation, which is returned as is by
+ * the API which requested the signature.
+ */
+typedef AZ_NODISCARD az_result (
+    *az_iot_sas_token_hmac_sha256_fn)(void* context, az_span message, az_span destination);
+
+/**
+ * @brief Allows the user to customize how #az_iot_sas_token_manager generates passwords.
+ */
+typedef struct
+{
+  /**
+   * The Shared Access Key Name (Policy Name). This is optional. For security reasons we recommend
+   * using one key per device instead of using a global policy key.
+   */
+  az_span key_name;
+
+  /**
+   * How long, in seconds, each generated password is valid for.
+   */
+  uint32_t token_duration_seconds;
+
+  /**
+   * How long, in seconds, before the password expires it is considered due for renewal. Must be
+   * less than `token_duration_seconds`.
+   */
+  uint32_t renewal_margin_seconds;
+
+  /**
+   * __[nullable]__ Signs with a key kept out of the application, such as in a Hardware Security
+   * Module or a crypto engine. If `NULL`, the built-in HMAC-SHA256 is used with the device key
+   * given to az_iot_sas_token_manager_init().
+   */
+  az_iot_sas_token_hmac_sha256_fn hmac_sha256;
+
+  /**
+   * __[nullable]__ The context passed to `hmac_sha256`.
+   */
+  void* hmac_sha256_context;
+} az_iot_sas_token_manager_options;
+
+/**
+ * @brief Generates and caches the SAS token MQTT password of a device.
+ */
+typedef struct
+{
+  struct
+  {
+    az_hmac_sha256_key key;
+    az_span password_buffer;
+    int32_t password_length;
+    uint64_t expiration_epoch_time;
+    az_iot_sas_token_manager_options options;
+  } _internal;
+} az_iot_sas_token_manager;
+
+/**
+ * @brief Gets the default #az_iot_sas_token_manager_options.
+ * @details Call this to obtain an initialized #az_iot_sas_token_manager_options structure that can
+ * be afterwards modified and passed to az_iot_sas_token_manager_init().
+ *
+ * @return #az_iot_sas_token_manager_options.
+ */
+AZ_NODISCARD az_iot_sas_token_manager_options az_iot_sas_token_manager_options_default();
+
+/**
+ * @brief Initializes an #az_iot_sas_token_manager.
+ * @details The device key is decoded, and the HMAC-SHA256 state derived from it is precomputed, so
+ * that renewing the password only hashes the message to sign. Neither the key nor its decoded
+ * bytes are referenced once the function returns.
+ *
+ * @param[out] manager The #az_iot_sas_token_manager to initialize.
+ * @param[in] base64_device_key The Base64 encoded Shared Access Key of the device. Can be empty
+ * when \p options specifies an #az_iot_sas_token_manager_options.hmac_sha256 function.
+ * @param[in] password_buffer The buffer the MQTT password is generated and cached into. It must
+ * stay valid while \p manager is used.
+ * @param[in] options __[nullable]__ A reference to an #az_iot_sas_token_manager_options structure.
+ * If `NULL` is passed, the manager will use the default options.
+ * @pre \p manager must not be `NULL`.
+ * @pre \p password_buffer must be a valid span of size greater than 0.
+ * @pre \p base64_device_key must be a valid span of size greater than or equal to 4, unless \p
+ * options specifies an #az_iot_sas_token_manager_options.hmac_sha256 function.
+ * @pre The token duration in \p options must be greater than its renewal margin.
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The manager was initialized successfully.
+ * @retval #AZ_ERROR_UNEXPECTED_CHAR The \p base64_device_key isn't valid Base64.
+ * @retval #AZ_ERROR_UNEXPECTED_END The \p base64_device_key isn't valid Base64.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The \p base64_device_key decodes to more than 128 bytes.
+ */
+AZ_NODISCARD az_result az_iot_sas_token_manager_init(
+    az_iot_sas_token_manager* manager,
+    az_span base64_device_key,
+    az_span password_buffer,
+    az_iot_sas_token_manager_options const* options);
+
+/**
+ * @brief Checks whether the cached password must be regenerated.
+ *
+ * @param[in] manager The #az_iot_sas_token_manager to use for this call.
+ * @param[in] current_epoch_time The current time, in seconds, from 1/1/1970.
+ * @pre \p manager must not be `NULL`.
+ * @return `true` if no password was generated yet, or if it expires within the renewal margin.
+ * `false` otherwise.
+ */
+AZ_NODISCARD bool az_iot_sas_token_manager_is_renewal_due(
+    az_iot_sas_token_manager const* manager,
+    uint64_t current_epoch_time);
+
+/**
+ * @brief Gets the time the cached password expires at.
+ *
+ * @param[in] manager The #az_iot_sas_token_manager to use for this call.
+ * @pre \p manager must not be `NULL`.
+ * @return The time, in seconds, from 1/1/1970, or 0 if no password was generated yet.
+ */
+AZ_NODISCARD AZ_INLINE uint64_t
+az_iot_sas_token_manager_get_expiration(az_iot_sas_token_manager const* manager)
+{
+  return manager->_internal.expiration_epoch_time;
+}
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_IOT_CORE_H
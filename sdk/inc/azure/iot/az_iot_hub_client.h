@@ -17,6 +17,7 @@
 #ifndef _az_IOT_HUB_CLIENT_H
 #define _az_IOT_HUB_CLIENT_H
 
+#include <azure/core/az_json.h>
 #include <azure/core/az_result.h>
 #include <azure/core/az_span.h>
 #include <azure/iot/az_iot_common.h>
@@ -81,6 +82,7 @@ typedef struct
     az_span iot_hub_hostname;
     az_span device_id;
     az_iot_hub_client_options options;
+    az_json_name_table component_names_table;
   } _internal;
 } az_iot_hub_client;
 
@@ -293,6 +295,36 @@ AZ_NODISCARD az_result az_iot_hub_client_sas_get_password(
     size_t mqtt_password_size,
     size_t* out_mqtt_password_length);
 
+/**
+ * @brief Gets the MQTT password, signed with the key of an #az_iot_sas_token_manager.
+ * @details The password cached by \p manager is returned as is, unless
+ * az_iot_sas_token_manager_is_renewal_due() is `true`. In that case a new password, valid for the
+ * token duration set in the manager options, is built in the password buffer of \p manager, signed
+ * and cached. This replaces calling az_iot_hub_client_sas_get_signature(), signing with
+ * HMAC-SHA256, Base64 encoding and calling az_iot_hub_client_sas_get_password().
+ *
+ * @note Use this API only when authenticating with SAS tokens.
+ *
+ * @param[in] client The #az_iot_hub_client to use for this call.
+ * @param[in,out] manager The #az_iot_sas_token_manager holding the key and cached password.
+ * @param[in] current_epoch_time The current time, in seconds, from 1/1/1970.
+ * @param[out] out_mqtt_password The password to pass to the MQTT client, which is a slice of the
+ * password buffer of \p manager, followed by a null terminator.
+ * @pre \p client must not be `NULL`.
+ * @pre \p manager must not be `NULL`.
+ * @pre \p current_epoch_time must be greater than 0.
+ * @pre \p out_mqtt_password must not be `NULL`.
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The password was returned successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The password buffer of \p manager is too small.
+ * @retval other Failures from the HMAC-SHA256 function of \p manager.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_sas_token_get_password(
+    az_iot_hub_client const* client,
+    az_iot_sas_token_manager* manager,
+    uint64_t current_epoch_time,
+    az_span* out_mqtt_password);
+
 /*
  *
  * Telemetry APIs
@@ -323,6 +355,128 @@ AZ_NODISCARD az_result az_iot_hub_client_telemetry_get_publish_topic(
     size_t mqtt_topic_size,
     size_t* out_mqtt_topic_length);
 
+/**
+ * @brief A batch of telemetry records, sent within a single telemetry message as the elements of a
+ * JSON array.
+ *
+ * @details Each record is written by an #az_json_writer, between calls to
+ * az_iot_hub_client_telemetry_batch_begin_record() and
+ * az_iot_hub_client_telemetry_batch_end_record(). A record which doesn't fit within the message
+ * (or fails to be written for any other reason) is discarded, by not ending it, which leaves the
+ * records added before it as they were.
+ */
+typedef struct
+{
+  struct
+  {
+    /// Writes the JSON array, up to the end of the last record that was ended.
+    az_json_writer writer;
+
+    /// Writes the record in progress, starting from where #writer left off.
+    az_json_writer record_writer;
+
+    /// The number of records within the batch.
+    int32_t record_count;
+  } _internal;
+} az_iot_hub_client_telemetry_batch;
+
+/**
+ * @brief Initializes an empty #az_iot_hub_client_telemetry_batch.
+ *
+ * @param[out] out_batch The #az_iot_hub_client_telemetry_batch to initialize.
+ * @param[in] payload_buffer A buffer to write the message payload into. Its size is the maximum
+ * size of the message payload, the last byte of which is reserved for closing the JSON array.
+ * @pre \p out_batch must not be `NULL`.
+ * @pre \p payload_buffer must be a valid span of size greater than 1.
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The batch was initialized successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_telemetry_batch_init(
+    az_iot_hub_client_telemetry_batch* out_batch,
+    az_span payload_buffer);
+
+/**
+ * @brief Starts a new record, which is written as a single JSON value using the returned
+ * #az_json_writer.
+ *
+ * @note Starting a new record discards the previous one, unless it was ended by calling
+ * az_iot_hub_client_telemetry_batch_end_record().
+ *
+ * @param[in,out] ref_batch The #az_iot_hub_client_telemetry_batch to add the record to.
+ * @pre \p ref_batch must not be `NULL`.
+ * @return The #az_json_writer to write the record with, which remains valid until the next record
+ * is started.
+ */
+AZ_NODISCARD az_json_writer* az_iot_hub_client_telemetry_batch_begin_record(
+    az_iot_hub_client_telemetry_batch* ref_batch);
+
+/**
+ * @brief Adds the record written since the last call to
+ * az_iot_hub_client_telemetry_batch_begin_record() to the batch.
+ *
+ * @param[in,out] ref_batch The #az_iot_hub_client_telemetry_batch to add the record to.
+ * @pre \p ref_batch must not be `NULL`.
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The record was added to the batch.
+ * @retval #AZ_ERROR_JSON_INVALID_STATE No record was started, or the record isn't a complete JSON
+ * value. The record is discarded.
+ */
+AZ_NODISCARD az_result
+az_iot_hub_client_telemetry_batch_end_record(az_iot_hub_client_telemetry_batch* ref_batch);
+
+/**
+ * @brief Gets the number of records within the batch.
+ *
+ * @param[in] batch The #az_iot_hub_client_telemetry_batch to use for this call.
+ * @pre \p batch must not be `NULL`.
+ * @return The number of records added to the batch.
+ */
+AZ_NODISCARD AZ_INLINE int32_t
+az_iot_hub_client_telemetry_batch_get_record_count(az_iot_hub_client_telemetry_batch const* batch)
+{
+  return batch->_internal.record_count;
+}
+
+/**
+ * @brief Gets the MQTT topic and payload of a telemetry message that contains the records within
+ * the batch.
+ *
+ * @details The content type and content encoding properties of the message are appended to \p
+ * properties (unless already present), as `application/json` and `utf-8`, so that the payload can
+ * be used by IoT Hub message routing queries.
+ *
+ * @note More records can be added to the batch afterwards, which invalidates \p out_payload.
+ *
+ * @param[in] client The #az_iot_hub_client to use for this call.
+ * @param[in] batch The #az_iot_hub_client_telemetry_batch to use for this call.
+ * @param[in,out] properties An initialized #az_iot_message_properties object, which can contain
+ * other properties of the message.
+ * @param[out] mqtt_topic A buffer with sufficient capacity to hold the MQTT topic. If successful,
+ * contains a null-terminated string with the topic that needs to be passed to the MQTT client.
+ * @param[in] mqtt_topic_size The size, in bytes of \p mqtt_topic.
+ * @param[out] out_mqtt_topic_length __[nullable]__ Contains the string length, in bytes, of \p
+ * mqtt_topic. Can be `NULL`.
+ * @param[out] out_payload The JSON array of records, to be published as the message payload.
+ * @pre \p client must not be `NULL`.
+ * @pre \p batch must not be `NULL`.
+ * @pre \p properties must not be `NULL`.
+ * @pre \p mqtt_topic must not be `NULL`.
+ * @pre \p mqtt_topic_size must be greater than 0.
+ * @pre \p out_payload must not be `NULL`.
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The topic and payload were retrieved successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE There was not enough space to append the properties, or to
+ * hold the topic.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_telemetry_batch_get_publish_message(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_telemetry_batch const* batch,
+    az_iot_message_properties* properties,
+    char* mqtt_topic,
+    size_t mqtt_topic_size,
+    size_t* out_mqtt_topic_length,
+    az_span* out_payload);
+
 /*
  *
  * Cloud-to-device (C2D) APIs
@@ -208,6 +208,33 @@ AZ_NODISCARD az_result az_iot_hub_client_properties_get_properties_version(
     az_iot_hub_client_properties_message_type message_type,
     int32_t* out_version);
 
+/**
+ * @brief Index the component names of the #az_iot_hub_client, so that
+ * az_iot_hub_client_properties_get_next_component_property() looks up each property name in
+ * constant time, rather than comparing it against every component name in turn.
+ *
+ * @remarks This is worthwhile for devices with many components. It must be called after
+ * az_iot_hub_client_init(), since initializing the client resets the index.
+ *
+ * @param[in,out] ref_client The #az_iot_hub_client to use for this call.
+ * @param[in] lookup_buffer A caller-provided buffer used to hold the index. It must outlive the
+ * \p ref_client.
+ * @param[in] lookup_buffer_length The number of entries in \p lookup_buffer. It must be a power of
+ * two, and greater than the number of component names. Twice the number of component names
+ * (rounded up to a power of two) is recommended.
+ *
+ * @pre \p ref_client must not be `NULL`.
+ * @pre \p lookup_buffer must not be `NULL`.
+ * @pre \p lookup_buffer_length must be a power of two greater than the number of component names.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The component names were indexed successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_index_component_names(
+    az_iot_hub_client* ref_client,
+    uint16_t lookup_buffer[],
+    int32_t lookup_buffer_length);
+
 /**
  * @brief Property type
  *
@@ -303,6 +330,380 @@ AZ_NODISCARD az_result az_iot_hub_client_properties_get_next_component_property(
     az_iot_hub_client_property_type property_type,
     az_span* out_component_name);
 
+/**
+ * @brief The snapshot of a single reported property, kept by an
+ * #az_iot_hub_client_properties_reported_state.
+ *
+ * @details Only hashes of the property name and value are kept, so that the snapshot takes the
+ * same space whatever the size of the value.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The hash of the component name and property name.
+    uint64_t name_hash;
+
+    /// The hash of the value last acknowledged by the service.
+    uint64_t value_hash;
+
+    /// The hash of the value sent in the reported properties patch awaiting acknowledgement.
+    uint64_t pending_value_hash;
+
+    /// The hash of the request ID of the patch awaiting acknowledgement.
+    uint32_t pending_request_id_hash;
+
+    /// Whether #value_hash, #pending_value_hash and #pending_request_id_hash are set, and whether
+    /// the property was written in the patch in progress.
+    uint8_t flags;
+  } _internal;
+} az_iot_hub_client_properties_reported_entry;
+
+/**
+ * @brief Keeps a snapshot of the reported properties last acknowledged by the service, so that
+ * reported properties patches only contain the properties whose value changed.
+ *
+ * @details A patch is written between calls to az_iot_hub_client_properties_reported_begin_patch()
+ * and az_iot_hub_client_properties_reported_end_patch(), with each property value written by the
+ * application between calls to az_iot_hub_client_properties_reported_begin_property() and
+ * az_iot_hub_client_properties_reported_end_property(). A property whose value is the same as the
+ * one last acknowledged is removed from the patch once it ends, as is a component none of whose
+ * properties changed.
+ *
+ * The patch is published with az_iot_hub_client_properties_get_reported_publish_topic(), using the
+ * request ID given to az_iot_hub_client_properties_reported_end_patch(), and the values it contains
+ * are added to the snapshot once az_iot_hub_client_properties_reported_confirm() is called with the
+ * acknowledgement of that request.
+ *
+ * @code
+ * az_iot_hub_client_properties_reported_begin_patch(&state, &jw);
+ * az_iot_hub_client_properties_reported_begin_component(&client, &state, &jw, component_name);
+ * az_iot_hub_client_properties_reported_begin_property(&state, &jw, property_name);
+ * // Append the property value here using jw directly.
+ * az_iot_hub_client_properties_reported_end_property(&state, &jw);
+ * az_iot_hub_client_properties_reported_end_component(&client, &state, &jw);
+ * az_iot_hub_client_properties_reported_end_patch(&state, &jw, request_id, &property_count);
+ * @endcode
+ *
+ * @note The patch must be written by an #az_json_writer over a single contiguous buffer, since
+ * properties are removed by restoring a copy of the writer.
+ */
+typedef struct
+{
+  struct
+  {
+    /// The caller-provided snapshot entries, one per reported property.
+    az_iot_hub_client_properties_reported_entry* entries;
+
+    /// The number of entries in #entries.
+    int32_t entries_length;
+
+    /// The number of entries in use.
+    int32_t entry_count;
+
+    /// The number of properties written in the patch in progress, and in its current component.
+    int32_t patch_property_count;
+    int32_t component_property_count;
+
+    /// The hash of the name of the current component, which property name hashes start from.
+    uint64_t component_name_hash;
+
+    /// The hash of the current property name.
+    uint64_t property_name_hash;
+
+    /// The offset at which the current property value starts.
+    int32_t property_value_offset;
+
+    /// Copies of the writer from before the current component and property, which are restored to
+    /// remove them from the patch.
+    az_json_writer component_writer;
+    az_json_writer property_writer;
+  } _internal;
+} az_iot_hub_client_properties_reported_state;
+
+/**
+ * @brief Initializes an #az_iot_hub_client_properties_reported_state with an empty snapshot.
+ *
+ * @param[out] out_state The #az_iot_hub_client_properties_reported_state to initialize.
+ * @param[in] entries A caller-provided array of entries used to hold the snapshot, one per reported
+ * property. It must outlive \p out_state.
+ * @param[in] entries_length The number of entries in \p entries.
+ *
+ * @pre \p out_state must not be `NULL`.
+ * @pre \p entries must not be `NULL`.
+ * @pre \p entries_length must be greater than 0.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The state was initialized successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_state_init(
+    az_iot_hub_client_properties_reported_state* out_state,
+    az_iot_hub_client_properties_reported_entry entries[],
+    int32_t entries_length);
+
+/**
+ * @brief Begin a reported properties patch, by appending the opening brace of the JSON payload.
+ *
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in,out] ref_json_writer The #az_json_writer to write the patch with. It must have been
+ * initialized with az_json_writer_init().
+ *
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p ref_json_writer must not be `NULL`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The patch was begun successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_begin_patch(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer);
+
+/**
+ * @brief Begin the properties of a component within a reported properties patch, as
+ * az_iot_hub_client_properties_writer_begin_component() does.
+ *
+ * @param[in] client The #az_iot_hub_client to use for this call.
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in,out] ref_json_writer The #az_json_writer the patch is written with.
+ * @param[in] component_name The component name associated with the reported properties.
+ *
+ * @pre \p client must not be `NULL`.
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p ref_json_writer must not be `NULL`.
+ * @pre \p component_name must be a valid, non-empty #az_span.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The component was begun successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_begin_component(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer,
+    az_span component_name);
+
+/**
+ * @brief End the properties of a component within a reported properties patch, which removes the
+ * component from the patch if none of its properties changed.
+ *
+ * @param[in] client The #az_iot_hub_client to use for this call.
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in,out] ref_json_writer The #az_json_writer the patch is written with.
+ *
+ * @pre \p client must not be `NULL`.
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p ref_json_writer must not be `NULL`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The component was ended successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_end_component(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer);
+
+/**
+ * @brief Begin a property within a reported properties patch, by appending its name.
+ *
+ * @note The application must append the property value using \p ref_json_writer directly, and
+ * then call az_iot_hub_client_properties_reported_end_property().
+ *
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in,out] ref_json_writer The #az_json_writer the patch is written with.
+ * @param[in] property_name The name of the property.
+ *
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p ref_json_writer must not be `NULL`.
+ * @pre \p property_name must be a valid, non-empty #az_span.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property was begun successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_begin_property(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer,
+    az_span property_name);
+
+/**
+ * @brief End a property within a reported properties patch, which removes the property from the
+ * patch if its value is the same as the one last acknowledged by the service.
+ *
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in,out] ref_json_writer The #az_json_writer the patch is written with.
+ *
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p ref_json_writer must not be `NULL`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The property was ended successfully, whether it was kept in the patch or not.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE There are no entries left in the snapshot for a property which
+ * wasn't reported before. The property is removed from the patch.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_end_property(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer);
+
+/**
+ * @brief End a reported properties patch, by appending the closing brace of the JSON payload.
+ *
+ * @details The properties in the patch are marked as awaiting the acknowledgement of \p request_id,
+ * which replaces any patch they were awaiting before.
+ *
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in,out] ref_json_writer The #az_json_writer the patch is written with.
+ * @param[in] request_id The request ID the patch is to be published with.
+ * @param[out] out_property_count The number of properties in the patch. The patch doesn't need to
+ * be published if it is 0.
+ *
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p ref_json_writer must not be `NULL`.
+ * @pre \p request_id must be a valid, non-empty #az_span.
+ * @pre \p out_property_count must not be `NULL`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The patch was ended successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_end_patch(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer,
+    az_span request_id,
+    int32_t* out_property_count);
+
+/**
+ * @brief Update the snapshot from a received properties message, which acknowledges a reported
+ * properties patch.
+ *
+ * @details When \p message acknowledges the patch with a status of #AZ_IOT_STATUS_NO_CONTENT, the
+ * values the patch contains are added to the snapshot. When it reports an error, they are
+ * discarded, so that they are sent again with the next patch.
+ *
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_reported_state to use for this call.
+ * @param[in] message The #az_iot_hub_client_properties_message parsed by
+ * az_iot_hub_client_properties_parse_received_topic().
+ *
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p message must not be `NULL`.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The snapshot was updated for the patch with the request ID of \p message.
+ * @retval #AZ_ERROR_ITEM_NOT_FOUND \p message is not a response to a patch awaiting
+ * acknowledgement.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_confirm(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_iot_hub_client_properties_message const* message);
+
+/**
+ * @brief Keeps the desired properties of the device up to date, by applying each writable
+ * properties update to the document received in response to a properties GET request.
+ *
+ * @details The document is kept as JSON text within a caller-provided buffer, and updated by
+ * applying each writable properties update to it as a JSON Merge Patch (RFC 7386). Updates are
+ * only applied in order of their `$version`, so that a missing update is detected, in which case
+ * the full document must be requested again with
+ * az_iot_hub_client_properties_document_get_publish_topic().
+ */
+typedef struct
+{
+  struct
+  {
+    /// Holds the document, as JSON text.
+    az_span document_buffer;
+
+    /// Holds the document resulting from applying an update, which then replaces #document_buffer.
+    az_span scratch_buffer;
+
+    /// The size of the document within #document_buffer.
+    int32_t document_size;
+
+    /// The `$version` of the document, or 0 when no document was received yet.
+    int32_t version;
+  } _internal;
+} az_iot_hub_client_properties_desired_state;
+
+/**
+ * @brief Initializes an #az_iot_hub_client_properties_desired_state without any document.
+ *
+ * @param[out] out_state The #az_iot_hub_client_properties_desired_state to initialize.
+ * @param[in] buffer A caller-provided buffer used to hold the document. Half of it holds the
+ * document, and the other half the document resulting from applying an update. It must outlive
+ * \p out_state.
+ *
+ * @pre \p out_state must not be `NULL`.
+ * @pre \p buffer must be a valid span of size greater than or equal to 4.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The state was initialized successfully.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_desired_state_init(
+    az_iot_hub_client_properties_desired_state* out_state,
+    az_span buffer);
+
+/**
+ * @brief Updates the desired properties from the payload of a received properties message.
+ *
+ * @details The response to a properties GET request replaces the document with its desired
+ * properties. A writable properties update is merged into the document if its `$version` is the one
+ * following the version of the document, and ignored if it is not newer than the document.
+ *
+ * @param[in] client The #az_iot_hub_client to use for this call.
+ * @param[in,out] ref_state The #az_iot_hub_client_properties_desired_state to use for this call.
+ * @param[in] message_type The #az_iot_hub_client_properties_message_type representing the message
+ * type associated with the payload.
+ * @param[in] payload The JSON payload of the message.
+ *
+ * @pre \p client must not be `NULL`.
+ * @pre \p ref_state must not be `NULL`.
+ * @pre \p message_type must be `AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED` or
+ * `AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE`.
+ * @pre \p payload must be a valid, non-empty #az_span.
+ *
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The document is up to date with the payload.
+ * @retval #AZ_ERROR_IOT_PROPERTIES_VERSION_GAP No document was received yet, or an update was
+ * missed. The document is left as it was, and the full document must be requested.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The document doesn't fit within the buffer. The document is
+ * left as it was.
+ * @retval #AZ_ERROR_JSON_NESTING_OVERFLOW The document or update has more than 10 levels of nested
+ * objects below the desired properties. The document is left as it was.
+ *
+ * @remark Merging an update looks up each of its members in the document, and each member of the
+ * document in the update, by reading the other object again. Merging an update of `m` members into
+ * an object of `n` members therefore takes `O(n * m)` time, which is meant for the small documents
+ * that devices typically have.
+ */
+AZ_NODISCARD az_result az_iot_hub_client_properties_desired_state_update(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_desired_state* ref_state,
+    az_iot_hub_client_properties_message_type message_type,
+    az_span payload);
+
+/**
+ * @brief Gets the desired properties document, as a JSON object.
+ *
+ * @param[in] state The #az_iot_hub_client_properties_desired_state to use for this call.
+ * @pre \p state must not be `NULL`.
+ * @return The JSON text of the desired properties, which is empty when no document was received
+ * yet. It remains valid until the next update.
+ */
+AZ_NODISCARD AZ_INLINE az_span az_iot_hub_client_properties_desired_state_get_document(
+    az_iot_hub_client_properties_desired_state const* state)
+{
+  return az_span_slice(state->_internal.document_buffer, 0, state->_internal.document_size);
+}
+
+/**
+ * @brief Gets the `$version` of the desired properties document.
+ *
+ * @param[in] state The #az_iot_hub_client_properties_desired_state to use for this call.
+ * @pre \p state must not be `NULL`.
+ * @return The version of the document, or 0 when no document was received yet.
+ */
+AZ_NODISCARD AZ_INLINE int32_t az_iot_hub_client_properties_desired_state_get_version(
+    az_iot_hub_client_properties_desired_state const* state)
+{
+  return state->_internal.version;
+}
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif //_az_IOT_HUB_CLIENT_PROPERTIES_H
@@ -216,6 +216,36 @@ AZ_NODISCARD az_result az_iot_provisioning_client_sas_get_password(
     size_t mqtt_password_size,
     size_t* out_mqtt_password_length);
 
+/**
+ * @brief Gets the MQTT password, signed with the key of an #az_iot_sas_token_manager.
+ * @details The password cached by \p manager is returned as is, unless
+ * az_iot_sas_token_manager_is_renewal_due() is `true`. In that case a new password, valid for the
+ * token duration set in the manager options, is built in the password buffer of \p manager, signed
+ * and cached. This replaces calling az_iot_provisioning_client_sas_get_signature(), signing with
+ * HMAC-SHA256, Base64 encoding and calling az_iot_provisioning_client_sas_get_password().
+ *
+ * @note Use this API only when authenticating with SAS tokens.
+ *
+ * @param[in] client The #az_iot_provisioning_client to use for this call.
+ * @param[in,out] manager The #az_iot_sas_token_manager holding the key and cached password.
+ * @param[in] current_epoch_time The current time, in seconds, from 1/1/1970.
+ * @param[out] out_mqtt_password The password to pass to the MQTT client, which is a slice of the
+ * password buffer of \p manager, followed by a null terminator.
+ * @pre \p client must not be `NULL`.
+ * @pre \p manager must not be `NULL`.
+ * @pre \p current_epoch_time must be greater than 0.
+ * @pre \p out_mqtt_password must not be `NULL`.
+ * @return An #az_result value indicating the result of the operation.
+ * @retval #AZ_OK The password was returned successfully.
+ * @retval #AZ_ERROR_NOT_ENOUGH_SPACE The password buffer of \p manager is too small.
+ * @retval other Failures from the HMAC-SHA256 function of \p manager.
+ */
+AZ_NODISCARD az_result az_iot_provisioning_client_sas_token_get_password(
+    az_iot_provisioning_client const* client,
+    az_iot_sas_token_manager* manager,
+    uint64_t current_epoch_time,
+    az_span* out_mqtt_password);
+
 /*
  *
  * Register APIs
@@ -17,8 +17,10 @@
 
 #include <azure/core/az_result.h>
 #include <azure/core/az_span.h>
+#include <azure/iot/az_iot_common.h>
 
 #include <stdbool.h>
+#include <stddef.h>
 #include <stdint.h>
 
 #include <azure/core/_az_cfg_prefix.h>
@@ -54,6 +56,73 @@ AZ_NODISCARD int32_t _az_iot_u64toa_size(uint64_t number);
 AZ_NODISCARD az_result
 _az_span_copy_url_encode(az_span destination, az_span source, az_span* out_remainder);
 
+enum
+{
+  // The size of a Base64 encoded HMAC-SHA256, including padding.
+  _az_IOT_SAS_TOKEN_BASE64_SIGNATURE_SIZE = 44,
+};
+
+/**
+ * @brief Signs the clear-text signature of a SAS token with the key of a SAS token manager.
+ *
+ * @param[in] manager The #az_iot_sas_token_manager whose key or HMAC-SHA256 function to use.
+ * @param[in] signature The clear-text signature to sign.
+ * @param[in] base64_signature A buffer of at least `_az_IOT_SAS_TOKEN_BASE64_SIGNATURE_SIZE` bytes.
+ * @param[out] out_base64_signature The slice of \p base64_signature with the Base64 encoded
+ * HMAC-SHA256 of \p signature.
+ * @return An `az_result` value.
+ */
+AZ_NODISCARD az_result _az_iot_sas_token_manager_sign(
+    az_iot_sas_token_manager const* manager,
+    az_span signature,
+    az_span base64_signature,
+    az_span* out_base64_signature);
+
+/**
+ * @brief Writes the clear-text signature of a client's SAS token, as its `sas_get_signature`
+ * function does.
+ */
+typedef AZ_NODISCARD az_result (*_az_iot_sas_token_get_signature_fn)(
+    void const* client,
+    uint64_t token_expiration_epoch_time,
+    az_span signature,
+    az_span* out_signature);
+
+/**
+ * @brief Writes the MQTT password of a client's SAS token, as its `sas_get_password` function does.
+ */
+typedef AZ_NODISCARD az_result (*_az_iot_sas_token_get_password_fn)(
+    void const* client,
+    uint64_t token_expiration_epoch_time,
+    az_span base64_hmac_sha256_signature,
+    az_span key_name,
+    char* mqtt_password,
+    size_t mqtt_password_size,
+    size_t* out_mqtt_password_length);
+
+/**
+ * @brief Gets the MQTT password cached by a SAS token manager, generating a new one first when
+ * it is due for renewal.
+ *
+ * @details This is the renewal and caching shared by the hub and provisioning clients, which only
+ * provide the functions that write their signature and password.
+ *
+ * @param[in,out] manager The #az_iot_sas_token_manager holding the cached password.
+ * @param[in] client The client passed to \p get_signature and \p get_password.
+ * @param[in] get_signature Writes the clear-text signature of the client's SAS token.
+ * @param[in] get_password Writes the MQTT password of the client's SAS token.
+ * @param[in] current_epoch_time The current time, in seconds since 00:00:00 UTC on 1 January 1970.
+ * @param[out] out_mqtt_password The slice of the manager's password buffer with the password.
+ * @return An `az_result` value.
+ */
+AZ_NODISCARD az_result _az_iot_sas_token_manager_get_password(
+    az_iot_sas_token_manager* manager,
+    void const* client,
+    _az_iot_sas_token_get_signature_fn get_signature,
+    _az_iot_sas_token_get_password_fn get_password,
+    uint64_t current_epoch_time,
+    az_span* out_mqtt_password);
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_IOT_CORE_INTERNAL_H
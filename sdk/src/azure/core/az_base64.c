@@ -1,8 +1,12 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // SPDX-License-Identifier: MIT
 
+#include "az_simd_private.h"
 #include <azure/core/az_base64.h>
 #include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <string.h>
 
 #include <azure/core/_az_cfg.h>
 
@@ -21,35 +25,295 @@ typedef enum
 static char const _az_base64_encode_array[65]
     = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
 
-static AZ_NODISCARD int32_t _az_base64_encode(uint8_t* three_bytes)
+static char const _az_base64_url_encode_array[65]
+    = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789-_";
+
+enum
+{
+  // Flags set in the decode table for the characters that are not part of the URL alphabet ('+' and
+  // '/'), or not part of the standard alphabet ('-' and '_'). Invalid characters have both set.
+  _az_BASE64_NOT_URL = 0x40,
+  _az_BASE64_NOT_STANDARD = 0x80,
+  _az_BASE64_VALUE_MASK = 0x3F,
+};
+
+// Maps every byte to its 6-bit value, along with the flags above, so that a single lookup both
+// validates and decodes a character, in either alphabet.
+static uint8_t const _az_base64_decode_table[256] = {
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0x7E, 0xC0, 0xBE, 0xC0, 0x7F,
+  0x34, 0x35, 0x36, 0x37, 0x38, 0x39, 0x3A, 0x3B, 0x3C, 0x3D, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0x00, 0x01, 0x02, 0x03, 0x04, 0x05, 0x06, 0x07, 0x08, 0x09, 0x0A, 0x0B, 0x0C, 0x0D, 0x0E,
+  0x0F, 0x10, 0x11, 0x12, 0x13, 0x14, 0x15, 0x16, 0x17, 0x18, 0x19, 0xC0, 0xC0, 0xC0, 0xC0, 0xBF,
+  0xC0, 0x1A, 0x1B, 0x1C, 0x1D, 0x1E, 0x1F, 0x20, 0x21, 0x22, 0x23, 0x24, 0x25, 0x26, 0x27, 0x28,
+  0x29, 0x2A, 0x2B, 0x2C, 0x2D, 0x2E, 0x2F, 0x30, 0x31, 0x32, 0x33, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+  0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0, 0xC0,
+};
+
+// On targets with byte shuffles, whole blocks are encoded and decoded at once, using the approach
+// described by Wojciech Mula and Daniel Lemire in "Faster Base64 Encoding and Decoding Using AVX2
+// Instructions" (ACM TOW, 2018), and the scalar code below only handles what is left over.
+#if defined(_az_SIMD_SSSE3) || defined(_az_SIMD_NEON)
+#define _az_BASE64_SIMD
+
+enum
+{
+#ifdef _az_SIMD_SSSE3
+  // 12 bytes become 16 characters, although 16 bytes are loaded to get them.
+  _az_BASE64_BLOCK_SIZE = 12,
+  _az_BASE64_BLOCK_LOAD_SIZE = 16,
+  _az_BASE64_BLOCK_ENCODED_SIZE = 16,
+#else
+  // 48 bytes, deinterleaved into three vectors, become four vectors of characters.
+  _az_BASE64_BLOCK_SIZE = 48,
+  _az_BASE64_BLOCK_LOAD_SIZE = 48,
+  _az_BASE64_BLOCK_ENCODED_SIZE = 64,
+#endif
+};
+
+// The nibble tables used to validate and decode characters of the standard alphabet. A character is
+// invalid if the flags found for its low and high nibbles have a bit in common. Otherwise, the
+// offset found for its high nibble (or for '/', which shares its high nibble with '+') turns it
+// into its 6-bit value.
+static uint8_t const _az_base64_low_nibble_flags[16] = {
+  0x15, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x11, 0x13, 0x1A, 0x1B, 0x1B, 0x1B, 0x1A,
+};
+
+static uint8_t const _az_base64_high_nibble_flags[16] = {
+  0x10, 0x10, 0x01, 0x02, 0x04, 0x08, 0x04, 0x08, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10, 0x10,
+};
+
+// 16 for '/', 19 for '+', 4 for digits, -65 for upper case and -71 for lower case letters.
+static uint8_t const _az_base64_high_nibble_offsets[16] = {
+  0, 16, 19, 4, 0xBF, 0xBF, 0xB9, 0xB9, 0, 0, 0, 0, 0, 0, 0, 0,
+};
+#endif // defined(_az_SIMD_SSSE3) || defined(_az_SIMD_NEON)
+
+#ifdef _az_SIMD_SSSE3
+
+AZ_NODISCARD AZ_INLINE __m128i _az_base64_load_table(uint8_t const* table)
+{
+  return _mm_loadu_si128((__m128i const*)(void const*)table);
+}
+
+static void
+_az_base64_encode_block(uint8_t* destination, uint8_t const* source, char const* alphabet)
+{
+  __m128i bytes = _mm_loadu_si128((__m128i const*)(void const*)source);
+
+  // Spread every 3 bytes over a 32-bit lane, as bytes 1, 0, 2, 1, and move each of their 6-bit
+  // groups into a byte of its own, with 16-bit multiplications standing in for variable shifts.
+  bytes = _mm_shuffle_epi8(bytes, _mm_setr_epi8(1, 0, 2, 1, 4, 3, 5, 4, 7, 6, 8, 7, 10, 9, 11, 10));
+  __m128i const first_and_third = _mm_mulhi_epu16(
+      _mm_and_si128(bytes, _mm_set1_epi32(0x0FC0FC00)), _mm_set1_epi32(0x04000040));
+  __m128i const second_and_fourth = _mm_mullo_epi16(
+      _mm_and_si128(bytes, _mm_set1_epi32(0x003F03F0)), _mm_set1_epi32(0x01000010));
+  __m128i const values = _mm_or_si128(first_and_third, second_and_fourth);
+
+  // Reduce the values to an index into the offsets from a value to its character: 0 to 25 become
+  // 13 ('A'), 26 to 51 become 0 ('a' - 26), 52 to 61 become 1 to 10 (digits), 62 is 11, and 63 is
+  // 12, which depend on the alphabet.
+  __m128i index = _mm_subs_epu8(values, _mm_set1_epi8(51));
+  index = _mm_or_si128(
+      index,
+      _mm_and_si128(_mm_cmpgt_epi8(_mm_set1_epi8(26), values), _mm_set1_epi8(13)));
+
+  __m128i const offsets = _mm_setr_epi8(
+      'a' - 26, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52, '0' - 52,
+      '0' - 52, '0' - 52, (char)(alphabet[62] - 62), (char)(alphabet[63] - 63), 'A', 0, 0);
+
+  _mm_storeu_si128(
+      (__m128i*)(void*)destination, _mm_add_epi8(values, _mm_shuffle_epi8(offsets, index)));
+}
+
+static AZ_NODISCARD bool
+_az_base64_decode_block(uint8_t* destination, uint8_t const* source, _az_base64_mode mode)
+{
+  __m128i characters = _mm_loadu_si128((__m128i const*)(void const*)source);
+
+  if (mode == _az_base64_mode_url)
+  {
+    // Reject '+' and '/', then swap '-' and '_' for them, to decode the rest as standard base 64.
+    __m128i const standard_only = _mm_or_si128(
+        _mm_cmpeq_epi8(characters, _mm_set1_epi8('+')),
+        _mm_cmpeq_epi8(characters, _mm_set1_epi8('/')));
+    if (_mm_movemask_epi8(standard_only) != 0)
+    {
+      return false;
+    }
+
+    characters = _mm_xor_si128(
+        characters,
+        _mm_and_si128(
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8('-')), _mm_set1_epi8('-' ^ '+')));
+    characters = _mm_xor_si128(
+        characters,
+        _mm_and_si128(
+            _mm_cmpeq_epi8(characters, _mm_set1_epi8('_')), _mm_set1_epi8('_' ^ '/')));
+  }
+
+  // Shuffles only look at the low 4 bits (and the high bit, which the mask clears), so the mask
+  // doubles as '/'.
+  __m128i const slash = _mm_set1_epi8('/');
+  __m128i const high_nibbles = _mm_and_si128(_mm_srli_epi32(characters, 4), slash);
+  __m128i const low_nibbles = _mm_and_si128(characters, slash);
+
+  __m128i const flags = _mm_and_si128(
+      _mm_shuffle_epi8(_az_base64_load_table(_az_base64_low_nibble_flags), low_nibbles),
+      _mm_shuffle_epi8(_az_base64_load_table(_az_base64_high_nibble_flags), high_nibbles));
+  if (_mm_movemask_epi8(_mm_cmpeq_epi8(flags, _mm_setzero_si128())) != 0xFFFF)
+  {
+    return false;
+  }
+
+  __m128i const offsets = _mm_shuffle_epi8(
+      _az_base64_load_table(_az_base64_high_nibble_offsets),
+      _mm_add_epi8(_mm_cmpeq_epi8(characters, slash), high_nibbles));
+  __m128i const values = _mm_add_epi8(characters, offsets);
+
+  // Merge pairs of 6-bit values into 12 bits, then pairs of those into 24 bits, and gather the
+  // three low-order bytes of each 32-bit lane, most significant first.
+  __m128i const pairs = _mm_maddubs_epi16(values, _mm_set1_epi32(0x01400140));
+  __m128i bytes = _mm_madd_epi16(pairs, _mm_set1_epi32(0x00011000));
+  bytes = _mm_shuffle_epi8(
+      bytes, _mm_setr_epi8(2, 1, 0, 6, 5, 4, 10, 9, 8, 14, 13, 12, -1, -1, -1, -1));
+
+  // Only write the 12 decoded bytes.
+  uint32_t const last_four_bytes = (uint32_t)_mm_cvtsi128_si32(_mm_srli_si128(bytes, 8));
+  _mm_storel_epi64((__m128i*)(void*)destination, bytes);
+  memcpy(destination + 8, &last_four_bytes, sizeof(last_four_bytes));
+  return true;
+}
+
+#elif defined(_az_SIMD_NEON)
+
+static void
+_az_base64_encode_block(uint8_t* destination, uint8_t const* source, char const* alphabet)
+{
+  uint8_t const* alphabet_ptr = (uint8_t const*)alphabet;
+  uint8x16x4_t table;
+  table.val[0] = vld1q_u8(alphabet_ptr);
+  table.val[1] = vld1q_u8(alphabet_ptr + 16);
+  table.val[2] = vld1q_u8(alphabet_ptr + 32);
+  table.val[3] = vld1q_u8(alphabet_ptr + 48);
+
+  uint8x16x3_t const bytes = vld3q_u8(source);
+  uint8x16_t const mask = vdupq_n_u8(0x3F);
+
+  uint8x16x4_t characters;
+  characters.val[0] = vshrq_n_u8(bytes.val[0], 2);
+  characters.val[1]
+      = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[0], 4), vshrq_n_u8(bytes.val[1], 4)), mask);
+  characters.val[2]
+      = vandq_u8(vorrq_u8(vshlq_n_u8(bytes.val[1], 2), vshrq_n_u8(bytes.val[2], 6)), mask);
+  characters.val[3] = vandq_u8(bytes.val[2], mask);
+
+  characters.val[0] = vqtbl4q_u8(table, characters.val[0]);
+  characters.val[1] = vqtbl4q_u8(table, characters.val[1]);
+  characters.val[2] = vqtbl4q_u8(table, characters.val[2]);
+  characters.val[3] = vqtbl4q_u8(table, characters.val[3]);
+
+  vst4q_u8(destination, characters);
+}
+
+// Returns the 6-bit values of the characters, and sets lanes of invalid to non-zero values where
+// they are not part of the alphabet.
+static AZ_NODISCARD uint8x16_t
+_az_base64_decode_vector(uint8x16_t characters, _az_base64_mode mode, uint8x16_t* invalid)
+{
+  if (mode == _az_base64_mode_url)
+  {
+    // Reject '+' and '/', then swap '-' and '_' for them, to decode the rest as standard base 64.
+    *invalid = vorrq_u8(
+        *invalid,
+        vorrq_u8(vceqq_u8(characters, vdupq_n_u8('+')), vceqq_u8(characters, vdupq_n_u8('/'))));
+    characters = veorq_u8(
+        characters, vandq_u8(vceqq_u8(characters, vdupq_n_u8('-')), vdupq_n_u8('-' ^ '+')));
+    characters = veorq_u8(
+        characters, vandq_u8(vceqq_u8(characters, vdupq_n_u8('_')), vdupq_n_u8('_' ^ '/')));
+  }
+
+  uint8x16_t const high_nibbles = vshrq_n_u8(characters, 4);
+  uint8x16_t const low_nibbles = vandq_u8(characters, vdupq_n_u8(0x0F));
+
+  *invalid = vorrq_u8(
+      *invalid,
+      vandq_u8(
+          vqtbl1q_u8(vld1q_u8(_az_base64_low_nibble_flags), low_nibbles),
+          vqtbl1q_u8(vld1q_u8(_az_base64_high_nibble_flags), high_nibbles)));
+
+  uint8x16_t const offsets = vqtbl1q_u8(
+      vld1q_u8(_az_base64_high_nibble_offsets),
+      vaddq_u8(vceqq_u8(characters, vdupq_n_u8('/')), high_nibbles));
+  return vaddq_u8(characters, offsets);
+}
+
+static AZ_NODISCARD bool
+_az_base64_decode_block(uint8_t* destination, uint8_t const* source, _az_base64_mode mode)
+{
+  uint8x16x4_t const characters = vld4q_u8(source);
+  uint8x16_t invalid = vdupq_n_u8(0);
+
+  uint8x16_t const first = _az_base64_decode_vector(characters.val[0], mode, &invalid);
+  uint8x16_t const second = _az_base64_decode_vector(characters.val[1], mode, &invalid);
+  uint8x16_t const third = _az_base64_decode_vector(characters.val[2], mode, &invalid);
+  uint8x16_t const fourth = _az_base64_decode_vector(characters.val[3], mode, &invalid);
+
+  if (vmaxvq_u8(invalid) != 0)
+  {
+    return false;
+  }
+
+  uint8x16x3_t bytes;
+  bytes.val[0] = vorrq_u8(vshlq_n_u8(first, 2), vshrq_n_u8(second, 4));
+  bytes.val[1] = vorrq_u8(vshlq_n_u8(second, 4), vshrq_n_u8(third, 2));
+  bytes.val[2] = vorrq_u8(vshlq_n_u8(third, 6), fourth);
+
+  vst3q_u8(destination, bytes);
+  return true;
+}
+
+#endif // _az_SIMD_SSSE3
+
+static AZ_NODISCARD int32_t _az_base64_encode(uint8_t const* three_bytes, char const* alphabet)
 {
   int32_t i = (*three_bytes << 16) | (*(three_bytes + 1) << 8) | *(three_bytes + 2);
 
-  int32_t i0 = _az_base64_encode_array[i >> 18];
-  int32_t i1 = _az_base64_encode_array[(i >> 12) & 0x3F];
-  int32_t i2 = _az_base64_encode_array[(i >> 6) & 0x3F];
-  int32_t i3 = _az_base64_encode_array[i & 0x3F];
+  int32_t i0 = alphabet[i >> 18];
+  int32_t i1 = alphabet[(i >> 12) & 0x3F];
+  int32_t i2 = alphabet[(i >> 6) & 0x3F];
+  int32_t i3 = alphabet[i & 0x3F];
 
   return i0 | (i1 << 8) | (i2 << 16) | (i3 << 24);
 }
 
-static AZ_NODISCARD int32_t _az_base64_encode_and_pad_one(uint8_t* two_bytes)
+static AZ_NODISCARD int32_t
+_az_base64_encode_and_pad_one(uint8_t const* two_bytes, char const* alphabet)
 {
   int32_t i = (*two_bytes << 16) | (*(two_bytes + 1) << 8);
 
-  int32_t i0 = _az_base64_encode_array[i >> 18];
-  int32_t i1 = _az_base64_encode_array[(i >> 12) & 0x3F];
-  int32_t i2 = _az_base64_encode_array[(i >> 6) & 0x3F];
+  int32_t i0 = alphabet[i >> 18];
+  int32_t i1 = alphabet[(i >> 12) & 0x3F];
+  int32_t i2 = alphabet[(i >> 6) & 0x3F];
 
   return i0 | (i1 << 8) | (i2 << 16) | (_az_ENCODING_PAD << 24);
 }
 
-static AZ_NODISCARD int32_t _az_base64_encode_and_pad_two(uint8_t* one_byte)
+static AZ_NODISCARD int32_t
+_az_base64_encode_and_pad_two(uint8_t const* one_byte, char const* alphabet)
 {
   int32_t i = (*one_byte << 8);
 
-  int32_t i0 = _az_base64_encode_array[i >> 10];
-  int32_t i1 = _az_base64_encode_array[(i >> 4) & 0x3F];
+  int32_t i0 = alphabet[i >> 10];
+  int32_t i1 = alphabet[(i >> 4) & 0x3F];
 
   return i0 | (i1 << 8) | (_az_ENCODING_PAD << 16) | (_az_ENCODING_PAD << 24);
 }
@@ -62,6 +326,60 @@ static void _az_base64_write_int_as_four_bytes(uint8_t* destination, int32_t val
   *(destination + 0) = (uint8_t)(value & 0xFF);
 }
 
+// Encodes every whole group of 3 bytes within the source, and returns the number of bytes encoded.
+static int32_t _az_base64_encode_groups(
+    uint8_t* destination,
+    uint8_t const* source,
+    int32_t source_length,
+    char const* alphabet)
+{
+  int32_t source_index = 0;
+
+#ifdef _az_BASE64_SIMD
+  while (source_length - source_index >= _az_BASE64_BLOCK_LOAD_SIZE)
+  {
+    _az_base64_encode_block(destination, source + source_index, alphabet);
+    destination += _az_BASE64_BLOCK_ENCODED_SIZE;
+    source_index += _az_BASE64_BLOCK_SIZE;
+  }
+#endif // _az_BASE64_SIMD
+
+  while (source_index < source_length - 2)
+  {
+    _az_base64_write_int_as_four_bytes(
+        destination, _az_base64_encode(source + source_index, alphabet));
+    destination += 4;
+    source_index += 3;
+  }
+
+  return source_index;
+}
+
+// Encodes the last 1 or 2 bytes, along with their padding unless it is omitted, and returns the
+// number of characters written.
+static int32_t _az_base64_encode_last_group(
+    uint8_t* destination,
+    uint8_t const* source,
+    int32_t source_length,
+    char const* alphabet,
+    bool omit_padding)
+{
+  int32_t const result = source_length == 1 ? _az_base64_encode_and_pad_two(source, alphabet)
+                                            : _az_base64_encode_and_pad_one(source, alphabet);
+  if (!omit_padding)
+  {
+    _az_base64_write_int_as_four_bytes(destination, result);
+    return 4;
+  }
+
+  for (int32_t i = 0; i <= source_length; i++)
+  {
+    destination[i] = (uint8_t)((result >> (i * 8)) & 0xFF);
+  }
+
+  return source_length + 1;
+}
+
 AZ_NODISCARD az_result
 az_base64_encode(az_span destination_base64_text, az_span source_bytes, int32_t* out_written)
 {
@@ -80,30 +398,18 @@ az_base64_encode(az_span destination_base64_text, az_span source_bytes, int32_t*
     return AZ_ERROR_NOT_ENOUGH_SPACE;
   }
 
-  int32_t source_index = 0;
-  int32_t result = 0;
-
-  while (source_index < source_length - 2)
-  {
-    result = _az_base64_encode(source_ptr + source_index);
-    _az_base64_write_int_as_four_bytes(destination_ptr, result);
-    destination_ptr += 4;
-    source_index += 3;
-  }
+  int32_t const source_index = _az_base64_encode_groups(
+      destination_ptr, source_ptr, source_length, _az_base64_encode_array);
+  destination_ptr += (source_index / 3) * 4;
 
-  if (source_index == source_length - 1)
+  if (source_index < source_length)
   {
-    result = _az_base64_encode_and_pad_two(source_ptr + source_index);
-    _az_base64_write_int_as_four_bytes(destination_ptr, result);
-    destination_ptr += 4;
-    source_index += 1;
-  }
-  else if (source_index == source_length - 2)
-  {
-    result = _az_base64_encode_and_pad_one(source_ptr + source_index);
-    _az_base64_write_int_as_four_bytes(destination_ptr, result);
-    destination_ptr += 4;
-    source_index += 2;
+    destination_ptr += _az_base64_encode_last_group(
+        destination_ptr,
+        source_ptr + source_index,
+        source_length - source_index,
+        _az_base64_encode_array,
+        false);
   }
 
   *out_written = (int32_t)(destination_ptr - az_span_ptr(destination_base64_text));
@@ -118,78 +424,37 @@ AZ_NODISCARD int32_t az_base64_get_max_encoded_size(int32_t source_bytes_size)
 
 static int32_t _get_base64_decoded_char(int32_t c, _az_base64_mode mode)
 {
-  if (mode == _az_base64_mode_url)
-  {
-    if (c == '+' || c == '/')
-    {
-      return -1; // can't use + or / with URL encoding
-    }
+  // '+' and '/' can't be used with URL encoding, where '-' and '_' take their place.
+  uint8_t const rejected
+      = mode == _az_base64_mode_url ? _az_BASE64_NOT_URL : _az_BASE64_NOT_STANDARD;
+  uint8_t const decoded = _az_base64_decode_table[(uint8_t)c];
 
-    if (c == '-')
-    {
-      c = '+'; // - becomes a +
-    }
-    else if (c == '_')
-    {
-      c = '/'; // _ becomes a /
-    }
-  }
-
-  if (c >= 'A' && c <= 'Z')
-  {
-    return (c - 'A');
-  }
-
-  if (c >= 'a' && c <= 'z')
-  {
-    return 26 + (c - 'a');
-  }
-
-  if (c >= '0' && c <= '9')
-  {
-    return 52 + (c - '0');
-  }
-
-  if (c == '+')
-  {
-    return 62;
-  }
-
-  if (c == '/')
-  {
-    return 63;
-  }
-
-  return -1;
+  return (decoded & rejected) != 0 ? -1 : (int32_t)(decoded & _az_BASE64_VALUE_MASK);
 }
 
 static AZ_NODISCARD int32_t
-_az_base64_decode_four_bytes(uint8_t* encoded_bytes, _az_base64_mode mode)
+_az_base64_decode_four_bytes(uint8_t const* encoded_bytes, _az_base64_mode mode)
 {
-  int32_t i0 = *encoded_bytes;
-  int32_t i1 = *(encoded_bytes + 1);
-  int32_t i2 = *(encoded_bytes + 2);
-  int32_t i3 = *(encoded_bytes + 3);
+  uint8_t const rejected
+      = mode == _az_base64_mode_url ? _az_BASE64_NOT_URL : _az_BASE64_NOT_STANDARD;
 
-  i0 = _get_base64_decoded_char(i0, mode);
-  i1 = _get_base64_decoded_char(i1, mode);
-  i2 = _get_base64_decoded_char(i2, mode);
-  i3 = _get_base64_decoded_char(i3, mode);
+  int32_t i0 = _az_base64_decode_table[*encoded_bytes];
+  int32_t i1 = _az_base64_decode_table[*(encoded_bytes + 1)];
+  int32_t i2 = _az_base64_decode_table[*(encoded_bytes + 2)];
+  int32_t i3 = _az_base64_decode_table[*(encoded_bytes + 3)];
 
-  if (i0 == -1 || i1 == -1 || i2 == -1 || i3 == -1)
+  // Check all four characters at once, since any of them being invalid fails the whole group.
+  if (((i0 | i1 | i2 | i3) & rejected) != 0)
   {
     return -1;
   }
 
-  i0 <<= 18;
-  i1 <<= 12;
-  i2 <<= 6;
-
-  i0 |= i3;
-  i1 |= i2;
+  i0 = (i0 & _az_BASE64_VALUE_MASK) << 18;
+  i1 = (i1 & _az_BASE64_VALUE_MASK) << 12;
+  i2 = (i2 & _az_BASE64_VALUE_MASK) << 6;
+  i3 &= _az_BASE64_VALUE_MASK;
 
-  i0 |= i1;
-  return i0;
+  return i0 | i1 | i2 | i3;
 }
 
 static void _az_base64_write_three_low_order_bytes(uint8_t* destination, int32_t value)
@@ -199,49 +464,60 @@ static void _az_base64_write_three_low_order_bytes(uint8_t* destination, int32_t
   *(destination + 2) = (uint8_t)(value);
 }
 
-static az_result _az_base64_decode(
-    az_span destination_bytes,
-    az_span source_base64_url_text,
-    int32_t* out_written,
+// Decodes every group of 4 characters within the source, whose length must be a multiple of 4,
+// without expecting any padding.
+static AZ_NODISCARD bool _az_base64_decode_groups(
+    uint8_t* destination,
+    uint8_t const* source,
+    int32_t source_length,
     _az_base64_mode mode)
 {
-  int32_t source_length = az_span_size(source_base64_url_text);
-  uint8_t* source_ptr = az_span_ptr(source_base64_url_text);
-
-  int32_t destination_length = az_span_size(destination_bytes);
-  uint8_t* destination_ptr = az_span_ptr(destination_bytes);
+  int32_t source_index = 0;
 
-  if (destination_length < az_base64_get_max_decoded_size(source_length) - 2)
+#ifdef _az_BASE64_SIMD
+  while (source_length - source_index >= _az_BASE64_BLOCK_ENCODED_SIZE)
   {
-    return AZ_ERROR_NOT_ENOUGH_SPACE;
+    if (!_az_base64_decode_block(destination, source + source_index, mode))
+    {
+      return false;
+    }
+    destination += _az_BASE64_BLOCK_SIZE;
+    source_index += _az_BASE64_BLOCK_ENCODED_SIZE;
   }
+#endif // _az_BASE64_SIMD
 
-  int32_t source_index = 0;
-  int32_t destination_index = 0;
-
-  while (source_index < source_length - 4)
+  while (source_index < source_length)
   {
-    int32_t result = _az_base64_decode_four_bytes(source_ptr + source_index, mode);
+    int32_t result = _az_base64_decode_four_bytes(source + source_index, mode);
     if (result < 0)
     {
-      return AZ_ERROR_UNEXPECTED_CHAR;
+      return false;
     }
-    _az_base64_write_three_low_order_bytes(destination_ptr, result);
-    destination_ptr += 3;
-    destination_index += 3;
+    _az_base64_write_three_low_order_bytes(destination, result);
+    destination += 3;
     source_index += 4;
   }
 
+  return true;
+}
+
+// Decodes the last group of 2 to 4 characters, which may be padded, into the destination_length
+// bytes left in the destination.
+static az_result _az_base64_decode_last_group(
+    uint8_t* destination_ptr,
+    int32_t destination_length,
+    uint8_t const* source_ptr,
+    int32_t source_length,
+    _az_base64_mode mode,
+    int32_t* out_written)
+{
   // If using standard base64 decoding, there is a precondition guaranteeing size is divisible by 4.
   // Otherwise with url encoding, we can assume padding characters.
-  // If length is divisible by four, do nothing. Else, we assume up to two padding characters.
-  int32_t source_length_mod_four = source_length % 4;
-  int32_t i0 = *(source_ptr + source_index);
-  int32_t i1 = *(source_ptr + source_index + 1);
-  int32_t i2 = source_length_mod_four == 2 ? _az_ENCODING_PAD : *(source_ptr + source_index + 2);
-  int32_t i3 = source_length_mod_four == 2 || source_length_mod_four == 3
-      ? _az_ENCODING_PAD
-      : *(source_ptr + source_index + 3);
+  // If there are four characters, do nothing. Else, we assume up to two padding characters.
+  int32_t i0 = *source_ptr;
+  int32_t i1 = *(source_ptr + 1);
+  int32_t i2 = source_length == 2 ? _az_ENCODING_PAD : *(source_ptr + 2);
+  int32_t i3 = source_length < 4 ? _az_ENCODING_PAD : *(source_ptr + 3);
 
   i0 = _get_base64_decoded_char(i0, mode);
   i1 = _get_base64_decoded_char(i1, mode);
@@ -265,12 +541,12 @@ static az_result _az_base64_decode(
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
-    if (destination_index > destination_length - 3)
+    if (destination_length < 3)
     {
       return AZ_ERROR_NOT_ENOUGH_SPACE;
     }
     _az_base64_write_three_low_order_bytes(destination_ptr, i0);
-    destination_ptr += 3;
+    *out_written = 3;
   }
   else if (i2 != _az_ENCODING_PAD)
   {
@@ -284,13 +560,13 @@ static az_result _az_base64_decode(
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
-    if (destination_index > destination_length - 2)
+    if (destination_length < 2)
     {
       return AZ_ERROR_NOT_ENOUGH_SPACE;
     }
     *(destination_ptr + 1) = (uint8_t)(i0 >> 8);
     *destination_ptr = (uint8_t)(i0 >> 16);
-    destination_ptr += 2;
+    *out_written = 2;
   }
   else
   {
@@ -298,15 +574,52 @@ static az_result _az_base64_decode(
     {
       return AZ_ERROR_UNEXPECTED_CHAR;
     }
-    if (destination_index > destination_length - 1)
+    if (destination_length < 1)
     {
       return AZ_ERROR_NOT_ENOUGH_SPACE;
     }
     *destination_ptr = (uint8_t)(i0 >> 16);
-    destination_ptr += 1;
+    *out_written = 1;
   }
 
-  *out_written = (int32_t)(destination_ptr - az_span_ptr(destination_bytes));
+  return AZ_OK;
+}
+
+static az_result _az_base64_decode(
+    az_span destination_bytes,
+    az_span source_base64_url_text,
+    int32_t* out_written,
+    _az_base64_mode mode)
+{
+  int32_t source_length = az_span_size(source_base64_url_text);
+  uint8_t* source_ptr = az_span_ptr(source_base64_url_text);
+
+  int32_t destination_length = az_span_size(destination_bytes);
+  uint8_t* destination_ptr = az_span_ptr(destination_bytes);
+
+  if (destination_length < az_base64_get_max_decoded_size(source_length) - 2)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  // Every group but the last, which may be padded, or be missing its padding with url encoding.
+  int32_t const groups_length = ((source_length - 1) / 4) * 4;
+  if (!_az_base64_decode_groups(destination_ptr, source_ptr, groups_length, mode))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  int32_t const destination_index = (groups_length / 4) * 3;
+  int32_t last_group_written = 0;
+  _az_RETURN_IF_FAILED(_az_base64_decode_last_group(
+      destination_ptr + destination_index,
+      destination_length - destination_index,
+      source_ptr + groups_length,
+      source_length - groups_length,
+      mode,
+      &last_group_written));
+
+  *out_written = destination_index + last_group_written;
   return AZ_OK;
 }
 
@@ -362,3 +675,307 @@ AZ_NODISCARD int32_t az_base64_url_get_max_decoded_size(int32_t source_base64_ur
   _az_PRECONDITION(source_base64_url_text_size >= 0);
   return (source_base64_url_text_size / 4) * 3;
 }
+
+static AZ_NODISCARD char const* _az_base64_get_encode_array(az_base64_alphabet alphabet)
+{
+  return alphabet == AZ_BASE64_ALPHABET_URL ? _az_base64_url_encode_array : _az_base64_encode_array;
+}
+
+static AZ_NODISCARD _az_base64_mode _az_base64_get_mode(az_base64_alphabet alphabet)
+{
+  return alphabet == AZ_BASE64_ALPHABET_URL ? _az_base64_mode_url : _az_base64_mode_standard;
+}
+
+AZ_NODISCARD az_result
+az_base64_encoder_init(az_base64_encoder* out_encoder, az_base64_alphabet alphabet)
+{
+  _az_PRECONDITION_NOT_NULL(out_encoder);
+  _az_PRECONDITION(alphabet == AZ_BASE64_ALPHABET_STANDARD || alphabet == AZ_BASE64_ALPHABET_URL);
+
+  *out_encoder = (az_base64_encoder){
+    ._internal = {
+      .pending = { 0 },
+      .pending_size = 0,
+      .alphabet = alphabet,
+    },
+  };
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_base64_encoder_update(
+    az_base64_encoder* ref_encoder,
+    az_span destination_base64_text,
+    az_span source_bytes,
+    int32_t* out_written)
+{
+  _az_PRECONDITION_NOT_NULL(ref_encoder);
+  _az_PRECONDITION_VALID_SPAN(destination_base64_text, 0, true);
+  _az_PRECONDITION_VALID_SPAN(source_bytes, 0, true);
+  _az_PRECONDITION_RANGE(0, az_span_size(source_bytes), _az_MAX_SAFE_ENCODED_LENGTH);
+  _az_PRECONDITION_NOT_NULL(out_written);
+
+  uint8_t* const pending = ref_encoder->_internal.pending;
+  int32_t const pending_size = ref_encoder->_internal.pending_size;
+  int32_t const source_length = az_span_size(source_bytes);
+  int32_t const groups = (pending_size + source_length) / 3;
+
+  if (groups == 0)
+  {
+    // Not enough for a whole group yet.
+    az_span_copy(az_span_create(pending + pending_size, 2 - pending_size), source_bytes);
+    ref_encoder->_internal.pending_size += source_length;
+    *out_written = 0;
+    return AZ_OK;
+  }
+
+  if (az_span_size(destination_base64_text) < groups * 4)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  char const* const alphabet = _az_base64_get_encode_array(ref_encoder->_internal.alphabet);
+  uint8_t* destination_ptr = az_span_ptr(destination_base64_text);
+  uint8_t const* const source_ptr = az_span_ptr(source_bytes);
+  int32_t source_index = 0;
+
+  // Complete the group started by the previous chunks.
+  if (pending_size > 0)
+  {
+    uint8_t group[3];
+    source_index = 3 - pending_size;
+    memcpy(group, pending, (size_t)pending_size);
+    memcpy(group + pending_size, source_ptr, (size_t)source_index);
+
+    _az_base64_write_int_as_four_bytes(destination_ptr, _az_base64_encode(group, alphabet));
+    destination_ptr += 4;
+  }
+
+  int32_t const encoded = _az_base64_encode_groups(
+      destination_ptr, source_ptr + source_index, source_length - source_index, alphabet);
+  destination_ptr += (encoded / 3) * 4;
+  source_index += encoded;
+
+  // Keep the 1 or 2 bytes left over for the next chunk.
+  ref_encoder->_internal.pending_size = source_length - source_index;
+  memcpy(pending, source_ptr + source_index, (size_t)ref_encoder->_internal.pending_size);
+
+  *out_written = (int32_t)(destination_ptr - az_span_ptr(destination_base64_text));
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_base64_encoder_final(
+    az_base64_encoder* ref_encoder,
+    az_span destination_base64_text,
+    int32_t* out_written)
+{
+  _az_PRECONDITION_NOT_NULL(ref_encoder);
+  _az_PRECONDITION_VALID_SPAN(destination_base64_text, 0, true);
+  _az_PRECONDITION_NOT_NULL(out_written);
+
+  int32_t const pending_size = ref_encoder->_internal.pending_size;
+  bool const omit_padding = ref_encoder->_internal.alphabet == AZ_BASE64_ALPHABET_URL;
+
+  if (pending_size > 0)
+  {
+    if (az_span_size(destination_base64_text) < (omit_padding ? pending_size + 1 : 4))
+    {
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
+    *out_written = _az_base64_encode_last_group(
+        az_span_ptr(destination_base64_text),
+        ref_encoder->_internal.pending,
+        pending_size,
+        _az_base64_get_encode_array(ref_encoder->_internal.alphabet),
+        omit_padding);
+  }
+  else
+  {
+    *out_written = 0;
+  }
+
+  ref_encoder->_internal.pending_size = 0;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_base64_decoder_init(az_base64_decoder* out_decoder, az_base64_alphabet alphabet)
+{
+  _az_PRECONDITION_NOT_NULL(out_decoder);
+  _az_PRECONDITION(alphabet == AZ_BASE64_ALPHABET_STANDARD || alphabet == AZ_BASE64_ALPHABET_URL);
+
+  *out_decoder = (az_base64_decoder){
+    ._internal = {
+      .pending = { 0 },
+      .pending_size = 0,
+      .alphabet = alphabet,
+      .is_padded = false,
+    },
+  };
+
+  return AZ_OK;
+}
+
+// Decodes whole groups of 4 characters, the last of which may be padded, in which case nothing
+// else may follow it.
+static AZ_NODISCARD az_result _az_base64_decoder_decode_groups(
+    az_base64_decoder* ref_decoder,
+    uint8_t* destination,
+    uint8_t const* source,
+    int32_t source_length,
+    int32_t* out_written)
+{
+  _az_base64_mode const mode = _az_base64_get_mode(ref_decoder->_internal.alphabet);
+  bool const is_padded = source[source_length - 1] == _az_ENCODING_PAD;
+  int32_t const groups_length = is_padded ? source_length - 4 : source_length;
+
+  if (!_az_base64_decode_groups(destination, source, groups_length, mode))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  *out_written = (groups_length / 4) * 3;
+
+  if (is_padded)
+  {
+    int32_t last_group_written = 0;
+    _az_RETURN_IF_FAILED(_az_base64_decode_last_group(
+        destination + *out_written, 3, source + groups_length, 4, mode, &last_group_written));
+    *out_written += last_group_written;
+    ref_decoder->_internal.is_padded = true;
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_base64_decoder_update(
+    az_base64_decoder* ref_decoder,
+    az_span destination_bytes,
+    az_span source_base64_text,
+    int32_t* out_written)
+{
+  _az_PRECONDITION_NOT_NULL(ref_decoder);
+  _az_PRECONDITION_VALID_SPAN(destination_bytes, 0, true);
+  _az_PRECONDITION_VALID_SPAN(source_base64_text, 0, true);
+  _az_PRECONDITION(az_span_size(source_base64_text) <= INT32_MAX - 3);
+  _az_PRECONDITION_NOT_NULL(out_written);
+
+  uint8_t* const pending = ref_decoder->_internal.pending;
+  int32_t const pending_size = ref_decoder->_internal.pending_size;
+  int32_t const source_length = az_span_size(source_base64_text);
+  uint8_t const* const source_ptr = az_span_ptr(source_base64_text);
+  int32_t const total_length = pending_size + source_length;
+  int32_t const groups_length = (total_length / 4) * 4;
+
+  // Nothing may follow padding.
+  if (ref_decoder->_internal.is_padded && source_length > 0)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  if (groups_length == 0)
+  {
+    // Not enough for a whole group yet.
+    az_span_copy(az_span_create(pending + pending_size, 3 - pending_size), source_base64_text);
+    ref_decoder->_internal.pending_size += source_length;
+    *out_written = 0;
+    return AZ_OK;
+  }
+
+  // Padding at the end of the last group shortens its decoded bytes, and an earlier group being
+  // padded is an error, which is detected as the groups are decoded.
+  int32_t padding = 0;
+  for (int32_t index = groups_length - 1; index >= groups_length - 2; index--)
+  {
+    uint8_t const c = index < pending_size ? pending[index] : source_ptr[index - pending_size];
+    if (c != _az_ENCODING_PAD)
+    {
+      break;
+    }
+    padding++;
+  }
+
+  if (az_span_size(destination_bytes) < (groups_length / 4) * 3 - padding)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  uint8_t* destination_ptr = az_span_ptr(destination_bytes);
+  int32_t source_index = 0;
+  int32_t written = 0;
+
+  // Complete the group started by the previous chunks.
+  if (pending_size > 0)
+  {
+    uint8_t group[4];
+    source_index = 4 - pending_size;
+    memcpy(group, pending, (size_t)pending_size);
+    memcpy(group + pending_size, source_ptr, (size_t)source_index);
+
+    _az_RETURN_IF_FAILED(
+        _az_base64_decoder_decode_groups(ref_decoder, destination_ptr, group, 4, &written));
+    destination_ptr += written;
+  }
+
+  int32_t const source_groups_length = groups_length - pending_size - source_index;
+  if (source_groups_length > 0)
+  {
+    if (ref_decoder->_internal.is_padded)
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
+    _az_RETURN_IF_FAILED(_az_base64_decoder_decode_groups(
+        ref_decoder, destination_ptr, source_ptr + source_index, source_groups_length, &written));
+    destination_ptr += written;
+    source_index += source_groups_length;
+  }
+
+  // Keep the 1 to 3 characters left over for the next chunk.
+  int32_t const left_over = source_length - source_index;
+  if (ref_decoder->_internal.is_padded && left_over > 0)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+  memcpy(pending, source_ptr + source_index, (size_t)left_over);
+  ref_decoder->_internal.pending_size = left_over;
+
+  *out_written = (int32_t)(destination_ptr - az_span_ptr(destination_bytes));
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_base64_decoder_final(
+    az_base64_decoder* ref_decoder,
+    az_span destination_bytes,
+    int32_t* out_written)
+{
+  _az_PRECONDITION_NOT_NULL(ref_decoder);
+  _az_PRECONDITION_VALID_SPAN(destination_bytes, 0, true);
+  _az_PRECONDITION_NOT_NULL(out_written);
+
+  int32_t const pending_size = ref_decoder->_internal.pending_size;
+  int32_t written = 0;
+
+  if (pending_size > 0)
+  {
+    // Only the URL alphabet may omit padding, in which case at least 2 characters must be left.
+    if (ref_decoder->_internal.alphabet != AZ_BASE64_ALPHABET_URL || pending_size == 1)
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    _az_RETURN_IF_FAILED(_az_base64_decode_last_group(
+        az_span_ptr(destination_bytes),
+        az_span_size(destination_bytes),
+        ref_decoder->_internal.pending,
+        pending_size,
+        _az_base64_mode_url,
+        &written));
+  }
+
+  ref_decoder->_internal.pending_size = 0;
+  ref_decoder->_internal.is_padded = false;
+  *out_written = written;
+  return AZ_OK;
+}
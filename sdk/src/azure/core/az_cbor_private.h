@@ -0,0 +1,71 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file
+ *
+ * @brief Defines private implementation used by cbor.
+ *
+ * @note You MUST NOT use any symbols (macros, functions, structures, enums, etc.)
+ * prefixed with an underscore ('_') directly in your application code. These symbols
+ * are part of Azure SDK's internal implementation; we do not document these symbols
+ * and they are subject to change in future versions of the SDK which would break your code.
+ */
+
+#ifndef _az_CBOR_PRIVATE_H
+#define _az_CBOR_PRIVATE_H
+
+#include <azure/core/az_cbor.h>
+
+#include <azure/core/_az_cfg_prefix.h>
+
+#define _az_CBOR_TOKEN_DEFAULT                     \
+  (az_cbor_token)                                  \
+  {                                                \
+    .kind = AZ_CBOR_TOKEN_NONE, ._internal = { 0 } \
+  }
+
+// The major types of CBOR data items, kept within the 3 high-order bits of their initial byte.
+typedef enum
+{
+  _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER = 0,
+  _az_CBOR_MAJOR_TYPE_NEGATIVE_INTEGER = 1,
+  _az_CBOR_MAJOR_TYPE_BYTE_STRING = 2,
+  _az_CBOR_MAJOR_TYPE_TEXT_STRING = 3,
+  _az_CBOR_MAJOR_TYPE_ARRAY = 4,
+  _az_CBOR_MAJOR_TYPE_MAP = 5,
+  _az_CBOR_MAJOR_TYPE_TAG = 6,
+  _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT = 7,
+} _az_cbor_major_type;
+
+enum
+{
+  // The 5 low-order bits of the initial byte hold the additional information, which is either the
+  // argument itself (below 24), or how many bytes follow to hold it.
+  _az_CBOR_ADDITIONAL_INFO_MASK = 0x1F,
+  _az_CBOR_ADDITIONAL_INFO_ONE_BYTE = 24,
+  _az_CBOR_ADDITIONAL_INFO_TWO_BYTES = 25,
+  _az_CBOR_ADDITIONAL_INFO_FOUR_BYTES = 26,
+  _az_CBOR_ADDITIONAL_INFO_EIGHT_BYTES = 27,
+  _az_CBOR_ADDITIONAL_INFO_INDEFINITE = 31,
+
+  // The initial bytes of the simple values, and of maps and arrays of indefinite length, along with
+  // the "break" byte that ends them.
+  _az_CBOR_FALSE = 0xF4,
+  _az_CBOR_TRUE = 0xF5,
+  _az_CBOR_NULL = 0xF6,
+  _az_CBOR_BEGIN_INDEFINITE_ARRAY = 0x9F,
+  _az_CBOR_BEGIN_INDEFINITE_MAP = 0xBF,
+  _az_CBOR_BREAK = 0xFF,
+
+  // The initial byte, and the 8-byte argument, of the longest data item head.
+  _az_CBOR_MAX_HEAD_SIZE = 9,
+
+  // When writing large strings in chunks, ask for at least 64 bytes, to avoid writing one byte at a
+  // time, which is also enough for any data item head.
+  _az_CBOR_MINIMUM_CHUNK_SIZE = 64,
+};
+
+#include <azure/core/_az_cfg_suffix.h>
+
+#endif // _az_CBOR_PRIVATE_H
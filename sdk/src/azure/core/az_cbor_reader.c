@@ -0,0 +1,442 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_cbor_private.h"
+#include "az_json_private.h"
+#include <azure/core/az_cbor.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_cbor_reader_init(
+    az_cbor_reader* out_cbor_reader,
+    az_span cbor_buffer,
+    az_cbor_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_cbor_reader);
+  _az_PRECONDITION(az_span_size(cbor_buffer) >= 1);
+
+  *out_cbor_reader = (az_cbor_reader){
+    .token = _az_CBOR_TOKEN_DEFAULT,
+    .current_depth = 0,
+    ._internal = {
+      .cbor_buffer = cbor_buffer,
+      .cbor_buffers = NULL,
+      .number_of_buffers = 1,
+      .buffer_index = 0,
+      .bytes_consumed = 0,
+      .total_bytes_consumed = 0,
+      .bit_stack = { 0 },
+      .remaining_items = { 0 },
+      .options = options == NULL ? az_cbor_reader_options_default() : *options,
+    },
+  };
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_reader_chunked_init(
+    az_cbor_reader* out_cbor_reader,
+    az_span cbor_buffers[],
+    int32_t number_of_buffers,
+    az_cbor_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_cbor_reader);
+  _az_PRECONDITION(number_of_buffers >= 1);
+  _az_PRECONDITION(az_span_size(cbor_buffers[0]) >= 1);
+
+  *out_cbor_reader = (az_cbor_reader){
+    .token = _az_CBOR_TOKEN_DEFAULT,
+    .current_depth = 0,
+    ._internal = {
+      .cbor_buffer = cbor_buffers[0],
+      .cbor_buffers = cbor_buffers,
+      .number_of_buffers = number_of_buffers,
+      .buffer_index = 0,
+      .bytes_consumed = 0,
+      .total_bytes_consumed = 0,
+      .bit_stack = { 0 },
+      .remaining_items = { 0 },
+      .options = options == NULL ? az_cbor_reader_options_default() : *options,
+    },
+  };
+  return AZ_OK;
+}
+
+// Returns the CBOR data left within the current buffer, moving on to the next buffer once the
+// current one has been read in full.
+AZ_NODISCARD static az_span _az_cbor_reader_get_remaining(az_cbor_reader* ref_cbor_reader)
+{
+  az_span remaining = az_span_slice_to_end(
+      ref_cbor_reader->_internal.cbor_buffer, ref_cbor_reader->_internal.bytes_consumed);
+
+  if (az_span_size(remaining) == 0
+      && ref_cbor_reader->_internal.buffer_index < ref_cbor_reader->_internal.number_of_buffers - 1)
+  {
+    ref_cbor_reader->_internal.buffer_index++;
+    ref_cbor_reader->_internal.cbor_buffer
+        = ref_cbor_reader->_internal.cbor_buffers[ref_cbor_reader->_internal.buffer_index];
+    ref_cbor_reader->_internal.bytes_consumed = 0;
+    remaining = ref_cbor_reader->_internal.cbor_buffer;
+  }
+
+  return remaining;
+}
+
+static void _az_cbor_reader_consume(az_cbor_reader* ref_cbor_reader, int32_t size)
+{
+  ref_cbor_reader->_internal.bytes_consumed += size;
+  ref_cbor_reader->_internal.total_bytes_consumed += size;
+}
+
+// Sets the token slice to the size bytes read since the given position, which may be in an earlier
+// buffer.
+static void _az_cbor_reader_set_token_slice(
+    az_cbor_reader* ref_cbor_reader,
+    int32_t start_buffer_index,
+    int32_t start_buffer_offset,
+    int32_t size)
+{
+  az_cbor_token* token = &ref_cbor_reader->token;
+  token->size = size;
+  token->_internal.start_buffer_index = start_buffer_index;
+  token->_internal.start_buffer_offset = start_buffer_offset;
+
+  if (start_buffer_index == ref_cbor_reader->_internal.buffer_index)
+  {
+    token->slice = az_span_slice(
+        ref_cbor_reader->_internal.cbor_buffer, start_buffer_offset, start_buffer_offset + size);
+    token->_internal.is_multisegment = false;
+    token->_internal.pointer_to_first_buffer = NULL;
+  }
+  else
+  {
+    token->slice = az_span_slice(
+        ref_cbor_reader->_internal.cbor_buffer, 0, ref_cbor_reader->_internal.bytes_consumed);
+    token->_internal.is_multisegment = true;
+    token->_internal.pointer_to_first_buffer = ref_cbor_reader->_internal.cbor_buffers;
+  }
+}
+
+// Reads the head of the next data item, i.e. its initial byte followed by its argument, which may
+// straddle buffers, and sets the token slice to it.
+AZ_NODISCARD static az_result _az_cbor_reader_read_head(
+    az_cbor_reader* ref_cbor_reader,
+    uint8_t* out_initial_byte,
+    uint64_t* out_argument)
+{
+  az_span remaining = _az_cbor_reader_get_remaining(ref_cbor_reader);
+  int32_t const remaining_size = az_span_size(remaining);
+  if (remaining_size == 0)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  uint8_t const* head = az_span_ptr(remaining);
+  uint8_t const additional_info = head[0] & _az_CBOR_ADDITIONAL_INFO_MASK;
+  uint64_t argument = additional_info;
+  int32_t argument_size = 0;
+
+  if (additional_info >= _az_CBOR_ADDITIONAL_INFO_ONE_BYTE)
+  {
+    if (additional_info <= _az_CBOR_ADDITIONAL_INFO_EIGHT_BYTES)
+    {
+      argument = 0;
+      argument_size = 1 << (additional_info - _az_CBOR_ADDITIONAL_INFO_ONE_BYTE);
+    }
+    else if (additional_info != _az_CBOR_ADDITIONAL_INFO_INDEFINITE)
+    {
+      // The additional information values from 28 to 30 are reserved.
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+  }
+
+  int32_t const start_buffer_index = ref_cbor_reader->_internal.buffer_index;
+  int32_t const start_buffer_offset = ref_cbor_reader->_internal.bytes_consumed;
+  *out_initial_byte = head[0];
+
+  if (argument_size < remaining_size)
+  {
+    for (int32_t i = 1; i <= argument_size; i++)
+    {
+      argument = (argument << 8U) | head[i];
+    }
+    _az_cbor_reader_consume(ref_cbor_reader, 1 + argument_size);
+  }
+  else
+  {
+    // The argument continues within the next buffer(s).
+    _az_cbor_reader_consume(ref_cbor_reader, 1);
+    for (int32_t i = 0; i < argument_size; i++)
+    {
+      remaining = _az_cbor_reader_get_remaining(ref_cbor_reader);
+      if (az_span_size(remaining) == 0)
+      {
+        return AZ_ERROR_UNEXPECTED_END;
+      }
+
+      argument = (argument << 8U) | *az_span_ptr(remaining);
+      _az_cbor_reader_consume(ref_cbor_reader, 1);
+    }
+  }
+
+  _az_cbor_reader_set_token_slice(
+      ref_cbor_reader, start_buffer_index, start_buffer_offset, 1 + argument_size);
+  *out_argument = argument;
+  return AZ_OK;
+}
+
+// Reads the content of a text or byte string, which may straddle buffers, and sets the token slice
+// to it.
+AZ_NODISCARD static az_result
+_az_cbor_reader_read_string_content(az_cbor_reader* ref_cbor_reader, uint64_t size)
+{
+  // A string can't be larger than any of the buffers it is read from.
+  if (size > INT32_MAX)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  int32_t left = (int32_t)size;
+  az_span remaining = left > 0 ? _az_cbor_reader_get_remaining(ref_cbor_reader) : AZ_SPAN_EMPTY;
+  int32_t const start_buffer_index = ref_cbor_reader->_internal.buffer_index;
+  int32_t const start_buffer_offset = ref_cbor_reader->_internal.bytes_consumed;
+
+  while (left > az_span_size(remaining))
+  {
+    if (az_span_size(remaining) == 0)
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    left -= az_span_size(remaining);
+    _az_cbor_reader_consume(ref_cbor_reader, az_span_size(remaining));
+    remaining = _az_cbor_reader_get_remaining(ref_cbor_reader);
+  }
+  _az_cbor_reader_consume(ref_cbor_reader, left);
+
+  _az_cbor_reader_set_token_slice(
+      ref_cbor_reader, start_buffer_index, start_buffer_offset, (int32_t)size);
+  return AZ_OK;
+}
+
+static void _az_cbor_reader_end_container(az_cbor_reader* ref_cbor_reader)
+{
+  ref_cbor_reader->token.kind
+      = _az_json_stack_peek(&ref_cbor_reader->_internal.bit_stack) == _az_JSON_STACK_OBJECT
+      ? AZ_CBOR_TOKEN_END_OBJECT
+      : AZ_CBOR_TOKEN_END_ARRAY;
+
+  _az_json_stack_pop(&ref_cbor_reader->_internal.bit_stack);
+  ref_cbor_reader->current_depth--;
+}
+
+AZ_NODISCARD static az_result _az_cbor_reader_begin_container(
+    az_cbor_reader* ref_cbor_reader,
+    _az_cbor_major_type major_type,
+    uint8_t additional_info,
+    uint64_t argument)
+{
+  int32_t const depth = ref_cbor_reader->current_depth;
+  if (depth >= _az_MAX_CBOR_NESTING_DEPTH)
+  {
+    return AZ_ERROR_JSON_NESTING_OVERFLOW;
+  }
+
+  bool const is_map = major_type == _az_CBOR_MAJOR_TYPE_MAP;
+  int32_t items = -1;
+  if (additional_info != _az_CBOR_ADDITIONAL_INFO_INDEFINITE)
+  {
+    // Every item takes at least one byte, so there can't be more of them than that.
+    if (argument > (uint64_t)(is_map ? INT32_MAX / 2 : INT32_MAX))
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    // Keys and values are counted as separate items.
+    items = is_map ? (int32_t)argument * 2 : (int32_t)argument;
+  }
+
+  _az_json_stack_push(
+      &ref_cbor_reader->_internal.bit_stack,
+      is_map ? _az_JSON_STACK_OBJECT : _az_JSON_STACK_ARRAY);
+  ref_cbor_reader->_internal.remaining_items[depth] = items;
+  ref_cbor_reader->current_depth++;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_reader_next_token(az_cbor_reader* ref_cbor_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_reader);
+
+  int32_t const depth = ref_cbor_reader->current_depth;
+  if (depth == 0)
+  {
+    // Once the top-level data item has been read in full, nothing else may follow it.
+    if (ref_cbor_reader->token.kind != AZ_CBOR_TOKEN_NONE)
+    {
+      return az_span_size(_az_cbor_reader_get_remaining(ref_cbor_reader)) == 0
+          ? AZ_ERROR_JSON_READER_DONE
+          : AZ_ERROR_UNEXPECTED_CHAR;
+    }
+  }
+  else if (ref_cbor_reader->_internal.remaining_items[depth - 1] == 0)
+  {
+    // All the items of a map or array of definite length have been read.
+    _az_cbor_reader_end_container(ref_cbor_reader);
+    _az_cbor_reader_set_token_slice(
+        ref_cbor_reader,
+        ref_cbor_reader->_internal.buffer_index,
+        ref_cbor_reader->_internal.bytes_consumed,
+        0);
+    return AZ_OK;
+  }
+
+  uint8_t initial_byte = 0;
+  uint64_t argument = 0;
+  _az_RETURN_IF_FAILED(_az_cbor_reader_read_head(ref_cbor_reader, &initial_byte, &argument));
+
+  // Tags only add semantics to the data item that follows them, so they are skipped.
+  bool is_tagged = false;
+  while ((initial_byte >> 5U) == _az_CBOR_MAJOR_TYPE_TAG)
+  {
+    if ((initial_byte & _az_CBOR_ADDITIONAL_INFO_MASK) == _az_CBOR_ADDITIONAL_INFO_INDEFINITE)
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
+    is_tagged = true;
+    _az_RETURN_IF_FAILED(_az_cbor_reader_read_head(ref_cbor_reader, &initial_byte, &argument));
+  }
+
+  // Within a map, keys and values alternate.
+  bool const is_in_map = depth > 0
+      && _az_json_stack_peek(&ref_cbor_reader->_internal.bit_stack) == _az_JSON_STACK_OBJECT;
+  bool const is_key = is_in_map && ref_cbor_reader->token.kind != AZ_CBOR_TOKEN_PROPERTY_NAME;
+
+  if (initial_byte == _az_CBOR_BREAK)
+  {
+    // Only maps and arrays of indefinite length end with a break, which can't come in between a
+    // key and its value.
+    if (is_tagged || depth == 0 || ref_cbor_reader->_internal.remaining_items[depth - 1] != -1
+        || (is_in_map && !is_key))
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
+    _az_cbor_reader_end_container(ref_cbor_reader);
+    return AZ_OK;
+  }
+
+  if (depth > 0 && ref_cbor_reader->_internal.remaining_items[depth - 1] > 0)
+  {
+    ref_cbor_reader->_internal.remaining_items[depth - 1]--;
+  }
+
+  _az_cbor_major_type const major_type = (_az_cbor_major_type)(initial_byte >> 5U);
+  uint8_t const additional_info = initial_byte & _az_CBOR_ADDITIONAL_INFO_MASK;
+  az_cbor_token_kind kind = AZ_CBOR_TOKEN_NONE;
+
+  switch (major_type)
+  {
+    case _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER:
+    case _az_CBOR_MAJOR_TYPE_NEGATIVE_INTEGER:
+      if (additional_info == _az_CBOR_ADDITIONAL_INFO_INDEFINITE)
+      {
+        return AZ_ERROR_UNEXPECTED_CHAR;
+      }
+      kind = AZ_CBOR_TOKEN_NUMBER;
+      break;
+    case _az_CBOR_MAJOR_TYPE_BYTE_STRING:
+    case _az_CBOR_MAJOR_TYPE_TEXT_STRING:
+      // Strings of indefinite length are made of chunks, which would have to be put back together.
+      if (additional_info == _az_CBOR_ADDITIONAL_INFO_INDEFINITE)
+      {
+        return AZ_ERROR_NOT_SUPPORTED;
+      }
+
+      if (major_type == _az_CBOR_MAJOR_TYPE_BYTE_STRING)
+      {
+        kind = AZ_CBOR_TOKEN_BYTES;
+      }
+      else
+      {
+        kind = is_key ? AZ_CBOR_TOKEN_PROPERTY_NAME : AZ_CBOR_TOKEN_STRING;
+      }
+      break;
+    case _az_CBOR_MAJOR_TYPE_ARRAY:
+    case _az_CBOR_MAJOR_TYPE_MAP:
+      kind = major_type == _az_CBOR_MAJOR_TYPE_MAP ? AZ_CBOR_TOKEN_BEGIN_OBJECT
+                                                   : AZ_CBOR_TOKEN_BEGIN_ARRAY;
+      break;
+    default:
+      switch (initial_byte)
+      {
+        case _az_CBOR_FALSE:
+          kind = AZ_CBOR_TOKEN_FALSE;
+          break;
+        case _az_CBOR_TRUE:
+          kind = AZ_CBOR_TOKEN_TRUE;
+          break;
+        case _az_CBOR_NULL:
+          kind = AZ_CBOR_TOKEN_NULL;
+          break;
+        default:
+          // Floating-point numbers, of half, single or double precision.
+          if (additional_info < _az_CBOR_ADDITIONAL_INFO_TWO_BYTES
+              || additional_info > _az_CBOR_ADDITIONAL_INFO_EIGHT_BYTES)
+          {
+            return AZ_ERROR_UNEXPECTED_CHAR;
+          }
+          kind = AZ_CBOR_TOKEN_NUMBER;
+          break;
+      }
+      break;
+  }
+
+  // Only text strings are supported as keys, like the property names of JSON objects.
+  if (is_key && kind != AZ_CBOR_TOKEN_PROPERTY_NAME)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  if (kind == AZ_CBOR_TOKEN_BEGIN_OBJECT || kind == AZ_CBOR_TOKEN_BEGIN_ARRAY)
+  {
+    _az_RETURN_IF_FAILED(
+        _az_cbor_reader_begin_container(ref_cbor_reader, major_type, additional_info, argument));
+  }
+  else if (
+      kind == AZ_CBOR_TOKEN_STRING || kind == AZ_CBOR_TOKEN_PROPERTY_NAME
+      || kind == AZ_CBOR_TOKEN_BYTES)
+  {
+    _az_RETURN_IF_FAILED(_az_cbor_reader_read_string_content(ref_cbor_reader, argument));
+  }
+
+  ref_cbor_reader->token.kind = kind;
+  ref_cbor_reader->token._internal.initial_byte = initial_byte;
+  ref_cbor_reader->token._internal.argument = argument;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_reader_skip_children(az_cbor_reader* ref_cbor_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_reader);
+
+  if (ref_cbor_reader->token.kind == AZ_CBOR_TOKEN_PROPERTY_NAME)
+  {
+    _az_RETURN_IF_FAILED(az_cbor_reader_next_token(ref_cbor_reader));
+  }
+
+  az_cbor_token_kind const token_kind = ref_cbor_reader->token.kind;
+  if (token_kind == AZ_CBOR_TOKEN_BEGIN_OBJECT || token_kind == AZ_CBOR_TOKEN_BEGIN_ARRAY)
+  {
+    // Keep moving the reader until we come back to the same depth.
+    int32_t const depth = ref_cbor_reader->current_depth;
+    do
+    {
+      _az_RETURN_IF_FAILED(az_cbor_reader_next_token(ref_cbor_reader));
+    } while (depth <= ref_cbor_reader->current_depth);
+  }
+  return AZ_OK;
+}
@@ -0,0 +1,282 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_cbor_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_cbor.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <math.h>
+#include <string.h>
+
+#include <azure/core/_az_cfg.h>
+
+// Returns the part of the token within the buffer segment at segment_index, given how many bytes of
+// the token are left to go through.
+AZ_NODISCARD static az_span _az_cbor_token_get_segment(
+    az_cbor_token const* cbor_token,
+    int32_t segment_index,
+    int32_t bytes_left)
+{
+  az_span segment = cbor_token->_internal.pointer_to_first_buffer[segment_index];
+  if (segment_index == cbor_token->_internal.start_buffer_index)
+  {
+    segment = az_span_slice_to_end(segment, cbor_token->_internal.start_buffer_offset);
+  }
+
+  return az_span_size(segment) > bytes_left ? az_span_slice(segment, 0, bytes_left) : segment;
+}
+
+az_span az_cbor_token_copy_into_span(az_cbor_token const* cbor_token, az_span destination)
+{
+  _az_PRECONDITION_VALID_SPAN(destination, cbor_token->size, false);
+
+  // Contiguous token
+  if (!cbor_token->_internal.is_multisegment)
+  {
+    return az_span_copy(destination, cbor_token->slice);
+  }
+
+  // Token straddles more than one segment
+  int32_t bytes_left = cbor_token->size;
+  for (int32_t i = cbor_token->_internal.start_buffer_index; bytes_left > 0; i++)
+  {
+    az_span const source = _az_cbor_token_get_segment(cbor_token, i, bytes_left);
+    destination = az_span_copy(destination, source);
+    bytes_left -= az_span_size(source);
+  }
+
+  return destination;
+}
+
+AZ_NODISCARD az_result az_cbor_token_get_boolean(az_cbor_token const* cbor_token, bool* out_value)
+{
+  _az_PRECONDITION_NOT_NULL(cbor_token);
+  _az_PRECONDITION_NOT_NULL(out_value);
+
+  if (cbor_token->kind != AZ_CBOR_TOKEN_TRUE && cbor_token->kind != AZ_CBOR_TOKEN_FALSE)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  *out_value = cbor_token->kind == AZ_CBOR_TOKEN_TRUE;
+  return AZ_OK;
+}
+
+AZ_NODISCARD static _az_cbor_major_type
+_az_cbor_token_get_major_type(az_cbor_token const* cbor_token)
+{
+  return (_az_cbor_major_type)(cbor_token->_internal.initial_byte >> 5U);
+}
+
+AZ_NODISCARD az_result
+az_cbor_token_get_uint64(az_cbor_token const* cbor_token, uint64_t* out_value)
+{
+  _az_PRECONDITION_NOT_NULL(cbor_token);
+  _az_PRECONDITION_NOT_NULL(out_value);
+
+  if (cbor_token->kind != AZ_CBOR_TOKEN_NUMBER)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  if (_az_cbor_token_get_major_type(cbor_token) != _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  *out_value = cbor_token->_internal.argument;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_cbor_token_get_uint32(az_cbor_token const* cbor_token, uint32_t* out_value)
+{
+  _az_PRECONDITION_NOT_NULL(out_value);
+
+  uint64_t value = 0;
+  _az_RETURN_IF_FAILED(az_cbor_token_get_uint64(cbor_token, &value));
+
+  if (value > UINT32_MAX)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  *out_value = (uint32_t)value;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_token_get_int64(az_cbor_token const* cbor_token, int64_t* out_value)
+{
+  _az_PRECONDITION_NOT_NULL(cbor_token);
+  _az_PRECONDITION_NOT_NULL(out_value);
+
+  if (cbor_token->kind != AZ_CBOR_TOKEN_NUMBER)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  uint64_t const argument = cbor_token->_internal.argument;
+  _az_cbor_major_type const major_type = _az_cbor_token_get_major_type(cbor_token);
+  if ((major_type != _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER
+       && major_type != _az_CBOR_MAJOR_TYPE_NEGATIVE_INTEGER)
+      || argument > INT64_MAX)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  // Negative integers are encoded as -1 minus their argument.
+  *out_value = major_type == _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER ? (int64_t)argument
+                                                                 : -1 - (int64_t)argument;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_token_get_int32(az_cbor_token const* cbor_token, int32_t* out_value)
+{
+  _az_PRECONDITION_NOT_NULL(out_value);
+
+  int64_t value = 0;
+  _az_RETURN_IF_FAILED(az_cbor_token_get_int64(cbor_token, &value));
+
+  if (value < INT32_MIN || value > INT32_MAX)
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  *out_value = (int32_t)value;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_token_get_double(az_cbor_token const* cbor_token, double* out_value)
+{
+  _az_PRECONDITION_NOT_NULL(cbor_token);
+  _az_PRECONDITION_NOT_NULL(out_value);
+
+  if (cbor_token->kind != AZ_CBOR_TOKEN_NUMBER)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  uint64_t const argument = cbor_token->_internal.argument;
+  double value = 0;
+
+  switch (_az_cbor_token_get_major_type(cbor_token))
+  {
+    case _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER:
+      value = (double)argument;
+      break;
+    case _az_CBOR_MAJOR_TYPE_NEGATIVE_INTEGER:
+      value = -1.0 - (double)argument;
+      break;
+    default:
+      switch (cbor_token->_internal.initial_byte & _az_CBOR_ADDITIONAL_INFO_MASK)
+      {
+        case _az_CBOR_ADDITIONAL_INFO_TWO_BYTES:
+        {
+          // Half precision, as decoded in RFC 8949, appendix D.
+          int32_t const exponent = (int32_t)((argument >> 10U) & 0x1FU);
+          double const mantissa = (double)(argument & 0x3FFU);
+          if (exponent == 0x1F)
+          {
+            return AZ_ERROR_UNEXPECTED_CHAR;
+          }
+
+          value = exponent == 0 ? ldexp(mantissa, -24) : ldexp(mantissa + 1024, exponent - 25);
+          if ((argument & 0x8000U) != 0)
+          {
+            value = -value;
+          }
+          break;
+        }
+        case _az_CBOR_ADDITIONAL_INFO_FOUR_BYTES:
+        {
+          uint32_t const float_bits = (uint32_t)argument;
+          float single = 0;
+          memcpy(&single, &float_bits, sizeof(single));
+          value = single;
+          break;
+        }
+        default:
+          memcpy(&value, &argument, sizeof(value));
+          break;
+      }
+
+      if (!_az_isfinite(value))
+      {
+        return AZ_ERROR_UNEXPECTED_CHAR;
+      }
+      break;
+  }
+
+  *out_value = value;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_token_get_string(
+    az_cbor_token const* cbor_token,
+    char* destination,
+    int32_t destination_max_size,
+    int32_t* out_string_length)
+{
+  _az_PRECONDITION_NOT_NULL(cbor_token);
+  _az_PRECONDITION_NOT_NULL(destination);
+  _az_PRECONDITION(destination_max_size > 0);
+
+  if (cbor_token->kind != AZ_CBOR_TOKEN_STRING && cbor_token->kind != AZ_CBOR_TOKEN_PROPERTY_NAME)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  // We need enough space to add a null terminator.
+  if (cbor_token->size >= destination_max_size)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  az_span_copy_u8(
+      az_cbor_token_copy_into_span(
+          cbor_token, az_span_create((uint8_t*)destination, destination_max_size)),
+      '\0');
+
+  if (out_string_length != NULL)
+  {
+    *out_string_length = cbor_token->size;
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD bool az_cbor_token_is_text_equal(
+    az_cbor_token const* cbor_token,
+    az_span expected_text)
+{
+  _az_PRECONDITION_NOT_NULL(cbor_token);
+
+  if ((cbor_token->kind != AZ_CBOR_TOKEN_STRING && cbor_token->kind != AZ_CBOR_TOKEN_PROPERTY_NAME)
+      || cbor_token->size != az_span_size(expected_text))
+  {
+    return false;
+  }
+
+  if (!cbor_token->_internal.is_multisegment)
+  {
+    return az_span_is_content_equal(cbor_token->slice, expected_text);
+  }
+
+  int32_t bytes_left = cbor_token->size;
+  for (int32_t i = cbor_token->_internal.start_buffer_index; bytes_left > 0; i++)
+  {
+    az_span const segment = _az_cbor_token_get_segment(cbor_token, i, bytes_left);
+    if (!az_span_is_content_equal(segment, az_span_slice(expected_text, 0, az_span_size(segment))))
+    {
+      return false;
+    }
+
+    expected_text = az_span_slice_to_end(expected_text, az_span_size(segment));
+    bytes_left -= az_span_size(segment);
+  }
+
+  return true;
+}
@@ -0,0 +1,507 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_cbor_private.h"
+#include "az_json_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_cbor.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <float.h>
+#include <string.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_cbor_writer_init(
+    az_cbor_writer* out_cbor_writer,
+    az_span destination_buffer,
+    az_cbor_writer_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_cbor_writer);
+
+  *out_cbor_writer = (az_cbor_writer){
+    .total_bytes_written = 0,
+    ._internal = {
+      .destination_buffer = destination_buffer,
+      .allocator_callback = NULL,
+      .user_context = NULL,
+      .bytes_written = 0,
+      .token_kind = AZ_CBOR_TOKEN_NONE,
+      .bit_stack = { 0 },
+      .options = options == NULL ? az_cbor_writer_options_default() : *options,
+    },
+  };
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_writer_chunked_init(
+    az_cbor_writer* out_cbor_writer,
+    az_span first_destination_buffer,
+    az_span_allocator_fn allocator_callback,
+    void* user_context,
+    az_cbor_writer_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_cbor_writer);
+  _az_PRECONDITION_NOT_NULL(allocator_callback);
+
+  *out_cbor_writer = (az_cbor_writer){
+    .total_bytes_written = 0,
+    ._internal = {
+      .destination_buffer = first_destination_buffer,
+      .allocator_callback = allocator_callback,
+      .user_context = user_context,
+      .bytes_written = 0,
+      .token_kind = AZ_CBOR_TOKEN_NONE,
+      .bit_stack = { 0 },
+      .options = options == NULL ? az_cbor_writer_options_default() : *options,
+    },
+  };
+  return AZ_OK;
+}
+
+static AZ_NODISCARD az_span
+_az_cbor_writer_get_remaining_span(az_cbor_writer* ref_cbor_writer, int32_t required_size)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(required_size > 0);
+
+  az_span remaining = az_span_slice_to_end(
+      ref_cbor_writer->_internal.destination_buffer, ref_cbor_writer->_internal.bytes_written);
+
+  if (az_span_size(remaining) < required_size
+      && ref_cbor_writer->_internal.allocator_callback != NULL)
+  {
+    az_span_allocator_context context = {
+      .user_context = ref_cbor_writer->_internal.user_context,
+      .bytes_used = ref_cbor_writer->_internal.bytes_written,
+      .minimum_required_size = required_size,
+    };
+
+    // No more space left in the destination, let the caller fail with AZ_ERROR_NOT_ENOUGH_SPACE.
+    if (az_result_failed(ref_cbor_writer->_internal.allocator_callback(&context, &remaining)))
+    {
+      return AZ_SPAN_EMPTY;
+    }
+    ref_cbor_writer->_internal.destination_buffer = remaining;
+    ref_cbor_writer->_internal.bytes_written = 0;
+  }
+
+  return remaining;
+}
+
+static void _az_cbor_writer_advance(az_cbor_writer* ref_cbor_writer, int32_t bytes_written)
+{
+  ref_cbor_writer->_internal.bytes_written += bytes_written;
+  ref_cbor_writer->total_bytes_written += bytes_written;
+}
+
+#ifndef AZ_NO_PRECONDITION_CHECKING
+static AZ_NODISCARD bool _az_cbor_is_appending_value_valid(az_cbor_writer const* cbor_writer)
+{
+  az_cbor_token_kind const kind = cbor_writer->_internal.token_kind;
+
+  // Within a map, every value must come after its key. Otherwise, it is only invalid to add more
+  // than one data item outside of any map or array.
+  if (_az_json_stack_peek(&cbor_writer->_internal.bit_stack))
+  {
+    return kind == AZ_CBOR_TOKEN_PROPERTY_NAME;
+  }
+
+  return cbor_writer->_internal.bit_stack._internal.current_depth != 0
+      || kind == AZ_CBOR_TOKEN_NONE;
+}
+
+static AZ_NODISCARD bool _az_cbor_is_appending_property_name_valid(
+    az_cbor_writer const* cbor_writer)
+{
+  // Keys can only be written within a map, and not right after another key.
+  return _az_json_stack_peek(&cbor_writer->_internal.bit_stack)
+      && cbor_writer->_internal.token_kind != AZ_CBOR_TOKEN_PROPERTY_NAME;
+}
+
+static AZ_NODISCARD bool _az_cbor_is_appending_container_end_valid(
+    az_cbor_writer const* cbor_writer,
+    _az_json_stack_item container)
+{
+  // Cannot write the end of a map or array without a matching start, or right after a key.
+  return cbor_writer->_internal.bit_stack._internal.current_depth > 0
+      && cbor_writer->_internal.token_kind != AZ_CBOR_TOKEN_PROPERTY_NAME
+      && _az_json_stack_peek(&cbor_writer->_internal.bit_stack) == container;
+}
+#endif // AZ_NO_PRECONDITION_CHECKING
+
+// Returns the size of the head of a data item (i.e. its initial byte, followed by its argument),
+// which depends on how many bytes are needed to hold the argument.
+AZ_NODISCARD static int32_t _az_cbor_get_head_size(uint64_t argument)
+{
+  if (argument < _az_CBOR_ADDITIONAL_INFO_ONE_BYTE)
+  {
+    return 1;
+  }
+  else if (argument <= UINT8_MAX)
+  {
+    return 2;
+  }
+  else if (argument <= UINT16_MAX)
+  {
+    return 3;
+  }
+  else if (argument <= UINT32_MAX)
+  {
+    return 5;
+  }
+
+  return _az_CBOR_MAX_HEAD_SIZE;
+}
+
+// Writes the head of a data item, with its argument in network byte order, within head_size bytes.
+static az_span _az_cbor_write_head(
+    az_span destination,
+    _az_cbor_major_type major_type,
+    uint64_t argument,
+    int32_t head_size)
+{
+  _az_PRECONDITION_VALID_SPAN(destination, head_size, false);
+
+  uint8_t* head = az_span_ptr(destination);
+  uint8_t additional_info = 0;
+  switch (head_size)
+  {
+    case 1:
+      additional_info = (uint8_t)argument;
+      break;
+    case 2:
+      additional_info = _az_CBOR_ADDITIONAL_INFO_ONE_BYTE;
+      break;
+    case 3:
+      additional_info = _az_CBOR_ADDITIONAL_INFO_TWO_BYTES;
+      break;
+    case 5:
+      additional_info = _az_CBOR_ADDITIONAL_INFO_FOUR_BYTES;
+      break;
+    default:
+      _az_PRECONDITION(head_size == _az_CBOR_MAX_HEAD_SIZE);
+      additional_info = _az_CBOR_ADDITIONAL_INFO_EIGHT_BYTES;
+      break;
+  }
+
+  head[0] = (uint8_t)(((uint32_t)major_type << 5U) | additional_info);
+  for (int32_t i = head_size - 1; i > 0; i--)
+  {
+    head[i] = (uint8_t)argument;
+    argument >>= 8U;
+  }
+
+  return az_span_slice_to_end(destination, head_size);
+}
+
+// Appends a data item which is made of its head alone, i.e. anything other than strings.
+static AZ_NODISCARD az_result _az_cbor_writer_append_head(
+    az_cbor_writer* ref_cbor_writer,
+    _az_cbor_major_type major_type,
+    uint64_t argument,
+    int32_t head_size,
+    az_cbor_token_kind token_kind)
+{
+  az_span remaining = _az_cbor_writer_get_remaining_span(ref_cbor_writer, head_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, head_size);
+
+  _az_cbor_write_head(remaining, major_type, argument, head_size);
+
+  _az_cbor_writer_advance(ref_cbor_writer, head_size);
+  ref_cbor_writer->_internal.token_kind = token_kind;
+  return AZ_OK;
+}
+
+static AZ_NODISCARD az_result _az_cbor_writer_append_string(
+    az_cbor_writer* ref_cbor_writer,
+    _az_cbor_major_type major_type,
+    az_span value,
+    az_cbor_token_kind token_kind)
+{
+  int32_t value_size = az_span_size(value);
+  int32_t const head_size = _az_cbor_get_head_size((uint64_t)value_size);
+
+  // Unless the destination can grow, the whole string must fit, so that nothing is written
+  // otherwise. A large string is instead split across buffers, after its head, which is never
+  // split.
+  int32_t required_size = head_size + value_size;
+  if (ref_cbor_writer->_internal.allocator_callback != NULL
+      && required_size > _az_CBOR_MINIMUM_CHUNK_SIZE)
+  {
+    required_size = _az_CBOR_MINIMUM_CHUNK_SIZE;
+  }
+
+  az_span remaining = _az_cbor_writer_get_remaining_span(ref_cbor_writer, required_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, required_size);
+
+  remaining = _az_cbor_write_head(remaining, major_type, (uint64_t)value_size, head_size);
+  _az_cbor_writer_advance(ref_cbor_writer, head_size);
+
+  while (value_size > 0)
+  {
+    int32_t const fits
+        = az_span_size(remaining) < value_size ? az_span_size(remaining) : value_size;
+    if (fits > 0)
+    {
+      az_span_copy(remaining, az_span_slice(value, 0, fits));
+      _az_cbor_writer_advance(ref_cbor_writer, fits);
+      value = az_span_slice_to_end(value, fits);
+      value_size -= fits;
+    }
+
+    if (value_size > 0)
+    {
+      required_size
+          = value_size < _az_CBOR_MINIMUM_CHUNK_SIZE ? value_size : _az_CBOR_MINIMUM_CHUNK_SIZE;
+      remaining = _az_cbor_writer_get_remaining_span(ref_cbor_writer, required_size);
+      _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, required_size);
+    }
+  }
+
+  ref_cbor_writer->_internal.token_kind = token_kind;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_string(az_cbor_writer* ref_cbor_writer, az_span value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION_VALID_SPAN(value, 0, true);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  return _az_cbor_writer_append_string(
+      ref_cbor_writer, _az_CBOR_MAJOR_TYPE_TEXT_STRING, value, AZ_CBOR_TOKEN_STRING);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_bytes(az_cbor_writer* ref_cbor_writer, az_span value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION_VALID_SPAN(value, 0, true);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  return _az_cbor_writer_append_string(
+      ref_cbor_writer, _az_CBOR_MAJOR_TYPE_BYTE_STRING, value, AZ_CBOR_TOKEN_BYTES);
+}
+
+AZ_NODISCARD az_result
+az_cbor_writer_append_property_name(az_cbor_writer* ref_cbor_writer, az_span name)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION_VALID_SPAN(name, 0, false);
+  _az_PRECONDITION(_az_cbor_is_appending_property_name_valid(ref_cbor_writer));
+
+  return _az_cbor_writer_append_string(
+      ref_cbor_writer, _az_CBOR_MAJOR_TYPE_TEXT_STRING, name, AZ_CBOR_TOKEN_PROPERTY_NAME);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_bool(az_cbor_writer* ref_cbor_writer, bool value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  uint8_t const simple_value = value ? _az_CBOR_TRUE : _az_CBOR_FALSE;
+  return _az_cbor_writer_append_head(
+      ref_cbor_writer,
+      _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT,
+      simple_value & _az_CBOR_ADDITIONAL_INFO_MASK,
+      1,
+      value ? AZ_CBOR_TOKEN_TRUE : AZ_CBOR_TOKEN_FALSE);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_null(az_cbor_writer* ref_cbor_writer)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  return _az_cbor_writer_append_head(
+      ref_cbor_writer,
+      _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT,
+      _az_CBOR_NULL & _az_CBOR_ADDITIONAL_INFO_MASK,
+      1,
+      AZ_CBOR_TOKEN_NULL);
+}
+
+AZ_NODISCARD az_result
+az_cbor_writer_append_uint64(az_cbor_writer* ref_cbor_writer, uint64_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  return _az_cbor_writer_append_head(
+      ref_cbor_writer,
+      _az_CBOR_MAJOR_TYPE_UNSIGNED_INTEGER,
+      value,
+      _az_cbor_get_head_size(value),
+      AZ_CBOR_TOKEN_NUMBER);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_int64(az_cbor_writer* ref_cbor_writer, int64_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  if (value >= 0)
+  {
+    return az_cbor_writer_append_uint64(ref_cbor_writer, (uint64_t)value);
+  }
+
+  // Negative integers are encoded as -1 minus their argument, which can't overflow.
+  uint64_t const argument = (uint64_t)(-(value + 1));
+  return _az_cbor_writer_append_head(
+      ref_cbor_writer,
+      _az_CBOR_MAJOR_TYPE_NEGATIVE_INTEGER,
+      argument,
+      _az_cbor_get_head_size(argument),
+      AZ_CBOR_TOKEN_NUMBER);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_int32(az_cbor_writer* ref_cbor_writer, int32_t value)
+{
+  return az_cbor_writer_append_int64(ref_cbor_writer, value);
+}
+
+// Converts the bits of a single precision floating-point number to half precision, if it can be
+// held exactly.
+AZ_NODISCARD static bool _az_cbor_float_to_half(uint32_t float_bits, uint16_t* out_half_bits)
+{
+  uint16_t const sign = (uint16_t)((float_bits >> 16U) & 0x8000U);
+  int32_t const exponent = (int32_t)((float_bits >> 23U) & 0xFFU) - 127;
+  uint32_t const mantissa = float_bits & 0x7FFFFFU;
+
+  if ((float_bits & 0x7FFFFFFFU) == 0)
+  {
+    *out_half_bits = sign;
+    return true;
+  }
+
+  // Normal half precision numbers keep the 10 high-order bits of the mantissa.
+  if (exponent >= -14 && exponent <= 15)
+  {
+    if ((mantissa & 0x1FFFU) != 0)
+    {
+      return false;
+    }
+
+    *out_half_bits
+        = (uint16_t)(sign | (uint32_t)((exponent + 15) << 10) | (uint16_t)(mantissa >> 13U));
+    return true;
+  }
+
+  // Subnormal half precision numbers are multiples of 2^-24.
+  if (exponent >= -24 && exponent < -14)
+  {
+    uint32_t const significand = mantissa | 0x800000U;
+    uint32_t const shift = (uint32_t)(-1 - exponent);
+    if ((significand & ((1U << shift) - 1U)) != 0)
+    {
+      return false;
+    }
+
+    *out_half_bits = (uint16_t)(sign | (significand >> shift));
+    return true;
+  }
+
+  return false;
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_double(az_cbor_writer* ref_cbor_writer, double value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+  // Non-finite numbers are not supported, for parity with az_json_writer_append_double.
+  _az_PRECONDITION(_az_isfinite(value));
+
+  // Converting a double which is out of the range of float is undefined behavior.
+  float const single = value >= -FLT_MAX && value <= FLT_MAX ? (float)value : 0;
+  double const widened = single;
+
+  // The value fits within a float when converting it back is exact, down to its bits.
+  if (memcmp(&widened, &value, sizeof(value)) == 0)
+  {
+    uint32_t float_bits = 0;
+    memcpy(&float_bits, &single, sizeof(float_bits));
+
+    uint16_t half_bits = 0;
+    if (_az_cbor_float_to_half(float_bits, &half_bits))
+    {
+      return _az_cbor_writer_append_head(
+          ref_cbor_writer, _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT, half_bits, 3, AZ_CBOR_TOKEN_NUMBER);
+    }
+
+    return _az_cbor_writer_append_head(
+        ref_cbor_writer, _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT, float_bits, 5, AZ_CBOR_TOKEN_NUMBER);
+  }
+
+  uint64_t double_bits = 0;
+  memcpy(&double_bits, &value, sizeof(double_bits));
+  return _az_cbor_writer_append_head(
+      ref_cbor_writer,
+      _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT,
+      double_bits,
+      _az_CBOR_MAX_HEAD_SIZE,
+      AZ_CBOR_TOKEN_NUMBER);
+}
+
+static AZ_NODISCARD az_result _az_cbor_writer_append_container_start(
+    az_cbor_writer* ref_cbor_writer,
+    _az_json_stack_item container)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_value_valid(ref_cbor_writer));
+
+  // The reader can't read more nested maps or arrays than that, so neither can they be written.
+  if (ref_cbor_writer->_internal.bit_stack._internal.current_depth >= _az_MAX_CBOR_NESTING_DEPTH)
+  {
+    return AZ_ERROR_JSON_NESTING_OVERFLOW;
+  }
+
+  bool const is_map = container == _az_JSON_STACK_OBJECT;
+  _az_RETURN_IF_FAILED(_az_cbor_writer_append_head(
+      ref_cbor_writer,
+      is_map ? _az_CBOR_MAJOR_TYPE_MAP : _az_CBOR_MAJOR_TYPE_ARRAY,
+      _az_CBOR_ADDITIONAL_INFO_INDEFINITE,
+      1,
+      is_map ? AZ_CBOR_TOKEN_BEGIN_OBJECT : AZ_CBOR_TOKEN_BEGIN_ARRAY));
+
+  _az_json_stack_push(&ref_cbor_writer->_internal.bit_stack, container);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_begin_object(az_cbor_writer* ref_cbor_writer)
+{
+  return _az_cbor_writer_append_container_start(ref_cbor_writer, _az_JSON_STACK_OBJECT);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_begin_array(az_cbor_writer* ref_cbor_writer)
+{
+  return _az_cbor_writer_append_container_start(ref_cbor_writer, _az_JSON_STACK_ARRAY);
+}
+
+static AZ_NODISCARD az_result
+_az_cbor_writer_append_container_end(az_cbor_writer* ref_cbor_writer, _az_json_stack_item container)
+{
+  _az_PRECONDITION_NOT_NULL(ref_cbor_writer);
+  _az_PRECONDITION(_az_cbor_is_appending_container_end_valid(ref_cbor_writer, container));
+
+  // Maps and arrays are written with an indefinite length, which the "break" byte ends.
+  _az_RETURN_IF_FAILED(_az_cbor_writer_append_head(
+      ref_cbor_writer,
+      _az_CBOR_MAJOR_TYPE_SIMPLE_OR_FLOAT,
+      _az_CBOR_ADDITIONAL_INFO_INDEFINITE,
+      1,
+      container == _az_JSON_STACK_OBJECT ? AZ_CBOR_TOKEN_END_OBJECT : AZ_CBOR_TOKEN_END_ARRAY));
+
+  _az_json_stack_pop(&ref_cbor_writer->_internal.bit_stack);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_end_object(az_cbor_writer* ref_cbor_writer)
+{
+  return _az_cbor_writer_append_container_end(ref_cbor_writer, _az_JSON_STACK_OBJECT);
+}
+
+AZ_NODISCARD az_result az_cbor_writer_append_end_array(az_cbor_writer* ref_cbor_writer)
+{
+  return _az_cbor_writer_append_container_end(ref_cbor_writer, _az_JSON_STACK_ARRAY);
+}
@@ -110,14 +110,19 @@ AZ_INLINE AZ_NODISCARD az_result _az_http_policy_retry_get_retry_after(
   *should_retry = true;
 
   // Try to get the value of retry-after header, if there's one.
+  // Each header name is hashed once, and only compared with the names whose hash it matches.
   az_span header_name = { 0 };
   az_span header_value = { 0 };
   while (az_result_succeeded(
       az_http_response_get_next_header(ref_response, &header_name, &header_value)))
   {
-    if (az_span_is_content_equal_ignoring_case(header_name, AZ_SPAN_FROM_STR("retry-after-ms"))
-        || az_span_is_content_equal_ignoring_case(
-            header_name, AZ_SPAN_FROM_STR("x-ms-retry-after-ms")))
+    uint32_t const name_hash = _az_http_header_name_hash(header_name);
+    if ((name_hash == _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER_MS
+         && az_span_is_content_equal_ignoring_case(
+             header_name, AZ_SPAN_FROM_STR("retry-after-ms")))
+        || (name_hash == _az_HTTP_HEADER_NAME_HASH_X_MS_RETRY_AFTER_MS
+            && az_span_is_content_equal_ignoring_case(
+                header_name, AZ_SPAN_FROM_STR("x-ms-retry-after-ms"))))
     {
       // The value is in milliseconds.
       int32_t const msec = _az_uint32_span_to_int32(header_value);
@@ -127,7 +132,9 @@ AZ_INLINE AZ_NODISCARD az_result _az_http_policy_retry_get_retry_after(
         return AZ_OK;
       }
     }
-    else if (az_span_is_content_equal_ignoring_case(header_name, AZ_SPAN_FROM_STR("Retry-After")))
+    else if (
+        name_hash == _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER
+        && az_span_is_content_equal_ignoring_case(header_name, AZ_SPAN_FROM_STR("Retry-After")))
     {
       // The value is either seconds or date.
       int32_t const seconds = _az_uint32_span_to_int32(header_value);
@@ -22,6 +22,7 @@
 #include <azure/core/internal/az_precondition_internal.h>
 
 #include <stdbool.h>
+#include <stdint.h>
 
 #include <azure/core/_az_cfg_prefix.h>
 
@@ -52,6 +53,23 @@ AZ_NODISCARD AZ_INLINE az_result _az_http_request_remove_retry_headers(az_http_r
   return AZ_OK;
 }
 
+// Hashes of the well-known header names that the SDK looks up in responses, as returned by
+// `_az_http_header_name_hash()`. They are precomputed so that a lookup only hashes the name of
+// each received header once, and compares its content only when the hash matches.
+#define _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER 0xC6DA1376U
+#define _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER_MS 0xFFFA2D95U
+#define _az_HTTP_HEADER_NAME_HASH_X_MS_RETRY_AFTER_MS 0x91576D19U
+
+/**
+ * @brief Computes a case-insensitive hash of an HTTP header name.
+ *
+ * @param[in] name The header name. ASCII letters are hashed as lowercase.
+ *
+ * @return The 32-bit FNV-1a hash of \p name. Names that are equal ignoring case have the same hash,
+ * but names with the same hash aren't necessarily equal.
+ */
+AZ_NODISCARD uint32_t _az_http_header_name_hash(az_span name);
+
 /**
  * @brief Sets buffer and parser to its initial state.
  *
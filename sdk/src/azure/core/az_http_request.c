@@ -79,12 +79,24 @@ AZ_NODISCARD az_result az_http_request_set_query_parameter(
   int32_t const initial_url_length = ref_request->_internal.url_length;
   az_span url_remainder = az_span_slice_to_end(ref_request->_internal.url, initial_url_length);
 
-  // Adding query parameter. Adding +2 to required length to include extra required symbols `=`
+  // Adding query parameter. Adding +2 to the name length to include extra required symbols `=`
   // and `?` or `&`.
-  int32_t required_length = 2 + az_span_size(name)
-      + (is_value_url_encoded ? az_span_size(value) : _az_span_url_encode_calc_length(value));
+  int32_t const prefix_length = 2 + az_span_size(name);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(url_remainder, prefix_length);
 
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(url_remainder, required_length);
+  // Parameter value, which is URL-encoded in the same pass that finds out whether it fits.
+  az_span const value_destination = az_span_slice_to_end(url_remainder, prefix_length);
+  int32_t value_length = az_span_size(value);
+  if (is_value_url_encoded)
+  {
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(value_destination, value_length);
+    az_span_copy(value_destination, value);
+  }
+  else
+  {
+    _az_RETURN_IF_FAILED(
+        _az_span_url_encode_and_get_length(value_destination, value, &value_length));
+  }
 
   // Append either '?' or '&'
   uint8_t separator = '&';
@@ -102,18 +114,7 @@ AZ_NODISCARD az_result az_http_request_set_query_parameter(
   // Append equal sym
   url_remainder = az_span_copy_u8(url_remainder, '=');
 
-  // Parameter value
-  if (is_value_url_encoded)
-  {
-    az_span_copy(url_remainder, value);
-  }
-  else
-  {
-    int32_t encoding_size = 0;
-    _az_RETURN_IF_FAILED(_az_span_url_encode(url_remainder, value, &encoding_size));
-  }
-
-  ref_request->_internal.url_length += required_length;
+  ref_request->_internal.url_length += prefix_length + value_length;
 
   return AZ_OK;
 }
@@ -326,6 +326,26 @@ void _az_http_response_reset(az_http_response* ref_response)
   (void)result;
 }
 
+AZ_NODISCARD uint32_t _az_http_header_name_hash(az_span name)
+{
+  uint8_t const* const name_ptr = az_span_ptr(name);
+  int32_t const name_size = az_span_size(name);
+
+  uint32_t hash = 0x811C9DC5U; // FNV-1a offset basis
+  for (int32_t i = 0; i < name_size; i++)
+  {
+    uint8_t c = name_ptr[i];
+    if ((uint8_t)(c - 'A') <= ('Z' - 'A'))
+    {
+      c = (uint8_t)(c + _az_ASCII_LOWER_DIF);
+    }
+
+    hash = (hash ^ c) * 0x01000193U; // FNV-1a prime
+  }
+
+  return hash;
+}
+
 // internal function to get az_http_response remainder
 static az_span _az_http_response_get_remaining(az_http_response const* response)
 {
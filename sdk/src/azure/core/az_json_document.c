@@ -0,0 +1,144 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_json_document_init(
+    az_json_document* out_document,
+    az_span json_buffer,
+    az_json_document_node nodes[],
+    int32_t nodes_length,
+    az_json_reader_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_document);
+  _az_PRECONDITION_VALID_SPAN(json_buffer, 1, false);
+  _az_PRECONDITION_NOT_NULL(nodes);
+  _az_PRECONDITION(nodes_length > 0);
+
+  *out_document = (az_json_document){
+    ._internal = {
+      .nodes = nodes,
+      .number_of_nodes = 0,
+    },
+  };
+
+  az_json_reader reader;
+  _az_RETURN_IF_FAILED(az_json_reader_init(&reader, json_buffer, options));
+
+  // The index of the start of each object or array which hasn't ended yet. The reader fails with
+  // AZ_ERROR_JSON_NESTING_OVERFLOW before this can overflow.
+  int32_t container_start_indices[_az_MAX_JSON_STACK_SIZE];
+  int32_t depth = 0;
+
+  int32_t number_of_nodes = 0;
+  az_result result = AZ_OK;
+  while (az_result_succeeded(result = az_json_reader_next_token(&reader)))
+  {
+    if (number_of_nodes == nodes_length)
+    {
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
+    az_json_token_kind const token_kind = reader.token.kind;
+
+    nodes[number_of_nodes] = (az_json_document_node){
+      .token = reader.token,
+      ._internal = {
+        .end_index = number_of_nodes,
+      },
+    };
+
+    if (token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
+    {
+      container_start_indices[depth++] = number_of_nodes;
+    }
+    else if (token_kind == AZ_JSON_TOKEN_END_OBJECT || token_kind == AZ_JSON_TOKEN_END_ARRAY)
+    {
+      nodes[container_start_indices[--depth]]._internal.end_index = number_of_nodes;
+    }
+
+    number_of_nodes++;
+  }
+
+  // Reading a complete JSON value, followed by nothing but whitespace, is the only way to be done.
+  if (result != AZ_ERROR_JSON_READER_DONE)
+  {
+    return result;
+  }
+
+  out_document->_internal.number_of_nodes = number_of_nodes;
+  return AZ_OK;
+}
+
+AZ_NODISCARD int32_t
+az_json_document_get_next_index(az_json_document const* document, int32_t index)
+{
+  _az_PRECONDITION_NOT_NULL(document);
+  _az_PRECONDITION_RANGE(0, index, document->_internal.number_of_nodes - 1);
+
+  return document->_internal.nodes[index]._internal.end_index + 1;
+}
+
+AZ_NODISCARD az_result az_json_document_get_property(
+    az_json_document const* document,
+    int32_t object_index,
+    az_span name,
+    int32_t* out_value_index)
+{
+  _az_PRECONDITION_NOT_NULL(document);
+  _az_PRECONDITION_RANGE(0, object_index, document->_internal.number_of_nodes - 1);
+  _az_PRECONDITION_NOT_NULL(out_value_index);
+
+  az_json_document_node const* nodes = document->_internal.nodes;
+  _az_PRECONDITION(nodes[object_index].token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT);
+
+  // Each property is made of its name, followed by its value, which may span many nodes.
+  int32_t index = object_index + 1;
+  while (nodes[index].token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    if (az_json_token_is_text_equal(&nodes[index].token, name))
+    {
+      *out_value_index = index + 1;
+      return AZ_OK;
+    }
+
+    index = nodes[index + 1]._internal.end_index + 1;
+  }
+
+  return AZ_ERROR_ITEM_NOT_FOUND;
+}
+
+AZ_NODISCARD az_result az_json_document_get_array_element(
+    az_json_document const* document,
+    int32_t array_index,
+    int32_t position,
+    int32_t* out_element_index)
+{
+  _az_PRECONDITION_NOT_NULL(document);
+  _az_PRECONDITION_RANGE(0, array_index, document->_internal.number_of_nodes - 1);
+  _az_PRECONDITION(position >= 0);
+  _az_PRECONDITION_NOT_NULL(out_element_index);
+
+  az_json_document_node const* nodes = document->_internal.nodes;
+  _az_PRECONDITION(nodes[array_index].token.kind == AZ_JSON_TOKEN_BEGIN_ARRAY);
+
+  int32_t index = array_index + 1;
+  for (int32_t i = 0; i < position && nodes[index].token.kind != AZ_JSON_TOKEN_END_ARRAY; i++)
+  {
+    index = nodes[index]._internal.end_index + 1;
+  }
+
+  if (nodes[index].token.kind == AZ_JSON_TOKEN_END_ARRAY)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  *out_element_index = index;
+  return AZ_OK;
+}
@@ -0,0 +1,255 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result az_json_path_set_init(
+    az_json_path_set* out_path_set,
+    az_span const paths[],
+    int32_t number_of_paths)
+{
+  _az_PRECONDITION_NOT_NULL(out_path_set);
+  _az_PRECONDITION_NOT_NULL(paths);
+  _az_PRECONDITION_RANGE(1, number_of_paths, AZ_JSON_PATH_SET_MAX_PATHS);
+
+  *out_path_set = (az_json_path_set){
+    ._internal = {
+      .paths = paths,
+      .number_of_paths = number_of_paths,
+      .paths_ending_at_depth = { 0 },
+    },
+  };
+
+  for (int32_t i = 0; i < number_of_paths; i++)
+  {
+    uint8_t const* path = az_span_ptr(paths[i]);
+    int32_t const path_size = az_span_size(paths[i]);
+    int32_t depth = 0;
+
+    if (path_size > 0 && path[0] != '/')
+    {
+      return AZ_ERROR_ARG;
+    }
+
+    for (int32_t j = 0; j < path_size; j++)
+    {
+      if (path[j] == '/')
+      {
+        depth++;
+      }
+      else if (path[j] == '~')
+      {
+        // Property names which contain '/' or '~' are not supported.
+        return AZ_ERROR_NOT_SUPPORTED;
+      }
+    }
+
+    if (depth > AZ_JSON_PATH_SET_MAX_DEPTH)
+    {
+      return AZ_ERROR_NOT_SUPPORTED;
+    }
+
+    out_path_set->_internal.paths_ending_at_depth[depth] |= 1U << (uint32_t)i;
+  }
+
+  return AZ_OK;
+}
+
+// Returns the reference token of path at depth (i.e. the text after the depth + 1'th '/'), which
+// the caller guarantees to exist.
+AZ_NODISCARD static az_span _az_json_path_get_segment(az_span path, int32_t depth)
+{
+  uint8_t const* path_ptr = az_span_ptr(path);
+  int32_t const path_size = az_span_size(path);
+
+  // Skip the leading '/', and then the previous reference tokens.
+  int32_t start = 1;
+  for (int32_t i = 0; i < depth; i++)
+  {
+    while (path_ptr[start] != '/')
+    {
+      start++;
+    }
+    start++;
+  }
+
+  int32_t end = start;
+  while (end < path_size && path_ptr[end] != '/')
+  {
+    end++;
+  }
+
+  return az_span_slice(path, start, end);
+}
+
+// Returns the subset of candidates whose reference token at depth matches the current token, which
+// is either a property name, or an array element at array_index.
+AZ_NODISCARD static uint32_t _az_json_path_set_match(
+    az_json_path_set const* path_set,
+    uint32_t candidates,
+    int32_t depth,
+    az_json_token const* property_name,
+    int32_t array_index)
+{
+  uint32_t matches = 0;
+
+  for (int32_t i = 0; i < path_set->_internal.number_of_paths; i++)
+  {
+    uint32_t const path_bit = 1U << (uint32_t)i;
+    if ((candidates & path_bit) == 0)
+    {
+      continue;
+    }
+
+    az_span const segment = _az_json_path_get_segment(path_set->_internal.paths[i], depth);
+
+    if (property_name != NULL)
+    {
+      if (az_json_token_is_text_equal(property_name, segment))
+      {
+        matches |= path_bit;
+      }
+    }
+    else
+    {
+      // Array indices are only made of digits, without leading zeros (other than the index 0).
+      uint8_t const first_digit = az_span_size(segment) > 0 ? az_span_ptr(segment)[0] : 0;
+      int32_t index = 0;
+      if (first_digit >= '0' && first_digit <= '9'
+          && (first_digit != '0' || az_span_size(segment) == 1)
+          && az_result_succeeded(az_span_atoi32(segment, &index)) && index == array_index)
+      {
+        matches |= path_bit;
+      }
+    }
+  }
+
+  return matches;
+}
+
+AZ_NODISCARD az_result az_json_reader_find_paths(
+    az_json_reader* ref_json_reader,
+    az_json_path_set const* path_set,
+    az_json_token out_tokens[])
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_reader);
+  _az_PRECONDITION_NOT_NULL(path_set);
+  _az_PRECONDITION_NOT_NULL(out_tokens);
+
+  int32_t const number_of_paths = path_set->_internal.number_of_paths;
+  uint32_t const* paths_ending_at_depth = path_set->_internal.paths_ending_at_depth;
+
+  for (int32_t i = 0; i < number_of_paths; i++)
+  {
+    out_tokens[i] = _az_JSON_TOKEN_DEFAULT;
+  }
+
+  if (ref_json_reader->token.kind == AZ_JSON_TOKEN_NONE
+      || ref_json_reader->token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  }
+
+  uint32_t const all_paths = number_of_paths == AZ_JSON_PATH_SET_MAX_PATHS
+      ? UINT32_MAX
+      : (1U << (uint32_t)number_of_paths) - 1U;
+
+  // Empty paths refer to the value the reader is on.
+  uint32_t found = paths_ending_at_depth[0];
+  for (int32_t i = 0; i < number_of_paths; i++)
+  {
+    if ((found & (1U << (uint32_t)i)) != 0)
+    {
+      out_tokens[i] = ref_json_reader->token;
+    }
+  }
+
+  az_json_token_kind token_kind = ref_json_reader->token.kind;
+  if (found == all_paths
+      || (token_kind != AZ_JSON_TOKEN_BEGIN_OBJECT && token_kind != AZ_JSON_TOKEN_BEGIN_ARRAY))
+  {
+    return AZ_OK;
+  }
+
+  // For each level of nesting below the starting value, the paths that could still be found
+  // within the current container, and the index of the next element if that container is an array.
+  uint32_t candidates[AZ_JSON_PATH_SET_MAX_DEPTH] = { 0 };
+  int32_t array_indices[AZ_JSON_PATH_SET_MAX_DEPTH] = { 0 };
+  int32_t depth = 0;
+  candidates[0] = all_paths & ~found;
+
+  while (true)
+  {
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    token_kind = ref_json_reader->token.kind;
+
+    if (token_kind == AZ_JSON_TOKEN_END_OBJECT || token_kind == AZ_JSON_TOKEN_END_ARRAY)
+    {
+      if (depth == 0)
+      {
+        return AZ_OK;
+      }
+
+      depth--;
+      continue;
+    }
+
+    uint32_t matches = 0;
+    if (token_kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+    {
+      matches = _az_json_path_set_match(
+          path_set, candidates[depth] & ~found, depth, &ref_json_reader->token, 0);
+
+      // Move to the property value.
+      _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+      token_kind = ref_json_reader->token.kind;
+    }
+    else
+    {
+      // Outside of property values, which are read along with their name, this must be an element
+      // of an array.
+      matches = _az_json_path_set_match(
+          path_set, candidates[depth] & ~found, depth, NULL, array_indices[depth]++);
+    }
+
+    uint32_t const completed = matches & paths_ending_at_depth[depth + 1];
+    if (completed != 0)
+    {
+      for (int32_t i = 0; i < number_of_paths; i++)
+      {
+        if ((completed & (1U << (uint32_t)i)) != 0)
+        {
+          out_tokens[i] = ref_json_reader->token;
+        }
+      }
+
+      found |= completed;
+      if (found == all_paths)
+      {
+        return AZ_OK;
+      }
+    }
+
+    if (token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
+    {
+      uint32_t const remaining = matches & ~completed;
+      if (remaining == 0)
+      {
+        _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_json_reader));
+      }
+      else
+      {
+        // The remaining paths have more than depth + 1 reference tokens, so this can't overflow.
+        depth++;
+        candidates[depth] = remaining;
+        array_indices[depth] = 0;
+      }
+    }
+  }
+}
@@ -52,6 +52,9 @@ enum
   // [-][0-9]{16}.[0-9]{15}, i.e. 1+16+1+15 since _az_MAX_SUPPORTED_FRACTIONAL_DIGITS is 15
   _az_MAX_SIZE_FOR_WRITING_DOUBLE = 33,
 
+  // [-]0.00000[0-9]{17}, i.e. 1+7+17, is the longest output of az_span_dtoa_round_trip
+  _az_MAX_SIZE_FOR_WRITING_DOUBLE_ROUND_TRIP = 25,
+
   // When writing large JSON strings in chunks, ask for at least 64 bytes, to avoid writing one
   // character at a time.
   // This value should be between 12 and 512 (inclusive).
@@ -138,6 +141,38 @@ AZ_NODISCARD AZ_INLINE bool _az_is_valid_escaped_character(uint8_t byte)
   }
 }
 
+/**
+ * @brief Returns the number of leading bytes within \p json_string that can be copied as-is within
+ * a JSON string, i.e. the index of the first quote, backslash, or control character (or \p size if
+ * there are none).
+ *
+ * @param[in] json_string A pointer to the bytes to scan.
+ * @param[in] size The number of bytes available at \p json_string.
+ */
+AZ_NODISCARD int32_t _az_json_string_scan(uint8_t const* json_string, int32_t size);
+
+/**
+ * @brief Returns the length of the JSON string within \p value after it has been escaped.
+ *
+ * @param[in] value The UTF-8 encoded string to be escaped.
+ * @param[out] out_index_of_first_escaped_char The index of the first character that needs to be
+ * escaped, or -1 if there are none.
+ * @param[in] break_on_first_escaped Whether to return as soon as the first character that needs to
+ * be escaped is found.
+ */
+int32_t _az_json_writer_escaped_length(
+    az_span value,
+    int32_t* out_index_of_first_escaped_char,
+    bool break_on_first_escaped);
+
+/**
+ * @brief Escapes \p source, which must not be empty, while copying it into \p destination, which
+ * the caller guarantees to be large enough.
+ *
+ * @return The remainder of \p destination, after the escaped string.
+ */
+AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination, az_span source);
+
 #include <azure/core/_az_cfg_suffix.h>
 
 #endif // _az_SPAN_PRIVATE_H
@@ -0,0 +1,176 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+AZ_NODISCARD az_result
+az_json_push_reader_init(az_json_push_reader* out_json_push_reader, az_span carry_buffer)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_push_reader);
+  _az_PRECONDITION_VALID_SPAN(carry_buffer, 1, false);
+
+  *out_json_push_reader = (az_json_push_reader){
+    .token = _az_JSON_TOKEN_DEFAULT,
+    .current_depth = 0,
+    ._internal = {
+      .carry_buffer = carry_buffer,
+      .carry_start = 0,
+      .carry_size = 0,
+      .input = AZ_SPAN_EMPTY,
+      .input_consumed = 0,
+      .is_final_input = false,
+    },
+  };
+
+  // The reader can't be initialized with an empty buffer. Either way, its buffer is replaced by
+  // the JSON text available each time a token is read.
+  return az_json_reader_init(&out_json_push_reader->_internal.reader, carry_buffer, NULL);
+}
+
+AZ_NODISCARD az_result az_json_push_reader_feed(
+    az_json_push_reader* ref_json_push_reader,
+    az_span json_fragment,
+    bool is_final_fragment)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_push_reader);
+  _az_PRECONDITION_VALID_SPAN(json_fragment, 0, true);
+
+  // Replacing a fragment which hasn't been read in full would lose part of the JSON text.
+  if (ref_json_push_reader->_internal.is_final_input
+      || ref_json_push_reader->_internal.input_consumed
+          < az_span_size(ref_json_push_reader->_internal.input))
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  ref_json_push_reader->_internal.input = json_fragment;
+  ref_json_push_reader->_internal.input_consumed = 0;
+  ref_json_push_reader->_internal.is_final_input = is_final_fragment;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_push_reader_next_token(az_json_push_reader* ref_json_push_reader)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_push_reader);
+
+  az_span const input = ref_json_push_reader->_internal.input;
+  int32_t const input_size = az_span_size(input);
+  int32_t const input_consumed = ref_json_push_reader->_internal.input_consumed;
+  int32_t const carry_size = ref_json_push_reader->_internal.carry_size;
+  az_span const carry_buffer = ref_json_push_reader->_internal.carry_buffer;
+
+  az_span json = AZ_SPAN_EMPTY;
+  int32_t appended = 0;
+
+  if (carry_size == 0)
+  {
+    // Whitespace in between tokens is skipped here, so that it is never carried over.
+    json = _az_span_trim_whitespace_from_start(az_span_slice_to_end(input, input_consumed));
+    ref_json_push_reader->_internal.input_consumed = input_size - az_span_size(json);
+
+    if (az_span_size(json) == 0 && !ref_json_push_reader->_internal.is_final_input)
+    {
+      return AZ_ERROR_JSON_READER_NEED_MORE_INPUT;
+    }
+  }
+  else
+  {
+    // Move the start of the split token to the front of the carry-over buffer (which invalidates
+    // the previous token), and append as much of the current fragment as fits after it. The
+    // appended bytes are only consumed from the fragment once it is known how many were read.
+    int32_t const carry_start = ref_json_push_reader->_internal.carry_start;
+    if (carry_start > 0)
+    {
+      az_span_copy(
+          carry_buffer, az_span_slice(carry_buffer, carry_start, carry_start + carry_size));
+      ref_json_push_reader->_internal.carry_start = 0;
+    }
+
+    appended = az_span_size(carry_buffer) - carry_size;
+    if (appended > input_size - input_consumed)
+    {
+      appended = input_size - input_consumed;
+    }
+
+    az_span_copy(
+        az_span_slice_to_end(carry_buffer, carry_size),
+        az_span_slice(input, input_consumed, input_consumed + appended));
+    json = az_span_slice(carry_buffer, 0, carry_size + appended);
+  }
+
+  // Whether the JSON text to read ends where the final fragment does, in which case reaching its
+  // end isn't due to a token being split across fragments.
+  bool const is_rest_of_json = ref_json_push_reader->_internal.is_final_input
+      && (carry_size == 0 || input_consumed + appended == input_size);
+
+  az_json_reader* reader = &ref_json_push_reader->_internal.reader;
+  az_json_reader const previous_reader = *reader;
+  reader->_internal.json_buffer = json;
+  reader->_internal.bytes_consumed = 0;
+
+  az_result const result = az_json_reader_next_token(reader);
+  int32_t const read = reader->_internal.bytes_consumed;
+
+  // Within an object or array, any token which reaches the end of the JSON text is reported as an
+  // unexpected end, including numbers, since the byte that follows is needed to know where they
+  // end. A single number, outside of any object or array, ends with the JSON text instead.
+  bool const is_split = result == AZ_ERROR_UNEXPECTED_END
+      || (az_result_succeeded(result) && reader->token.kind == AZ_JSON_TOKEN_NUMBER
+          && read == az_span_size(json));
+
+  if (is_split && !is_rest_of_json)
+  {
+    // Read the token again, from the start, once more of the JSON text is available.
+    *reader = previous_reader;
+
+    if (carry_size == 0)
+    {
+      _az_RETURN_IF_NOT_ENOUGH_SIZE(carry_buffer, az_span_size(json));
+      az_span_copy(carry_buffer, json);
+      ref_json_push_reader->_internal.carry_start = 0;
+      ref_json_push_reader->_internal.carry_size = az_span_size(json);
+    }
+    else
+    {
+      // The carry-over buffer is full, but the token continues within the current fragment.
+      if (input_consumed + appended < input_size)
+      {
+        return AZ_ERROR_NOT_ENOUGH_SPACE;
+      }
+
+      ref_json_push_reader->_internal.carry_size += appended;
+    }
+
+    ref_json_push_reader->_internal.input_consumed = input_size;
+    return AZ_ERROR_JSON_READER_NEED_MORE_INPUT;
+  }
+
+  _az_RETURN_IF_FAILED(result);
+
+  if (carry_size == 0)
+  {
+    ref_json_push_reader->_internal.input_consumed += read;
+  }
+  else if (read >= carry_size)
+  {
+    // The token ends within the bytes appended from the current fragment.
+    ref_json_push_reader->_internal.input_consumed += read - carry_size;
+    ref_json_push_reader->_internal.carry_size = 0;
+  }
+  else
+  {
+    ref_json_push_reader->_internal.carry_start = read;
+    ref_json_push_reader->_internal.carry_size = carry_size - read;
+  }
+
+  ref_json_push_reader->token = reader->token;
+  ref_json_push_reader->current_depth = reader->current_depth;
+  return AZ_OK;
+}
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "az_json_private.h"
+#include "az_simd_private.h"
 #include "az_span_private.h"
 #include <azure/core/az_precondition.h>
 #include <azure/core/internal/az_result_internal.h>
@@ -11,6 +12,211 @@
 
 #include <azure/core/_az_cfg.h>
 
+enum
+{
+  // The number of bytes classified at once when building the structural index.
+  _az_JSON_STRUCTURAL_BLOCK_SIZE = 64,
+};
+
+// The state carried from one block to the next while building the structural index.
+typedef struct
+{
+  int32_t* index;
+  int32_t capacity;
+  int32_t count;
+  bool is_in_string;
+  bool is_escaped;
+  bool previous_is_separator;
+} _az_json_structural_index_state;
+
+AZ_NODISCARD AZ_INLINE bool _az_json_is_structural_character(uint8_t byte)
+{
+  switch (byte)
+  {
+    case '{':
+    case '}':
+    case '[':
+    case ']':
+    case ':':
+    case ',':
+      return true;
+    default:
+      return false;
+  }
+}
+
+AZ_NODISCARD static bool _az_json_structural_index_append(
+    _az_json_structural_index_state* ref_state,
+    int32_t offset)
+{
+  if (ref_state->count >= ref_state->capacity)
+  {
+    return false;
+  }
+
+  ref_state->index[ref_state->count++] = offset;
+  return true;
+}
+
+// Indexes the structural characters ({}[]:,), the opening quote of each string, and the first byte
+// of every other token (a number or a literal) that follows whitespace or a structural character,
+// ignoring anything found within a string.
+AZ_NODISCARD static bool _az_json_structural_index_scan(
+    _az_json_structural_index_state* ref_state,
+    uint8_t const* json,
+    int32_t start,
+    int32_t end)
+{
+  for (int32_t i = start; i < end; i++)
+  {
+    uint8_t const next_byte = json[i];
+    bool const is_structural = _az_json_is_structural_character(next_byte);
+
+    if (ref_state->is_in_string)
+    {
+      if (ref_state->is_escaped)
+      {
+        ref_state->is_escaped = false;
+      }
+      else if (next_byte == '\\')
+      {
+        ref_state->is_escaped = true;
+      }
+      else if (next_byte == '"')
+      {
+        ref_state->is_in_string = false;
+      }
+    }
+    else if (
+        next_byte == '"' || is_structural
+        || (ref_state->previous_is_separator && !_az_is_whitespace(next_byte)))
+    {
+      ref_state->is_in_string = next_byte == '"';
+      if (!_az_json_structural_index_append(ref_state, i))
+      {
+        return false;
+      }
+    }
+
+    ref_state->previous_is_separator = is_structural || _az_is_whitespace(next_byte);
+  }
+
+  return true;
+}
+
+#ifdef _az_SIMD_ENABLED
+// Returns a mask where each bit is set if there is an odd number of bits set in mask at or before
+// that position, i.e. it marks the opening quote and the contents of each string, given a mask of
+// the quotes.
+AZ_NODISCARD AZ_INLINE uint64_t _az_json_prefix_xor(uint64_t mask)
+{
+  mask ^= mask << 1U;
+  mask ^= mask << 2U;
+  mask ^= mask << 4U;
+  mask ^= mask << 8U;
+  mask ^= mask << 16U;
+  mask ^= mask << 32U;
+  return mask;
+}
+
+AZ_NODISCARD static bool _az_json_structural_index_scan_block(
+    _az_json_structural_index_state* ref_state,
+    uint8_t const* json,
+    int32_t offset)
+{
+  uint64_t quotes = 0;
+  uint64_t backslashes = 0;
+  uint64_t whitespace = 0;
+  uint64_t structurals = 0;
+
+  for (int32_t i = 0; i < _az_JSON_STRUCTURAL_BLOCK_SIZE; i += _az_SIMD_BLOCK_SIZE)
+  {
+    _az_simd_vector const block = _az_simd_load(json + offset + i);
+    _az_simd_vector const is_whitespace = _az_simd_or(
+        _az_simd_or(
+            _az_simd_eq(block, _az_simd_splat(' ')), _az_simd_eq(block, _az_simd_splat('\t'))),
+        _az_simd_or(
+            _az_simd_eq(block, _az_simd_splat('\n')), _az_simd_eq(block, _az_simd_splat('\r'))));
+    _az_simd_vector const is_structural = _az_simd_or(
+        _az_simd_or(
+            _az_simd_or(
+                _az_simd_eq(block, _az_simd_splat('{')), _az_simd_eq(block, _az_simd_splat('}'))),
+            _az_simd_or(
+                _az_simd_eq(block, _az_simd_splat('[')), _az_simd_eq(block, _az_simd_splat(']')))),
+        _az_simd_or(
+            _az_simd_eq(block, _az_simd_splat(':')), _az_simd_eq(block, _az_simd_splat(','))));
+
+    uint32_t const shift = (uint32_t)i;
+    quotes |= (uint64_t)_az_simd_mask(_az_simd_eq(block, _az_simd_splat('"'))) << shift;
+    backslashes |= (uint64_t)_az_simd_mask(_az_simd_eq(block, _az_simd_splat('\\'))) << shift;
+    whitespace |= (uint64_t)_az_simd_mask(is_whitespace) << shift;
+    structurals |= (uint64_t)_az_simd_mask(is_structural) << shift;
+  }
+
+  // Escaped characters are rare, so let the scalar scan deal with them, rather than tracking runs
+  // of backslashes across the block.
+  if (backslashes != 0 || ref_state->is_escaped)
+  {
+    return _az_json_structural_index_scan(
+        ref_state, json, offset, offset + _az_JSON_STRUCTURAL_BLOCK_SIZE);
+  }
+
+  uint64_t const in_string
+      = _az_json_prefix_xor(quotes) ^ (ref_state->is_in_string ? UINT64_MAX : 0);
+  uint64_t const separators = whitespace | structurals;
+  uint64_t const follows_separator
+      = (separators << 1U) | (ref_state->previous_is_separator ? 1U : 0U);
+
+  uint64_t found = ((structurals | (~(separators | quotes) & follows_separator)) & ~in_string)
+      | (quotes & in_string);
+
+  ref_state->is_in_string = (in_string >> 63U) != 0;
+  ref_state->previous_is_separator = (separators >> 63U) != 0;
+
+  while (found != 0)
+  {
+    if (!_az_json_structural_index_append(ref_state, offset + _az_ctz64(found)))
+    {
+      return false;
+    }
+    found &= found - 1;
+  }
+
+  return true;
+}
+#endif // _az_SIMD_ENABLED
+
+static void _az_json_reader_build_structural_index(az_json_reader* ref_json_reader)
+{
+  _az_json_structural_index_state state = {
+    .index = ref_json_reader->_internal.options.structural_index,
+    .capacity = ref_json_reader->_internal.options.structural_index_length,
+    .count = 0,
+    .is_in_string = false,
+    .is_escaped = false,
+    .previous_is_separator = true,
+  };
+
+  uint8_t const* json = az_span_ptr(ref_json_reader->_internal.json_buffer);
+  int32_t const size = az_span_size(ref_json_reader->_internal.json_buffer);
+  int32_t offset = 0;
+
+#ifdef _az_SIMD_ENABLED
+  for (; offset <= size - _az_JSON_STRUCTURAL_BLOCK_SIZE; offset += _az_JSON_STRUCTURAL_BLOCK_SIZE)
+  {
+    if (!_az_json_structural_index_scan_block(&state, json, offset))
+    {
+      return;
+    }
+  }
+#endif // _az_SIMD_ENABLED
+
+  if (_az_json_structural_index_scan(&state, json, offset, size))
+  {
+    ref_json_reader->_internal.structural_index_count = state.count;
+  }
+}
+
 AZ_NODISCARD az_result az_json_reader_init(
     az_json_reader* out_json_reader,
     az_span json_buffer,
@@ -44,8 +250,17 @@ AZ_NODISCARD az_result az_json_reader_init(
       .is_complex_json = false,
       .bit_stack = { 0 },
       .options = options == NULL ? az_json_reader_options_default() : *options,
+      .structural_index_count = 0,
+      .structural_index_position = 0,
     },
   };
+
+  if (out_json_reader->_internal.options.structural_index != NULL
+      && out_json_reader->_internal.options.structural_index_length > 0)
+  {
+    _az_json_reader_build_structural_index(out_json_reader);
+  }
+
   return AZ_OK;
 }
 
@@ -85,6 +300,8 @@ AZ_NODISCARD az_result az_json_reader_chunked_init(
       .is_complex_json = false,
       .bit_stack = { 0 },
       .options = options == NULL ? az_json_reader_options_default() : *options,
+      .structural_index_count = 0,
+      .structural_index_position = 0,
     },
   };
   return AZ_OK;
@@ -174,8 +391,47 @@ AZ_NODISCARD static az_result _az_json_reader_get_next_buffer(
   return AZ_OK;
 }
 
+AZ_NODISCARD static az_span _az_json_reader_skip_whitespace_using_index(
+    az_json_reader* ref_json_reader)
+{
+  az_span remaining = _get_remaining_json(ref_json_reader);
+
+  if (az_span_size(remaining) < 1 || !_az_is_whitespace(az_span_ptr(remaining)[0]))
+  {
+    return remaining;
+  }
+
+  int32_t const* index = ref_json_reader->_internal.options.structural_index;
+  int32_t const count = ref_json_reader->_internal.structural_index_count;
+  int32_t const current_offset = ref_json_reader->_internal.bytes_consumed;
+  int32_t position = ref_json_reader->_internal.structural_index_position;
+
+  // The reader only moves forward, so the offsets that are behind it can be dropped for good.
+  while (position < count && index[position] <= current_offset)
+  {
+    position++;
+  }
+  ref_json_reader->_internal.structural_index_position = position;
+
+  // Outside of a string, any non-whitespace byte that follows whitespace is indexed, so everything
+  // up to the next offset (or the end of the JSON, if there are none left) must be whitespace.
+  int32_t const next_offset
+      = position < count ? index[position] : current_offset + az_span_size(remaining);
+  int32_t const consumed = next_offset - current_offset;
+
+  ref_json_reader->_internal.bytes_consumed += consumed;
+  ref_json_reader->_internal.total_bytes_consumed += consumed;
+
+  return az_span_slice_to_end(remaining, consumed);
+}
+
 AZ_NODISCARD static az_span _az_json_reader_skip_whitespace(az_json_reader* ref_json_reader)
 {
+  if (ref_json_reader->_internal.structural_index_count > 0)
+  {
+    return _az_json_reader_skip_whitespace_using_index(ref_json_reader);
+  }
+
   az_span json;
   az_span remaining = _get_remaining_json(ref_json_reader);
 
@@ -237,10 +493,46 @@ AZ_NODISCARD static az_result _az_json_reader_process_container_start(
   return AZ_OK;
 }
 
+AZ_NODISCARD int32_t _az_json_string_scan(uint8_t const* json_string, int32_t size)
+{
+  int32_t index = 0;
+
+#ifdef _az_SIMD_ENABLED
+  _az_simd_vector const quote = _az_simd_splat('"');
+  _az_simd_vector const backslash = _az_simd_splat('\\');
+  _az_simd_vector const last_control_character = _az_simd_splat(_az_ASCII_SPACE_CHARACTER - 1);
+
+  for (; index <= size - _az_SIMD_BLOCK_SIZE; index += _az_SIMD_BLOCK_SIZE)
+  {
+    _az_simd_vector const block = _az_simd_load(json_string + index);
+    uint32_t const mask = _az_simd_mask(_az_simd_or(
+        _az_simd_or(_az_simd_eq(block, quote), _az_simd_eq(block, backslash)),
+        _az_simd_le(block, last_control_character)));
+
+    if (mask != 0)
+    {
+      return index + _az_ctz32(mask);
+    }
+  }
+#endif // _az_SIMD_ENABLED
+
+  for (; index < size; index++)
+  {
+    uint8_t const next_byte = json_string[index];
+    if (next_byte == '"' || next_byte == '\\' || next_byte < _az_ASCII_SPACE_CHARACTER)
+    {
+      break;
+    }
+  }
+
+  return index;
+}
+
 AZ_NODISCARD static az_result _az_json_reader_process_string(az_json_reader* ref_json_reader)
 {
   // Move past the first '"' character
   ref_json_reader->_internal.bytes_consumed++;
+  ref_json_reader->_internal.total_bytes_consumed++;
 
   az_span token = _get_remaining_json(ref_json_reader);
   int32_t remaining_size = az_span_size(token);
@@ -325,6 +617,13 @@ AZ_NODISCARD static az_result _az_json_reader_process_string(az_json_reader* ref
       {
         return AZ_ERROR_UNEXPECTED_CHAR;
       }
+
+      // Skip over the run of regular characters that follow, within the current buffer, so that
+      // only the next quote, backslash, or control character is processed byte by byte.
+      int32_t const run_length = _az_json_string_scan(
+          token_ptr + current_index + 1, remaining_size - current_index - 1);
+      current_index += run_length;
+      string_length += run_length;
     }
 
     current_index++;
@@ -833,6 +1132,7 @@ AZ_NODISCARD static az_result _az_json_reader_process_next_byte(
   if (next_byte == ',')
   {
     ref_json_reader->_internal.bytes_consumed++;
+    ref_json_reader->_internal.total_bytes_consumed++;
 
     az_span json = _az_json_reader_skip_whitespace(ref_json_reader);
 
@@ -943,6 +1243,209 @@ AZ_NODISCARD az_result az_json_reader_next_token(az_json_reader* ref_json_reader
   }
 }
 
+// Returns the number of leading bytes within json that are neither a quote nor a bracket.
+AZ_NODISCARD static int32_t _az_json_container_scan(uint8_t const* json, int32_t size)
+{
+  int32_t index = 0;
+
+#ifdef _az_SIMD_ENABLED
+  // Setting the 0x20 bit maps '[' (0x5B) to '{' (0x7B) and ']' (0x5D) to '}' (0x7D), while no other
+  // bytes map to either.
+  _az_simd_vector const case_bit = _az_simd_splat(0x20);
+  _az_simd_vector const quote = _az_simd_splat('"');
+  _az_simd_vector const open_brace = _az_simd_splat('{');
+  _az_simd_vector const close_brace = _az_simd_splat('}');
+
+  for (; index <= size - _az_SIMD_BLOCK_SIZE; index += _az_SIMD_BLOCK_SIZE)
+  {
+    _az_simd_vector const block = _az_simd_load(json + index);
+    _az_simd_vector const folded = _az_simd_or(block, case_bit);
+    uint32_t const mask = _az_simd_mask(_az_simd_or(
+        _az_simd_eq(block, quote),
+        _az_simd_or(_az_simd_eq(folded, open_brace), _az_simd_eq(folded, close_brace))));
+
+    if (mask != 0)
+    {
+      return index + _az_ctz32(mask);
+    }
+  }
+#endif // _az_SIMD_ENABLED
+
+  for (; index < size; index++)
+  {
+    uint8_t const next_byte = json[index];
+    if (next_byte == '"' || next_byte == '{' || next_byte == '}' || next_byte == '['
+        || next_byte == ']')
+    {
+      break;
+    }
+  }
+
+  return index;
+}
+
+// Pushes or pops the bit stack for a bracket found while skipping children, and returns
+// AZ_ERROR_JSON_READER_DONE once the bracket closing the container at depth is found.
+AZ_NODISCARD static az_result _az_json_reader_skip_bracket(
+    az_json_reader* ref_json_reader,
+    uint8_t bracket,
+    int32_t depth)
+{
+  _az_json_bit_stack* bit_stack = &ref_json_reader->_internal.bit_stack;
+
+  if (bracket == '{' || bracket == '[')
+  {
+    if (bit_stack->_internal.current_depth >= _az_MAX_JSON_STACK_SIZE)
+    {
+      return AZ_ERROR_JSON_NESTING_OVERFLOW;
+    }
+
+    _az_json_stack_push(
+        bit_stack, bracket == '{' ? _az_JSON_STACK_OBJECT : _az_JSON_STACK_ARRAY);
+    return AZ_OK;
+  }
+
+  if (_az_json_stack_peek(bit_stack)
+      != (bracket == '}' ? _az_JSON_STACK_OBJECT : _az_JSON_STACK_ARRAY))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  // Leave the matching end of the container for _az_json_reader_process_container_end.
+  if (bit_stack->_internal.current_depth == depth)
+  {
+    return AZ_ERROR_JSON_READER_DONE;
+  }
+
+  _az_json_stack_pop(bit_stack);
+  return AZ_OK;
+}
+
+// Moves the reader to the matching end of the current container using the structural index, which
+// contains every bracket outside of a string.
+AZ_NODISCARD static az_result _az_json_reader_skip_children_using_index(
+    az_json_reader* ref_json_reader)
+{
+  int32_t const* index = ref_json_reader->_internal.options.structural_index;
+  int32_t const count = ref_json_reader->_internal.structural_index_count;
+  int32_t const depth = ref_json_reader->_internal.bit_stack._internal.current_depth;
+  int32_t const start_offset = ref_json_reader->_internal.bytes_consumed;
+  uint8_t const* json = az_span_ptr(ref_json_reader->_internal.json_buffer);
+
+  for (int32_t position = ref_json_reader->_internal.structural_index_position; position < count;
+       position++)
+  {
+    int32_t const offset = index[position];
+    uint8_t const next_byte = json[offset];
+
+    if (offset < start_offset
+        || (next_byte != '{' && next_byte != '}' && next_byte != '[' && next_byte != ']'))
+    {
+      continue;
+    }
+
+    az_result const result = _az_json_reader_skip_bracket(ref_json_reader, next_byte, depth);
+    if (result == AZ_ERROR_JSON_READER_DONE)
+    {
+      ref_json_reader->_internal.structural_index_position = position;
+      ref_json_reader->_internal.bytes_consumed = offset;
+      ref_json_reader->_internal.total_bytes_consumed += offset - start_offset;
+      return AZ_OK;
+    }
+    _az_RETURN_IF_FAILED(result);
+  }
+
+  return AZ_ERROR_UNEXPECTED_END;
+}
+
+// Moves the reader to the matching end of the current container, only keeping track of whether it
+// is within a string, and of the nesting of objects and arrays.
+AZ_NODISCARD static az_result _az_json_reader_skip_children_fast(az_json_reader* ref_json_reader)
+{
+  // Clear the internal state of any previous token.
+  ref_json_reader->token._internal.start_buffer_index = -1;
+  ref_json_reader->token._internal.start_buffer_offset = -1;
+  ref_json_reader->token._internal.end_buffer_index = -1;
+  ref_json_reader->token._internal.end_buffer_offset = -1;
+
+  if (ref_json_reader->_internal.structural_index_count > 0)
+  {
+    _az_RETURN_IF_FAILED(_az_json_reader_skip_children_using_index(ref_json_reader));
+  }
+  else
+  {
+    int32_t const depth = ref_json_reader->_internal.bit_stack._internal.current_depth;
+    az_span remaining = _get_remaining_json(ref_json_reader);
+    bool is_in_string = false;
+    bool is_escaped = false;
+
+    while (true)
+    {
+      uint8_t const* json = az_span_ptr(remaining);
+      int32_t const size = az_span_size(remaining);
+      int32_t index = 0;
+      az_result result = AZ_OK;
+
+      while (index < size)
+      {
+        if (is_escaped)
+        {
+          is_escaped = false;
+          index++;
+          continue;
+        }
+
+        // Control characters are left for a validating reader to reject, so only look for the end
+        // of the string or an escaped character that could be a quote.
+        index += is_in_string ? _az_json_string_scan(json + index, size - index)
+                              : _az_json_container_scan(json + index, size - index);
+        if (index >= size)
+        {
+          break;
+        }
+
+        uint8_t const next_byte = json[index];
+        if (is_in_string)
+        {
+          is_escaped = next_byte == '\\';
+          is_in_string = next_byte != '"';
+        }
+        else if (next_byte == '"')
+        {
+          is_in_string = true;
+        }
+        else
+        {
+          result = _az_json_reader_skip_bracket(ref_json_reader, next_byte, depth);
+          if (result == AZ_ERROR_JSON_READER_DONE)
+          {
+            break;
+          }
+          _az_RETURN_IF_FAILED(result);
+        }
+
+        index++;
+      }
+
+      ref_json_reader->_internal.bytes_consumed += index;
+      ref_json_reader->_internal.total_bytes_consumed += index;
+
+      if (result == AZ_ERROR_JSON_READER_DONE)
+      {
+        break;
+      }
+
+      _az_RETURN_IF_FAILED(_az_json_reader_get_next_buffer(ref_json_reader, &remaining, true));
+    }
+  }
+
+  return _az_json_reader_process_container_end(
+      ref_json_reader,
+      _az_json_stack_peek(&ref_json_reader->_internal.bit_stack) == _az_JSON_STACK_OBJECT
+          ? AZ_JSON_TOKEN_END_OBJECT
+          : AZ_JSON_TOKEN_END_ARRAY);
+}
+
 AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_reader)
 {
   _az_PRECONDITION_NOT_NULL(ref_json_reader);
@@ -953,6 +1456,12 @@ AZ_NODISCARD az_result az_json_reader_skip_children(az_json_reader* ref_json_rea
   }
 
   az_json_token_kind const token_kind = ref_json_reader->token.kind;
+  if (ref_json_reader->_internal.options.fast_skip_children
+      && (token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY))
+  {
+    return _az_json_reader_skip_children_fast(ref_json_reader);
+  }
+
   if (token_kind == AZ_JSON_TOKEN_BEGIN_OBJECT || token_kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
   {
     // Keep moving the reader until we come back to the same depth.
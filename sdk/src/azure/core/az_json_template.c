@@ -0,0 +1,283 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include "az_span_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+#include <azure/core/internal/az_span_internal.h>
+
+#include <azure/core/_az_cfg.h>
+
+enum
+{
+  // The size of the `null` literal each slot is made of, within the skeleton.
+  _az_JSON_TEMPLATE_SLOT_SIZE = 4,
+};
+
+AZ_NODISCARD az_result az_json_template_init(
+    az_json_template* out_json_template,
+    az_span json_skeleton,
+    int32_t slot_offsets[],
+    int32_t slot_offsets_length)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_template);
+  _az_PRECONDITION_VALID_SPAN(json_skeleton, 1, false);
+  _az_PRECONDITION(slot_offsets_length >= 0);
+  _az_PRECONDITION(slot_offsets_length == 0 || slot_offsets != NULL);
+
+  *out_json_template = (az_json_template){
+    ._internal = {
+      .json_skeleton = json_skeleton,
+      .slot_offsets = slot_offsets,
+      .number_of_slots = 0,
+    },
+  };
+
+  az_json_reader reader;
+  _az_RETURN_IF_FAILED(az_json_reader_init(&reader, json_skeleton, NULL));
+
+  int32_t number_of_slots = 0;
+  az_result result = AZ_OK;
+  while (az_result_succeeded(result = az_json_reader_next_token(&reader)))
+  {
+    if (reader.token.kind == AZ_JSON_TOKEN_NULL)
+    {
+      if (number_of_slots == slot_offsets_length)
+      {
+        return AZ_ERROR_NOT_ENOUGH_SPACE;
+      }
+
+      // The skeleton is a single contiguous buffer, so the token slice always points within it.
+      slot_offsets[number_of_slots++]
+          = (int32_t)(az_span_ptr(reader.token.slice) - az_span_ptr(json_skeleton));
+    }
+  }
+
+  // Reading a complete JSON value, followed by nothing but whitespace, is the only way to be done.
+  if (result != AZ_ERROR_JSON_READER_DONE)
+  {
+    return result;
+  }
+
+  out_json_template->_internal.number_of_slots = number_of_slots;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_template_writer_init(
+    az_json_template_writer* out_json_template_writer,
+    az_json_template const* json_template,
+    az_span destination_buffer)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_template_writer);
+  _az_PRECONDITION_NOT_NULL(json_template);
+
+  *out_json_template_writer = (az_json_template_writer){
+    ._internal = {
+      .json_template = json_template,
+      .destination = destination_buffer,
+      .bytes_written = 0,
+      .next_slot = 0,
+    },
+  };
+
+  return AZ_OK;
+}
+
+// Returns the literal text of the skeleton, in between the end of the previous slot (or the start
+// of the skeleton) and slot_index (or the end of the skeleton, when slot_index is the number of
+// slots).
+AZ_NODISCARD static az_span
+_az_json_template_get_fragment(az_json_template const* json_template, int32_t slot_index)
+{
+  int32_t const* slot_offsets = json_template->_internal.slot_offsets;
+  int32_t const start
+      = slot_index == 0 ? 0 : slot_offsets[slot_index - 1] + _az_JSON_TEMPLATE_SLOT_SIZE;
+  int32_t const end = slot_index == json_template->_internal.number_of_slots
+      ? az_span_size(json_template->_internal.json_skeleton)
+      : slot_offsets[slot_index];
+
+  return az_span_slice(json_template->_internal.json_skeleton, start, end);
+}
+
+// Copies the literal text that comes before the next slot, and returns the remaining destination,
+// where the slot value is to be written. The writer state is only updated, by
+// _az_json_template_writer_commit_slot(), once the value has been written successfully.
+AZ_NODISCARD static az_result _az_json_template_writer_begin_slot(
+    az_json_template_writer const* json_template_writer,
+    int32_t slot_value_size,
+    az_span* out_remaining)
+{
+  az_json_template const* json_template = json_template_writer->_internal.json_template;
+  int32_t const next_slot = json_template_writer->_internal.next_slot;
+
+  if (next_slot >= json_template->_internal.number_of_slots)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  az_span const fragment = _az_json_template_get_fragment(json_template, next_slot);
+  az_span remaining = az_span_slice_to_end(
+      json_template_writer->_internal.destination, json_template_writer->_internal.bytes_written);
+
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, az_span_size(fragment) + slot_value_size);
+
+  *out_remaining = az_span_copy(remaining, fragment);
+  return AZ_OK;
+}
+
+static void _az_json_template_writer_commit_slot(
+    az_json_template_writer* ref_json_template_writer,
+    az_span remaining_after_value)
+{
+  ref_json_template_writer->_internal.bytes_written = _az_span_diff(
+      remaining_after_value, ref_json_template_writer->_internal.destination);
+  ref_json_template_writer->_internal.next_slot++;
+}
+
+AZ_NODISCARD static az_result _az_json_template_writer_append_literal(
+    az_json_template_writer* ref_json_template_writer,
+    az_span literal)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_template_writer);
+
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_json_template_writer, az_span_size(literal), &remaining));
+
+  _az_json_template_writer_commit_slot(ref_json_template_writer, az_span_copy(remaining, literal));
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_template_writer_append_string(
+    az_json_template_writer* ref_json_template_writer,
+    az_span value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_template_writer);
+  _az_PRECONDITION_VALID_SPAN(value, 0, true);
+  _az_PRECONDITION(az_span_size(value) <= _az_MAX_UNESCAPED_STRING_SIZE);
+
+  int32_t index_of_first_escaped_char = -1;
+  int32_t const escaped_length
+      = _az_json_writer_escaped_length(value, &index_of_first_escaped_char, false);
+
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_template_writer_begin_slot(
+      ref_json_template_writer, escaped_length + 2, &remaining)); // Add 2 for the quotes.
+
+  remaining = az_span_copy_u8(remaining, '"');
+
+  if (index_of_first_escaped_char == -1)
+  {
+    remaining = az_span_copy(remaining, value);
+  }
+  else
+  {
+    // Bulk copy the characters that didn't need to be escaped before dropping to the byte-by-byte
+    // encode and copy.
+    remaining = az_span_copy(remaining, az_span_slice(value, 0, index_of_first_escaped_char));
+    remaining = _az_json_writer_escape_and_copy(
+        remaining, az_span_slice_to_end(value, index_of_first_escaped_char));
+  }
+
+  remaining = az_span_copy_u8(remaining, '"');
+
+  _az_json_template_writer_commit_slot(ref_json_template_writer, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_bool(az_json_template_writer* ref_json_template_writer, bool value)
+{
+  return _az_json_template_writer_append_literal(
+      ref_json_template_writer, value ? AZ_SPAN_FROM_STR("true") : AZ_SPAN_FROM_STR("false"));
+}
+
+AZ_NODISCARD az_result
+az_json_template_writer_append_null(az_json_template_writer* ref_json_template_writer)
+{
+  return _az_json_template_writer_append_literal(
+      ref_json_template_writer, AZ_SPAN_FROM_STR("null"));
+}
+
+AZ_NODISCARD az_result az_json_template_writer_append_int32(
+    az_json_template_writer* ref_json_template_writer,
+    int32_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_template_writer);
+
+  // The size of the number isn't known ahead of time, so it is up to az_span_i32toa to check
+  // whether it fits, after the literal text.
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(
+      _az_json_template_writer_begin_slot(ref_json_template_writer, 1, &remaining));
+  _az_RETURN_IF_FAILED(az_span_i32toa(remaining, value, &remaining));
+
+  _az_json_template_writer_commit_slot(ref_json_template_writer, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_template_writer_append_int64(
+    az_json_template_writer* ref_json_template_writer,
+    int64_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_template_writer);
+
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(
+      _az_json_template_writer_begin_slot(ref_json_template_writer, 1, &remaining));
+  _az_RETURN_IF_FAILED(az_span_i64toa(remaining, value, &remaining));
+
+  _az_json_template_writer_commit_slot(ref_json_template_writer, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_template_writer_append_double(
+    az_json_template_writer* ref_json_template_writer,
+    double value,
+    int32_t fractional_digits)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_template_writer);
+  // Non-finite numbers are not supported because they lead to invalid JSON.
+  _az_PRECONDITION(_az_isfinite(value));
+  _az_PRECONDITION_RANGE(0, fractional_digits, _az_MAX_SUPPORTED_FRACTIONAL_DIGITS);
+
+  az_span remaining = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(
+      _az_json_template_writer_begin_slot(ref_json_template_writer, 1, &remaining));
+  _az_RETURN_IF_FAILED(az_span_dtoa(remaining, value, fractional_digits, &remaining));
+
+  _az_json_template_writer_commit_slot(ref_json_template_writer, remaining);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_template_writer_get_json(
+    az_json_template_writer const* json_template_writer,
+    az_span* out_json)
+{
+  _az_PRECONDITION_NOT_NULL(json_template_writer);
+  _az_PRECONDITION_NOT_NULL(out_json);
+
+  az_json_template const* json_template = json_template_writer->_internal.json_template;
+  int32_t const bytes_written = json_template_writer->_internal.bytes_written;
+
+  if (json_template_writer->_internal.next_slot != json_template->_internal.number_of_slots)
+  {
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  // The text after the last slot is copied every time, which leaves the writer as is.
+  az_span const fragment
+      = _az_json_template_get_fragment(json_template, json_template->_internal.number_of_slots);
+  az_span const remaining
+      = az_span_slice_to_end(json_template_writer->_internal.destination, bytes_written);
+
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining, az_span_size(fragment));
+  az_span_copy(remaining, fragment);
+
+  *out_json = az_span_slice(
+      json_template_writer->_internal.destination, 0, bytes_written + az_span_size(fragment));
+  return AZ_OK;
+}
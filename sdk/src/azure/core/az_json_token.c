@@ -7,6 +7,7 @@
 
 #include "az_json_private.h"
 
+#include "az_simd_private.h"
 #include "az_span_private.h"
 #include <azure/core/_az_cfg.h>
 
@@ -83,6 +84,39 @@ AZ_NODISCARD static uint8_t _az_json_unescape_single_byte(uint8_t ch)
   }
 }
 
+// Copies the leading bytes of source that don't need to be unescaped, i.e. up to the first
+// backslash, into destination, and returns how many were copied. Both must have at least size bytes
+// available. The destination may overlap the source, as long as it doesn't start after it.
+AZ_NODISCARD static int32_t
+_az_json_copy_until_backslash(uint8_t* destination, uint8_t const* source, int32_t size)
+{
+  int32_t index = 0;
+
+#ifdef _az_SIMD_ENABLED
+  _az_simd_vector const backslash = _az_simd_splat('\\');
+
+  for (; index <= size - _az_SIMD_BLOCK_SIZE; index += _az_SIMD_BLOCK_SIZE)
+  {
+    _az_simd_vector const block = _az_simd_load(source + index);
+    if (_az_simd_mask(_az_simd_eq(block, backslash)) != 0)
+    {
+      // Only the bytes before the backslash are copied, one at a time, so that the backslash and
+      // the character it escapes aren't overwritten when unescaping in place.
+      break;
+    }
+
+    _az_simd_store(destination + index, block);
+  }
+#endif // _az_SIMD_ENABLED
+
+  for (; index < size && source[index] != '\\'; index++)
+  {
+    destination[index] = source[index];
+  }
+
+  return index;
+}
+
 AZ_NODISCARD static bool _az_json_token_is_text_equal_helper(
     az_span token_slice,
     az_span* expected_text,
@@ -283,8 +317,30 @@ AZ_NODISCARD static az_result _az_json_token_get_string_helper(
 {
   int32_t source_size = az_span_size(source);
   uint8_t* source_ptr = az_span_ptr(source);
-  for (int32_t i = 0; i < source_size; i++)
+  int32_t i = 0;
+  while (i < source_size)
   {
+    if (!*next_char_escaped)
+    {
+      // Bulk copy the run of characters that don't need to be unescaped, up to the next
+      // backslash, or as much of it as fits.
+      int32_t available_size = source_size - i;
+      if (available_size > destination_max_size - *dest_idx)
+      {
+        available_size = destination_max_size - *dest_idx;
+      }
+
+      int32_t const run_length = _az_json_copy_until_backslash(
+          (uint8_t*)destination + *dest_idx, source_ptr + i, available_size);
+      *dest_idx = *dest_idx + run_length;
+      i += run_length;
+
+      if (i >= source_size)
+      {
+        break;
+      }
+    }
+
     if (*dest_idx >= destination_max_size)
     {
       return AZ_ERROR_NOT_ENOUGH_SPACE;
@@ -299,6 +355,7 @@ AZ_NODISCARD static az_result _az_json_token_get_string_helper(
       }
       else
       {
+        // The escaped character may be at the start of the next segment.
         i++;
         if (i >= source_size)
         {
@@ -320,6 +377,7 @@ AZ_NODISCARD static az_result _az_json_token_get_string_helper(
 
     destination[*dest_idx] = (char)token_byte;
     *dest_idx = *dest_idx + 1;
+    i++;
   }
 
   return AZ_OK;
@@ -338,8 +396,28 @@ AZ_NODISCARD az_span az_json_string_unescape(az_span json_string, az_span destin
   uint8_t* span_ptr = az_span_ptr(json_string);
   uint8_t* destination_ptr = az_span_ptr(destination);
   int32_t destination_size = az_span_size(destination);
-  for (int32_t i = 0; i < span_size; i++)
-  {
+  int32_t i = 0;
+  while (i < span_size)
+  {
+    // Bulk copy the run of characters that don't need to be unescaped, up to the next backslash,
+    // or as much of it as fits. When unescaping in place, the destination never gets ahead of the
+    // source.
+    int32_t available_size = span_size - i;
+    if (available_size > destination_size - position)
+    {
+      available_size = destination_size - position;
+    }
+
+    int32_t const run_length
+        = _az_json_copy_until_backslash(destination_ptr + position, span_ptr + i, available_size);
+    position += run_length;
+    i += run_length;
+
+    if (i >= span_size)
+    {
+      break;
+    }
+
     uint8_t current_char = span_ptr[i];
     if (current_char == '\\' && i < span_size - 1)
     {
@@ -363,7 +441,7 @@ AZ_NODISCARD az_span az_json_string_unescape(az_span json_string, az_span destin
       return az_span_slice(destination, 0, position);
     }
 
-    if (position > destination_size)
+    if (position >= destination_size)
     {
       // We assume that the destination buffer is large enough, but stop processing, in-case it
       // isn't.
@@ -372,6 +450,7 @@ AZ_NODISCARD az_span az_json_string_unescape(az_span json_string, az_span destin
 
     destination_ptr[position] = current_char;
     position++;
+    i++;
   }
 
   return az_span_slice(destination, 0, position);
@@ -651,3 +730,127 @@ AZ_NODISCARD az_result az_json_token_get_double(az_json_token const* json_token,
 
   return az_span_atod(az_span_slice(scratch, 0, _az_span_diff(remainder, scratch)), out_value);
 }
+
+// Hashes the length and the first, middle, and last bytes of the name, which is enough to tell most
+// property names apart, without having to read all of them.
+AZ_NODISCARD static uint32_t _az_json_name_table_hash(az_span name)
+{
+  uint8_t const* name_ptr = az_span_ptr(name);
+  int32_t const name_size = az_span_size(name);
+
+  uint32_t hash = (uint32_t)name_size * 0x9E3779B1U;
+  if (name_size > 0)
+  {
+    hash ^= ((uint32_t)name_ptr[0] << 16U) | ((uint32_t)name_ptr[name_size / 2] << 8U)
+        | (uint32_t)name_ptr[name_size - 1];
+  }
+
+  // Mix the higher bits into the lower bits, which are used to pick the bucket.
+  hash *= 0x85EBCA6BU;
+  return hash ^ (hash >> 16U);
+}
+
+AZ_NODISCARD az_result az_json_name_table_init(
+    az_json_name_table* out_name_table,
+    az_span const names[],
+    int32_t number_of_names,
+    uint16_t buckets[],
+    int32_t number_of_buckets)
+{
+  _az_PRECONDITION_NOT_NULL(out_name_table);
+  _az_PRECONDITION(number_of_names == 0 || names != NULL);
+  _az_PRECONDITION_RANGE(0, number_of_names, UINT16_MAX - 1);
+  _az_PRECONDITION_NOT_NULL(buckets);
+  _az_PRECONDITION(number_of_buckets > number_of_names);
+  _az_PRECONDITION((number_of_buckets & (number_of_buckets - 1)) == 0);
+
+  *out_name_table = (az_json_name_table){
+    ._internal = {
+      .names = names,
+      .number_of_names = number_of_names,
+      .buckets = buckets,
+      .number_of_buckets = number_of_buckets,
+    },
+  };
+
+  uint32_t const mask = (uint32_t)number_of_buckets - 1U;
+
+  for (int32_t i = 0; i < number_of_buckets; i++)
+  {
+    buckets[i] = 0;
+  }
+
+  for (int32_t i = 0; i < number_of_names; i++)
+  {
+    uint32_t bucket = _az_json_name_table_hash(names[i]) & mask;
+    bool is_duplicate = false;
+
+    while (buckets[bucket] != 0)
+    {
+      if (az_span_is_content_equal(names[buckets[bucket] - 1], names[i]))
+      {
+        is_duplicate = true;
+        break;
+      }
+      bucket = (bucket + 1U) & mask;
+    }
+
+    if (!is_duplicate)
+    {
+      buckets[bucket] = (uint16_t)(i + 1);
+    }
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_name_table_find(
+    az_json_name_table const* name_table,
+    az_json_token const* json_token,
+    int32_t* out_index)
+{
+  _az_PRECONDITION_NOT_NULL(name_table);
+  _az_PRECONDITION_NOT_NULL(json_token);
+  _az_PRECONDITION_NOT_NULL(out_index);
+
+  if (json_token->kind != AZ_JSON_TOKEN_STRING && json_token->kind != AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  az_span const* names = name_table->_internal.names;
+
+  // The hash is computed over the raw bytes, so tokens which need to be unescaped or stitched
+  // together from multiple buffers fall back to comparing against every name.
+  if (json_token->_internal.string_has_escaped_chars || json_token->_internal.is_multisegment)
+  {
+    for (int32_t i = 0; i < name_table->_internal.number_of_names; i++)
+    {
+      if (az_json_token_is_text_equal(json_token, names[i]))
+      {
+        *out_index = i;
+        return AZ_OK;
+      }
+    }
+
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  uint16_t const* buckets = name_table->_internal.buckets;
+  uint32_t const mask = (uint32_t)name_table->_internal.number_of_buckets - 1U;
+  uint32_t bucket = _az_json_name_table_hash(json_token->slice) & mask;
+
+  // There is always at least one empty bucket, which ends the search.
+  while (buckets[bucket] != 0)
+  {
+    int32_t const index = buckets[bucket] - 1;
+    if (az_span_is_content_equal(names[index], json_token->slice))
+    {
+      *out_index = index;
+      return AZ_OK;
+    }
+    bucket = (bucket + 1U) & mask;
+  }
+
+  return AZ_ERROR_ITEM_NOT_FOUND;
+}
@@ -0,0 +1,481 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_json_private.h"
+#include <azure/core/az_json.h>
+#include <azure/core/az_precondition.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <ctype.h>
+
+#include <azure/core/_az_cfg.h>
+
+// The role of a byte within the JSON grammar, outside of strings.
+typedef enum
+{
+  _az_JSON_CLASS_OTHER = 0,
+  _az_JSON_CLASS_WHITESPACE,
+  _az_JSON_CLASS_BEGIN_OBJECT,
+  _az_JSON_CLASS_END_OBJECT,
+  _az_JSON_CLASS_BEGIN_ARRAY,
+  _az_JSON_CLASS_END_ARRAY,
+  _az_JSON_CLASS_COLON,
+  _az_JSON_CLASS_COMMA,
+  _az_JSON_CLASS_QUOTE,
+  _az_JSON_CLASS_MINUS,
+  _az_JSON_CLASS_PLUS,
+  _az_JSON_CLASS_POINT,
+  _az_JSON_CLASS_ZERO,
+  _az_JSON_CLASS_DIGIT,
+  _az_JSON_CLASS_EXPONENT,
+  _az_JSON_CLASS_LITERAL,
+  _az_JSON_CLASS_COUNT,
+} _az_json_class;
+
+static const uint8_t _az_json_classes[256] = {
+  [' '] = _az_JSON_CLASS_WHITESPACE,  ['\t'] = _az_JSON_CLASS_WHITESPACE,
+  ['\n'] = _az_JSON_CLASS_WHITESPACE, ['\r'] = _az_JSON_CLASS_WHITESPACE,
+  ['{'] = _az_JSON_CLASS_BEGIN_OBJECT, ['}'] = _az_JSON_CLASS_END_OBJECT,
+  ['['] = _az_JSON_CLASS_BEGIN_ARRAY,  [']'] = _az_JSON_CLASS_END_ARRAY,
+  [':'] = _az_JSON_CLASS_COLON,        [','] = _az_JSON_CLASS_COMMA,
+  ['"'] = _az_JSON_CLASS_QUOTE,        ['-'] = _az_JSON_CLASS_MINUS,
+  ['+'] = _az_JSON_CLASS_PLUS,         ['.'] = _az_JSON_CLASS_POINT,
+  ['0'] = _az_JSON_CLASS_ZERO,         ['1'] = _az_JSON_CLASS_DIGIT,
+  ['2'] = _az_JSON_CLASS_DIGIT,        ['3'] = _az_JSON_CLASS_DIGIT,
+  ['4'] = _az_JSON_CLASS_DIGIT,        ['5'] = _az_JSON_CLASS_DIGIT,
+  ['6'] = _az_JSON_CLASS_DIGIT,        ['7'] = _az_JSON_CLASS_DIGIT,
+  ['8'] = _az_JSON_CLASS_DIGIT,        ['9'] = _az_JSON_CLASS_DIGIT,
+  ['e'] = _az_JSON_CLASS_EXPONENT,     ['E'] = _az_JSON_CLASS_EXPONENT,
+  ['t'] = _az_JSON_CLASS_LITERAL,      ['f'] = _az_JSON_CLASS_LITERAL,
+  ['n'] = _az_JSON_CLASS_LITERAL,
+};
+
+// What is expected next, in between tokens.
+typedef enum
+{
+  // A value, at the start, after a colon, or after a comma within an array.
+  _az_JSON_STATE_VALUE = 0,
+  // A value or the end of the array.
+  _az_JSON_STATE_ARRAY_START,
+  // A property name or the end of the object.
+  _az_JSON_STATE_OBJECT_START,
+  // A property name, after a comma within an object.
+  _az_JSON_STATE_PROPERTY_NAME,
+  // The colon that follows a property name.
+  _az_JSON_STATE_COLON,
+  // A comma or the end of the object or array, after a value.
+  _az_JSON_STATE_AFTER_VALUE,
+  _az_JSON_STATE_COUNT,
+} _az_json_validator_state;
+
+typedef enum
+{
+  _az_JSON_ACTION_ERROR = 0,
+  _az_JSON_ACTION_SKIP,
+  _az_JSON_ACTION_BEGIN_OBJECT,
+  _az_JSON_ACTION_END_OBJECT,
+  _az_JSON_ACTION_BEGIN_ARRAY,
+  _az_JSON_ACTION_END_ARRAY,
+  _az_JSON_ACTION_COLON,
+  _az_JSON_ACTION_COMMA,
+  _az_JSON_ACTION_STRING,
+  _az_JSON_ACTION_PROPERTY_NAME,
+  _az_JSON_ACTION_NUMBER,
+  _az_JSON_ACTION_LITERAL,
+} _az_json_validator_action;
+
+// The action to take for each class of byte, in each state. Anything not listed is unexpected.
+static const uint8_t _az_json_validator_actions[_az_JSON_STATE_COUNT][_az_JSON_CLASS_COUNT] = {
+  [_az_JSON_STATE_VALUE] = {
+    [_az_JSON_CLASS_WHITESPACE] = _az_JSON_ACTION_SKIP,
+    [_az_JSON_CLASS_BEGIN_OBJECT] = _az_JSON_ACTION_BEGIN_OBJECT,
+    [_az_JSON_CLASS_BEGIN_ARRAY] = _az_JSON_ACTION_BEGIN_ARRAY,
+    [_az_JSON_CLASS_QUOTE] = _az_JSON_ACTION_STRING,
+    [_az_JSON_CLASS_MINUS] = _az_JSON_ACTION_NUMBER,
+    [_az_JSON_CLASS_ZERO] = _az_JSON_ACTION_NUMBER,
+    [_az_JSON_CLASS_DIGIT] = _az_JSON_ACTION_NUMBER,
+    [_az_JSON_CLASS_LITERAL] = _az_JSON_ACTION_LITERAL,
+  },
+  [_az_JSON_STATE_ARRAY_START] = {
+    [_az_JSON_CLASS_WHITESPACE] = _az_JSON_ACTION_SKIP,
+    [_az_JSON_CLASS_BEGIN_OBJECT] = _az_JSON_ACTION_BEGIN_OBJECT,
+    [_az_JSON_CLASS_BEGIN_ARRAY] = _az_JSON_ACTION_BEGIN_ARRAY,
+    [_az_JSON_CLASS_END_ARRAY] = _az_JSON_ACTION_END_ARRAY,
+    [_az_JSON_CLASS_QUOTE] = _az_JSON_ACTION_STRING,
+    [_az_JSON_CLASS_MINUS] = _az_JSON_ACTION_NUMBER,
+    [_az_JSON_CLASS_ZERO] = _az_JSON_ACTION_NUMBER,
+    [_az_JSON_CLASS_DIGIT] = _az_JSON_ACTION_NUMBER,
+    [_az_JSON_CLASS_LITERAL] = _az_JSON_ACTION_LITERAL,
+  },
+  [_az_JSON_STATE_OBJECT_START] = {
+    [_az_JSON_CLASS_WHITESPACE] = _az_JSON_ACTION_SKIP,
+    [_az_JSON_CLASS_END_OBJECT] = _az_JSON_ACTION_END_OBJECT,
+    [_az_JSON_CLASS_QUOTE] = _az_JSON_ACTION_PROPERTY_NAME,
+  },
+  [_az_JSON_STATE_PROPERTY_NAME] = {
+    [_az_JSON_CLASS_WHITESPACE] = _az_JSON_ACTION_SKIP,
+    [_az_JSON_CLASS_QUOTE] = _az_JSON_ACTION_PROPERTY_NAME,
+  },
+  [_az_JSON_STATE_COLON] = {
+    [_az_JSON_CLASS_WHITESPACE] = _az_JSON_ACTION_SKIP,
+    [_az_JSON_CLASS_COLON] = _az_JSON_ACTION_COLON,
+  },
+  [_az_JSON_STATE_AFTER_VALUE] = {
+    [_az_JSON_CLASS_WHITESPACE] = _az_JSON_ACTION_SKIP,
+    [_az_JSON_CLASS_END_OBJECT] = _az_JSON_ACTION_END_OBJECT,
+    [_az_JSON_CLASS_END_ARRAY] = _az_JSON_ACTION_END_ARRAY,
+    [_az_JSON_CLASS_COMMA] = _az_JSON_ACTION_COMMA,
+  },
+};
+
+// The part of a number read so far.
+typedef enum
+{
+  _az_JSON_NUMBER_ERROR = 0,
+  // The number ended right before the current byte.
+  _az_JSON_NUMBER_END,
+  _az_JSON_NUMBER_START,
+  _az_JSON_NUMBER_MINUS,
+  _az_JSON_NUMBER_ZERO,
+  _az_JSON_NUMBER_INTEGER,
+  _az_JSON_NUMBER_POINT,
+  _az_JSON_NUMBER_FRACTION,
+  _az_JSON_NUMBER_EXPONENT,
+  _az_JSON_NUMBER_EXPONENT_SIGN,
+  _az_JSON_NUMBER_EXPONENT_DIGITS,
+  _az_JSON_NUMBER_STATE_COUNT,
+} _az_json_number_state;
+
+// The next number state for each class of byte. Whitespace, a comma, or the end of an object or an
+// array end the number, where it is complete. As with the az_json_reader, an exponent without any
+// digits is accepted when followed by one of those.
+static const uint8_t _az_json_number_transitions[_az_JSON_NUMBER_STATE_COUNT][_az_JSON_CLASS_COUNT]
+    = {
+        [_az_JSON_NUMBER_START] = {
+          [_az_JSON_CLASS_MINUS] = _az_JSON_NUMBER_MINUS,
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_ZERO,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_INTEGER,
+        },
+        [_az_JSON_NUMBER_MINUS] = {
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_ZERO,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_INTEGER,
+        },
+        [_az_JSON_NUMBER_ZERO] = {
+          [_az_JSON_CLASS_POINT] = _az_JSON_NUMBER_POINT,
+          [_az_JSON_CLASS_EXPONENT] = _az_JSON_NUMBER_EXPONENT,
+          [_az_JSON_CLASS_WHITESPACE] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_COMMA] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_OBJECT] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_ARRAY] = _az_JSON_NUMBER_END,
+        },
+        [_az_JSON_NUMBER_INTEGER] = {
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_INTEGER,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_INTEGER,
+          [_az_JSON_CLASS_POINT] = _az_JSON_NUMBER_POINT,
+          [_az_JSON_CLASS_EXPONENT] = _az_JSON_NUMBER_EXPONENT,
+          [_az_JSON_CLASS_WHITESPACE] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_COMMA] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_OBJECT] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_ARRAY] = _az_JSON_NUMBER_END,
+        },
+        [_az_JSON_NUMBER_POINT] = {
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_FRACTION,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_FRACTION,
+        },
+        [_az_JSON_NUMBER_FRACTION] = {
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_FRACTION,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_FRACTION,
+          [_az_JSON_CLASS_EXPONENT] = _az_JSON_NUMBER_EXPONENT,
+          [_az_JSON_CLASS_WHITESPACE] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_COMMA] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_OBJECT] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_ARRAY] = _az_JSON_NUMBER_END,
+        },
+        [_az_JSON_NUMBER_EXPONENT] = {
+          [_az_JSON_CLASS_MINUS] = _az_JSON_NUMBER_EXPONENT_SIGN,
+          [_az_JSON_CLASS_PLUS] = _az_JSON_NUMBER_EXPONENT_SIGN,
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_EXPONENT_DIGITS,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_EXPONENT_DIGITS,
+          [_az_JSON_CLASS_WHITESPACE] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_COMMA] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_OBJECT] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_ARRAY] = _az_JSON_NUMBER_END,
+        },
+        [_az_JSON_NUMBER_EXPONENT_SIGN] = {
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_EXPONENT_DIGITS,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_EXPONENT_DIGITS,
+        },
+        [_az_JSON_NUMBER_EXPONENT_DIGITS] = {
+          [_az_JSON_CLASS_ZERO] = _az_JSON_NUMBER_EXPONENT_DIGITS,
+          [_az_JSON_CLASS_DIGIT] = _az_JSON_NUMBER_EXPONENT_DIGITS,
+          [_az_JSON_CLASS_WHITESPACE] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_COMMA] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_OBJECT] = _az_JSON_NUMBER_END,
+          [_az_JSON_CLASS_END_ARRAY] = _az_JSON_NUMBER_END,
+        },
+      };
+
+AZ_NODISCARD static az_result
+_az_json_validate_string(uint8_t const* json, int32_t size, int32_t* ref_index)
+{
+  // Move past the opening quote.
+  int32_t index = *ref_index + 1;
+
+  while (true)
+  {
+    // Skip over the run of regular characters, up to the next quote, backslash, or control
+    // character.
+    index += _az_json_string_scan(json + index, size - index);
+    if (index >= size)
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    uint8_t const next_byte = json[index++];
+    if (next_byte == '"')
+    {
+      *ref_index = index;
+      return AZ_OK;
+    }
+
+    // Control characters are invalid within a JSON string and should be correctly escaped.
+    if (next_byte != '\\')
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
+    if (index >= size)
+    {
+      return AZ_ERROR_UNEXPECTED_END;
+    }
+
+    uint8_t const escaped_byte = json[index++];
+    if (escaped_byte == 'u')
+    {
+      // Expecting 4 hex digits to follow the escaped 'u'
+      for (int32_t i = 0; i < 4; i++)
+      {
+        if (index >= size)
+        {
+          return AZ_ERROR_UNEXPECTED_END;
+        }
+
+        if (!isxdigit(json[index++]))
+        {
+          return AZ_ERROR_UNEXPECTED_CHAR;
+        }
+      }
+    }
+    else if (!_az_is_valid_escaped_character(escaped_byte))
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+  }
+}
+
+AZ_NODISCARD static az_result
+_az_json_validate_number(uint8_t const* json, int32_t size, int32_t* ref_index)
+{
+  uint8_t state = _az_JSON_NUMBER_START;
+
+  for (int32_t index = *ref_index; index < size; index++)
+  {
+    uint8_t const next_state = _az_json_number_transitions[state][_az_json_classes[json[index]]];
+    if (next_state == _az_JSON_NUMBER_END)
+    {
+      *ref_index = index;
+      return AZ_OK;
+    }
+
+    if (next_state == _az_JSON_NUMBER_ERROR)
+    {
+      return AZ_ERROR_UNEXPECTED_CHAR;
+    }
+
+    state = next_state;
+  }
+
+  // The number ends with the JSON text, which is only valid once it has at least one digit after
+  // any sign, decimal point, or exponent.
+  if (state != _az_JSON_NUMBER_ZERO && state != _az_JSON_NUMBER_INTEGER
+      && state != _az_JSON_NUMBER_FRACTION && state != _az_JSON_NUMBER_EXPONENT_DIGITS)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  *ref_index = size;
+  return AZ_OK;
+}
+
+AZ_NODISCARD static az_result _az_json_validate_literal(
+    az_span json_text,
+    int32_t* ref_index,
+    az_json_token_kind* out_token_kind)
+{
+  uint8_t const first_byte = az_span_ptr(json_text)[*ref_index];
+  az_span literal = AZ_SPAN_FROM_STR("null");
+  *out_token_kind = AZ_JSON_TOKEN_NULL;
+
+  if (first_byte == 't')
+  {
+    literal = AZ_SPAN_FROM_STR("true");
+    *out_token_kind = AZ_JSON_TOKEN_TRUE;
+  }
+  else if (first_byte == 'f')
+  {
+    literal = AZ_SPAN_FROM_STR("false");
+    *out_token_kind = AZ_JSON_TOKEN_FALSE;
+  }
+
+  int32_t const literal_size = az_span_size(literal);
+  int32_t const available_size = az_span_size(json_text) - *ref_index;
+  int32_t const comparable_size = available_size < literal_size ? available_size : literal_size;
+
+  if (!az_span_is_content_equal(
+          az_span_slice(json_text, *ref_index, *ref_index + comparable_size),
+          az_span_slice(literal, 0, comparable_size)))
+  {
+    return AZ_ERROR_UNEXPECTED_CHAR;
+  }
+
+  // The JSON text ends before the literal does.
+  if (comparable_size < literal_size)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  *ref_index += literal_size;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_validate(az_span json_text, az_json_validated_text* out_validated_text)
+{
+  _az_PRECONDITION_VALID_SPAN(json_text, 1, false);
+
+  uint8_t const* json = az_span_ptr(json_text);
+  int32_t const size = az_span_size(json_text);
+
+  _az_json_bit_stack bit_stack = { 0 };
+  uint8_t state = _az_JSON_STATE_VALUE;
+  az_json_token_kind last_token_kind = AZ_JSON_TOKEN_NONE;
+  int32_t index = 0;
+
+  while (index < size)
+  {
+    uint8_t const action = _az_json_validator_actions[state][_az_json_classes[json[index]]];
+    int32_t const current_depth = bit_stack._internal.current_depth;
+
+    switch (action)
+    {
+      case _az_JSON_ACTION_SKIP:
+      {
+        index++;
+        break;
+      }
+      case _az_JSON_ACTION_BEGIN_OBJECT:
+      case _az_JSON_ACTION_BEGIN_ARRAY:
+      {
+        if (current_depth >= _az_MAX_JSON_STACK_SIZE)
+        {
+          return AZ_ERROR_JSON_NESTING_OVERFLOW;
+        }
+
+        bool const is_object = action == _az_JSON_ACTION_BEGIN_OBJECT;
+        _az_json_stack_push(&bit_stack, is_object ? _az_JSON_STACK_OBJECT : _az_JSON_STACK_ARRAY);
+        state = is_object ? _az_JSON_STATE_OBJECT_START : _az_JSON_STATE_ARRAY_START;
+        index++;
+        break;
+      }
+      case _az_JSON_ACTION_END_OBJECT:
+      case _az_JSON_ACTION_END_ARRAY:
+      {
+        bool const is_object = action == _az_JSON_ACTION_END_OBJECT;
+
+        // The end of a container must match the start of the one it is in, if any.
+        if (current_depth == 0
+            || _az_json_stack_peek(&bit_stack)
+                != (is_object ? _az_JSON_STACK_OBJECT : _az_JSON_STACK_ARRAY))
+        {
+          return AZ_ERROR_UNEXPECTED_CHAR;
+        }
+
+        (void)_az_json_stack_pop(&bit_stack);
+        last_token_kind = is_object ? AZ_JSON_TOKEN_END_OBJECT : AZ_JSON_TOKEN_END_ARRAY;
+        state = _az_JSON_STATE_AFTER_VALUE;
+        index++;
+        break;
+      }
+      case _az_JSON_ACTION_COLON:
+      {
+        state = _az_JSON_STATE_VALUE;
+        index++;
+        break;
+      }
+      case _az_JSON_ACTION_COMMA:
+      {
+        // Extra data after a single JSON value (complete object or array or one primitive value)
+        // is invalid.
+        if (current_depth == 0)
+        {
+          return AZ_ERROR_UNEXPECTED_CHAR;
+        }
+
+        state = _az_json_stack_peek(&bit_stack) == _az_JSON_STACK_OBJECT
+            ? _az_JSON_STATE_PROPERTY_NAME
+            : _az_JSON_STATE_VALUE;
+        index++;
+        break;
+      }
+      case _az_JSON_ACTION_STRING:
+      {
+        _az_RETURN_IF_FAILED(_az_json_validate_string(json, size, &index));
+        last_token_kind = AZ_JSON_TOKEN_STRING;
+        state = _az_JSON_STATE_AFTER_VALUE;
+        break;
+      }
+      case _az_JSON_ACTION_PROPERTY_NAME:
+      {
+        _az_RETURN_IF_FAILED(_az_json_validate_string(json, size, &index));
+        state = _az_JSON_STATE_COLON;
+        break;
+      }
+      case _az_JSON_ACTION_NUMBER:
+      {
+        _az_RETURN_IF_FAILED(_az_json_validate_number(json, size, &index));
+        last_token_kind = AZ_JSON_TOKEN_NUMBER;
+        state = _az_JSON_STATE_AFTER_VALUE;
+        break;
+      }
+      case _az_JSON_ACTION_LITERAL:
+      {
+        _az_RETURN_IF_FAILED(_az_json_validate_literal(json_text, &index, &last_token_kind));
+        state = _az_JSON_STATE_AFTER_VALUE;
+        break;
+      }
+      default:
+      {
+        return AZ_ERROR_UNEXPECTED_CHAR;
+      }
+    }
+  }
+
+  // The JSON text can only end after a single, complete, value.
+  if (state != _az_JSON_STATE_AFTER_VALUE || bit_stack._internal.current_depth != 0)
+  {
+    return AZ_ERROR_UNEXPECTED_END;
+  }
+
+  if (out_validated_text != NULL)
+  {
+    *out_validated_text = (az_json_validated_text){
+      ._internal = {
+        .json_text = json_text,
+        .last_token_kind = last_token_kind,
+      },
+    };
+  }
+
+  return AZ_OK;
+}
@@ -61,6 +61,91 @@ AZ_NODISCARD az_result az_json_writer_chunked_init(
   return AZ_OK;
 }
 
+// The allocator used by writers initialized with az_json_writer_sink_init(), which flushes the
+// buffer that is full and then hands out the other one.
+static AZ_NODISCARD az_result _az_json_writer_sink_allocator(
+    az_span_allocator_context* allocator_context,
+    az_span* out_next_destination)
+{
+  az_json_writer_sink* sink = (az_json_writer_sink*)allocator_context->user_context;
+  int32_t const current_buffer = sink->_internal.current_buffer;
+
+  if (allocator_context->bytes_used > 0)
+  {
+    _az_RETURN_IF_FAILED(sink->_internal.flush_callback(
+        sink->_internal.user_context,
+        az_span_slice(sink->_internal.buffers[current_buffer], 0, allocator_context->bytes_used)));
+  }
+
+  int32_t const next_buffer = 1 - current_buffer;
+  sink->_internal.current_buffer = next_buffer;
+
+  // The writer asks for at most _az_MINIMUM_STRING_CHUNK_SIZE bytes at once, which the buffers are
+  // expected to hold, so this only fails if that precondition isn't honored.
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(
+      sink->_internal.buffers[next_buffer], allocator_context->minimum_required_size);
+
+  *out_next_destination = sink->_internal.buffers[next_buffer];
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_json_writer_sink_init(
+    az_json_writer* out_json_writer,
+    az_json_writer_sink* out_json_writer_sink,
+    az_span first_buffer,
+    az_span second_buffer,
+    az_json_writer_flush_fn flush_callback,
+    void* user_context,
+    az_json_writer_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(out_json_writer_sink);
+  _az_PRECONDITION_VALID_SPAN(first_buffer, _az_MINIMUM_STRING_CHUNK_SIZE, false);
+  _az_PRECONDITION_VALID_SPAN(second_buffer, _az_MINIMUM_STRING_CHUNK_SIZE, false);
+  _az_PRECONDITION_NO_OVERLAP_SPANS(first_buffer, second_buffer);
+  _az_PRECONDITION_NOT_NULL(flush_callback);
+
+  *out_json_writer_sink = (az_json_writer_sink){
+    ._internal = {
+      .buffers = { first_buffer, second_buffer },
+      .current_buffer = 0,
+      .flush_callback = flush_callback,
+      .user_context = user_context,
+    },
+  };
+
+  return az_json_writer_chunked_init(
+      out_json_writer,
+      first_buffer,
+      _az_json_writer_sink_allocator,
+      out_json_writer_sink,
+      options);
+}
+
+AZ_NODISCARD az_result az_json_writer_sink_flush(az_json_writer* ref_json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(ref_json_writer->_internal.allocator_callback == _az_json_writer_sink_allocator);
+
+  if (ref_json_writer->_internal.bytes_written == 0)
+  {
+    return AZ_OK;
+  }
+
+  // Ask for the other buffer, as the writer would once the current one is full.
+  az_span_allocator_context context = {
+    .user_context = ref_json_writer->_internal.user_context,
+    .bytes_used = ref_json_writer->_internal.bytes_written,
+    .minimum_required_size = 0,
+  };
+
+  az_span next_destination = AZ_SPAN_EMPTY;
+  _az_RETURN_IF_FAILED(_az_json_writer_sink_allocator(&context, &next_destination));
+
+  ref_json_writer->_internal.destination_buffer = next_destination;
+  ref_json_writer->_internal.bytes_written = 0;
+  return AZ_OK;
+}
+
 static AZ_NODISCARD az_span
 _get_remaining_span(az_json_writer* ref_json_writer, int32_t required_size)
 {
@@ -204,7 +289,7 @@ static AZ_NODISCARD bool _az_is_appending_container_end_valid(
 // If no chars need to be escaped then return the size of value with the out parameter set to -1.
 // If break_on_first_escaped is set to true, then it returns as soon as the first character to
 // escape is found.
-static int32_t _az_json_writer_escaped_length(
+int32_t _az_json_writer_escaped_length(
     az_span value,
     int32_t* out_index_of_first_escaped_char,
     bool break_on_first_escaped)
@@ -215,12 +300,20 @@ static int32_t _az_json_writer_escaped_length(
   int32_t value_size = az_span_size(value);
   _az_PRECONDITION(value_size <= _az_MAX_UNESCAPED_STRING_SIZE);
 
-  int32_t escaped_length = 0;
-  *out_index_of_first_escaped_char = -1;
-
-  int32_t i = 0;
   uint8_t* value_ptr = az_span_ptr(value);
 
+  // In most common cases, such as device IDs and enum values, nothing needs to be escaped, which
+  // the scan finds out 16 bytes at a time (when SIMD is enabled).
+  int32_t i = _az_json_string_scan(value_ptr, value_size);
+  if (i == value_size)
+  {
+    *out_index_of_first_escaped_char = -1;
+    return value_size;
+  }
+
+  *out_index_of_first_escaped_char = i;
+
+  int32_t escaped_length = i;
   while (i < value_size)
   {
     uint8_t const ch = value_ptr[i];
@@ -240,36 +333,26 @@ static int32_t _az_json_writer_escaped_length(
       }
       default:
       {
-        // Check if the character has to be escaped as a UNICODE escape sequence.
-        if (ch < _az_ASCII_SPACE_CHARACTER)
-        {
-          escaped_length += _az_MAX_EXPANSION_FACTOR_WHILE_ESCAPING;
-        }
-        else
-        {
-          escaped_length++; // No escaping required.
-        }
+        // Everything else the scan stops at has to be escaped as a UNICODE escape sequence.
+        escaped_length += _az_MAX_EXPANSION_FACTOR_WHILE_ESCAPING;
         break;
       }
     }
 
     i++;
 
-    // If this is the first time that we found a character that needs to be escaped,
-    // set out_index_of_first_escaped_char to the corresponding index.
-    // If escaped_length == i, then we haven't found a character that needs to be escaped yet.
-    if (escaped_length != i && *out_index_of_first_escaped_char == -1)
+    if (break_on_first_escaped)
     {
-      *out_index_of_first_escaped_char = i - 1;
-      if (break_on_first_escaped)
-      {
-        break;
-      }
+      break;
     }
 
+    // Skip over the run of characters that don't need to be escaped, up to the next one that does.
+    int32_t const run_length = _az_json_string_scan(value_ptr + i, value_size - i);
+    escaped_length += run_length;
+    i += run_length;
+
     // If the length overflows, in case the precondition is not honored, stop processing and break
     // The caller will return AZ_ERROR_NOT_ENOUGH_SPACE since az_span can't contain it.
-    // TODO: Consider removing this if it is too costly.
     if (escaped_length < 0)
     {
       escaped_length = INT32_MAX;
@@ -277,8 +360,6 @@ static int32_t _az_json_writer_escaped_length(
     }
   }
 
-  // In most common cases, escaped_length will equal value_size and out_index_of_first_escaped_char
-  // will be -1.
   return escaped_length;
 }
 
@@ -360,7 +441,7 @@ static int32_t _az_json_writer_escape_next_byte_and_copy(
   return written;
 }
 
-static AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination, az_span source)
+AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination, az_span source)
 {
   _az_PRECONDITION_VALID_SPAN(source, 1, false);
 
@@ -375,9 +456,21 @@ static AZ_NODISCARD az_span _az_json_writer_escape_and_copy(az_span destination,
 
   while (i < src_size)
   {
-    uint8_t const ch = value_ptr[i];
-    _az_json_writer_escape_next_byte_and_copy(&remaining_destination, ch);
-    i++;
+    // Bulk copy the run of characters that don't need to be escaped, if any, and then escape the
+    // character that ends it.
+    int32_t const run_length = _az_json_string_scan(value_ptr + i, src_size - i);
+    if (run_length > 0)
+    {
+      remaining_destination
+          = az_span_copy(remaining_destination, az_span_create(value_ptr + i, run_length));
+      i += run_length;
+    }
+
+    if (i < src_size)
+    {
+      _az_json_writer_escape_next_byte_and_copy(&remaining_destination, value_ptr[i]);
+      i++;
+    }
   }
 
   return remaining_destination;
@@ -714,41 +807,6 @@ az_json_writer_append_property_name(az_json_writer* ref_json_writer, az_span nam
   return az_json_writer_append_property_name_chunked(ref_json_writer, name);
 }
 
-static AZ_NODISCARD az_result _az_validate_json(
-    az_span json_text,
-    az_json_token_kind* first_token_kind,
-    az_json_token_kind* last_token_kind)
-{
-  _az_PRECONDITION_NOT_NULL(first_token_kind);
-
-  az_json_reader reader = { 0 };
-  _az_RETURN_IF_FAILED(az_json_reader_init(&reader, json_text, NULL));
-
-  az_result result = az_json_reader_next_token(&reader);
-  _az_RETURN_IF_FAILED(result);
-
-  // This is guaranteed not to be a property name or end object/array.
-  // The first token of a valid JSON must either be a value or start object/array.
-  *first_token_kind = reader.token.kind;
-
-  // Keep reading until we have finished validating the entire JSON text and make sure it isn't
-  // incomplete.
-  while (az_result_succeeded(result = az_json_reader_next_token(&reader)))
-  {
-  }
-
-  if (result != AZ_ERROR_JSON_READER_DONE)
-  {
-    return result;
-  }
-
-  // This is guaranteed not to be a property name or start object/array.
-  // The last token of a valid JSON must either be a value or end object/array.
-  *last_token_kind = reader.token.kind;
-
-  return AZ_OK;
-}
-
 AZ_NODISCARD az_result
 az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_text)
 {
@@ -756,17 +814,25 @@ az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_te
   // A null or empty span is not allowed since that is invalid JSON.
   _az_PRECONDITION_VALID_SPAN(json_text, 0, false);
 
-  az_json_token_kind first_token_kind = AZ_JSON_TOKEN_NONE;
-  az_json_token_kind last_token_kind = AZ_JSON_TOKEN_NONE;
-
   // This runtime validation is necessary since the input could be user defined and malformed.
   // This cannot be caught at dev time by a precondition, especially since they can be turned off.
-  _az_RETURN_IF_FAILED(_az_validate_json(json_text, &first_token_kind, &last_token_kind));
+  az_json_validated_text validated_text = { 0 };
+  _az_RETURN_IF_FAILED(az_json_validate(json_text, &validated_text));
 
-  // It is guaranteed that first_token_kind is NOT:
-  // AZ_JSON_TOKEN_NONE, AZ_JSON_TOKEN_END_ARRAY, AZ_JSON_TOKEN_END_OBJECT,
-  // AZ_JSON_TOKEN_PROPERTY_NAME
-  // And that last_token_kind is NOT:
+  return az_json_writer_append_validated_json_text(ref_json_writer, &validated_text);
+}
+
+AZ_NODISCARD az_result az_json_writer_append_validated_json_text(
+    az_json_writer* ref_json_writer,
+    az_json_validated_text const* validated_text)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_NOT_NULL(validated_text);
+  _az_PRECONDITION_VALID_SPAN(validated_text->_internal.json_text, 1, false);
+
+  az_span const json_text = validated_text->_internal.json_text;
+
+  // It is guaranteed that the last token kind is NOT:
   // AZ_JSON_TOKEN_NONE, AZ_JSON_TOKEN_START_ARRAY, AZ_JSON_TOKEN_START_OBJECT,
   // AZ_JSON_TOKEN_PROPERTY_NAME
 
@@ -775,7 +841,6 @@ az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_te
   if (!_az_is_appending_value_valid(ref_json_writer))
   {
     // All other tokens, including start array and object are validated here.
-    // Also first_token_kind cannot be AZ_JSON_TOKEN_NONE at this point.
     return AZ_ERROR_JSON_INVALID_STATE;
   }
 
@@ -801,7 +866,8 @@ az_json_writer_append_json_text(az_json_writer* ref_json_writer, az_span json_te
   // Therefore, need_comma must be true after appending the json_text.
 
   // We already tracked and updated bytes_written while writing, so no need to update it here.
-  _az_update_json_writer_state(ref_json_writer, 0, required_size, true, last_token_kind);
+  _az_update_json_writer_state(
+      ref_json_writer, 0, required_size, true, validated_text->_internal.last_token_kind);
   return AZ_OK;
 }
 
@@ -887,6 +953,131 @@ AZ_NODISCARD az_result az_json_writer_append_int32(az_json_writer* ref_json_writ
   return AZ_OK;
 }
 
+AZ_NODISCARD az_result az_json_writer_append_int64(az_json_writer* ref_json_writer, int64_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
+
+  int32_t required_size = _az_MAX_SIZE_FOR_INT64; // Need enough space to write any 64-bit integer.
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+  }
+
+  // Since we asked for the maximum needed space above, this is guaranteed not to fail due to
+  // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
+  // cases.
+  az_span leftover;
+  _az_RETURN_IF_FAILED(az_span_i64toa(remaining_json, value, &leftover));
+
+  // We already accounted for the maximum size needed in required_size, so subtract that to get the
+  // actual bytes written.
+  int32_t written
+      = required_size + _az_span_diff(leftover, remaining_json) - _az_MAX_SIZE_FOR_INT64;
+  _az_update_json_writer_state(ref_json_writer, written, written, true, AZ_JSON_TOKEN_NUMBER);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_writer_append_uint64(az_json_writer* ref_json_writer, uint64_t value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
+
+  int32_t required_size = _az_MAX_SIZE_FOR_UINT64; // Need enough space to write any 64-bit integer.
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+  }
+
+  // Since we asked for the maximum needed space above, this is guaranteed not to fail due to
+  // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
+  // cases.
+  az_span leftover;
+  _az_RETURN_IF_FAILED(az_span_u64toa(remaining_json, value, &leftover));
+
+  // We already accounted for the maximum size needed in required_size, so subtract that to get the
+  // actual bytes written.
+  int32_t written
+      = required_size + _az_span_diff(leftover, remaining_json) - _az_MAX_SIZE_FOR_UINT64;
+  _az_update_json_writer_state(ref_json_writer, written, written, true, AZ_JSON_TOKEN_NUMBER);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result
+az_json_writer_append_number_text(az_json_writer* ref_json_writer, az_span number_text)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_VALID_SPAN(number_text, 1, false);
+  // Only the first byte is checked, since the caller is trusted to provide a valid JSON number.
+  _az_PRECONDITION(
+      az_span_ptr(number_text)[0] == '-'
+      || (az_span_ptr(number_text)[0] >= '0' && az_span_ptr(number_text)[0] <= '9'));
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
+
+  int32_t required_size = az_span_size(number_text);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  // A chunked writer can't be asked for more than a chunk at once, so longer text is written in
+  // pieces, the same way long strings are.
+  if (required_size > _az_MINIMUM_STRING_CHUNK_SIZE
+      && ref_json_writer->_internal.allocator_callback != NULL)
+  {
+    az_span remaining_json
+        = _get_remaining_span(ref_json_writer, _az_MINIMUM_STRING_CHUNK_SIZE);
+    _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, _az_MINIMUM_STRING_CHUNK_SIZE);
+
+    if (ref_json_writer->_internal.need_comma)
+    {
+      remaining_json = az_span_copy_u8(remaining_json, ',');
+      ref_json_writer->_internal.bytes_written++;
+    }
+
+    _az_RETURN_IF_FAILED(
+        az_json_writer_span_copy_chunked(ref_json_writer, &remaining_json, number_text));
+
+    // We already tracked and updated bytes_written while writing, so no need to update it here.
+    _az_update_json_writer_state(ref_json_writer, 0, required_size, true, AZ_JSON_TOKEN_NUMBER);
+    return AZ_OK;
+  }
+
+  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+  }
+
+  az_span_copy(remaining_json, number_text);
+
+  _az_update_json_writer_state(
+      ref_json_writer, required_size, required_size, true, AZ_JSON_TOKEN_NUMBER);
+  return AZ_OK;
+}
+
 AZ_NODISCARD az_result az_json_writer_append_double(
     az_json_writer* ref_json_writer,
     double value,
@@ -929,6 +1120,45 @@ AZ_NODISCARD az_result az_json_writer_append_double(
   return AZ_OK;
 }
 
+AZ_NODISCARD az_result
+az_json_writer_append_double_round_trip(az_json_writer* ref_json_writer, double value)
+{
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(_az_is_appending_value_valid(ref_json_writer));
+  // Non-finite numbers are not supported because they lead to invalid JSON.
+  // Unquoted strings such as nan and -inf are invalid as JSON numbers.
+  _az_PRECONDITION(_az_isfinite(value));
+
+  // Need enough space to write any double number.
+  int32_t required_size = _az_MAX_SIZE_FOR_WRITING_DOUBLE_ROUND_TRIP;
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    required_size++; // For the leading comma separator.
+  }
+
+  az_span remaining_json = _get_remaining_span(ref_json_writer, required_size);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(remaining_json, required_size);
+
+  if (ref_json_writer->_internal.need_comma)
+  {
+    remaining_json = az_span_copy_u8(remaining_json, ',');
+  }
+
+  // Since we asked for the maximum needed space above, this is guaranteed not to fail due to
+  // AZ_ERROR_NOT_ENOUGH_SPACE. Still checking the returned az_result, for other potential failure
+  // cases.
+  az_span leftover;
+  _az_RETURN_IF_FAILED(az_span_dtoa_round_trip(remaining_json, value, &leftover));
+
+  // We already accounted for the maximum size needed in required_size, so subtract that to get the
+  // actual bytes written.
+  int32_t written = required_size + _az_span_diff(leftover, remaining_json)
+      - _az_MAX_SIZE_FOR_WRITING_DOUBLE_ROUND_TRIP;
+  _az_update_json_writer_state(ref_json_writer, written, written, true, AZ_JSON_TOKEN_NUMBER);
+  return AZ_OK;
+}
+
 static AZ_NODISCARD az_result _az_json_writer_append_container_start(
     az_json_writer* ref_json_writer,
     uint8_t byte,
@@ -0,0 +1,281 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include <azure/core/az_precondition.h>
+#include <azure/core/az_sha256.h>
+#include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
+#include <azure/core/internal/az_span_internal.h>
+
+#include <string.h>
+
+#include <azure/core/_az_cfg.h>
+
+#define _az_HMAC_INNER_PAD 0x36
+#define _az_HMAC_OUTER_PAD 0x5C
+
+// The first 32 bits of the fractional parts of the cube roots of the first 64 primes.
+static uint32_t const _az_sha256_round_constants[64] = {
+  0x428a2f98, 0x71374491, 0xb5c0fbcf, 0xe9b5dba5, 0x3956c25b, 0x59f111f1, 0x923f82a4, 0xab1c5ed5,
+  0xd807aa98, 0x12835b01, 0x243185be, 0x550c7dc3, 0x72be5d74, 0x80deb1fe, 0x9bdc06a7, 0xc19bf174,
+  0xe49b69c1, 0xefbe4786, 0x0fc19dc6, 0x240ca1cc, 0x2de92c6f, 0x4a7484aa, 0x5cb0a9dc, 0x76f988da,
+  0x983e5152, 0xa831c66d, 0xb00327c8, 0xbf597fc7, 0xc6e00bf3, 0xd5a79147, 0x06ca6351, 0x14292967,
+  0x27b70a85, 0x2e1b2138, 0x4d2c6dfc, 0x53380d13, 0x650a7354, 0x766a0abb, 0x81c2c92e, 0x92722c85,
+  0xa2bfe8a1, 0xa81a664b, 0xc24b8b70, 0xc76c51a3, 0xd192e819, 0xd6990624, 0xf40e3585, 0x106aa070,
+  0x19a4c116, 0x1e376c08, 0x2748774c, 0x34b0bcb5, 0x391c0cb3, 0x4ed8aa4a, 0x5b9cca4f, 0x682e6ff3,
+  0x748f82ee, 0x78a5636f, 0x84c87814, 0x8cc70208, 0x90befffa, 0xa4506ceb, 0xbef9a3f7, 0xc67178f2,
+};
+
+// The first 32 bits of the fractional parts of the square roots of the first 8 primes.
+static uint32_t const _az_sha256_initial_state[8] = {
+  0x6a09e667, 0xbb67ae85, 0x3c6ef372, 0xa54ff53a, 0x510e527f, 0x9b05688c, 0x1f83d9ab, 0x5be0cd19,
+};
+
+AZ_NODISCARD AZ_INLINE uint32_t _az_sha256_rotr(uint32_t value, uint32_t count)
+{
+  return (value >> count) | (value << (32U - count));
+}
+
+AZ_NODISCARD AZ_INLINE uint32_t _az_sha256_load_be32(uint8_t const* ptr)
+{
+  return ((uint32_t)ptr[0] << 24U) | ((uint32_t)ptr[1] << 16U) | ((uint32_t)ptr[2] << 8U)
+      | (uint32_t)ptr[3];
+}
+
+AZ_INLINE void _az_sha256_store_be32(uint8_t* ptr, uint32_t value)
+{
+  ptr[0] = (uint8_t)(value >> 24U);
+  ptr[1] = (uint8_t)(value >> 16U);
+  ptr[2] = (uint8_t)(value >> 8U);
+  ptr[3] = (uint8_t)value;
+}
+
+// Processes one 64 byte block. The message schedule is kept in a rolling window of 16 words,
+// rather than expanded up front into 64, to keep the stack small on constrained devices.
+static void _az_sha256_transform(uint32_t state[8], uint8_t const* block)
+{
+  uint32_t w[16];
+  for (int32_t i = 0; i < 16; i++)
+  {
+    w[i] = _az_sha256_load_be32(block + (i * 4));
+  }
+
+  uint32_t a = state[0];
+  uint32_t b = state[1];
+  uint32_t c = state[2];
+  uint32_t d = state[3];
+  uint32_t e = state[4];
+  uint32_t f = state[5];
+  uint32_t g = state[6];
+  uint32_t h = state[7];
+
+  for (int32_t i = 0; i < 64; i++)
+  {
+    if (i >= 16)
+    {
+      uint32_t const w15 = w[(i - 15) & 15];
+      uint32_t const w2 = w[(i - 2) & 15];
+      uint32_t const s0 = _az_sha256_rotr(w15, 7) ^ _az_sha256_rotr(w15, 18) ^ (w15 >> 3U);
+      uint32_t const s1 = _az_sha256_rotr(w2, 17) ^ _az_sha256_rotr(w2, 19) ^ (w2 >> 10U);
+      w[i & 15] += s0 + w[(i - 7) & 15] + s1;
+    }
+
+    uint32_t const sum1 = _az_sha256_rotr(e, 6) ^ _az_sha256_rotr(e, 11) ^ _az_sha256_rotr(e, 25);
+    uint32_t const choice = (e & f) ^ (~e & g);
+    uint32_t const temp1 = h + sum1 + choice + _az_sha256_round_constants[i] + w[i & 15];
+    uint32_t const sum0 = _az_sha256_rotr(a, 2) ^ _az_sha256_rotr(a, 13) ^ _az_sha256_rotr(a, 22);
+    uint32_t const majority = (a & b) ^ (a & c) ^ (b & c);
+    uint32_t const temp2 = sum0 + majority;
+
+    h = g;
+    g = f;
+    f = e;
+    e = d + temp1;
+    d = c;
+    c = b;
+    b = a;
+    a = temp1 + temp2;
+  }
+
+  state[0] += a;
+  state[1] += b;
+  state[2] += c;
+  state[3] += d;
+  state[4] += e;
+  state[5] += f;
+  state[6] += g;
+  state[7] += h;
+}
+
+AZ_NODISCARD az_result az_sha256_init(az_sha256* out_sha256)
+{
+  _az_PRECONDITION_NOT_NULL(out_sha256);
+
+  memcpy(
+      out_sha256->_internal.state, _az_sha256_initial_state, sizeof(_az_sha256_initial_state));
+  out_sha256->_internal.length = 0;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_sha256_update(az_sha256* ref_sha256, az_span data)
+{
+  _az_PRECONDITION_NOT_NULL(ref_sha256);
+
+  uint8_t const* data_ptr = az_span_ptr(data);
+  int32_t data_size = az_span_size(data);
+
+  int32_t const buffered = (int32_t)(ref_sha256->_internal.length % AZ_SHA256_BLOCK_SIZE);
+  ref_sha256->_internal.length += (uint64_t)data_size;
+
+  // Complete the partially filled block first, if any.
+  if (buffered > 0)
+  {
+    int32_t const needed = AZ_SHA256_BLOCK_SIZE - buffered;
+    if (data_size < needed)
+    {
+      if (data_size > 0)
+      {
+        memcpy(ref_sha256->_internal.block + buffered, data_ptr, (size_t)data_size);
+      }
+      return AZ_OK;
+    }
+
+    memcpy(ref_sha256->_internal.block + buffered, data_ptr, (size_t)needed);
+    _az_sha256_transform(ref_sha256->_internal.state, ref_sha256->_internal.block);
+    data_ptr += needed;
+    data_size -= needed;
+  }
+
+  // Whole blocks are hashed straight from the caller's buffer, without being copied.
+  while (data_size >= AZ_SHA256_BLOCK_SIZE)
+  {
+    _az_sha256_transform(ref_sha256->_internal.state, data_ptr);
+    data_ptr += AZ_SHA256_BLOCK_SIZE;
+    data_size -= AZ_SHA256_BLOCK_SIZE;
+  }
+
+  if (data_size > 0)
+  {
+    memcpy(ref_sha256->_internal.block, data_ptr, (size_t)data_size);
+  }
+
+  return AZ_OK;
+}
+
+// Pads the data hashed so far and writes the AZ_SHA256_HASH_SIZE bytes of the hash to destination.
+static void _az_sha256_finish(az_sha256* ref_sha256, uint8_t* destination)
+{
+  uint64_t const bit_length = ref_sha256->_internal.length * 8U;
+  int32_t buffered = (int32_t)(ref_sha256->_internal.length % AZ_SHA256_BLOCK_SIZE);
+  uint8_t* const block = ref_sha256->_internal.block;
+
+  // Append the 1 bit, then zeros up to the last 8 bytes of a block, which hold the bit length.
+  block[buffered++] = 0x80;
+  if (buffered > AZ_SHA256_BLOCK_SIZE - 8)
+  {
+    memset(block + buffered, 0, (size_t)(AZ_SHA256_BLOCK_SIZE - buffered));
+    _az_sha256_transform(ref_sha256->_internal.state, block);
+    buffered = 0;
+  }
+
+  memset(block + buffered, 0, (size_t)(AZ_SHA256_BLOCK_SIZE - 8 - buffered));
+  _az_sha256_store_be32(block + AZ_SHA256_BLOCK_SIZE - 8, (uint32_t)(bit_length >> 32U));
+  _az_sha256_store_be32(block + AZ_SHA256_BLOCK_SIZE - 4, (uint32_t)bit_length);
+  _az_sha256_transform(ref_sha256->_internal.state, block);
+
+  for (int32_t i = 0; i < 8; i++)
+  {
+    _az_sha256_store_be32(destination + (i * 4), ref_sha256->_internal.state[i]);
+  }
+}
+
+AZ_NODISCARD az_result az_sha256_final(az_sha256* ref_sha256, az_span destination)
+{
+  _az_PRECONDITION_NOT_NULL(ref_sha256);
+
+  if (az_span_size(destination) < AZ_SHA256_HASH_SIZE)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  _az_sha256_finish(ref_sha256, az_span_ptr(destination));
+  return AZ_OK;
+}
+
+// Derives the inner and outer hash states of an HMAC key. The buffers holding copies of the key are
+// provided by the caller, so that it can wipe them whether this succeeds or not.
+AZ_NODISCARD static az_result _az_hmac_sha256_key_derive(
+    az_hmac_sha256_key* out_key,
+    az_span key,
+    az_sha256* key_hash,
+    uint8_t padded_key[AZ_SHA256_BLOCK_SIZE],
+    uint8_t pad[AZ_SHA256_BLOCK_SIZE])
+{
+  // Keys longer than a block are replaced by their hash, and shorter ones are padded with zeros.
+  if (az_span_size(key) > AZ_SHA256_BLOCK_SIZE)
+  {
+    _az_RETURN_IF_FAILED(az_sha256_init(key_hash));
+    _az_RETURN_IF_FAILED(az_sha256_update(key_hash, key));
+    _az_sha256_finish(key_hash, padded_key);
+  }
+  else if (az_span_size(key) > 0)
+  {
+    memcpy(padded_key, az_span_ptr(key), (size_t)az_span_size(key));
+  }
+
+  az_span const pad_span = az_span_create(pad, AZ_SHA256_BLOCK_SIZE);
+
+  for (int32_t i = 0; i < AZ_SHA256_BLOCK_SIZE; i++)
+  {
+    pad[i] = (uint8_t)(padded_key[i] ^ _az_HMAC_INNER_PAD);
+  }
+  _az_RETURN_IF_FAILED(az_sha256_init(&out_key->_internal.inner));
+  _az_RETURN_IF_FAILED(az_sha256_update(&out_key->_internal.inner, pad_span));
+
+  for (int32_t i = 0; i < AZ_SHA256_BLOCK_SIZE; i++)
+  {
+    pad[i] = (uint8_t)(padded_key[i] ^ _az_HMAC_OUTER_PAD);
+  }
+  _az_RETURN_IF_FAILED(az_sha256_init(&out_key->_internal.outer));
+  _az_RETURN_IF_FAILED(az_sha256_update(&out_key->_internal.outer, pad_span));
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_hmac_sha256_key_init(az_hmac_sha256_key* out_key, az_span key)
+{
+  _az_PRECONDITION_NOT_NULL(out_key);
+
+  az_sha256 key_hash;
+  uint8_t padded_key[AZ_SHA256_BLOCK_SIZE] = { 0 };
+  uint8_t pad[AZ_SHA256_BLOCK_SIZE];
+  az_result const result = _az_hmac_sha256_key_derive(out_key, key, &key_hash, padded_key, pad);
+
+  // Don't leave copies of the secret key on the stack, including the state that hashes a long key.
+  _az_span_secure_zero(az_span_create((uint8_t*)&key_hash, (int32_t)sizeof(key_hash)));
+  _az_span_secure_zero(AZ_SPAN_FROM_BUFFER(padded_key));
+  _az_span_secure_zero(AZ_SPAN_FROM_BUFFER(pad));
+  return result;
+}
+
+AZ_NODISCARD az_result
+az_hmac_sha256_compute(az_hmac_sha256_key const* key, az_span message, az_span destination)
+{
+  _az_PRECONDITION_NOT_NULL(key);
+
+  if (az_span_size(destination) < AZ_SHA256_HASH_SIZE)
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  // Resume from the precomputed states, so the padded keys aren't hashed again.
+  uint8_t inner_hash[AZ_SHA256_HASH_SIZE];
+  az_sha256 sha256 = key->_internal.inner;
+  _az_RETURN_IF_FAILED(az_sha256_update(&sha256, message));
+  _az_sha256_finish(&sha256, inner_hash);
+
+  sha256 = key->_internal.outer;
+  _az_RETURN_IF_FAILED(az_sha256_update(&sha256, AZ_SPAN_FROM_BUFFER(inner_hash)));
+  _az_sha256_finish(&sha256, az_span_ptr(destination));
+  return AZ_OK;
+}
@@ -0,0 +1,223 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+/**
+ * @file
+ *
+ * @brief Defines private SIMD and bit manipulation helpers used to speed up byte scanning.
+ *
+ * @details The vector helpers operate on 16 byte blocks and are only available when
+ * `_az_SIMD_ENABLED` is defined, which is selected at compile time based on the target (SSE2 on
+ * x86/x64, NEON on ARM64). Defining `AZ_NO_SIMD` (or setting the CMake option `SIMD` to `OFF`)
+ * disables them, in which case callers fall back to portable scalar code.
+ *
+ * When the compiler targets SSSE3 or later on x86/x64 (for example, with `-mssse3` or
+ * `/arch:AVX`), `_az_SIMD_SSSE3` is also defined, for code that needs byte shuffles.
+ *
+ * @note You MUST NOT use any symbols (macros, functions, structures, enums, etc.)
+ * prefixed with an underscore ('_') directly in your application code. These symbols
+ * are part of Azure SDK's internal implementation; we do not document these symbols
+ * and they are subject to change in future versions of the SDK which would break your code.
+ */
+
+#ifndef _az_SIMD_PRIVATE_H
+#define _az_SIMD_PRIVATE_H
+
+#include <stdint.h>
+
+#ifdef _MSC_VER
+#include <intrin.h>
+#endif // _MSC_VER
+
+#ifndef AZ_NO_SIMD
+#if defined(__SSE2__) || defined(_M_X64) || (defined(_M_IX86_FP) && _M_IX86_FP >= 2)
+#include <emmintrin.h>
+#define _az_SIMD_SSE2
+#define _az_SIMD_ENABLED
+#if defined(__SSSE3__) || defined(__AVX__)
+#include <tmmintrin.h>
+#define _az_SIMD_SSSE3
+#endif
+#elif (defined(__ARM_NEON) || defined(_M_ARM64)) && (defined(__aarch64__) || defined(_M_ARM64))
+#include <arm_neon.h>
+#define _az_SIMD_NEON
+#define _az_SIMD_ENABLED
+#endif
+#endif // AZ_NO_SIMD
+
+#include <azure/core/_az_cfg_prefix.h>
+
+enum
+{
+  // The number of bytes processed at once by the vector helpers.
+  _az_SIMD_BLOCK_SIZE = 16,
+};
+
+/**
+ * @brief Returns the number of trailing zero bits in \p value, which must not be 0.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_ctz32(uint32_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (int32_t)__builtin_ctz(value);
+#elif defined(_MSC_VER)
+  unsigned long index = 0;
+  (void)_BitScanForward(&index, value);
+  return (int32_t)index;
+#else
+  int32_t count = 0;
+  while ((value & 1U) == 0)
+  {
+    value >>= 1U;
+    count++;
+  }
+  return count;
+#endif
+}
+
+/**
+ * @brief Returns the number of trailing zero bits in \p value, which must not be 0.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_ctz64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (int32_t)__builtin_ctzll(value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index = 0;
+  (void)_BitScanForward64(&index, value);
+  return (int32_t)index;
+#else
+  uint32_t const low = (uint32_t)value;
+  return low != 0 ? _az_ctz32(low) : 32 + _az_ctz32((uint32_t)(value >> 32U));
+#endif
+}
+
+/**
+ * @brief Returns the number of leading zero bits in \p value, which must not be 0.
+ */
+AZ_NODISCARD AZ_INLINE int32_t _az_clz64(uint64_t value)
+{
+#if defined(__GNUC__) || defined(__clang__)
+  return (int32_t)__builtin_clzll(value);
+#elif defined(_MSC_VER) && (defined(_M_X64) || defined(_M_ARM64))
+  unsigned long index = 0;
+  (void)_BitScanReverse64(&index, value);
+  return 63 - (int32_t)index;
+#else
+  int32_t count = 0;
+  while ((value >> 63U) == 0)
+  {
+    value <<= 1U;
+    count++;
+  }
+  return count;
+#endif
+}
+
+#ifdef _az_SIMD_ENABLED
+
+#ifdef _az_SIMD_SSE2
+typedef __m128i _az_simd_vector;
+#else // _az_SIMD_NEON
+typedef uint8x16_t _az_simd_vector;
+#endif
+
+// Loads 16 bytes from a potentially unaligned address.
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_load(uint8_t const* ptr)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_loadu_si128((__m128i const*)(void const*)ptr);
+#else
+  return vld1q_u8(ptr);
+#endif
+}
+
+// Stores 16 bytes to a potentially unaligned address.
+AZ_INLINE void _az_simd_store(uint8_t* ptr, _az_simd_vector value)
+{
+#ifdef _az_SIMD_SSE2
+  _mm_storeu_si128((__m128i*)(void*)ptr, value);
+#else
+  vst1q_u8(ptr, value);
+#endif
+}
+
+// Returns a vector with every lane set to byte.
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_splat(uint8_t byte)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_set1_epi8((char)byte);
+#else
+  return vdupq_n_u8(byte);
+#endif
+}
+
+// Lanes are set to 0xFF where a == b, and 0 otherwise.
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_eq(_az_simd_vector a, _az_simd_vector b)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_cmpeq_epi8(a, b);
+#else
+  return vceqq_u8(a, b);
+#endif
+}
+
+// Lanes are set to 0xFF where a <= b (as unsigned bytes), and 0 otherwise.
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_le(_az_simd_vector a, _az_simd_vector b)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_cmpeq_epi8(_mm_min_epu8(a, b), a);
+#else
+  return vcleq_u8(a, b);
+#endif
+}
+
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_or(_az_simd_vector a, _az_simd_vector b)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_or_si128(a, b);
+#else
+  return vorrq_u8(a, b);
+#endif
+}
+
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_and(_az_simd_vector a, _az_simd_vector b)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_and_si128(a, b);
+#else
+  return vandq_u8(a, b);
+#endif
+}
+
+AZ_NODISCARD AZ_INLINE _az_simd_vector _az_simd_xor(_az_simd_vector a, _az_simd_vector b)
+{
+#ifdef _az_SIMD_SSE2
+  return _mm_xor_si128(a, b);
+#else
+  return veorq_u8(a, b);
+#endif
+}
+
+// Collects the most significant bit of each lane into a 16-bit mask, where bit i corresponds to
+// lane i. The lanes are expected to be either 0 or 0xFF, as returned by the comparison helpers.
+AZ_NODISCARD AZ_INLINE uint32_t _az_simd_mask(_az_simd_vector value)
+{
+#ifdef _az_SIMD_SSE2
+  return (uint32_t)_mm_movemask_epi8(value);
+#else
+  static const uint8_t bit_weights[_az_SIMD_BLOCK_SIZE]
+      = { 1, 2, 4, 8, 16, 32, 64, 128, 1, 2, 4, 8, 16, 32, 64, 128 };
+  uint8x16_t bits = vandq_u8(value, vld1q_u8(bit_weights));
+  bits = vpaddq_u8(bits, bits);
+  bits = vpaddq_u8(bits, bits);
+  bits = vpaddq_u8(bits, bits);
+  return (uint32_t)vgetq_lane_u16(vreinterpretq_u16_u8(bits), 0);
+#endif
+}
+
+#endif // _az_SIMD_ENABLED
+
+#include <azure/core/_az_cfg_suffix.h>
+
+#endif // _az_SIMD_PRIVATE_H
@@ -2,6 +2,7 @@
 // SPDX-License-Identifier: MIT
 
 #include "az_hex_private.h"
+#include "az_simd_private.h"
 #include "az_span_private.h"
 #include <azure/core/az_precondition.h>
 #include <azure/core/az_span.h>
@@ -10,6 +11,7 @@
 #include <azure/core/internal/az_span_internal.h>
 
 #include <ctype.h>
+#include <float.h>
 #include <math.h>
 #include <stdbool.h>
 #include <stdint.h>
@@ -90,9 +92,36 @@ AZ_NODISCARD bool az_span_is_content_equal_ignoring_case(az_span span1, az_span
   {
     return false;
   }
-  for (int32_t i = 0; i < size; ++i)
+
+  uint8_t const* const ptr1 = az_span_ptr(span1);
+  uint8_t const* const ptr2 = az_span_ptr(span2);
+  int32_t i = 0;
+
+#ifdef _az_SIMD_ENABLED
+  // Bytes match if they are equal, or if they only differ by the ASCII case bit and are letters.
+  _az_simd_vector const case_bit = _az_simd_splat(_az_ASCII_LOWER_DIF);
+  _az_simd_vector const lower_a = _az_simd_splat('a');
+  _az_simd_vector const lower_z = _az_simd_splat('z');
+  for (; i + _az_SIMD_BLOCK_SIZE <= size; i += _az_SIMD_BLOCK_SIZE)
+  {
+    _az_simd_vector const block1 = _az_simd_load(ptr1 + i);
+    _az_simd_vector const block2 = _az_simd_load(ptr2 + i);
+    _az_simd_vector const folded = _az_simd_or(block1, case_bit);
+    _az_simd_vector const is_letter
+        = _az_simd_and(_az_simd_le(lower_a, folded), _az_simd_le(folded, lower_z));
+    _az_simd_vector const differ_by_case
+        = _az_simd_and(_az_simd_eq(_az_simd_xor(block1, block2), case_bit), is_letter);
+    _az_simd_vector const match = _az_simd_or(_az_simd_eq(block1, block2), differ_by_case);
+    if (_az_simd_mask(match) != 0xFFFFU)
+    {
+      return false;
+    }
+  }
+#endif // _az_SIMD_ENABLED
+
+  for (; i < size; ++i)
   {
-    if (_az_tolower(az_span_ptr(span1)[i]) != _az_tolower(az_span_ptr(span2)[i]))
+    if (_az_tolower(ptr1[i]) != _az_tolower(ptr2[i]))
     {
       return false;
     }
@@ -354,6 +383,136 @@ static bool _is_valid_start_of_double(uint8_t first_byte)
   return result;
 }
 
+// The powers of ten which are exactly representable as a double (5^22 is the largest power of five
+// that fits within the 53-bit mantissa).
+static const double _az_exact_powers_of_10[] = {
+  1e0,  1e1,  1e2,  1e3,  1e4,  1e5,  1e6,  1e7,  1e8,  1e9,  1e10, 1e11,
+  1e12, 1e13, 1e14, 1e15, 1e16, 1e17, 1e18, 1e19, 1e20, 1e21, 1e22,
+};
+
+// Parses the common form [+-]digits[.digits][(e|E)[+-]digits] when the decimal significand and the
+// power of ten are both exactly representable as doubles. A single multiplication or division is
+// then correctly rounded, so the result is the same as sscanf's (Clinger's fast path).
+// Returns false for any other input, including valid ones such as "1." or those with more than 19
+// significant digits, which are left to the general purpose, sscanf based, parsing.
+static bool _az_span_try_parse_double_fast(az_span source, double* out_number)
+{
+#if defined(FLT_EVAL_METHOD) && FLT_EVAL_METHOD == 0
+  uint8_t const* source_ptr = az_span_ptr(source);
+  int32_t const size = az_span_size(source);
+  int32_t i = 0;
+
+  bool const is_negative = source_ptr[0] == '-';
+  if (is_negative || source_ptr[0] == '+')
+  {
+    i++;
+  }
+
+  uint64_t significand = 0;
+  int32_t significant_digits = 0;
+  int32_t exponent = 0;
+  bool in_fraction = false;
+  int32_t digits_start = i;
+
+  while (i < size)
+  {
+    uint8_t const next_byte = source_ptr[i];
+    if (isdigit(next_byte))
+    {
+      if (significand != 0 || next_byte != '0')
+      {
+        // Anything beyond that many digits could overflow, and is rejected below anyway.
+        if (++significant_digits <= _az_MAX_SIGNIFICANT_DIGITS_FOR_FAST_PARSING)
+        {
+          significand = significand * _az_NUMBER_OF_DECIMAL_VALUES + (uint64_t)(next_byte - '0');
+        }
+      }
+
+      if (in_fraction)
+      {
+        exponent--;
+      }
+    }
+    else if (next_byte == '.' && !in_fraction && i > digits_start)
+    {
+      in_fraction = true;
+      digits_start = i + 1;
+    }
+    else
+    {
+      break;
+    }
+    i++;
+  }
+
+  // There must be at least one digit before, and after, the decimal point.
+  if (i == digits_start)
+  {
+    return false;
+  }
+
+  if (i < size && (source_ptr[i] == 'e' || source_ptr[i] == 'E'))
+  {
+    i++;
+    bool const is_negative_exponent = i < size && source_ptr[i] == '-';
+    if (i < size && (source_ptr[i] == '-' || source_ptr[i] == '+'))
+    {
+      i++;
+    }
+
+    int32_t const exponent_start = i;
+    int32_t explicit_exponent = 0;
+    for (; i < size && isdigit(source_ptr[i]); i++)
+    {
+      // The source is at most 99 bytes long, so once the exponent is that large, the number is out
+      // of range of the fast path regardless of its digits. Stop accumulating, to avoid overflow.
+      if (explicit_exponent < _az_MAX_SIZE_FOR_PARSING_DOUBLE)
+      {
+        explicit_exponent
+            = explicit_exponent * _az_NUMBER_OF_DECIMAL_VALUES + (source_ptr[i] - '0');
+      }
+    }
+
+    if (i == exponent_start)
+    {
+      return false;
+    }
+
+    exponent += is_negative_exponent ? -explicit_exponent : explicit_exponent;
+  }
+
+  if (i != size || significant_digits > _az_MAX_SIGNIFICANT_DIGITS_FOR_FAST_PARSING)
+  {
+    return false;
+  }
+
+  int32_t const max_exact_exponent
+      = (int32_t)(sizeof(_az_exact_powers_of_10) / sizeof(_az_exact_powers_of_10[0])) - 1;
+
+  double value = 0;
+  if (significand != 0)
+  {
+    if (significand > (UINT64_C(1) << 53U) || exponent < -max_exact_exponent
+        || exponent > max_exact_exponent)
+    {
+      return false;
+    }
+
+    value = (double)significand;
+    value = exponent < 0 ? value / _az_exact_powers_of_10[-exponent]
+                         : value * _az_exact_powers_of_10[exponent];
+  }
+
+  *out_number = is_negative ? -value : value;
+  return true;
+#else
+  // The fast path relies on each arithmetic operation rounding to double precision.
+  (void)source;
+  (void)out_number;
+  return false;
+#endif // FLT_EVAL_METHOD
+}
+
 // Disable the following warning just for this particular use case.
 // C4996: 'sscanf': This function or variable may be unsafe. Consider using sscanf_s instead.
 // C4710: 'sscanf': function not inlined
@@ -380,6 +539,11 @@ AZ_NODISCARD az_result az_span_atod(az_span source, double* out_number)
     return AZ_ERROR_UNEXPECTED_CHAR;
   }
 
+  if (_az_span_try_parse_double_fast(source, out_number))
+  {
+    return AZ_OK;
+  }
+
   // Stack based string to allow thread-safe mutation.
   // The length is 8 to allow space for the null-terminating character.
   // NOLINTNEXTLINE(readability-magic-numbers,  cppcoreguidelines-avoid-magic-numbers)
@@ -402,79 +566,255 @@ AZ_NODISCARD az_result az_span_atod(az_span source, double* out_number)
 #pragma warning(pop)
 #endif
 
-AZ_NODISCARD int32_t az_span_find(az_span source, az_span target)
+// Returns the start of the maximal suffix of target, minus one, for either the byte ordering or its
+// reverse, along with the period of that suffix, as computed by the Crochemore-Perrin algorithm.
+AZ_NODISCARD static int32_t _az_span_find_maximal_suffix(
+    uint8_t const* target,
+    int32_t target_size,
+    bool is_reversed,
+    int32_t* out_period)
 {
-  /* This function implements the Naive string-search algorithm.
-   * The rationale to use this algorithm instead of other potentially more
-   * performing ones (Rabin-Karp, e.g.) is due to no additional space needed.
-   * The logic:
-   * 1. The function will look into each position of `source` if it contains the same value as the
-   * first position of `target`.
-   * 2. If it does, it could be that the next bytes in `source` are a perfect match of the remaining
-   * bytes of `target`.
-   * 3. Being so, it loops through the remaining bytes of `target` and see if they match exactly the
-   * next bytes of `source`.
-   * 4. If the loop gets to the end (all bytes of `target` are evaluated), it means `target` indeed
-   * occurs in that position of `source`.
-   * 5. If the loop gets interrupted before cruising through the entire `target`, the function must
-   * go back to step 1. from  the next position in `source`.
-   *   The loop in 5. gets interrupted if
-   *     - a byte in `target` is different than `source`, in the expected corresponding position;
-   *     - the loop has reached the end of `source` (and there are still remaining bytes of `target`
-   *         to be checked).
-   */
+  int32_t suffix = -1;
+  int32_t j = 0;
+  int32_t k = 1;
+  int32_t period = 1;
 
-  int32_t source_size = az_span_size(source);
-  int32_t target_size = az_span_size(target);
-  const int32_t target_not_found = -1;
+  while (j + k < target_size)
+  {
+    uint8_t const a = target[j + k];
+    uint8_t const b = target[suffix + k];
+    if (is_reversed ? a > b : a < b)
+    {
+      j += k;
+      k = 1;
+      period = j - suffix;
+    }
+    else if (a == b)
+    {
+      if (k != period)
+      {
+        k++;
+      }
+      else
+      {
+        j += period;
+        k = 1;
+      }
+    }
+    else
+    {
+      suffix = j;
+      j = suffix + 1;
+      k = 1;
+      period = 1;
+    }
+  }
 
-  if (target_size == 0)
+  *out_period = period;
+  return suffix;
+}
+
+// The Two-Way algorithm (Crochemore and Perrin, 1991), which finds target in linear time and
+// constant space. Target is split at a critical position, and its right part is matched first, so
+// that on a mismatch, the search can skip ahead as far as the mismatch position (or the period of
+// target, once the right part matched) without missing an occurrence.
+AZ_NODISCARD static int32_t _az_span_find_two_way(
+    uint8_t const* source,
+    int32_t source_size,
+    uint8_t const* target,
+    int32_t target_size)
+{
+  int32_t period = 0;
+  int32_t reversed_period = 0;
+  int32_t split = _az_span_find_maximal_suffix(target, target_size, false, &period);
+  int32_t const reversed_split
+      = _az_span_find_maximal_suffix(target, target_size, true, &reversed_period);
+
+  if (reversed_split > split)
   {
-    return 0;
+    split = reversed_split;
+    period = reversed_period;
   }
 
-  if (source_size < target_size)
+  int32_t const last_position = source_size - target_size;
+
+  if (memcmp(target, target + period, (size_t)split + 1) == 0)
+  {
+    // Target is periodic, so after matching its right part, the part of the left one which overlaps
+    // the previous attempt is known to match already.
+    int32_t memory = -1;
+    for (int32_t j = 0; j <= last_position;)
+    {
+      int32_t i = (split > memory ? split : memory) + 1;
+      while (i < target_size && target[i] == source[i + j])
+      {
+        i++;
+      }
+
+      if (i < target_size)
+      {
+        j += i - split;
+        memory = -1;
+        continue;
+      }
+
+      i = split;
+      while (i > memory && target[i] == source[i + j])
+      {
+        i--;
+      }
+
+      if (i <= memory)
+      {
+        return j;
+      }
+
+      j += period;
+      memory = target_size - period - 1;
+    }
+  }
+  else
   {
-    return target_not_found;
+    // Otherwise, an occurrence can't overlap the previous attempt by more than either part of
+    // target.
+    int32_t const right_size = target_size - split - 1;
+    period = (split + 1 > right_size ? split + 1 : right_size) + 1;
+
+    for (int32_t j = 0; j <= last_position;)
+    {
+      int32_t i = split + 1;
+      while (i < target_size && target[i] == source[i + j])
+      {
+        i++;
+      }
+
+      if (i < target_size)
+      {
+        j += i - split;
+        continue;
+      }
+
+      i = split;
+      while (i >= 0 && target[i] == source[i + j])
+      {
+        i--;
+      }
+
+      if (i < 0)
+      {
+        return j;
+      }
+
+      j += period;
+    }
   }
 
-  uint8_t* source_ptr = az_span_ptr(source);
-  uint8_t* target_ptr = az_span_ptr(target);
+  return -1;
+}
+
+// Looks for the positions of source which hold both the first and last bytes of target (16 at a
+// time with SIMD), and only compares the bytes in between at those positions, which quickly finds
+// typical targets such as topic segments. Since inputs like long runs of the same byte make every
+// position a candidate, the number of bytes compared is limited to a multiple of the source bytes
+// scanned, beyond which the search is left to the Two-Way algorithm, from *out_resume_index.
+AZ_NODISCARD static int32_t _az_span_find_filtered(
+    uint8_t const* source,
+    int32_t source_size,
+    uint8_t const* target,
+    int32_t target_size,
+    int32_t* out_resume_index)
+{
+  int32_t const last = target_size - 1;
+  int32_t const last_position = source_size - target_size;
+  int32_t budget = 2 * target_size;
+  int32_t i = 0;
 
-  // This loop traverses `source` position by position (step 1.)
-  for (int32_t i = 0; i < (source_size - target_size + 1); i++)
+  *out_resume_index = -1;
+
+#ifdef _az_SIMD_ENABLED
+  _az_simd_vector const first_bytes = _az_simd_splat(target[0]);
+  _az_simd_vector const last_bytes = _az_simd_splat(target[last]);
+
+  for (; i + _az_SIMD_BLOCK_SIZE - 1 <= last_position; i += _az_SIMD_BLOCK_SIZE)
   {
-    // This is the check done in step 1. above.
-    if (source_ptr[i] == target_ptr[0])
+    uint32_t mask = _az_simd_mask(_az_simd_and(
+        _az_simd_eq(_az_simd_load(source + i), first_bytes),
+        _az_simd_eq(_az_simd_load(source + i + last), last_bytes)));
+
+    while (mask != 0)
     {
-      // The condition in step 2. has been satisfied.
-      int32_t j = 1;
-      // This is the loop defined in step 3.
-      // The loop must be broken if it reaches the ends of `target` (step 3.) OR `source`
-      // (step 5.).
-      for (; j < target_size && (i + j) < source_size; j++)
+      int32_t const candidate = i + _az_ctz32(mask);
+      if (last < 2 || memcmp(source + candidate + 1, target + 1, (size_t)last - 1) == 0)
       {
-        // Condition defined in step 5.
-        if (source_ptr[i + j] != target_ptr[j])
-        {
-          break;
-        }
+        return candidate;
       }
 
-      if (j == target_size)
+      budget -= last;
+      if (budget < 0)
       {
-        // All bytes in `target` have been checked and matched the corresponding bytes in `source`
-        // (from the start point `i`), so this is indeed an instance of `target` in that position
-        // of `source` (step 4.).
+        *out_resume_index = candidate + 1;
+        return -1;
+      }
+
+      mask &= mask - 1;
+    }
+
+    budget += 4 * _az_SIMD_BLOCK_SIZE;
+  }
+#endif // _az_SIMD_ENABLED
 
+  for (; i <= last_position; i++)
+  {
+    if (source[i] == target[0] && source[i + last] == target[last])
+    {
+      if (last < 2 || memcmp(source + i + 1, target + 1, (size_t)last - 1) == 0)
+      {
         return i;
       }
+
+      budget -= last;
+      if (budget < 0)
+      {
+        *out_resume_index = i + 1;
+        return -1;
+      }
     }
+
+    budget += 4;
+  }
+
+  return -1;
+}
+
+AZ_NODISCARD int32_t az_span_find(az_span source, az_span target)
+{
+  int32_t const source_size = az_span_size(source);
+  int32_t const target_size = az_span_size(target);
+
+  if (target_size == 0)
+  {
+    return 0;
+  }
+
+  if (source_size < target_size)
+  {
+    return -1;
+  }
+
+  uint8_t const* const source_ptr = az_span_ptr(source);
+  uint8_t const* const target_ptr = az_span_ptr(target);
+
+  int32_t resume_index = -1;
+  int32_t const index
+      = _az_span_find_filtered(source_ptr, source_size, target_ptr, target_size, &resume_index);
+  if (resume_index < 0 || source_size - resume_index < target_size)
+  {
+    return index;
   }
 
-  // If the function hasn't returned before, all positions
-  // of `source` have been evaluated but `target` could not be found.
-  return target_not_found;
+  int32_t const two_way_index = _az_span_find_two_way(
+      source_ptr + resume_index, source_size - resume_index, target_ptr, target_size);
+  return two_way_index < 0 ? -1 : resume_index + two_way_index;
 }
 
 az_span az_span_copy(az_span destination, az_span source)
@@ -563,36 +903,98 @@ AZ_INLINE uint8_t _az_decimal_to_ascii(uint8_t d)
   return (uint8_t)((uint32_t)('0' + d) & (uint8_t)UINT8_MAX);
 }
 
-static AZ_NODISCARD az_result _az_span_builder_append_uint64(az_span* ref_span, uint64_t n)
+// The two digit decimal representations of 0 through 99, i.e. "00", "01", ..., "99".
+static const char _az_decimal_digit_pairs[] = "0001020304050607080910111213141516171819"
+                                             "2021222324252627282930313233343536373839"
+                                             "4041424344454647484950515253545556575859"
+                                             "6061626364656667686970717273747576777879"
+                                             "8081828384858687888990919293949596979899";
+
+// The powers of 10 that fit in a uint64_t, from 10^0 to 10^19.
+static const uint64_t _az_powers_of_10[] = {
+  1ULL,
+  10ULL,
+  100ULL,
+  1000ULL,
+  10000ULL,
+  100000ULL,
+  1000000ULL,
+  10000000ULL,
+  100000000ULL,
+  1000000000ULL,
+  10000000000ULL,
+  100000000000ULL,
+  1000000000000ULL,
+  10000000000000ULL,
+  100000000000000ULL,
+  1000000000000000ULL,
+  10000000000000000ULL,
+  100000000000000000ULL,
+  1000000000000000000ULL,
+  _az_SMALLEST_20_DIGIT_NUMBER,
+};
+
+AZ_NODISCARD int32_t _az_span_u64toa_size(uint64_t number)
 {
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_span, 1);
+  // The number of bits needed for the number, multiplied by log10(2) (approximated as 1233 / 2^12),
+  // is either the number of digits, or one less than it. Setting the lowest bit accounts for 0,
+  // without changing the result for any other number.
+  number |= 1U;
+  int32_t const digit_count = ((64 - _az_clz64(number)) * 1233) >> 12U;
+  return digit_count + (number >= _az_powers_of_10[digit_count] ? 1 : 0);
+}
 
-  if (n == 0)
+// Writes the digits of n, ending right before end.
+static void _az_write_u32_digits(uint8_t* end, uint32_t n)
+{
+  // Write two digits at a time, starting from the least significant ones.
+  while (n >= 100)
   {
-    *ref_span = az_span_copy_u8(*ref_span, '0');
-    return AZ_OK;
+    uint32_t const pair_index = (n % 100) * 2;
+    n /= 100;
+    *--end = (uint8_t)_az_decimal_digit_pairs[pair_index + 1];
+    *--end = (uint8_t)_az_decimal_digit_pairs[pair_index];
   }
 
-  uint64_t div = _az_SMALLEST_20_DIGIT_NUMBER;
-  uint64_t nn = n;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT64;
-  while (nn / div == 0)
+  if (n >= _az_NUMBER_OF_DECIMAL_VALUES)
   {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
+    *--end = (uint8_t)_az_decimal_digit_pairs[n * 2 + 1];
+    *--end = (uint8_t)_az_decimal_digit_pairs[n * 2];
   }
+  else
+  {
+    *--end = _az_decimal_to_ascii((uint8_t)n);
+  }
+}
 
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_span, digit_count);
-
-  while (div > 1)
+// Writes the digits of n, ending right before end.
+static void _az_write_u64_digits(uint8_t* end, uint64_t n)
+{
+  // Peel off 8 digits at a time with 64-bit divisions, so that the rest (and most numbers, which
+  // fit in 32 bits to begin with) only needs the cheaper 32-bit ones.
+  while (n > UINT32_MAX)
   {
-    uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)(nn / div));
-    *ref_span = az_span_copy_u8(*ref_span, value_to_append);
-    nn %= div;
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
+    uint32_t low_digits = (uint32_t)(n % 100000000U);
+    n /= 100000000U;
+    for (int32_t i = 0; i < 4; i++)
+    {
+      uint32_t const pair_index = (low_digits % 100) * 2;
+      low_digits /= 100;
+      *--end = (uint8_t)_az_decimal_digit_pairs[pair_index + 1];
+      *--end = (uint8_t)_az_decimal_digit_pairs[pair_index];
+    }
   }
-  uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)nn);
-  *ref_span = az_span_copy_u8(*ref_span, value_to_append);
+
+  _az_write_u32_digits(end, (uint32_t)n);
+}
+
+static AZ_NODISCARD az_result _az_span_builder_append_uint64(az_span* ref_span, uint64_t n)
+{
+  int32_t const digit_count = _az_span_u64toa_size(n);
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_span, digit_count);
+
+  _az_write_u64_digits(az_span_ptr(*ref_span) + digit_count, n);
+  *ref_span = az_span_slice_to_end(*ref_span, digit_count);
   return AZ_OK;
 }
 
@@ -614,7 +1016,8 @@ AZ_NODISCARD az_result az_span_i64toa(az_span destination, int64_t source, az_sp
   {
     _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, 1);
     *out_span = az_span_copy_u8(destination, '-');
-    return _az_span_builder_append_uint64(out_span, (uint64_t)-source);
+    // Negate as unsigned, which is well defined for INT64_MIN as well.
+    return _az_span_builder_append_uint64(out_span, 0U - (uint64_t)source);
   }
 
   // make out_span point to destination before trying to write on it (might be an empty az_span or
@@ -626,38 +1029,11 @@ AZ_NODISCARD az_result az_span_i64toa(az_span destination, int64_t source, az_sp
 static AZ_NODISCARD az_result
 _az_span_builder_append_u32toa(az_span destination, uint32_t n, az_span* out_span)
 {
-  _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, 1);
-
-  if (n == 0)
-  {
-    *out_span = az_span_copy_u8(destination, '0');
-    return AZ_OK;
-  }
-
-  uint32_t div = _az_SMALLEST_10_DIGIT_NUMBER;
-  uint32_t nn = n;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT32;
-  while (nn / div == 0)
-  {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
-  }
-
+  int32_t const digit_count = _az_span_u64toa_size(n);
   _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, digit_count);
 
-  *out_span = destination;
-
-  while (div > 1)
-  {
-    uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)(nn / div));
-    *out_span = az_span_copy_u8(*out_span, value_to_append);
-
-    nn %= div;
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-  }
-
-  uint8_t value_to_append = _az_decimal_to_ascii((uint8_t)nn);
-  *out_span = az_span_copy_u8(*out_span, value_to_append);
+  _az_write_u32_digits(az_span_ptr(destination) + digit_count, n);
+  *out_span = az_span_slice_to_end(destination, digit_count);
   return AZ_OK;
 }
 
@@ -679,7 +1055,9 @@ AZ_NODISCARD az_result az_span_i32toa(az_span destination, int32_t source, az_sp
   {
     _az_RETURN_IF_NOT_ENOUGH_SIZE(*out_span, 1);
     *out_span = az_span_copy_u8(*out_span, '-');
-    source = -source;
+
+    // Negate as unsigned, which is well defined for INT32_MIN as well.
+    return _az_span_builder_append_u32toa(*out_span, 0U - (uint32_t)source, out_span);
   }
 
   return _az_span_builder_append_u32toa(*out_span, (uint32_t)source, out_span);
@@ -787,6 +1165,430 @@ az_span_dtoa(az_span destination, double source, int32_t fractional_digits, az_s
   return _az_span_builder_append_uint64(out_span, fractional_part);
 }
 
+// A floating point number, f * 2^e, with a 64-bit significand, as used by the Grisu algorithms
+// described in "Printing Floating-Point Numbers Quickly and Accurately with Integers" (Loitsch).
+typedef struct
+{
+  uint64_t f;
+  int32_t e;
+} _az_diy_fp;
+
+// A normalized approximation of 10^k, i.e. f * 2^e.
+typedef struct
+{
+  uint64_t f;
+  int16_t e;
+  int16_t k;
+} _az_cached_power;
+
+enum
+{
+  // The binary exponent range targeted when scaling by a cached power of ten, so that the integral
+  // part of the scaled value fits within 32 bits.
+  _az_GRISU_ALPHA = -60,
+  _az_GRISU_GAMMA = -32,
+
+  // The decimal exponent of the first cached power, and the step between consecutive ones.
+  _az_CACHED_POWERS_MIN_DECIMAL_EXPONENT = -300,
+  _az_CACHED_POWERS_DECIMAL_EXPONENT_STEP = 8,
+
+  // The number of explicitly stored bits in the significand of a double.
+  _az_DOUBLE_SIGNIFICAND_BITS = 52,
+  _az_DOUBLE_EXPONENT_BIAS = 1075, // 1023 + 52
+
+  // A double never needs more than 17 significant digits to round-trip.
+  _az_MAX_SIGNIFICANT_DIGITS_FOR_DOUBLE = 17,
+
+  // Numbers whose decimal point falls within this range are written without an exponent.
+  _az_MIN_DECIMAL_POINT_WITHOUT_EXPONENT = -5,
+  _az_MAX_DECIMAL_POINT_WITHOUT_EXPONENT = 21,
+};
+
+// Powers of ten from 10^-300 to 10^324, rounded to a 64-bit significand.
+static const _az_cached_power _az_cached_powers[] = {
+    { 0xAB70FE17C79AC6CA, -1060, -300 },
+    { 0xFF77B1FCBEBCDC4F, -1034, -292 },
+    { 0xBE5691EF416BD60C, -1007, -284 },
+    { 0x8DD01FAD907FFC3C, -980, -276 },
+    { 0xD3515C2831559A83, -954, -268 },
+    { 0x9D71AC8FADA6C9B5, -927, -260 },
+    { 0xEA9C227723EE8BCB, -901, -252 },
+    { 0xAECC49914078536D, -874, -244 },
+    { 0x823C12795DB6CE57, -847, -236 },
+    { 0xC21094364DFB5637, -821, -228 },
+    { 0x9096EA6F3848984F, -794, -220 },
+    { 0xD77485CB25823AC7, -768, -212 },
+    { 0xA086CFCD97BF97F4, -741, -204 },
+    { 0xEF340A98172AACE5, -715, -196 },
+    { 0xB23867FB2A35B28E, -688, -188 },
+    { 0x84C8D4DFD2C63F3B, -661, -180 },
+    { 0xC5DD44271AD3CDBA, -635, -172 },
+    { 0x936B9FCEBB25C996, -608, -164 },
+    { 0xDBAC6C247D62A584, -582, -156 },
+    { 0xA3AB66580D5FDAF6, -555, -148 },
+    { 0xF3E2F893DEC3F126, -529, -140 },
+    { 0xB5B5ADA8AAFF80B8, -502, -132 },
+    { 0x87625F056C7C4A8B, -475, -124 },
+    { 0xC9BCFF6034C13053, -449, -116 },
+    { 0x964E858C91BA2655, -422, -108 },
+    { 0xDFF9772470297EBD, -396, -100 },
+    { 0xA6DFBD9FB8E5B88F, -369, -92 },
+    { 0xF8A95FCF88747D94, -343, -84 },
+    { 0xB94470938FA89BCF, -316, -76 },
+    { 0x8A08F0F8BF0F156B, -289, -68 },
+    { 0xCDB02555653131B6, -263, -60 },
+    { 0x993FE2C6D07B7FAC, -236, -52 },
+    { 0xE45C10C42A2B3B06, -210, -44 },
+    { 0xAA242499697392D3, -183, -36 },
+    { 0xFD87B5F28300CA0E, -157, -28 },
+    { 0xBCE5086492111AEB, -130, -20 },
+    { 0x8CBCCC096F5088CC, -103, -12 },
+    { 0xD1B71758E219652C, -77, -4 },
+    { 0x9C40000000000000, -50, 4 },
+    { 0xE8D4A51000000000, -24, 12 },
+    { 0xAD78EBC5AC620000, 3, 20 },
+    { 0x813F3978F8940984, 30, 28 },
+    { 0xC097CE7BC90715B3, 56, 36 },
+    { 0x8F7E32CE7BEA5C70, 83, 44 },
+    { 0xD5D238A4ABE98068, 109, 52 },
+    { 0x9F4F2726179A2245, 136, 60 },
+    { 0xED63A231D4C4FB27, 162, 68 },
+    { 0xB0DE65388CC8ADA8, 189, 76 },
+    { 0x83C7088E1AAB65DB, 216, 84 },
+    { 0xC45D1DF942711D9A, 242, 92 },
+    { 0x924D692CA61BE758, 269, 100 },
+    { 0xDA01EE641A708DEA, 295, 108 },
+    { 0xA26DA3999AEF774A, 322, 116 },
+    { 0xF209787BB47D6B85, 348, 124 },
+    { 0xB454E4A179DD1877, 375, 132 },
+    { 0x865B86925B9BC5C2, 402, 140 },
+    { 0xC83553C5C8965D3D, 428, 148 },
+    { 0x952AB45CFA97A0B3, 455, 156 },
+    { 0xDE469FBD99A05FE3, 481, 164 },
+    { 0xA59BC234DB398C25, 508, 172 },
+    { 0xF6C69A72A3989F5C, 534, 180 },
+    { 0xB7DCBF5354E9BECE, 561, 188 },
+    { 0x88FCF317F22241E2, 588, 196 },
+    { 0xCC20CE9BD35C78A5, 614, 204 },
+    { 0x98165AF37B2153DF, 641, 212 },
+    { 0xE2A0B5DC971F303A, 667, 220 },
+    { 0xA8D9D1535CE3B396, 694, 228 },
+    { 0xFB9B7CD9A4A7443C, 720, 236 },
+    { 0xBB764C4CA7A44410, 747, 244 },
+    { 0x8BAB8EEFB6409C1A, 774, 252 },
+    { 0xD01FEF10A657842C, 800, 260 },
+    { 0x9B10A4E5E9913129, 827, 268 },
+    { 0xE7109BFBA19C0C9D, 853, 276 },
+    { 0xAC2820D9623BF429, 880, 284 },
+    { 0x80444B5E7AA7CF85, 907, 292 },
+    { 0xBF21E44003ACDD2D, 933, 300 },
+    { 0x8E679C2F5E44FF8F, 960, 308 },
+    { 0xD433179D9C8CB841, 986, 316 },
+    { 0x9E19DB92B4E31BA9, 1013, 324 },
+};
+
+AZ_NODISCARD static _az_diy_fp _az_diy_fp_multiply(_az_diy_fp x, _az_diy_fp y)
+{
+  // Computes the upper 64 bits of the 128-bit product (rounded), using 32-bit halves.
+  uint64_t const x_low = x.f & UINT32_MAX;
+  uint64_t const x_high = x.f >> 32U;
+  uint64_t const y_low = y.f & UINT32_MAX;
+  uint64_t const y_high = y.f >> 32U;
+
+  uint64_t const low_low = x_low * y_low;
+  uint64_t const low_high = x_low * y_high;
+  uint64_t const high_low = x_high * y_low;
+  uint64_t const high_high = x_high * y_high;
+
+  uint64_t middle = (low_low >> 32U) + (low_high & UINT32_MAX) + (high_low & UINT32_MAX);
+  middle += UINT64_C(1) << 31U;
+
+  return (_az_diy_fp){
+    .f = high_high + (low_high >> 32U) + (high_low >> 32U) + (middle >> 32U),
+    .e = x.e + y.e + 64,
+  };
+}
+
+AZ_NODISCARD static _az_diy_fp _az_diy_fp_normalize(_az_diy_fp x)
+{
+  while ((x.f >> 63U) == 0)
+  {
+    x.f <<= 1U;
+    x.e--;
+  }
+  return x;
+}
+
+// Moves the last digit towards the value being written, while it stays within the rounding
+// interval, so that the shortest representation is also the closest one.
+static void _az_grisu2_round(
+    uint8_t* digits,
+    int32_t length,
+    uint64_t distance,
+    uint64_t delta,
+    uint64_t rest,
+    uint64_t ten_k)
+{
+  while (rest < distance && delta - rest >= ten_k
+         && (rest + ten_k < distance || distance - rest > rest + ten_k - distance))
+  {
+    digits[length - 1]--;
+    rest += ten_k;
+  }
+}
+
+// Generates the shortest digits of a number within (low, high), where value is the one closest to
+// the number being written.
+static void _az_grisu2_generate_digits(
+    uint8_t* digits,
+    int32_t* out_length,
+    int32_t* ref_decimal_exponent,
+    _az_diy_fp low,
+    _az_diy_fp value,
+    _az_diy_fp high)
+{
+  uint64_t delta = high.f - low.f;
+  uint64_t distance = high.f - value.f;
+
+  // Split high into its integral part (at most 32 bits, given the target exponent range) and its
+  // fractional part.
+  uint32_t const shift = (uint32_t)-high.e;
+  uint64_t const one = UINT64_C(1) << shift;
+  uint32_t integral = (uint32_t)(high.f >> shift);
+  uint64_t fractional = high.f & (one - 1);
+
+  uint32_t power_of_10 = 1;
+  int32_t remaining_digits = 1;
+  while (power_of_10 <= integral / _az_NUMBER_OF_DECIMAL_VALUES)
+  {
+    power_of_10 *= _az_NUMBER_OF_DECIMAL_VALUES;
+    remaining_digits++;
+  }
+
+  int32_t length = 0;
+  while (remaining_digits > 0)
+  {
+    digits[length++] = _az_decimal_to_ascii((uint8_t)(integral / power_of_10));
+    integral %= power_of_10;
+    remaining_digits--;
+
+    uint64_t const rest = ((uint64_t)integral << shift) + fractional;
+    if (rest <= delta)
+    {
+      *ref_decimal_exponent += remaining_digits;
+      _az_grisu2_round(digits, length, distance, delta, rest, (uint64_t)power_of_10 << shift);
+      *out_length = length;
+      return;
+    }
+
+    power_of_10 /= _az_NUMBER_OF_DECIMAL_VALUES;
+  }
+
+  // The integral part alone isn't precise enough, so continue with the fractional digits.
+  int32_t fractional_digits = 0;
+  do
+  {
+    fractional *= _az_NUMBER_OF_DECIMAL_VALUES;
+    digits[length++] = _az_decimal_to_ascii((uint8_t)(fractional >> shift));
+    fractional &= one - 1;
+    fractional_digits++;
+
+    delta *= _az_NUMBER_OF_DECIMAL_VALUES;
+    distance *= _az_NUMBER_OF_DECIMAL_VALUES;
+  } while (fractional > delta);
+
+  *ref_decimal_exponent -= fractional_digits;
+  _az_grisu2_round(digits, length, distance, delta, fractional, one);
+  *out_length = length;
+}
+
+// Writes the shortest (in all but rare cases) digits that uniquely identify the positive, finite,
+// value, such that value == digits * 10^decimal_exponent once parsed back.
+static void _az_grisu2(
+    double value,
+    uint8_t digits[_az_MAX_SIGNIFICANT_DIGITS_FOR_DOUBLE],
+    int32_t* out_length,
+    int32_t* out_decimal_exponent)
+{
+  uint64_t bits = 0;
+  // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+  memcpy(&bits, &value, sizeof(bits));
+
+  uint64_t const hidden_bit = UINT64_C(1) << _az_DOUBLE_SIGNIFICAND_BITS;
+  uint64_t const significand = bits & (hidden_bit - 1);
+  int32_t const biased_exponent = (int32_t)(bits >> _az_DOUBLE_SIGNIFICAND_BITS);
+
+  // Subnormal numbers don't have the implicit leading 1 bit.
+  _az_diy_fp const v = biased_exponent == 0
+      ? (_az_diy_fp){ .f = significand, .e = 1 - _az_DOUBLE_EXPONENT_BIAS }
+      : (_az_diy_fp){ .f = significand + hidden_bit,
+                      .e = biased_exponent - _az_DOUBLE_EXPONENT_BIAS };
+
+  // The boundaries are half way between value and its neighbors, where the lower neighbor is closer
+  // when value is a power of two.
+  bool const is_lower_boundary_closer = significand == 0 && biased_exponent > 1;
+  _az_diy_fp const high = _az_diy_fp_normalize((_az_diy_fp){ .f = 2 * v.f + 1, .e = v.e - 1 });
+  _az_diy_fp low = is_lower_boundary_closer
+      ? (_az_diy_fp){ .f = 4 * v.f - 1, .e = v.e - 2 }
+      : (_az_diy_fp){ .f = 2 * v.f - 1, .e = v.e - 1 };
+  low.f <<= (uint32_t)(low.e - high.e);
+  low.e = high.e;
+
+  // Find the cached power of ten, c = 10^-k, such that high * c has a binary exponent within
+  // [alpha, gamma]. 78913 / 2^18 approximates log10(2).
+  int32_t const f = _az_GRISU_ALPHA - high.e - 1;
+  int32_t const k = (f * 78913) / (1 << 18) + (f > 0 ? 1 : 0);
+  int32_t const index = (k - _az_CACHED_POWERS_MIN_DECIMAL_EXPONENT
+                         + (_az_CACHED_POWERS_DECIMAL_EXPONENT_STEP - 1))
+      / _az_CACHED_POWERS_DECIMAL_EXPONENT_STEP;
+  _az_cached_power const cached = _az_cached_powers[index];
+  _az_diy_fp const c = { .f = cached.f, .e = cached.e };
+
+  _az_diy_fp const scaled_value = _az_diy_fp_multiply(_az_diy_fp_normalize(v), c);
+  _az_diy_fp scaled_low = _az_diy_fp_multiply(low, c);
+  _az_diy_fp scaled_high = _az_diy_fp_multiply(high, c);
+
+  // Account for the imprecision of the cached power (and the multiplication), by only generating
+  // digits within the narrower interval.
+  scaled_low.f++;
+  scaled_high.f--;
+
+  *out_decimal_exponent = -cached.k;
+  _az_grisu2_generate_digits(
+      digits, out_length, out_decimal_exponent, scaled_low, scaled_value, scaled_high);
+}
+
+AZ_NODISCARD az_result
+az_span_dtoa_round_trip(az_span destination, double source, az_span* out_span)
+{
+  _az_PRECONDITION_VALID_SPAN(destination, 0, false);
+  // Inputs that are either positive or negative infinity, or not a number, are not supported.
+  _az_PRECONDITION(_az_isfinite(source));
+  _az_PRECONDITION_NOT_NULL(out_span);
+
+  *out_span = destination;
+
+  // The input is either positive or negative infinity, or not a number.
+  if (!_az_isfinite(source))
+  {
+    return AZ_ERROR_NOT_SUPPORTED;
+  }
+
+  uint8_t digits[_az_MAX_SIGNIFICANT_DIGITS_FOR_DOUBLE] = { '0' };
+  int32_t length = 1;
+  int32_t decimal_exponent = 0;
+
+  // Check the sign bit directly, so that -0 is written with its sign.
+  uint64_t source_bits = 0;
+  // NOLINTNEXTLINE(clang-analyzer-security.insecureAPI.DeprecatedOrUnsafeBufferHandling)
+  memcpy(&source_bits, &source, sizeof(source_bits));
+  bool const is_negative = (source_bits >> 63U) != 0;
+  // Ignoring the sign bit, zero is the only value with all bits clear.
+  if ((source_bits << 1U) != 0)
+  {
+    _az_grisu2(is_negative ? -source : source, digits, &length, &decimal_exponent);
+  }
+
+  // The position of the decimal point, relative to the first digit.
+  int32_t const decimal_point = length + decimal_exponent;
+  int32_t const exponent = decimal_point - 1;
+  int32_t const exponent_magnitude = exponent < 0 ? -exponent : exponent;
+  bool const use_exponent = decimal_point < _az_MIN_DECIMAL_POINT_WITHOUT_EXPONENT
+      || decimal_point > _az_MAX_DECIMAL_POINT_WITHOUT_EXPONENT;
+
+  int32_t required_size = is_negative ? 1 : 0;
+  if (use_exponent)
+  {
+    // d[.ddd]e(+|-)x[x[x]]
+    required_size += length + (length > 1 ? 1 : 0) + 3 + (exponent_magnitude >= 10 ? 1 : 0)
+        + (exponent_magnitude >= 100 ? 1 : 0);
+  }
+  else if (decimal_point <= 0)
+  {
+    // 0.[000]ddd
+    required_size += 2 - decimal_point + length;
+  }
+  else if (decimal_point < length)
+  {
+    // ddd.ddd
+    required_size += length + 1;
+  }
+  else
+  {
+    // ddd[000]
+    required_size += decimal_point;
+  }
+
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(destination, required_size);
+
+  uint8_t* ptr = az_span_ptr(destination);
+  int32_t written = 0;
+
+  if (is_negative)
+  {
+    ptr[written++] = '-';
+  }
+
+  if (use_exponent)
+  {
+    ptr[written++] = digits[0];
+    if (length > 1)
+    {
+      ptr[written++] = '.';
+      for (int32_t i = 1; i < length; i++)
+      {
+        ptr[written++] = digits[i];
+      }
+    }
+
+    ptr[written++] = 'e';
+    ptr[written++] = exponent < 0 ? '-' : '+';
+    if (exponent_magnitude >= 100)
+    {
+      ptr[written++] = _az_decimal_to_ascii((uint8_t)(exponent_magnitude / 100));
+    }
+    if (exponent_magnitude >= 10)
+    {
+      ptr[written++] = _az_decimal_to_ascii(
+          (uint8_t)((exponent_magnitude / _az_NUMBER_OF_DECIMAL_VALUES)
+                    % _az_NUMBER_OF_DECIMAL_VALUES));
+    }
+    ptr[written++]
+        = _az_decimal_to_ascii((uint8_t)(exponent_magnitude % _az_NUMBER_OF_DECIMAL_VALUES));
+  }
+  else if (decimal_point <= 0)
+  {
+    ptr[written++] = '0';
+    ptr[written++] = '.';
+    for (int32_t i = decimal_point; i < 0; i++)
+    {
+      ptr[written++] = '0';
+    }
+    for (int32_t i = 0; i < length; i++)
+    {
+      ptr[written++] = digits[i];
+    }
+  }
+  else
+  {
+    for (int32_t i = 0; i < length; i++)
+    {
+      if (i == decimal_point)
+      {
+        ptr[written++] = '.';
+      }
+      ptr[written++] = digits[i];
+    }
+    for (int32_t i = length; i < decimal_point; i++)
+    {
+      ptr[written++] = '0';
+    }
+  }
+
+  *out_span = az_span_slice_to_end(destination, written);
+  return AZ_OK;
+}
+
 // TODO: pass az_span by value
 AZ_NODISCARD az_result _az_is_expected_span(az_span* ref_span, az_span expected)
 {
@@ -816,20 +1618,6 @@ AZ_NODISCARD az_span _az_span_trim_whitespace(az_span source)
   return _az_span_trim_whitespace_from_end(_az_span_trim_whitespace_from_start(source));
 }
 
-AZ_NODISCARD AZ_INLINE bool _az_is_whitespace(uint8_t c)
-{
-  switch (c)
-  {
-    case ' ':
-    case '\t':
-    case '\n':
-    case '\r':
-      return true;
-    default:
-      return false;
-  }
-}
-
 typedef enum
 {
   LEFT = 0,
@@ -882,29 +1670,74 @@ AZ_NODISCARD az_span _az_span_trim_whitespace_from_end(az_span source)
   return _az_span_trim_side(source, RIGHT);
 }
 
-// [0-9]
-AZ_NODISCARD AZ_INLINE bool _az_span_is_byte_digit(uint8_t c) { return '0' <= c && c <= '9'; }
-
-// [A-Za-z]
-AZ_NODISCARD AZ_INLINE bool _az_span_is_byte_letter(uint8_t c)
+// Flags the bytes which are copied as is when URL-encoding, which are the unreserved characters of
+// RFC 3986: [A-Za-z0-9], '-', '.', '_' and '~'. Every other byte is percent-encoded.
+static uint8_t const _az_span_url_unreserved[256] = {
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x00
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x10
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 1, 1, 0, // 0x20
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 0, 0, // 0x30
+  0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x40
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 0, 1, // 0x50
+  0, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, // 0x60
+  1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 1, 0, 0, 0, 1, 0, // 0x70
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x80
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0x90
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xA0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xB0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xC0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xD0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xE0
+  0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, 0, // 0xF0
+};
+
+// Returns the number of bytes at the start of source which don't need to be URL-encoded, checking
+// 16 bytes at a time when SIMD is enabled.
+AZ_NODISCARD static int32_t _az_span_url_scan(uint8_t const* source, int32_t source_size)
 {
-  // This is equivalent to ('A' <= c && c <= 'Z') || ('a' <= c && c <= 'z')
-  // This works because upper case and lower case letters are 0x20 away from each other.
-  return ((uint32_t)(c - 'A') & ~(uint32_t)_az_ASCII_SPACE_CHARACTER) <= 'Z' - 'A';
-}
+  int32_t i = 0;
+
+#ifdef _az_SIMD_ENABLED
+  _az_simd_vector const digit_first = _az_simd_splat('0');
+  _az_simd_vector const digit_last = _az_simd_splat('9');
+  _az_simd_vector const lower_first = _az_simd_splat('a');
+  _az_simd_vector const lower_last = _az_simd_splat('z');
+  _az_simd_vector const case_bit = _az_simd_splat(0x20);
+  _az_simd_vector const dash = _az_simd_splat('-');
+  _az_simd_vector const dot = _az_simd_splat('.');
+  _az_simd_vector const underscore = _az_simd_splat('_');
+  _az_simd_vector const tilde = _az_simd_splat('~');
+
+  for (; i + _az_SIMD_BLOCK_SIZE <= source_size; i += _az_SIMD_BLOCK_SIZE)
+  {
+    _az_simd_vector const bytes = _az_simd_load(source + i);
+
+    // Setting the 0x20 bit maps upper case letters to lower case ones, and no other byte into the
+    // [a-z] range.
+    _az_simd_vector const lower = _az_simd_or(bytes, case_bit);
+    _az_simd_vector const is_letter
+        = _az_simd_and(_az_simd_le(lower_first, lower), _az_simd_le(lower, lower_last));
+    _az_simd_vector const is_digit
+        = _az_simd_and(_az_simd_le(digit_first, bytes), _az_simd_le(bytes, digit_last));
+    _az_simd_vector const is_mark = _az_simd_or(
+        _az_simd_or(_az_simd_eq(bytes, dash), _az_simd_eq(bytes, dot)),
+        _az_simd_or(_az_simd_eq(bytes, underscore), _az_simd_eq(bytes, tilde)));
+
+    uint32_t const to_encode
+        = ~_az_simd_mask(_az_simd_or(_az_simd_or(is_letter, is_digit), is_mark)) & 0xFFFFU;
+    if (to_encode != 0)
+    {
+      return i + _az_ctz32(to_encode);
+    }
+  }
+#endif // _az_SIMD_ENABLED
 
-AZ_NODISCARD AZ_INLINE bool _az_span_url_should_encode(uint8_t c)
-{
-  switch (c)
+  while (i < source_size && _az_span_url_unreserved[source[i]] != 0)
   {
-    case '-':
-    case '_':
-    case '.':
-    case '~':
-      return false;
-    default:
-      return !(_az_span_is_byte_digit(c) || _az_span_is_byte_letter(c));
+    i++;
   }
+
+  return i;
 }
 
 AZ_NODISCARD int32_t _az_span_url_encode_calc_length(az_span source)
@@ -918,20 +1751,78 @@ AZ_NODISCARD int32_t _az_span_url_encode_calc_length(az_span source)
   uint8_t const* const src_ptr = az_span_ptr(source);
 
   int32_t encoded_length = source_size;
-  for (int32_t i = 0; i < source_size; i++)
+  int32_t i = _az_span_url_scan(src_ptr, source_size);
+  while (i < source_size)
   {
-    uint8_t c = src_ptr[i];
-    if (_az_span_url_should_encode(c))
-    {
-      // Adding '%' plus 2 digits (minus 1 as original symbol is counted as 1)
-      encoded_length += 2;
-    }
+    // Adding '%' plus 2 digits (minus 1 as original symbol is counted as 1)
+    encoded_length += 2;
+    i++;
+    i += _az_span_url_scan(src_ptr + i, source_size - i);
   }
 
   // If source_size is 0, this will return 0.
   return encoded_length;
 }
 
+AZ_INLINE void _az_span_url_encode_byte(uint8_t* dest_ptr, uint8_t c)
+{
+  dest_ptr[0] = '%';
+  dest_ptr[1] = _az_number_to_upper_hex(c >> 4U);
+  dest_ptr[2] = _az_number_to_upper_hex(c & (uint32_t)_az_LARGEST_HEX_VALUE);
+}
+
+// URL-encodes as much of source as fits into destination. Runs of bytes that don't need to be
+// encoded are copied at once. Returns the number of bytes written, and sets *out_source_read to the
+// number of source bytes consumed, which is less than source_size if destination is too small.
+AZ_NODISCARD static int32_t _az_span_url_encode_runs(
+    uint8_t* dest_ptr,
+    int32_t dest_size,
+    uint8_t const* src_ptr,
+    int32_t source_size,
+    int32_t* out_source_read)
+{
+  int32_t written = 0;
+  int32_t i = 0;
+
+  while (i < source_size)
+  {
+    int32_t run_length = _az_span_url_scan(src_ptr + i, source_size - i);
+    if (run_length > dest_size - written)
+    {
+      // Copy what fits, as encoding one byte at a time would have.
+      run_length = dest_size - written;
+      if (run_length > 0)
+      {
+        memcpy(dest_ptr + written, src_ptr + i, (size_t)run_length);
+      }
+      *out_source_read = i + run_length;
+      return written + run_length;
+    }
+
+    if (run_length > 0)
+    {
+      memcpy(dest_ptr + written, src_ptr + i, (size_t)run_length);
+      written += run_length;
+      i += run_length;
+    }
+
+    if (i < source_size)
+    {
+      if (dest_size - written < 3)
+      {
+        break;
+      }
+
+      _az_span_url_encode_byte(dest_ptr + written, src_ptr[i]);
+      written += 3;
+      i++;
+    }
+  }
+
+  *out_source_read = i;
+  return written;
+}
+
 AZ_NODISCARD az_result _az_span_url_encode(az_span destination, az_span source, int32_t* out_length)
 {
   _az_PRECONDITION_NOT_NULL(out_length);
@@ -943,44 +1834,86 @@ AZ_NODISCARD az_result _az_span_url_encode(az_span destination, az_span source,
   _az_PRECONDITION_NO_OVERLAP_SPANS(destination, source);
 
   uint8_t* const dest_begin = az_span_ptr(destination);
-  uint8_t* const dest_end = dest_begin + az_span_size(destination);
-
   uint8_t* const src_ptr = az_span_ptr(source);
-  uint8_t* dest_ptr = dest_begin;
 
-  for (int32_t i = 0; i < source_size; i++)
+  // Overlapping spans are only possible when preconditions aren't checked, in which case the
+  // bytes keep being encoded one at a time, for the output to stay the same as it always was.
+  if (source_size > 0 && az_span_size(destination) > 0 && _az_span_overlap(destination, source))
   {
-    uint8_t c = src_ptr[i];
-    if (!_az_span_url_should_encode(c))
-    {
-      if (dest_ptr >= dest_end)
-      {
-        *out_length = 0;
-        return AZ_ERROR_NOT_ENOUGH_SPACE;
-      }
+    uint8_t* const dest_end = dest_begin + az_span_size(destination);
+    uint8_t* dest_ptr = dest_begin;
 
-      *dest_ptr = c;
-      ++dest_ptr;
-    }
-    else
+    for (int32_t i = 0; i < source_size; i++)
     {
-      if (dest_ptr >= dest_end - 2)
+      uint8_t c = src_ptr[i];
+      if (_az_span_url_unreserved[c] != 0)
       {
-        *out_length = 0;
-        return AZ_ERROR_NOT_ENOUGH_SPACE;
+        if (dest_ptr >= dest_end)
+        {
+          *out_length = 0;
+          return AZ_ERROR_NOT_ENOUGH_SPACE;
+        }
+
+        *dest_ptr = c;
+        ++dest_ptr;
       }
+      else
+      {
+        if (dest_ptr >= dest_end - 2)
+        {
+          *out_length = 0;
+          return AZ_ERROR_NOT_ENOUGH_SPACE;
+        }
 
-      dest_ptr[0] = '%';
-      dest_ptr[1] = _az_number_to_upper_hex(c >> 4U);
-      dest_ptr[2] = _az_number_to_upper_hex(c & (uint32_t)_az_LARGEST_HEX_VALUE);
-      dest_ptr += 3;
+        _az_span_url_encode_byte(dest_ptr, c);
+        dest_ptr += 3;
+      }
     }
+
+    *out_length = (int32_t)(dest_ptr - dest_begin);
+    return AZ_OK;
   }
 
-  *out_length = (int32_t)(dest_ptr - dest_begin);
+  int32_t source_read = 0;
+  int32_t const written = _az_span_url_encode_runs(
+      dest_begin, az_span_size(destination), src_ptr, source_size, &source_read);
+  if (source_read < source_size)
+  {
+    *out_length = 0;
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  *out_length = written;
   return AZ_OK;
 }
 
+AZ_NODISCARD az_result
+_az_span_url_encode_and_get_length(az_span destination, az_span source, int32_t* out_length)
+{
+  _az_PRECONDITION_NOT_NULL(out_length);
+  _az_PRECONDITION_VALID_SPAN(source, 0, true);
+  _az_PRECONDITION_RANGE(0, az_span_size(source), INT32_MAX / 3);
+  _az_PRECONDITION_VALID_SPAN(destination, 0, true);
+  _az_PRECONDITION_NO_OVERLAP_SPANS(destination, source);
+
+  int32_t const source_size = az_span_size(source);
+  uint8_t const* const src_ptr = az_span_ptr(source);
+
+  int32_t source_read = 0;
+  int32_t const written = _az_span_url_encode_runs(
+      az_span_ptr(destination), az_span_size(destination), src_ptr, source_size, &source_read);
+  if (source_read == source_size)
+  {
+    *out_length = written;
+    return AZ_OK;
+  }
+
+  // Only the rest of the source still needs to be measured, rather than all of it again.
+  *out_length
+      = written + _az_span_url_encode_calc_length(az_span_slice_to_end(source, source_read));
+  return AZ_ERROR_NOT_ENOUGH_SPACE;
+}
+
 az_span _az_span_token(
     az_span source,
     az_span delimiter,
@@ -1004,3 +1937,17 @@ az_span _az_span_token(
   *out_remainder = AZ_SPAN_EMPTY;
   return source;
 }
+
+void _az_span_secure_zero(az_span destination)
+{
+  _az_PRECONDITION_VALID_SPAN(destination, 0, true);
+
+  // Each write through a volatile pointer is an observable side effect, so none of them can be
+  // optimized away, unlike memset() on a buffer that isn't read again.
+  uint8_t volatile* const ptr = az_span_ptr(destination);
+  int32_t const size = az_span_size(destination);
+  for (int32_t i = 0; i < size; i++)
+  {
+    ptr[i] = 0;
+  }
+}
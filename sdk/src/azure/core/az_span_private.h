@@ -47,6 +47,9 @@ enum
   // Two digit length to create the "format" passed to sscanf.
   _az_MAX_SIZE_FOR_PARSING_DOUBLE = 99,
 
+  // Any number with up to 19 decimal digits fits within a uint64_t.
+  _az_MAX_SIGNIFICANT_DIGITS_FOR_FAST_PARSING = 19,
+
   // The number value of the ASCII space character ' '.
   _az_ASCII_SPACE_CHARACTER = 0x20,
 
@@ -86,6 +89,23 @@ AZ_NODISCARD AZ_INLINE bool _az_isfinite(double value)
 
 AZ_NODISCARD az_result _az_is_expected_span(az_span* ref_span, az_span expected);
 
+/**
+ * @brief Returns `true` if \p c is a whitespace character (` `, \\t, \\n, \\r).
+ */
+AZ_NODISCARD AZ_INLINE bool _az_is_whitespace(uint8_t c)
+{
+  switch (c)
+  {
+    case ' ':
+    case '\t':
+    case '\n':
+    case '\r':
+      return true;
+    default:
+      return false;
+  }
+}
+
 /**
  * @brief Removes all leading and trailing whitespace characters from the \p span. Function will
  * create a new #az_span pointing to the first non-whitespace (` `, \\n, \\r, \\t) character found
@@ -3,7 +3,9 @@
 
 #include <stdint.h>
 
+#include <azure/core/az_base64.h>
 #include <azure/core/az_result.h>
+#include <azure/core/az_sha256.h>
 #include <azure/core/az_span.h>
 #include <azure/core/internal/az_precondition_internal.h>
 #include <azure/core/internal/az_result_internal.h>
@@ -173,47 +175,157 @@ AZ_NODISCARD int32_t az_iot_calculate_retry_delay(
   return delay > 0 ? delay : 0;
 }
 
-AZ_NODISCARD int32_t _az_iot_u32toa_size(uint32_t number)
+AZ_NODISCARD az_iot_sas_token_manager_options az_iot_sas_token_manager_options_default()
 {
-  if (number == 0)
-  {
-    return 1;
-  }
+  return (az_iot_sas_token_manager_options){
+    .key_name = AZ_SPAN_EMPTY,
+    .token_duration_seconds = AZ_IOT_SAS_TOKEN_DEFAULT_DURATION_SECONDS,
+    .renewal_margin_seconds = AZ_IOT_SAS_TOKEN_DEFAULT_RENEWAL_MARGIN_SECONDS,
+    .hmac_sha256 = NULL,
+    .hmac_sha256_context = NULL,
+  };
+}
 
-  uint32_t div = _az_SMALLEST_10_DIGIT_NUMBER;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT32;
-  while (number / div == 0)
+AZ_NODISCARD az_result az_iot_sas_token_manager_init(
+    az_iot_sas_token_manager* manager,
+    az_span base64_device_key,
+    az_span password_buffer,
+    az_iot_sas_token_manager_options const* options)
+{
+  _az_PRECONDITION_NOT_NULL(manager);
+  _az_PRECONDITION_VALID_SPAN(password_buffer, 1, false);
+  // A Base64 encoded key of at least 1 byte has at least 4 characters.
+  _az_PRECONDITION(
+      options != NULL && options->hmac_sha256 != NULL
+          ? _az_span_is_valid(base64_device_key, 0, true)
+          : _az_span_is_valid(base64_device_key, 4, false));
+  _az_PRECONDITION(
+      options == NULL || options->token_duration_seconds > options->renewal_margin_seconds);
+
+  manager->_internal.options
+      = options == NULL ? az_iot_sas_token_manager_options_default() : *options;
+  manager->_internal.password_buffer = password_buffer;
+  manager->_internal.password_length = 0;
+  manager->_internal.expiration_epoch_time = 0;
+
+  if (manager->_internal.options.hmac_sha256 == NULL)
   {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
+    // Device keys are 32 or 64 bytes, and the buffer leaves room for larger ones.
+    uint8_t key[AZ_SHA256_BLOCK_SIZE * 2];
+    int32_t key_length = 0;
+    az_result result = az_base64_decode(AZ_SPAN_FROM_BUFFER(key), base64_device_key, &key_length);
+    if (az_result_succeeded(result))
+    {
+      result = az_hmac_sha256_key_init(&manager->_internal.key, az_span_create(key, key_length));
+    }
+
+    // Don't leave a copy of the device key on the stack.
+    _az_span_secure_zero(AZ_SPAN_FROM_BUFFER(key));
+    _az_RETURN_IF_FAILED(result);
   }
 
-  return digit_count;
+  return AZ_OK;
 }
 
-AZ_NODISCARD int32_t _az_iot_u64toa_size(uint64_t number)
+AZ_NODISCARD bool az_iot_sas_token_manager_is_renewal_due(
+    az_iot_sas_token_manager const* manager,
+    uint64_t current_epoch_time)
+{
+  _az_PRECONDITION_NOT_NULL(manager);
+
+  return manager->_internal.expiration_epoch_time == 0
+      || current_epoch_time + manager->_internal.options.renewal_margin_seconds
+      >= manager->_internal.expiration_epoch_time;
+}
+
+AZ_NODISCARD az_result _az_iot_sas_token_manager_sign(
+    az_iot_sas_token_manager const* manager,
+    az_span signature,
+    az_span base64_signature,
+    az_span* out_base64_signature)
 {
-  if (number == 0)
+  uint8_t hmac[AZ_SHA256_HASH_SIZE];
+  if (manager->_internal.options.hmac_sha256 != NULL)
+  {
+    _az_RETURN_IF_FAILED(manager->_internal.options.hmac_sha256(
+        manager->_internal.options.hmac_sha256_context, signature, AZ_SPAN_FROM_BUFFER(hmac)));
+  }
+  else
   {
-    return 1;
+    _az_RETURN_IF_FAILED(
+        az_hmac_sha256_compute(&manager->_internal.key, signature, AZ_SPAN_FROM_BUFFER(hmac)));
   }
 
-  uint64_t div = _az_SMALLEST_20_DIGIT_NUMBER;
-  int32_t digit_count = _az_MAX_SIZE_FOR_UINT64;
-  while (number / div == 0)
+  int32_t base64_signature_length = 0;
+  _az_RETURN_IF_FAILED(
+      az_base64_encode(base64_signature, AZ_SPAN_FROM_BUFFER(hmac), &base64_signature_length));
+
+  *out_base64_signature = az_span_slice(base64_signature, 0, base64_signature_length);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result _az_iot_sas_token_manager_get_password(
+    az_iot_sas_token_manager* manager,
+    void const* client,
+    _az_iot_sas_token_get_signature_fn get_signature,
+    _az_iot_sas_token_get_password_fn get_password,
+    uint64_t current_epoch_time,
+    az_span* out_mqtt_password)
+{
+  az_span const password_buffer = manager->_internal.password_buffer;
+
+  if (!az_iot_sas_token_manager_is_renewal_due(manager, current_epoch_time))
   {
-    div /= _az_NUMBER_OF_DECIMAL_VALUES;
-    digit_count--;
+    *out_mqtt_password = az_span_slice(password_buffer, 0, manager->_internal.password_length);
+    return AZ_OK;
   }
 
-  return digit_count;
+  // The clear-text signature is built in the password buffer, which invalidates the cached
+  // password until the new one is in place.
+  manager->_internal.expiration_epoch_time = 0;
+  uint64_t const expiration
+      = current_epoch_time + manager->_internal.options.token_duration_seconds;
+
+  az_span signature;
+  _az_RETURN_IF_FAILED(get_signature(client, expiration, password_buffer, &signature));
+
+  uint8_t base64_signature_buffer[_az_IOT_SAS_TOKEN_BASE64_SIGNATURE_SIZE];
+  az_span base64_signature;
+  _az_RETURN_IF_FAILED(_az_iot_sas_token_manager_sign(
+      manager, signature, AZ_SPAN_FROM_BUFFER(base64_signature_buffer), &base64_signature));
+
+  size_t password_length = 0;
+  _az_RETURN_IF_FAILED(get_password(
+      client,
+      expiration,
+      base64_signature,
+      manager->_internal.options.key_name,
+      (char*)az_span_ptr(password_buffer),
+      (size_t)az_span_size(password_buffer),
+      &password_length));
+
+  manager->_internal.password_length = (int32_t)password_length;
+  manager->_internal.expiration_epoch_time = expiration;
+
+  *out_mqtt_password = az_span_slice(password_buffer, 0, manager->_internal.password_length);
+  return AZ_OK;
+}
+
+AZ_NODISCARD int32_t _az_iot_u32toa_size(uint32_t number)
+{
+  return _az_span_u64toa_size(number);
+}
+
+AZ_NODISCARD int32_t _az_iot_u64toa_size(uint64_t number)
+{
+  return _az_span_u64toa_size(number);
 }
 
 AZ_NODISCARD az_result
 _az_span_copy_url_encode(az_span destination, az_span source, az_span* out_remainder)
 {
   int32_t length = 0;
-  _az_RETURN_IF_FAILED(_az_span_url_encode(destination, source, &length));
+  _az_RETURN_IF_FAILED(_az_span_url_encode_and_get_length(destination, source, &length));
   *out_remainder = az_span_slice(destination, length, az_span_size(destination));
   return AZ_OK;
 }
@@ -48,6 +48,7 @@ AZ_NODISCARD az_result az_iot_hub_client_init(
   client->_internal.iot_hub_hostname = iot_hub_hostname;
   client->_internal.device_id = device_id;
   client->_internal.options = options == NULL ? az_iot_hub_client_options_default() : *options;
+  client->_internal.component_names_table = (az_json_name_table){ 0 };
 
   return AZ_OK;
 }
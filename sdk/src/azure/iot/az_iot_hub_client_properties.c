@@ -9,6 +9,10 @@
 static const az_span iot_hub_properties_reported = AZ_SPAN_LITERAL_FROM_STR("reported");
 static const az_span iot_hub_properties_desired = AZ_SPAN_LITERAL_FROM_STR("desired");
 static const az_span iot_hub_properties_desired_version = AZ_SPAN_LITERAL_FROM_STR("$version");
+static const az_span iot_hub_properties_desired_version_path
+    = AZ_SPAN_LITERAL_FROM_STR("/desired/$version");
+static const az_span iot_hub_properties_writable_updated_version_path
+    = AZ_SPAN_LITERAL_FROM_STR("/$version");
 static const az_span properties_response_value_name = AZ_SPAN_LITERAL_FROM_STR("value");
 static const az_span properties_ack_code_name = AZ_SPAN_LITERAL_FROM_STR("ac");
 static const az_span properties_ack_version_name = AZ_SPAN_LITERAL_FROM_STR("av");
@@ -176,6 +180,18 @@ static bool is_component_in_model(
 {
   int32_t index = 0;
 
+  if (client->_internal.component_names_table._internal.buckets != NULL)
+  {
+    if (az_result_failed(az_json_name_table_find(
+            &client->_internal.component_names_table, component_name, &index)))
+    {
+      return false;
+    }
+
+    *out_component_name = client->_internal.options.component_names[index];
+    return true;
+  }
+
   while (index < client->_internal.options.component_names_length)
   {
     if (az_json_token_is_text_equal(
@@ -212,20 +228,44 @@ AZ_NODISCARD az_result az_iot_hub_client_properties_get_properties_version(
     return AZ_ERROR_UNEXPECTED_CHAR;
   }
 
-  _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+  az_json_path_set version_path_set;
+  _az_RETURN_IF_FAILED(az_json_path_set_init(
+      &version_path_set,
+      message_type == AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE
+          ? &iot_hub_properties_desired_version_path
+          : &iot_hub_properties_writable_updated_version_path,
+      1));
 
-  if (message_type == AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE)
+  az_json_token version_token;
+  _az_RETURN_IF_FAILED(
+      az_json_reader_find_paths(ref_json_reader, &version_path_set, &version_token));
+
+  if (version_token.kind == AZ_JSON_TOKEN_NONE)
   {
-    _az_RETURN_IF_FAILED(json_child_token_move(ref_json_reader, iot_hub_properties_desired));
-    _az_RETURN_IF_FAILED(az_json_reader_next_token(ref_json_reader));
+    return AZ_ERROR_ITEM_NOT_FOUND;
   }
 
-  _az_RETURN_IF_FAILED(json_child_token_move(ref_json_reader, iot_hub_properties_desired_version));
-  _az_RETURN_IF_FAILED(az_json_token_get_int32(&ref_json_reader->token, out_version));
+  _az_RETURN_IF_FAILED(az_json_token_get_int32(&version_token, out_version));
 
   return AZ_OK;
 }
 
+AZ_NODISCARD az_result az_iot_hub_client_properties_index_component_names(
+    az_iot_hub_client* ref_client,
+    uint16_t lookup_buffer[],
+    int32_t lookup_buffer_length)
+{
+  _az_PRECONDITION_NOT_NULL(ref_client);
+  _az_PRECONDITION_NOT_NULL(lookup_buffer);
+
+  return az_json_name_table_init(
+      &ref_client->_internal.component_names_table,
+      ref_client->_internal.options.component_names,
+      ref_client->_internal.options.component_names_length,
+      lookup_buffer,
+      lookup_buffer_length);
+}
+
 // process_first_move_if_needed performs initial setup when beginning to parse
 // the JSON document.  It sets the next read token to the appropriate
 // location based on whether we have a full twin or a patch and what property_type
@@ -484,3 +524,626 @@ AZ_NODISCARD az_result az_iot_hub_client_properties_get_next_component_property(
 
   return AZ_OK;
 }
+
+enum
+{
+  reported_entry_acknowledged = 0x1,
+  reported_entry_pending = 0x2,
+  reported_entry_in_patch = 0x4,
+};
+
+// 64-bit FNV-1a, which is continued from the given hash so that names can be hashed in parts.
+static const uint64_t reported_hash_offset_basis = 0xCBF29CE484222325ULL;
+
+AZ_NODISCARD static uint64_t reported_hash(uint64_t hash, az_span bytes)
+{
+  uint8_t const* const bytes_ptr = az_span_ptr(bytes);
+  int32_t const bytes_size = az_span_size(bytes);
+  for (int32_t i = 0; i < bytes_size; i++)
+  {
+    hash ^= bytes_ptr[i];
+    hash *= 0x100000001B3ULL;
+  }
+
+  return hash;
+}
+
+// The NUL byte, which property names don't contain, separates the component name from the
+// property name, so that moving characters from one to the other changes the hash.
+AZ_NODISCARD static uint64_t reported_component_name_hash(az_span component_name)
+{
+  return reported_hash(
+      reported_hash(reported_hash_offset_basis, component_name), AZ_SPAN_FROM_STR("\0"));
+}
+
+AZ_NODISCARD static uint32_t reported_request_id_hash(az_span request_id)
+{
+  uint64_t const hash = reported_hash(reported_hash_offset_basis, request_id);
+  return (uint32_t)(hash ^ (hash >> 32U));
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_state_init(
+    az_iot_hub_client_properties_reported_state* out_state,
+    az_iot_hub_client_properties_reported_entry entries[],
+    int32_t entries_length)
+{
+  _az_PRECONDITION_NOT_NULL(out_state);
+  _az_PRECONDITION_NOT_NULL(entries);
+  _az_PRECONDITION(entries_length > 0);
+
+  *out_state = (az_iot_hub_client_properties_reported_state){
+    ._internal = {
+      .entries = entries,
+      .entries_length = entries_length,
+      .entry_count = 0,
+      .patch_property_count = 0,
+      .component_property_count = 0,
+      .component_name_hash = reported_component_name_hash(AZ_SPAN_EMPTY),
+      .property_name_hash = 0,
+      .property_value_offset = 0,
+    },
+  };
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_begin_patch(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION(ref_json_writer->_internal.allocator_callback == NULL);
+
+  // Properties written in a patch which was never ended aren't part of this one.
+  for (int32_t i = 0; i < ref_state->_internal.entry_count; i++)
+  {
+    ref_state->_internal.entries[i]._internal.flags &= (uint8_t)~reported_entry_in_patch;
+  }
+
+  ref_state->_internal.patch_property_count = 0;
+  ref_state->_internal.component_property_count = 0;
+  ref_state->_internal.component_name_hash = reported_component_name_hash(AZ_SPAN_EMPTY);
+
+  return az_json_writer_append_begin_object(ref_json_writer);
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_begin_component(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer,
+    az_span component_name)
+{
+  _az_PRECONDITION_NOT_NULL(client);
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_VALID_SPAN(component_name, 1, false);
+
+  ref_state->_internal.component_writer = *ref_json_writer;
+  ref_state->_internal.component_property_count = 0;
+  ref_state->_internal.component_name_hash = reported_component_name_hash(component_name);
+
+  return az_iot_hub_client_properties_writer_begin_component(
+      client, ref_json_writer, component_name);
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_end_component(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(client);
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+
+  if (ref_state->_internal.component_property_count == 0)
+  {
+    // None of the properties changed, so the component is left out of the patch altogether.
+    *ref_json_writer = ref_state->_internal.component_writer;
+  }
+  else
+  {
+    _az_RETURN_IF_FAILED(
+        az_iot_hub_client_properties_writer_end_component(client, ref_json_writer));
+  }
+
+  ref_state->_internal.component_name_hash = reported_component_name_hash(AZ_SPAN_EMPTY);
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_begin_property(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer,
+    az_span property_name)
+{
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_VALID_SPAN(property_name, 1, false);
+
+  ref_state->_internal.property_writer = *ref_json_writer;
+  ref_state->_internal.property_name_hash
+      = reported_hash(ref_state->_internal.component_name_hash, property_name);
+
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(ref_json_writer, property_name));
+
+  ref_state->_internal.property_value_offset = ref_json_writer->_internal.bytes_written;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_end_property(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer)
+{
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+
+  // The value is hashed as written, so a value only compares equal to one written the same way.
+  az_span const value = az_span_slice_to_end(
+      az_json_writer_get_bytes_used_in_destination(ref_json_writer),
+      ref_state->_internal.property_value_offset);
+  uint64_t const value_hash = reported_hash(reported_hash_offset_basis, value);
+  uint64_t const name_hash = ref_state->_internal.property_name_hash;
+
+  az_iot_hub_client_properties_reported_entry* entry = NULL;
+  for (int32_t i = 0; i < ref_state->_internal.entry_count; i++)
+  {
+    if (ref_state->_internal.entries[i]._internal.name_hash == name_hash)
+    {
+      entry = &ref_state->_internal.entries[i];
+      break;
+    }
+  }
+
+  if (entry == NULL)
+  {
+    if (ref_state->_internal.entry_count == ref_state->_internal.entries_length)
+    {
+      *ref_json_writer = ref_state->_internal.property_writer;
+      return AZ_ERROR_NOT_ENOUGH_SPACE;
+    }
+
+    entry = &ref_state->_internal.entries[ref_state->_internal.entry_count++];
+    entry->_internal.name_hash = name_hash;
+    entry->_internal.value_hash = 0;
+    entry->_internal.pending_value_hash = 0;
+    entry->_internal.pending_request_id_hash = 0;
+    entry->_internal.flags = 0;
+  }
+  else if (
+      (entry->_internal.flags & reported_entry_acknowledged) != 0
+      && entry->_internal.value_hash == value_hash
+      && ((entry->_internal.flags & reported_entry_pending) == 0
+          || entry->_internal.pending_value_hash == value_hash))
+  {
+    // The service already has this value, and no other value is on its way to replace it.
+    *ref_json_writer = ref_state->_internal.property_writer;
+    return AZ_OK;
+  }
+
+  // Whichever patch the property was awaiting the acknowledgement of, this one replaces it.
+  entry->_internal.pending_value_hash = value_hash;
+  entry->_internal.flags
+      = (uint8_t)((entry->_internal.flags & ~reported_entry_pending) | reported_entry_in_patch);
+
+  ref_state->_internal.patch_property_count++;
+  ref_state->_internal.component_property_count++;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_end_patch(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_json_writer* ref_json_writer,
+    az_span request_id,
+    int32_t* out_property_count)
+{
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(ref_json_writer);
+  _az_PRECONDITION_VALID_SPAN(request_id, 1, false);
+  _az_PRECONDITION_NOT_NULL(out_property_count);
+
+  _az_RETURN_IF_FAILED(az_json_writer_append_end_object(ref_json_writer));
+
+  uint32_t const request_id_hash = reported_request_id_hash(request_id);
+  for (int32_t i = 0; i < ref_state->_internal.entry_count; i++)
+  {
+    az_iot_hub_client_properties_reported_entry* entry = &ref_state->_internal.entries[i];
+    if ((entry->_internal.flags & reported_entry_in_patch) != 0)
+    {
+      entry->_internal.pending_request_id_hash = request_id_hash;
+      entry->_internal.flags
+          = (uint8_t)((entry->_internal.flags & ~reported_entry_in_patch) | reported_entry_pending);
+    }
+  }
+
+  *out_property_count = ref_state->_internal.patch_property_count;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_reported_confirm(
+    az_iot_hub_client_properties_reported_state* ref_state,
+    az_iot_hub_client_properties_message const* message)
+{
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION_NOT_NULL(message);
+
+  if (message->message_type != AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_ACKNOWLEDGEMENT
+      && message->message_type != AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_ERROR)
+  {
+    return AZ_ERROR_ITEM_NOT_FOUND;
+  }
+
+  bool const is_accepted
+      = message->message_type == AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_ACKNOWLEDGEMENT
+      && message->status == AZ_IOT_STATUS_NO_CONTENT;
+  uint32_t const request_id_hash = reported_request_id_hash(message->request_id);
+  bool is_found = false;
+
+  for (int32_t i = 0; i < ref_state->_internal.entry_count; i++)
+  {
+    az_iot_hub_client_properties_reported_entry* entry = &ref_state->_internal.entries[i];
+    if ((entry->_internal.flags & reported_entry_pending) != 0
+        && entry->_internal.pending_request_id_hash == request_id_hash)
+    {
+      is_found = true;
+      if (is_accepted)
+      {
+        entry->_internal.value_hash = entry->_internal.pending_value_hash;
+        entry->_internal.flags |= reported_entry_acknowledged;
+      }
+
+      entry->_internal.flags &= (uint8_t)~reported_entry_pending;
+    }
+  }
+
+  return is_found ? AZ_OK : AZ_ERROR_ITEM_NOT_FOUND;
+}
+
+// IoT Hub limits desired properties to 10 levels of nested objects, below the desired properties
+// object itself, which bounds the recursion of the merge.
+static const int32_t desired_max_depth = 11;
+static const az_span desired_empty_object = AZ_SPAN_LITERAL_FROM_STR("{}");
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_desired_state_init(
+    az_iot_hub_client_properties_desired_state* out_state,
+    az_span buffer)
+{
+  _az_PRECONDITION_NOT_NULL(out_state);
+  _az_PRECONDITION_VALID_SPAN(buffer, 4, false);
+
+  int32_t const half_size = az_span_size(buffer) / 2;
+  out_state->_internal.document_buffer = az_span_slice(buffer, 0, half_size);
+  out_state->_internal.scratch_buffer = az_span_slice(buffer, half_size, half_size * 2);
+  out_state->_internal.document_size = 0;
+  out_state->_internal.version = 0;
+
+  return AZ_OK;
+}
+
+// Returns the JSON text of a token, including the quotes around strings and property names.
+AZ_NODISCARD static az_span desired_token_text(az_json_token const* token)
+{
+  if (token->kind == AZ_JSON_TOKEN_STRING || token->kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    return az_span_create(az_span_ptr(token->slice) - 1, az_span_size(token->slice) + 2);
+  }
+
+  return token->slice;
+}
+
+// Reads past the value the reader is on, including its children, and returns its JSON text.
+AZ_NODISCARD static az_result desired_read_value_text(az_json_reader* ref_jr, az_span* out_text)
+{
+  uint8_t* const start = az_span_ptr(desired_token_text(&ref_jr->token));
+  _az_RETURN_IF_FAILED(az_json_reader_skip_children(ref_jr));
+
+  az_span const last = desired_token_text(&ref_jr->token);
+  *out_text = az_span_create(start, (int32_t)(az_span_ptr(last) + az_span_size(last) - start));
+  return AZ_OK;
+}
+
+AZ_NODISCARD static bool
+desired_is_name_equal(az_json_token const* token, az_json_token const* name)
+{
+  // Names with escaped characters are compared as written, which is how the service sends them.
+  return name->_internal.string_has_escaped_chars
+      ? az_span_is_content_equal(token->slice, name->slice)
+      : az_json_token_is_text_equal(token, name->slice);
+}
+
+// Finds the member of a JSON object with the same name as the property name token.
+AZ_NODISCARD static az_result desired_find_member(
+    az_span object_text,
+    az_json_token const* name,
+    az_json_token_kind* out_value_kind,
+    az_span* out_value_text)
+{
+  az_json_reader jr;
+  _az_RETURN_IF_FAILED(az_json_reader_init(&jr, object_text, NULL));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+
+  while (jr.token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    bool const is_match = desired_is_name_equal(&jr.token, name);
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+
+    if (is_match)
+    {
+      *out_value_kind = jr.token.kind;
+      return desired_read_value_text(&jr, out_value_text);
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(&jr));
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  }
+
+  return AZ_ERROR_ITEM_NOT_FOUND;
+}
+
+AZ_NODISCARD static az_result desired_append(az_span* ref_destination, az_span text)
+{
+  _az_RETURN_IF_NOT_ENOUGH_SIZE(*ref_destination, az_span_size(text));
+  *ref_destination = az_span_copy(*ref_destination, text);
+  return AZ_OK;
+}
+
+AZ_NODISCARD static az_result desired_merge_object(
+    az_span target_text,
+    az_span patch_text,
+    az_span* ref_destination,
+    int32_t depth);
+
+AZ_NODISCARD static az_result
+desired_append_name(az_span* ref_destination, bool* ref_need_comma, az_json_token const* name)
+{
+  if (*ref_need_comma)
+  {
+    _az_RETURN_IF_FAILED(desired_append(ref_destination, AZ_SPAN_FROM_STR(",")));
+  }
+
+  *ref_need_comma = true;
+  _az_RETURN_IF_FAILED(desired_append(ref_destination, desired_token_text(name)));
+  return desired_append(ref_destination, AZ_SPAN_FROM_STR(":"));
+}
+
+// Appends a member of the merged object, given its value in the target object (if any) and in the
+// patch, as specified by RFC 7386.
+AZ_NODISCARD static az_result desired_append_merged_member(
+    az_span* ref_destination,
+    bool* ref_need_comma,
+    az_json_token const* name,
+    az_json_token_kind target_kind,
+    az_span target_text,
+    az_json_token_kind patch_kind,
+    az_span patch_text,
+    int32_t depth)
+{
+  // A null value removes the member.
+  if (patch_kind == AZ_JSON_TOKEN_NULL)
+  {
+    return AZ_OK;
+  }
+
+  _az_RETURN_IF_FAILED(desired_append_name(ref_destination, ref_need_comma, name));
+
+  // An object is merged into the target value, unless the target value isn't an object, in which
+  // case it is merged into an empty object, so that its null members are removed.
+  if (patch_kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
+  {
+    return desired_merge_object(
+        target_kind == AZ_JSON_TOKEN_BEGIN_OBJECT ? target_text : desired_empty_object,
+        patch_text,
+        ref_destination,
+        depth + 1);
+  }
+
+  return desired_append(ref_destination, patch_text);
+}
+
+AZ_NODISCARD static az_result desired_merge_object(
+    az_span target_text,
+    az_span patch_text,
+    az_span* ref_destination,
+    int32_t depth)
+{
+  if (depth > desired_max_depth)
+  {
+    return AZ_ERROR_JSON_NESTING_OVERFLOW;
+  }
+
+  bool need_comma = false;
+  az_json_token name;
+  az_json_token_kind value_kind = AZ_JSON_TOKEN_NONE;
+  az_span value_text = AZ_SPAN_EMPTY;
+  az_json_token_kind other_kind = AZ_JSON_TOKEN_NONE;
+  az_span other_text = AZ_SPAN_EMPTY;
+  az_json_reader jr;
+
+  _az_RETURN_IF_FAILED(desired_append(ref_destination, AZ_SPAN_FROM_STR("{")));
+
+  // The members of the target object, which the patch leaves, replaces, merges into or removes.
+  _az_RETURN_IF_FAILED(az_json_reader_init(&jr, target_text, NULL));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+
+  while (jr.token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    name = jr.token;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+    value_kind = jr.token.kind;
+    _az_RETURN_IF_FAILED(desired_read_value_text(&jr, &value_text));
+
+    az_result const result = desired_find_member(patch_text, &name, &other_kind, &other_text);
+    if (result == AZ_ERROR_ITEM_NOT_FOUND)
+    {
+      _az_RETURN_IF_FAILED(desired_append_name(ref_destination, &need_comma, &name));
+      _az_RETURN_IF_FAILED(desired_append(ref_destination, value_text));
+    }
+    else
+    {
+      _az_RETURN_IF_FAILED(result);
+      _az_RETURN_IF_FAILED(desired_append_merged_member(
+          ref_destination,
+          &need_comma,
+          &name,
+          value_kind,
+          value_text,
+          other_kind,
+          other_text,
+          depth));
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  }
+
+  // The members of the patch which the target object doesn't have.
+  _az_RETURN_IF_FAILED(az_json_reader_init(&jr, patch_text, NULL));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+
+  while (jr.token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    name = jr.token;
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+    value_kind = jr.token.kind;
+    _az_RETURN_IF_FAILED(desired_read_value_text(&jr, &value_text));
+
+    az_result const result = desired_find_member(target_text, &name, &other_kind, &other_text);
+    if (result == AZ_ERROR_ITEM_NOT_FOUND)
+    {
+      _az_RETURN_IF_FAILED(desired_append_merged_member(
+          ref_destination,
+          &need_comma,
+          &name,
+          AZ_JSON_TOKEN_NONE,
+          AZ_SPAN_EMPTY,
+          value_kind,
+          value_text,
+          depth));
+    }
+    else
+    {
+      _az_RETURN_IF_FAILED(result);
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  }
+
+  return desired_append(ref_destination, AZ_SPAN_FROM_STR("}"));
+}
+
+// Finds the desired properties object within the response to a properties GET request.
+AZ_NODISCARD static az_result desired_find_desired_object(az_span payload, az_span* out_text)
+{
+  az_json_reader jr;
+  _az_RETURN_IF_FAILED(az_json_reader_init(&jr, payload, NULL));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+
+  while (jr.token.kind == AZ_JSON_TOKEN_PROPERTY_NAME)
+  {
+    bool const is_desired = az_json_token_is_text_equal(&jr.token, iot_hub_properties_desired);
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+
+    if (is_desired)
+    {
+      if (jr.token.kind != AZ_JSON_TOKEN_BEGIN_OBJECT)
+      {
+        return AZ_ERROR_UNEXPECTED_CHAR;
+      }
+
+      return desired_read_value_text(&jr, out_text);
+    }
+
+    _az_RETURN_IF_FAILED(az_json_reader_skip_children(&jr));
+    _az_RETURN_IF_FAILED(az_json_reader_next_token(&jr));
+  }
+
+  return AZ_ERROR_ITEM_NOT_FOUND;
+}
+
+// Checks that an object has no more levels of nested objects than a merge accepts. Like the merge,
+// this doesn't look into arrays, which are always replaced as a whole.
+AZ_NODISCARD static az_result desired_check_depth(az_span object_text)
+{
+  az_json_reader jr;
+  _az_RETURN_IF_FAILED(az_json_reader_init(&jr, object_text, NULL));
+
+  int32_t depth = 0;
+  while (az_result_succeeded(az_json_reader_next_token(&jr)))
+  {
+    if (jr.token.kind == AZ_JSON_TOKEN_BEGIN_OBJECT)
+    {
+      if (++depth > desired_max_depth)
+      {
+        return AZ_ERROR_JSON_NESTING_OVERFLOW;
+      }
+    }
+    else if (jr.token.kind == AZ_JSON_TOKEN_END_OBJECT)
+    {
+      depth--;
+    }
+    else if (jr.token.kind == AZ_JSON_TOKEN_BEGIN_ARRAY)
+    {
+      _az_RETURN_IF_FAILED(az_json_reader_skip_children(&jr));
+    }
+  }
+
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_properties_desired_state_update(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_desired_state* ref_state,
+    az_iot_hub_client_properties_message_type message_type,
+    az_span payload)
+{
+  _az_PRECONDITION_NOT_NULL(client);
+  _az_PRECONDITION_NOT_NULL(ref_state);
+  _az_PRECONDITION(
+      (message_type == AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED)
+      || (message_type == AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE));
+  _az_PRECONDITION_VALID_SPAN(payload, 1, false);
+
+  int32_t version = 0;
+  az_json_reader jr;
+  _az_RETURN_IF_FAILED(az_json_reader_init(&jr, payload, NULL));
+  _az_RETURN_IF_FAILED(
+      az_iot_hub_client_properties_get_properties_version(client, &jr, message_type, &version));
+
+  az_span scratch = ref_state->_internal.scratch_buffer;
+
+  if (message_type == AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE)
+  {
+    az_span desired_text = AZ_SPAN_EMPTY;
+    _az_RETURN_IF_FAILED(desired_find_desired_object(payload, &desired_text));
+    _az_RETURN_IF_FAILED(desired_check_depth(desired_text));
+    _az_RETURN_IF_FAILED(desired_append(&scratch, desired_text));
+  }
+  else if (ref_state->_internal.version == 0 || version > ref_state->_internal.version + 1)
+  {
+    return AZ_ERROR_IOT_PROPERTIES_VERSION_GAP;
+  }
+  else if (version <= ref_state->_internal.version)
+  {
+    // Already part of the document.
+    return AZ_OK;
+  }
+  else
+  {
+    _az_RETURN_IF_FAILED(desired_merge_object(
+        az_iot_hub_client_properties_desired_state_get_document(ref_state),
+        payload,
+        &scratch,
+        1));
+  }
+
+  // The scratch buffer now holds the document.
+  az_span const document_buffer = ref_state->_internal.scratch_buffer;
+  ref_state->_internal.scratch_buffer = ref_state->_internal.document_buffer;
+  ref_state->_internal.document_buffer = document_buffer;
+  ref_state->_internal.document_size = az_span_size(document_buffer) - az_span_size(scratch);
+  ref_state->_internal.version = version;
+
+  return AZ_OK;
+}
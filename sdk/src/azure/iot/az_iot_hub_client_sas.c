@@ -170,3 +170,53 @@ AZ_NODISCARD az_result az_iot_hub_client_sas_get_password(
 
   return AZ_OK;
 }
+
+// Adapt the hub client's functions to the ones shared with the provisioning client.
+AZ_NODISCARD static az_result _az_iot_hub_client_sas_token_get_signature(
+    void const* client,
+    uint64_t token_expiration_epoch_time,
+    az_span signature,
+    az_span* out_signature)
+{
+  return az_iot_hub_client_sas_get_signature(
+      (az_iot_hub_client const*)client, token_expiration_epoch_time, signature, out_signature);
+}
+
+AZ_NODISCARD static az_result _az_iot_hub_client_sas_token_get_password(
+    void const* client,
+    uint64_t token_expiration_epoch_time,
+    az_span base64_hmac_sha256_signature,
+    az_span key_name,
+    char* mqtt_password,
+    size_t mqtt_password_size,
+    size_t* out_mqtt_password_length)
+{
+  return az_iot_hub_client_sas_get_password(
+      (az_iot_hub_client const*)client,
+      token_expiration_epoch_time,
+      base64_hmac_sha256_signature,
+      key_name,
+      mqtt_password,
+      mqtt_password_size,
+      out_mqtt_password_length);
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_sas_token_get_password(
+    az_iot_hub_client const* client,
+    az_iot_sas_token_manager* manager,
+    uint64_t current_epoch_time,
+    az_span* out_mqtt_password)
+{
+  _az_PRECONDITION_NOT_NULL(client);
+  _az_PRECONDITION_NOT_NULL(manager);
+  _az_PRECONDITION(current_epoch_time > 0);
+  _az_PRECONDITION_NOT_NULL(out_mqtt_password);
+
+  return _az_iot_sas_token_manager_get_password(
+      manager,
+      client,
+      _az_iot_hub_client_sas_token_get_signature,
+      _az_iot_hub_client_sas_token_get_password,
+      current_epoch_time,
+      out_mqtt_password);
+}
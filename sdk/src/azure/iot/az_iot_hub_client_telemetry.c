@@ -1,6 +1,7 @@
 // Copyright (c) Microsoft Corporation. All rights reserved.
 // SPDX-License-Identifier: MIT
 
+#include <azure/core/az_json.h>
 #include <azure/core/az_precondition.h>
 #include <azure/core/az_result.h>
 #include <azure/core/az_span.h>
@@ -16,6 +17,9 @@ static const uint8_t null_terminator = '\0';
 static const az_span telemetry_topic_prefix = AZ_SPAN_LITERAL_FROM_STR("devices/");
 static const az_span telemetry_topic_modules_mid = AZ_SPAN_LITERAL_FROM_STR("/modules/");
 static const az_span telemetry_topic_suffix = AZ_SPAN_LITERAL_FROM_STR("/messages/events/");
+static const az_span telemetry_batch_content_type
+    = AZ_SPAN_LITERAL_FROM_STR("application%2Fjson");
+static const az_span telemetry_batch_content_encoding = AZ_SPAN_LITERAL_FROM_STR("utf-8");
 
 AZ_NODISCARD az_result az_iot_hub_client_telemetry_get_publish_topic(
     az_iot_hub_client const* client,
@@ -74,3 +78,108 @@ AZ_NODISCARD az_result az_iot_hub_client_telemetry_get_publish_topic(
 
   return AZ_OK;
 }
+
+AZ_NODISCARD az_result az_iot_hub_client_telemetry_batch_init(
+    az_iot_hub_client_telemetry_batch* out_batch,
+    az_span payload_buffer)
+{
+  _az_PRECONDITION_NOT_NULL(out_batch);
+  _az_PRECONDITION_VALID_SPAN(payload_buffer, 2, false);
+
+  out_batch->_internal.record_count = 0;
+
+  // The writer never uses the last byte, so that the array can always be closed, however many
+  // records are added.
+  _az_RETURN_IF_FAILED(az_json_writer_init(
+      &out_batch->_internal.writer,
+      az_span_slice(payload_buffer, 0, az_span_size(payload_buffer) - 1),
+      NULL));
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_array(&out_batch->_internal.writer));
+
+  out_batch->_internal.record_writer = out_batch->_internal.writer;
+  return AZ_OK;
+}
+
+AZ_NODISCARD az_json_writer* az_iot_hub_client_telemetry_batch_begin_record(
+    az_iot_hub_client_telemetry_batch* ref_batch)
+{
+  _az_PRECONDITION_NOT_NULL(ref_batch);
+
+  // The record is written past the end of the array, which is left as is until the record ends.
+  ref_batch->_internal.record_writer = ref_batch->_internal.writer;
+  return &ref_batch->_internal.record_writer;
+}
+
+AZ_NODISCARD az_result
+az_iot_hub_client_telemetry_batch_end_record(az_iot_hub_client_telemetry_batch* ref_batch)
+{
+  _az_PRECONDITION_NOT_NULL(ref_batch);
+
+  az_json_writer const* record_writer = &ref_batch->_internal.record_writer;
+
+  // A complete record leaves the writer back within the array, after having written something.
+  if (record_writer->_internal.bit_stack._internal.current_depth != 1
+      || record_writer->total_bytes_written == ref_batch->_internal.writer.total_bytes_written)
+  {
+    ref_batch->_internal.record_writer = ref_batch->_internal.writer;
+    return AZ_ERROR_JSON_INVALID_STATE;
+  }
+
+  ref_batch->_internal.writer = *record_writer;
+  ref_batch->_internal.record_count++;
+  return AZ_OK;
+}
+
+AZ_NODISCARD static az_result _az_iot_message_properties_append_if_not_found(
+    az_iot_message_properties* properties,
+    az_span name,
+    az_span value)
+{
+  az_span existing_value = AZ_SPAN_EMPTY;
+  az_result const result = az_iot_message_properties_find(properties, name, &existing_value);
+
+  if (result == AZ_ERROR_ITEM_NOT_FOUND)
+  {
+    return az_iot_message_properties_append(properties, name, value);
+  }
+
+  return result;
+}
+
+AZ_NODISCARD az_result az_iot_hub_client_telemetry_batch_get_publish_message(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_telemetry_batch const* batch,
+    az_iot_message_properties* properties,
+    char* mqtt_topic,
+    size_t mqtt_topic_size,
+    size_t* out_mqtt_topic_length,
+    az_span* out_payload)
+{
+  _az_PRECONDITION_NOT_NULL(client);
+  _az_PRECONDITION_NOT_NULL(batch);
+  _az_PRECONDITION_NOT_NULL(properties);
+  _az_PRECONDITION_NOT_NULL(mqtt_topic);
+  _az_PRECONDITION(mqtt_topic_size > 0);
+  _az_PRECONDITION_NOT_NULL(out_payload);
+
+  _az_RETURN_IF_FAILED(_az_iot_message_properties_append_if_not_found(
+      properties,
+      AZ_SPAN_FROM_STR(AZ_IOT_MESSAGE_PROPERTIES_CONTENT_TYPE),
+      telemetry_batch_content_type));
+  _az_RETURN_IF_FAILED(_az_iot_message_properties_append_if_not_found(
+      properties,
+      AZ_SPAN_FROM_STR(AZ_IOT_MESSAGE_PROPERTIES_CONTENT_ENCODING),
+      telemetry_batch_content_encoding));
+
+  _az_RETURN_IF_FAILED(az_iot_hub_client_telemetry_get_publish_topic(
+      client, properties, mqtt_topic, mqtt_topic_size, out_mqtt_topic_length));
+
+  // The array is closed within the byte reserved for it, right after the last record that was
+  // ended. Since the writer itself isn't updated, more records can still be added afterwards.
+  az_span const json = az_json_writer_get_bytes_used_in_destination(&batch->_internal.writer);
+  az_span const payload = az_span_create(az_span_ptr(json), az_span_size(json) + 1);
+  az_span_copy_u8(az_span_slice_to_end(payload, az_span_size(json)), ']');
+
+  *out_payload = payload;
+  return AZ_OK;
+}
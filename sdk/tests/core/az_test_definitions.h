@@ -2,11 +2,13 @@
 // SPDX-License-Identifier: MIT
 
 int test_az_base64();
+int test_az_cbor();
 int test_az_context();
 int test_az_http();
 int test_az_json();
 int test_az_logging();
 int test_az_pipeline();
 int test_az_policy();
+int test_az_sha256();
 int test_az_span();
 int test_az_url_encode();
@@ -7,6 +7,7 @@
 #include <setjmp.h>
 #include <stdarg.h>
 #include <stddef.h>
+#include <string.h>
 
 #include <cmocka.h>
 
@@ -548,6 +549,310 @@ static void az_base64_url_decode_invalid_test(void** state)
   assert_int_equal(bytes_written, 0);
 }
 
+// Long enough for the encoder and decoder to go through whole vector blocks, with some left over.
+#define _az_BASE64_LONG_TEXT                                                                    \
+  "CzBVep/E6Q4zWH2ix+wRNluApcrvFDleg6jN8hc8YYar0PUaP2SJrtP4HUJnjLHW+yBFao+02f4jSG2St9wBJktwlbr" \
+  "fBClOc5i94gcsUXabwOUKL1R5nsPoDTJXfKHG6xA1Wg=="
+
+#define _az_BASE64_URL_LONG_TEXT                                                                \
+  "CzBVep_E6Q4zWH2ix-wRNluApcrvFDleg6jN8hc8YYar0PUaP2SJrtP4HUJnjLHW-yBFao-02f4jSG2St9wBJktwlbr" \
+  "fBClOc5i94gcsUXabwOUKL1R5nsPoDTJXfKHG6xA1Wg"
+
+static void _az_base64_get_long_test_bytes(uint8_t* bytes, int32_t size)
+{
+  for (int32_t i = 0; i < size; i++)
+  {
+    bytes[i] = (uint8_t)(i * 37 + 11);
+  }
+}
+
+static void az_base64_long_test(void** state)
+{
+  (void)state;
+
+  uint8_t bytes[100];
+  _az_base64_get_long_test_bytes(bytes, sizeof(bytes));
+
+  uint8_t text_buffer[136];
+  int32_t text_length = 0;
+  assert_true(az_result_succeeded(az_base64_encode(
+      AZ_SPAN_FROM_BUFFER(text_buffer), AZ_SPAN_FROM_BUFFER(bytes), &text_length)));
+  assert_int_equal(text_length, sizeof(text_buffer));
+  assert_true(az_span_is_content_equal(
+      AZ_SPAN_FROM_BUFFER(text_buffer), AZ_SPAN_FROM_STR(_az_BASE64_LONG_TEXT)));
+
+  uint8_t decoded[100];
+  int32_t decoded_length = 0;
+  assert_true(az_result_succeeded(az_base64_decode(
+      AZ_SPAN_FROM_BUFFER(decoded), AZ_SPAN_FROM_STR(_az_BASE64_LONG_TEXT), &decoded_length)));
+  assert_int_equal(decoded_length, sizeof(decoded));
+  assert_memory_equal(decoded, bytes, sizeof(bytes));
+
+  memset(decoded, 0, sizeof(decoded));
+  assert_true(az_result_succeeded(az_base64_url_decode(
+      AZ_SPAN_FROM_BUFFER(decoded), AZ_SPAN_FROM_STR(_az_BASE64_URL_LONG_TEXT), &decoded_length)));
+  assert_int_equal(decoded_length, sizeof(decoded));
+  assert_memory_equal(decoded, bytes, sizeof(bytes));
+
+  // Every length, to end at every offset within a block.
+  for (int32_t size = 1; size <= (int32_t)sizeof(bytes); size++)
+  {
+    az_span const source = az_span_create(bytes, size);
+    assert_true(az_result_succeeded(
+        az_base64_encode(AZ_SPAN_FROM_BUFFER(text_buffer), source, &text_length)));
+    assert_int_equal(text_length, az_base64_get_max_encoded_size(size));
+
+    assert_true(az_result_succeeded(az_base64_decode(
+        AZ_SPAN_FROM_BUFFER(decoded),
+        az_span_create(text_buffer, text_length),
+        &decoded_length)));
+    assert_true(az_span_is_content_equal(az_span_create(decoded, decoded_length), source));
+  }
+}
+
+static void _az_base64_decode_invalid_char_test_helper(az_span text, bool is_url)
+{
+  uint8_t text_buffer[136];
+  az_span const source = az_span_create(text_buffer, az_span_size(text));
+  uint8_t destination_buffer[100];
+  az_span const destination = AZ_SPAN_FROM_BUFFER(destination_buffer);
+
+  // The last four characters may be padding, which is covered by the tests above.
+  for (int32_t position = 0; position < az_span_size(text) - 4; position++)
+  {
+    for (int32_t c = 0; c < 256; c++)
+    {
+      bool const is_valid = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z')
+          || (c >= '0' && c <= '9')
+          || (is_url ? (c == '-' || c == '_') : (c == '+' || c == '/'));
+
+      az_span_copy(source, text);
+      text_buffer[position] = (uint8_t)c;
+
+      int32_t bytes_written = 0;
+      az_result const result = is_url
+          ? az_base64_url_decode(destination, source, &bytes_written)
+          : az_base64_decode(destination, source, &bytes_written);
+      assert_int_equal(result, is_valid ? AZ_OK : AZ_ERROR_UNEXPECTED_CHAR);
+    }
+  }
+}
+
+static void az_base64_decode_long_invalid_test(void** state)
+{
+  (void)state;
+  _az_base64_decode_invalid_char_test_helper(AZ_SPAN_FROM_STR(_az_BASE64_LONG_TEXT), false);
+  _az_base64_decode_invalid_char_test_helper(AZ_SPAN_FROM_STR(_az_BASE64_URL_LONG_TEXT), true);
+}
+
+static int32_t _az_base64_min(int32_t a, int32_t b)
+{
+  return a < b ? a : b;
+}
+
+static void _az_base64_encoder_test_helper(az_base64_alphabet alphabet, az_span expected)
+{
+  uint8_t bytes[100];
+  _az_base64_get_long_test_bytes(bytes, sizeof(bytes));
+
+  // Every chunk size, so that chunks split groups of 3 bytes in every way.
+  for (int32_t chunk_size = 1; chunk_size <= 7; chunk_size++)
+  {
+    az_base64_encoder encoder;
+    assert_int_equal(az_base64_encoder_init(&encoder, alphabet), AZ_OK);
+
+    uint8_t text_buffer[136];
+    int32_t text_length = 0;
+    for (int32_t offset = 0; offset < (int32_t)sizeof(bytes); offset += chunk_size)
+    {
+      int32_t const size = _az_base64_min(chunk_size, (int32_t)sizeof(bytes) - offset);
+      int32_t written = 0;
+      assert_int_equal(
+          az_base64_encoder_update(
+              &encoder,
+              az_span_create(text_buffer + text_length, az_base64_get_max_encoded_size(size)),
+              az_span_create(bytes + offset, size),
+              &written),
+          AZ_OK);
+      text_length += written;
+    }
+
+    int32_t written = 0;
+    assert_int_equal(
+        az_base64_encoder_final(&encoder, az_span_create(text_buffer + text_length, 4), &written),
+        AZ_OK);
+    text_length += written;
+
+    assert_true(az_span_is_content_equal(az_span_create(text_buffer, text_length), expected));
+  }
+}
+
+static void az_base64_encoder_test(void** state)
+{
+  (void)state;
+
+  _az_base64_encoder_test_helper(
+      AZ_BASE64_ALPHABET_STANDARD, AZ_SPAN_FROM_STR(_az_BASE64_LONG_TEXT));
+  _az_base64_encoder_test_helper(
+      AZ_BASE64_ALPHABET_URL, AZ_SPAN_FROM_STR(_az_BASE64_URL_LONG_TEXT));
+
+  az_base64_encoder encoder;
+  assert_int_equal(az_base64_encoder_init(&encoder, AZ_BASE64_ALPHABET_STANDARD), AZ_OK);
+
+  uint8_t destination_buffer[8];
+  az_span const destination = AZ_SPAN_FROM_BUFFER(destination_buffer);
+  int32_t written = 0;
+
+  // Nothing to write until a whole group is provided.
+  assert_int_equal(
+      az_base64_encoder_update(&encoder, destination, AZ_SPAN_FROM_STR("\x01\x02"), &written),
+      AZ_OK);
+  assert_int_equal(written, 0);
+
+  // Nothing is consumed when the destination is too small.
+  az_span const next_bytes = AZ_SPAN_FROM_STR("\x03\x04\x05\x06");
+  assert_int_equal(
+      az_base64_encoder_update(&encoder, az_span_slice(destination, 0, 7), next_bytes, &written),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_base64_encoder_update(&encoder, destination, next_bytes, &written), AZ_OK);
+  assert_int_equal(written, 8);
+  assert_memory_equal(destination_buffer, "AQIDBAUG", 8);
+
+  assert_int_equal(az_base64_encoder_final(&encoder, destination, &written), AZ_OK);
+  assert_int_equal(written, 0);
+
+  // The encoder is reset by az_base64_encoder_final, and the URL alphabet isn't padded.
+  assert_int_equal(az_base64_encoder_init(&encoder, AZ_BASE64_ALPHABET_URL), AZ_OK);
+  assert_int_equal(
+      az_base64_encoder_update(&encoder, destination, AZ_SPAN_FROM_STR("\xFB\xFF"), &written),
+      AZ_OK);
+  assert_int_equal(
+      az_base64_encoder_final(&encoder, az_span_slice(destination, 0, 2), &written),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_base64_encoder_final(&encoder, destination, &written), AZ_OK);
+  assert_int_equal(written, 3);
+  assert_memory_equal(destination_buffer, "-_8", 3);
+}
+
+static void _az_base64_decoder_test_helper(az_base64_alphabet alphabet, az_span text)
+{
+  uint8_t expected[100];
+  _az_base64_get_long_test_bytes(expected, sizeof(expected));
+
+  // Every chunk size, so that chunks split groups of 4 characters in every way.
+  for (int32_t chunk_size = 1; chunk_size <= 9; chunk_size++)
+  {
+    az_base64_decoder decoder;
+    assert_int_equal(az_base64_decoder_init(&decoder, alphabet), AZ_OK);
+
+    uint8_t bytes[100];
+    int32_t bytes_length = 0;
+    for (int32_t offset = 0; offset < az_span_size(text); offset += chunk_size)
+    {
+      int32_t const size = _az_base64_min(chunk_size, az_span_size(text) - offset);
+      int32_t written = 0;
+      assert_int_equal(
+          az_base64_decoder_update(
+              &decoder,
+              az_span_create(bytes + bytes_length, (int32_t)sizeof(bytes) - bytes_length),
+              az_span_slice(text, offset, offset + size),
+              &written),
+          AZ_OK);
+      bytes_length += written;
+    }
+
+    int32_t written = 0;
+    assert_int_equal(
+        az_base64_decoder_final(
+            &decoder,
+            az_span_create(bytes + bytes_length, (int32_t)sizeof(bytes) - bytes_length),
+            &written),
+        AZ_OK);
+    bytes_length += written;
+
+    assert_int_equal(bytes_length, sizeof(expected));
+    assert_memory_equal(bytes, expected, sizeof(expected));
+  }
+}
+
+static void az_base64_decoder_test(void** state)
+{
+  (void)state;
+
+  _az_base64_decoder_test_helper(
+      AZ_BASE64_ALPHABET_STANDARD, AZ_SPAN_FROM_STR(_az_BASE64_LONG_TEXT));
+  _az_base64_decoder_test_helper(
+      AZ_BASE64_ALPHABET_URL, AZ_SPAN_FROM_STR(_az_BASE64_URL_LONG_TEXT));
+
+  az_base64_decoder decoder;
+  uint8_t destination_buffer[6];
+  az_span const destination = AZ_SPAN_FROM_BUFFER(destination_buffer);
+  int32_t written = 0;
+
+  // Nothing is consumed when the destination is too small, and padding shortens the last group.
+  assert_int_equal(az_base64_decoder_init(&decoder, AZ_BASE64_ALPHABET_STANDARD), AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQI"), &written), AZ_OK);
+  assert_int_equal(written, 0);
+  assert_int_equal(
+      az_base64_decoder_update(
+          &decoder, az_span_slice(destination, 0, 3), AZ_SPAN_FROM_STR("DBA=="), &written),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("DBA="), &written), AZ_OK);
+  assert_int_equal(written, 3);
+  assert_memory_equal(destination_buffer, "\x01\x02\x03", 3);
+  assert_int_equal(
+      az_base64_decoder_update(
+          &decoder, az_span_slice(destination, 0, 1), AZ_SPAN_FROM_STR("="), &written),
+      AZ_OK);
+  assert_int_equal(written, 1);
+  assert_int_equal(destination_buffer[0], 4);
+
+  // Nothing may follow padding.
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQ"), &written),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_base64_decoder_final(&decoder, destination, &written), AZ_OK);
+  assert_int_equal(written, 0);
+
+  assert_int_equal(az_base64_decoder_init(&decoder, AZ_BASE64_ALPHABET_STANDARD), AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQ==AQID"), &written),
+      AZ_ERROR_UNEXPECTED_CHAR);
+
+  // The standard alphabet must be padded, while the URL alphabet doesn't need to be.
+  assert_int_equal(az_base64_decoder_init(&decoder, AZ_BASE64_ALPHABET_STANDARD), AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQID-_=="), &written),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_base64_decoder_init(&decoder, AZ_BASE64_ALPHABET_STANDARD), AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQIDBA"), &written),
+      AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_final(&decoder, destination, &written), AZ_ERROR_UNEXPECTED_END);
+
+  assert_int_equal(az_base64_decoder_init(&decoder, AZ_BASE64_ALPHABET_URL), AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQID-_8"), &written),
+      AZ_OK);
+  assert_int_equal(written, 3);
+  assert_int_equal(
+      az_base64_decoder_final(&decoder, az_span_slice(destination, 0, 1), &written),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_base64_decoder_final(&decoder, destination, &written), AZ_OK);
+  assert_int_equal(written, 2);
+  assert_memory_equal(destination_buffer, "\xFB\xFF", 2);
+
+  assert_int_equal(az_base64_decoder_init(&decoder, AZ_BASE64_ALPHABET_URL), AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_update(&decoder, destination, AZ_SPAN_FROM_STR("AQIDB"), &written),
+      AZ_OK);
+  assert_int_equal(
+      az_base64_decoder_final(&decoder, destination, &written), AZ_ERROR_UNEXPECTED_END);
+}
+
 int test_az_base64()
 {
   const struct CMUnitTest tests[] = {
@@ -563,6 +868,10 @@ int test_az_base64()
     cmocka_unit_test(az_base64_url_decode_destination_small_test),
     cmocka_unit_test(az_base64_url_decode_source_small_test),
     cmocka_unit_test(az_base64_url_decode_invalid_test),
+    cmocka_unit_test(az_base64_long_test),
+    cmocka_unit_test(az_base64_decode_long_invalid_test),
+    cmocka_unit_test(az_base64_encoder_test),
+    cmocka_unit_test(az_base64_decoder_test),
   };
   return cmocka_run_group_tests_name("az_core_base64", tests, NULL, NULL);
 }
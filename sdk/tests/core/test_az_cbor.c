@@ -0,0 +1,499 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_test_definitions.h"
+#include <azure/core/az_cbor.h>
+#include <azure/core/internal/az_result_internal.h>
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+
+#include <cmocka.h>
+
+#include <azure/core/_az_cfg.h>
+
+#define TEST_EXPECT_SUCCESS(exp) assert_true(az_result_succeeded(exp))
+
+// {"temperature": 21.5, "humidity": 40, "ok": true, "id": null, "samples": [1, -2, 300],
+// "blob": h'0102'}, as written by the az_cbor_writer.
+static az_span const _test_cbor_document = AZ_SPAN_LITERAL_FROM_STR(
+    "\xbf"
+    "\x6b"
+    "temperature"
+    "\xf9\x4d\x60"
+    "\x68"
+    "humidity"
+    "\x18\x28"
+    "\x62"
+    "ok"
+    "\xf5"
+    "\x62"
+    "id"
+    "\xf6"
+    "\x67"
+    "samples"
+    "\x9f\x01\x21\x19\x01\x2c\xff"
+    "\x64"
+    "blob"
+    "\x42\x01\x02"
+    "\xff");
+
+static void _test_cbor_write_document(az_cbor_writer* ref_writer)
+{
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_begin_object(ref_writer));
+  TEST_EXPECT_SUCCESS(
+      az_cbor_writer_append_property_name(ref_writer, AZ_SPAN_FROM_STR("temperature")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_double(ref_writer, 21.5));
+  TEST_EXPECT_SUCCESS(
+      az_cbor_writer_append_property_name(ref_writer, AZ_SPAN_FROM_STR("humidity")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_int32(ref_writer, 40));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_property_name(ref_writer, AZ_SPAN_FROM_STR("ok")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_bool(ref_writer, true));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_property_name(ref_writer, AZ_SPAN_FROM_STR("id")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_null(ref_writer));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_property_name(ref_writer, AZ_SPAN_FROM_STR("samples")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_begin_array(ref_writer));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_int32(ref_writer, 1));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_int64(ref_writer, -2));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_uint64(ref_writer, 300));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_end_array(ref_writer));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_property_name(ref_writer, AZ_SPAN_FROM_STR("blob")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_bytes(ref_writer, AZ_SPAN_FROM_STR("\x01\x02")));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_end_object(ref_writer));
+}
+
+static void test_cbor_writer(void** state)
+{
+  (void)state;
+
+  uint8_t buffer[100] = { 0 };
+  az_cbor_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  _test_cbor_write_document(&writer);
+
+  assert_int_equal(writer.total_bytes_written, az_span_size(_test_cbor_document));
+  assert_true(az_span_is_content_equal(
+      az_cbor_writer_get_bytes_used_in_destination(&writer), _test_cbor_document));
+
+  // Nothing is written when a string doesn't fit.
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, az_span_create(buffer, 4), NULL));
+  assert_int_equal(
+      az_cbor_writer_append_string(&writer, AZ_SPAN_FROM_STR("abcd")), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(writer.total_bytes_written, 0);
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_string(&writer, AZ_SPAN_FROM_STR("abc")));
+  assert_true(az_span_is_content_equal(
+      az_cbor_writer_get_bytes_used_in_destination(&writer), AZ_SPAN_FROM_STR("\x63" "abc")));
+
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  for (int32_t i = 0; i < 16; i++)
+  {
+    TEST_EXPECT_SUCCESS(az_cbor_writer_append_begin_array(&writer));
+  }
+  assert_int_equal(az_cbor_writer_append_begin_object(&writer), AZ_ERROR_JSON_NESTING_OVERFLOW);
+}
+
+static void _test_cbor_integer(int64_t value, az_span expected)
+{
+  uint8_t buffer[9] = { 0 };
+  az_cbor_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_int64(&writer, value));
+  assert_true(
+      az_span_is_content_equal(az_cbor_writer_get_bytes_used_in_destination(&writer), expected));
+
+  az_cbor_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, expected, NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_CBOR_TOKEN_NUMBER);
+
+  int64_t read = 0;
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_int64(&reader.token, &read));
+  assert_true(read == value);
+  assert_int_equal(az_cbor_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+}
+
+static void _test_cbor_double(double value, az_span expected)
+{
+  uint8_t buffer[9] = { 0 };
+  az_cbor_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_double(&writer, value));
+  assert_true(
+      az_span_is_content_equal(az_cbor_writer_get_bytes_used_in_destination(&writer), expected));
+
+  az_cbor_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, expected, NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_CBOR_TOKEN_NUMBER);
+
+  double read = 0;
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_double(&reader.token, &read));
+  assert_memory_equal(&read, &value, sizeof(value));
+  assert_int_equal(az_cbor_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+}
+
+// The examples of RFC 8949, appendix A, which all use the preferred serialization.
+static void test_cbor_numbers(void** state)
+{
+  (void)state;
+
+  _test_cbor_integer(0, AZ_SPAN_FROM_STR("\x00"));
+  _test_cbor_integer(23, AZ_SPAN_FROM_STR("\x17"));
+  _test_cbor_integer(24, AZ_SPAN_FROM_STR("\x18\x18"));
+  _test_cbor_integer(100, AZ_SPAN_FROM_STR("\x18\x64"));
+  _test_cbor_integer(1000, AZ_SPAN_FROM_STR("\x19\x03\xe8"));
+  _test_cbor_integer(1000000, AZ_SPAN_FROM_STR("\x1a\x00\x0f\x42\x40"));
+  _test_cbor_integer(1000000000000, AZ_SPAN_FROM_STR("\x1b\x00\x00\x00\xe8\xd4\xa5\x10\x00"));
+  _test_cbor_integer(-1, AZ_SPAN_FROM_STR("\x20"));
+  _test_cbor_integer(-10, AZ_SPAN_FROM_STR("\x29"));
+  _test_cbor_integer(-100, AZ_SPAN_FROM_STR("\x38\x63"));
+  _test_cbor_integer(-1000, AZ_SPAN_FROM_STR("\x39\x03\xe7"));
+  _test_cbor_integer(INT64_MIN, AZ_SPAN_FROM_STR("\x3b\x7f\xff\xff\xff\xff\xff\xff\xff"));
+
+  _test_cbor_double(0.0, AZ_SPAN_FROM_STR("\xf9\x00\x00"));
+  _test_cbor_double(-0.0, AZ_SPAN_FROM_STR("\xf9\x80\x00"));
+  _test_cbor_double(1.0, AZ_SPAN_FROM_STR("\xf9\x3c\x00"));
+  _test_cbor_double(1.1, AZ_SPAN_FROM_STR("\xfb\x3f\xf1\x99\x99\x99\x99\x99\x9a"));
+  _test_cbor_double(1.5, AZ_SPAN_FROM_STR("\xf9\x3e\x00"));
+  _test_cbor_double(65504.0, AZ_SPAN_FROM_STR("\xf9\x7b\xff"));
+  _test_cbor_double(100000.0, AZ_SPAN_FROM_STR("\xfa\x47\xc3\x50\x00"));
+  _test_cbor_double(3.4028234663852886e+38, AZ_SPAN_FROM_STR("\xfa\x7f\x7f\xff\xff"));
+  _test_cbor_double(1.0e+300, AZ_SPAN_FROM_STR("\xfb\x7e\x37\xe4\x3c\x88\x00\x75\x9c"));
+  _test_cbor_double(5.960464477539063e-8, AZ_SPAN_FROM_STR("\xf9\x00\x01"));
+  _test_cbor_double(0.00006103515625, AZ_SPAN_FROM_STR("\xf9\x04\x00"));
+  _test_cbor_double(-4.0, AZ_SPAN_FROM_STR("\xf9\xc4\x00"));
+  _test_cbor_double(-4.1, AZ_SPAN_FROM_STR("\xfb\xc0\x10\x66\x66\x66\x66\x66\x66"));
+
+  uint8_t buffer[9] = { 0 };
+  az_cbor_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, AZ_SPAN_FROM_BUFFER(buffer), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_uint64(&writer, UINT64_MAX));
+  assert_true(az_span_is_content_equal(
+      az_cbor_writer_get_bytes_used_in_destination(&writer),
+      AZ_SPAN_FROM_STR("\x1b\xff\xff\xff\xff\xff\xff\xff\xff")));
+
+  // Numbers which don't fit within the requested type.
+  az_cbor_reader reader = { 0 };
+  uint64_t u64 = 0;
+  uint32_t u32 = 0;
+  int64_t i64 = 0;
+  int32_t i32 = 0;
+  double number = 0;
+  bool boolean = false;
+
+  TEST_EXPECT_SUCCESS(
+      az_cbor_reader_init(&reader, az_cbor_writer_get_bytes_used_in_destination(&writer), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_uint64(&reader.token, &u64));
+  assert_true(u64 == UINT64_MAX);
+  assert_int_equal(az_cbor_token_get_uint32(&reader.token, &u32), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_cbor_token_get_int64(&reader.token, &i64), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_cbor_token_get_boolean(&reader.token, &boolean), AZ_ERROR_JSON_INVALID_STATE);
+
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, AZ_SPAN_FROM_STR("\x3a\x80\x00\x00\x00"), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(az_cbor_token_get_uint64(&reader.token, &u64), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_cbor_token_get_int32(&reader.token, &i32), AZ_ERROR_UNEXPECTED_CHAR);
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_int64(&reader.token, &i64));
+  assert_true(i64 == -2147483649LL);
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_double(&reader.token, &number));
+  assert_true(number < -2147483648.5 && number > -2147483649.5);
+
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, AZ_SPAN_FROM_STR("\xf9\x3e\x00"), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(az_cbor_token_get_int32(&reader.token, &i32), AZ_ERROR_UNEXPECTED_CHAR);
+
+  // Infinity and NaN, of half precision.
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, AZ_SPAN_FROM_STR("\xf9\x7c\x00"), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(az_cbor_token_get_double(&reader.token, &number), AZ_ERROR_UNEXPECTED_CHAR);
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, AZ_SPAN_FROM_STR("\xf9\x7e\x00"), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(az_cbor_token_get_double(&reader.token, &number), AZ_ERROR_UNEXPECTED_CHAR);
+}
+
+static void _test_cbor_reader_expect(az_span cbor, az_cbor_token_kind const* kinds, int32_t count)
+{
+  az_cbor_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, cbor, NULL));
+  for (int32_t i = 0; i < count; i++)
+  {
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, kinds[i]);
+  }
+  assert_int_equal(az_cbor_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+  assert_int_equal(reader._internal.total_bytes_consumed, az_span_size(cbor));
+}
+
+static void _test_cbor_reader_fails(az_span cbor, int32_t valid_tokens, az_result expected)
+{
+  az_cbor_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&reader, cbor, NULL));
+  for (int32_t i = 0; i < valid_tokens; i++)
+  {
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  }
+  assert_int_equal(az_cbor_reader_next_token(&reader), expected);
+}
+
+static void test_cbor_reader(void** state)
+{
+  (void)state;
+
+  // Maps and arrays of definite and indefinite lengths, from RFC 8949, appendix A.
+  {
+    az_cbor_token_kind const kinds[] = {
+      AZ_CBOR_TOKEN_BEGIN_ARRAY, AZ_CBOR_TOKEN_NUMBER,    AZ_CBOR_TOKEN_BEGIN_ARRAY,
+      AZ_CBOR_TOKEN_NUMBER,      AZ_CBOR_TOKEN_NUMBER,    AZ_CBOR_TOKEN_END_ARRAY,
+      AZ_CBOR_TOKEN_BEGIN_ARRAY, AZ_CBOR_TOKEN_NUMBER,    AZ_CBOR_TOKEN_NUMBER,
+      AZ_CBOR_TOKEN_END_ARRAY,   AZ_CBOR_TOKEN_END_ARRAY,
+    };
+    _test_cbor_reader_expect(AZ_SPAN_FROM_STR("\x83\x01\x82\x02\x03\x82\x04\x05"), kinds, 11);
+    _test_cbor_reader_expect(
+        AZ_SPAN_FROM_STR("\x9f\x01\x82\x02\x03\x9f\x04\x05\xff\xff"), kinds, 11);
+    _test_cbor_reader_expect(AZ_SPAN_FROM_STR("\x83\x01\x9f\x02\x03\xff\x82\x04\x05"), kinds, 11);
+  }
+  {
+    az_cbor_token_kind const kinds[] = {
+      AZ_CBOR_TOKEN_BEGIN_OBJECT,  AZ_CBOR_TOKEN_PROPERTY_NAME, AZ_CBOR_TOKEN_NUMBER,
+      AZ_CBOR_TOKEN_PROPERTY_NAME, AZ_CBOR_TOKEN_BEGIN_ARRAY,   AZ_CBOR_TOKEN_NUMBER,
+      AZ_CBOR_TOKEN_NUMBER,        AZ_CBOR_TOKEN_END_ARRAY,     AZ_CBOR_TOKEN_END_OBJECT,
+    };
+    _test_cbor_reader_expect(
+        AZ_SPAN_FROM_STR("\xa2\x61" "a" "\x01\x61" "b" "\x82\x02\x03"), kinds, 9);
+    _test_cbor_reader_expect(
+        AZ_SPAN_FROM_STR("\xbf\x61" "a" "\x01\x61" "b" "\x9f\x02\x03\xff\xff"), kinds, 9);
+  }
+  {
+    az_cbor_token_kind const kinds[] = {
+      AZ_CBOR_TOKEN_BEGIN_OBJECT, AZ_CBOR_TOKEN_END_OBJECT,
+    };
+    _test_cbor_reader_expect(AZ_SPAN_FROM_STR("\xa0"), kinds, 2);
+  }
+
+  // Tags are skipped.
+  az_cbor_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(
+      &reader, AZ_SPAN_FROM_STR("\xd8\x20\x76" "http://www.example.com"), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_CBOR_TOKEN_STRING);
+  assert_true(
+      az_cbor_token_is_text_equal(&reader.token, AZ_SPAN_FROM_STR("http://www.example.com")));
+
+  uint32_t u32 = 0;
+  TEST_EXPECT_SUCCESS(
+      az_cbor_reader_init(&reader, AZ_SPAN_FROM_STR("\xc1\x1a\x51\x4b\x67\xb0"), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_uint32(&reader.token, &u32));
+  assert_int_equal(u32, 1363896240);
+
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x82\x01"), 2, AZ_ERROR_UNEXPECTED_END);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x63" "ab"), 0, AZ_ERROR_UNEXPECTED_END);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x19\x01"), 0, AZ_ERROR_UNEXPECTED_END);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x01\x01"), 1, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\xa1\x01\x02"), 1, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x81\xff"), 1, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\xbf\x61" "a" "\xff"), 2, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x9f\xc1\xff"), 1, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x1c"), 0, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\xf7"), 0, AZ_ERROR_UNEXPECTED_CHAR);
+  _test_cbor_reader_fails(AZ_SPAN_FROM_STR("\x5f\x41\x01\xff"), 0, AZ_ERROR_NOT_SUPPORTED);
+
+  uint8_t nested[17] = { 0 };
+  for (int32_t i = 0; i < 16; i++)
+  {
+    nested[i] = 0x81;
+  }
+  nested[16] = 0x01;
+  _test_cbor_reader_fails(AZ_SPAN_FROM_BUFFER(nested), 33, AZ_ERROR_JSON_READER_DONE);
+  nested[16] = 0x81;
+  _test_cbor_reader_fails(AZ_SPAN_FROM_BUFFER(nested), 16, AZ_ERROR_JSON_NESTING_OVERFLOW);
+}
+
+static void test_cbor_reader_document(void** state)
+{
+  (void)state;
+
+  // The same document is read from a single buffer, and one byte at a time.
+  az_span chunks[100] = { 0 };
+  int32_t const size = az_span_size(_test_cbor_document);
+  assert_true(size <= 100);
+  for (int32_t i = 0; i < size; i++)
+  {
+    chunks[i] = az_span_slice(_test_cbor_document, i, i + 1);
+  }
+
+  az_cbor_reader readers[2] = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_reader_init(&readers[0], _test_cbor_document, NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_chunked_init(&readers[1], chunks, size, NULL));
+
+  for (int32_t i = 0; i < 2; i++)
+  {
+    az_cbor_reader* reader = &readers[i];
+    char text[16] = { 0 };
+    int32_t text_length = 0;
+    double number = 0;
+    int32_t i32 = 0;
+    bool boolean = false;
+    uint8_t bytes[4] = { 0 };
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_BEGIN_OBJECT);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_PROPERTY_NAME);
+    assert_int_equal(reader->token._internal.is_multisegment, i == 1);
+    assert_true(az_cbor_token_is_text_equal(&reader->token, AZ_SPAN_FROM_STR("temperature")));
+    assert_false(az_cbor_token_is_text_equal(&reader->token, AZ_SPAN_FROM_STR("temperaturE")));
+    assert_false(az_cbor_token_is_text_equal(&reader->token, AZ_SPAN_FROM_STR("temp")));
+    TEST_EXPECT_SUCCESS(az_cbor_token_get_string(&reader->token, text, 12, &text_length));
+    assert_int_equal(text_length, 11);
+    assert_string_equal(text, "temperature");
+    assert_int_equal(
+        az_cbor_token_get_string(&reader->token, text, 11, NULL), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_NUMBER);
+    TEST_EXPECT_SUCCESS(az_cbor_token_get_double(&reader->token, &number));
+    assert_true(number > 21.49 && number < 21.51);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    TEST_EXPECT_SUCCESS(az_cbor_token_get_int32(&reader->token, &i32));
+    assert_int_equal(i32, 40);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    TEST_EXPECT_SUCCESS(az_cbor_token_get_boolean(&reader->token, &boolean));
+    assert_true(boolean);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_NULL);
+
+    // The samples are skipped over.
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_true(az_cbor_token_is_text_equal(&reader->token, AZ_SPAN_FROM_STR("samples")));
+    TEST_EXPECT_SUCCESS(az_cbor_reader_skip_children(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_END_ARRAY);
+    assert_int_equal(reader->current_depth, 1);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_BYTES);
+    assert_int_equal(reader->token.size, 2);
+    az_cbor_token_copy_into_span(&reader->token, AZ_SPAN_FROM_BUFFER(bytes));
+    assert_true(bytes[0] == 1 && bytes[1] == 2);
+    assert_int_equal(
+        az_cbor_token_get_string(&reader->token, text, 16, NULL), AZ_ERROR_JSON_INVALID_STATE);
+
+    TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(reader));
+    assert_int_equal(reader->token.kind, AZ_CBOR_TOKEN_END_OBJECT);
+    assert_int_equal(reader->current_depth, 0);
+    assert_int_equal(az_cbor_reader_next_token(reader), AZ_ERROR_JSON_READER_DONE);
+    assert_int_equal(reader->_internal.total_bytes_consumed, size);
+  }
+
+  // A number, split in the middle of its argument.
+  az_span number_chunks[] = {
+    AZ_SPAN_FROM_STR("\x1a\x00"),
+    AZ_SPAN_FROM_STR("\x0f"),
+    AZ_SPAN_FROM_STR("\x42\x40"),
+  };
+  uint32_t u32 = 0;
+  TEST_EXPECT_SUCCESS(az_cbor_reader_chunked_init(&readers[0], number_chunks, 3, NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_reader_next_token(&readers[0]));
+  TEST_EXPECT_SUCCESS(az_cbor_token_get_uint32(&readers[0].token, &u32));
+  assert_int_equal(u32, 1000000);
+  assert_int_equal(readers[0].token.size, 5);
+  assert_true(readers[0].token._internal.is_multisegment);
+
+  TEST_EXPECT_SUCCESS(az_cbor_reader_chunked_init(&readers[0], number_chunks, 2, NULL));
+  assert_int_equal(az_cbor_reader_next_token(&readers[0]), AZ_ERROR_UNEXPECTED_END);
+}
+
+typedef struct
+{
+  az_span buffer;
+  int32_t offset;
+} _test_cbor_allocator_context;
+
+// Hands out consecutive slices of a single buffer, of the minimum required size, but no less than 7
+// bytes, so that the whole CBOR data ends up contiguous.
+static az_result _test_cbor_allocator(
+    az_span_allocator_context* allocator_context,
+    az_span* out_next_destination)
+{
+  _test_cbor_allocator_context* context
+      = (_test_cbor_allocator_context*)allocator_context->user_context;
+  int32_t const size = allocator_context->minimum_required_size < 7
+      ? 7
+      : allocator_context->minimum_required_size;
+
+  context->offset += allocator_context->bytes_used;
+  if (context->offset + size > az_span_size(context->buffer))
+  {
+    return AZ_ERROR_NOT_ENOUGH_SPACE;
+  }
+
+  *out_next_destination = az_span_slice(context->buffer, context->offset, context->offset + size);
+  return AZ_OK;
+}
+
+static void test_cbor_writer_chunked(void** state)
+{
+  (void)state;
+
+  uint8_t expected[200] = { 0 };
+  uint8_t chunked[200] = { 0 };
+  az_span const long_text
+      = AZ_SPAN_FROM_STR("0123456789012345678901234567890123456789012345678901234567890123456789"
+                         "0123456789012345678901234567890123456789");
+
+  az_cbor_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(&writer, AZ_SPAN_FROM_BUFFER(expected), NULL));
+  _test_cbor_write_document(&writer);
+  int32_t const document_size = writer.total_bytes_written;
+  TEST_EXPECT_SUCCESS(az_cbor_writer_init(
+      &writer, az_span_slice_to_end(AZ_SPAN_FROM_BUFFER(expected), document_size), NULL));
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_string(&writer, long_text));
+  int32_t const expected_size = document_size + writer.total_bytes_written;
+
+  _test_cbor_allocator_context context = { .buffer = AZ_SPAN_FROM_BUFFER(chunked), .offset = 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_chunked_init(
+      &writer, az_span_create(chunked, 7), _test_cbor_allocator, &context, NULL));
+  _test_cbor_write_document(&writer);
+  assert_int_equal(writer.total_bytes_written, document_size);
+  assert_memory_equal(chunked, expected, (size_t)document_size);
+
+  // A long string is split across buffers.
+  az_span const remaining = az_span_slice_to_end(
+      AZ_SPAN_FROM_BUFFER(chunked), context.offset + writer._internal.bytes_written);
+  TEST_EXPECT_SUCCESS(az_cbor_writer_chunked_init(
+      &writer, az_span_slice(remaining, 0, 7), _test_cbor_allocator, &context, NULL));
+  context.offset = document_size;
+  TEST_EXPECT_SUCCESS(az_cbor_writer_append_string(&writer, long_text));
+  assert_int_equal(document_size + writer.total_bytes_written, expected_size);
+  assert_memory_equal(chunked, expected, (size_t)expected_size);
+
+  // Running out of buffers.
+  context = (_test_cbor_allocator_context){ .buffer = az_span_create(chunked, 20), .offset = 0 };
+  TEST_EXPECT_SUCCESS(az_cbor_writer_chunked_init(
+      &writer, az_span_create(chunked, 7), _test_cbor_allocator, &context, NULL));
+  assert_int_equal(
+      az_cbor_writer_append_string(&writer, long_text), AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
+int test_az_cbor()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(test_cbor_writer),
+    cmocka_unit_test(test_cbor_numbers),
+    cmocka_unit_test(test_cbor_reader),
+    cmocka_unit_test(test_cbor_reader_document),
+    cmocka_unit_test(test_cbor_writer_chunked),
+  };
+  return cmocka_run_group_tests_name("az_core_cbor", tests, NULL, NULL);
+}
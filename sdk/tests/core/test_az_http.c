@@ -1053,6 +1053,39 @@ static void test_http_response_append_overflow_on_second_call(void** state)
   }
 }
 
+static void test_http_header_name_hash(void** state)
+{
+  (void)state;
+
+  assert_int_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("retry-after")),
+      _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER);
+  assert_int_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("Retry-After")),
+      _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER);
+  assert_int_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("retry-after-ms")),
+      _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER_MS);
+  assert_int_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("RETRY-AFTER-MS")),
+      _az_HTTP_HEADER_NAME_HASH_RETRY_AFTER_MS);
+  assert_int_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("x-ms-retry-after-ms")),
+      _az_HTTP_HEADER_NAME_HASH_X_MS_RETRY_AFTER_MS);
+  assert_int_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("X-Ms-Retry-After-Ms")),
+      _az_HTTP_HEADER_NAME_HASH_X_MS_RETRY_AFTER_MS);
+
+  // Only letters are folded.
+  assert_int_not_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("retry@after")),
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("retry`after")));
+  assert_int_not_equal(
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("retry-after")),
+      _az_http_header_name_hash(AZ_SPAN_FROM_STR("retry-afte")));
+  assert_int_equal(_az_http_header_name_hash(AZ_SPAN_EMPTY), 0x811C9DC5U);
+}
+
 int test_az_http()
 {
 #ifndef AZ_NO_PRECONDITION_CHECKING
@@ -1076,6 +1109,7 @@ int test_az_http()
     cmocka_unit_test(test_http_response_append_overflow),
     cmocka_unit_test(test_http_response_append),
     cmocka_unit_test(test_http_response_append_overflow_on_second_call),
+    cmocka_unit_test(test_http_header_name_hash),
   };
   return cmocka_run_group_tests_name("az_core_http", tests, NULL, NULL);
 }
@@ -17,6 +17,7 @@
 
 #include <azure/core/_az_cfg.h>
 #include <stdlib.h>
+#include <string.h>
 #define TEST_EXPECT_SUCCESS(exp) assert_true(az_result_succeeded(exp))
 
 az_result test_allocator(
@@ -349,6 +350,119 @@ static void test_json_writer(void** state)
   }
 }
 
+static void test_json_writer_append_double_round_trip(void** state)
+{
+  (void)state;
+
+  double const values[]
+      = { 0.1, -0.0, 23.5, -122.3331, 0.1 + 0.2, 1.5e-7, 1e21, 9007199254740993.0 };
+
+  uint8_t array[200] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+  {
+    TEST_EXPECT_SUCCESS(az_json_writer_append_double_round_trip(&writer, values[i]));
+  }
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&writer));
+
+  az_span const json = az_json_writer_get_bytes_used_in_destination(&writer);
+  assert_true(az_span_is_content_equal(
+      json,
+      AZ_SPAN_FROM_STR(
+          "[0.1,-0,23.5,-122.3331,0.30000000000000004,1.5e-7,1e+21,9007199254740992]")));
+
+  // Every number must read back as the exact same value.
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  for (size_t i = 0; i < sizeof(values) / sizeof(values[0]); i++)
+  {
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    double value = 0;
+    TEST_EXPECT_SUCCESS(az_json_token_get_double(&reader.token, &value));
+    assert_memory_equal(&value, &values[i], sizeof(double));
+  }
+
+  // The writer requires enough space for the longest possible number.
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, az_span_create(array, 25), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  assert_int_equal(
+      az_json_writer_append_double_round_trip(&writer, 1), AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
+static void test_json_writer_append_64bit_and_number_text(void** state)
+{
+  (void)state;
+
+  uint8_t array[200] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("min")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, INT64_MIN));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("values")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, INT64_MAX));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&writer, 0));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_uint64(&writer, UINT64_MAX));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_uint64(&writer, 1700000000123ULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_number_text(&writer, AZ_SPAN_FROM_STR("-12.5e3")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_number_text(&writer, AZ_SPAN_FROM_STR("7")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, AZ_SPAN_FROM_STR("raw")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_number_text(&writer, AZ_SPAN_FROM_STR("0.25")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+
+  az_span const json = az_json_writer_get_bytes_used_in_destination(&writer);
+  assert_true(az_span_is_content_equal(
+      json,
+      AZ_SPAN_FROM_STR("{\"min\":-9223372036854775808,\"values\":[9223372036854775807,0,"
+                       "18446744073709551615,1700000000123,-12.5e3,7],\"raw\":0.25}")));
+
+  // The output must be valid JSON, and read back with the same values.
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  int64_t signed_value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_int64(&reader.token, &signed_value));
+  assert_true(signed_value == INT64_MIN);
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_token_get_int64(&reader.token, &signed_value));
+  assert_true(signed_value == INT64_MAX);
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  uint64_t unsigned_value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_uint64(&reader.token, &unsigned_value));
+  assert_true(unsigned_value == UINT64_MAX);
+  while (az_result_succeeded(az_json_reader_next_token(&reader)))
+  {
+  }
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+
+  // The 64-bit appenders require enough space for the longest possible number, while the number
+  // text only needs its own size.
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, az_span_create(array, 20), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  assert_int_equal(az_json_writer_append_int64(&writer, 1), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_json_writer_append_uint64(&writer, 1), AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_number_text(&writer, AZ_SPAN_FROM_STR("1234567890")));
+  assert_int_equal(
+      az_json_writer_append_number_text(&writer, AZ_SPAN_FROM_STR("123456789")),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_writer_append_number_text(&writer, AZ_SPAN_FROM_STR("12345678")));
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&writer),
+      AZ_SPAN_FROM_STR("[1234567890,12345678")));
+}
+
 static void test_json_writer_append_nested(void** state)
 {
   (void)state;
@@ -571,6 +685,54 @@ static void test_json_writer_append_nested_invalid(void** state)
   }
 }
 
+static void test_json_writer_append_validated_json_text(void** state)
+{
+  (void)state;
+
+  // The same JSON text, and the same result, as az_json_reader would read.
+  az_json_validated_text validated_text = { 0 };
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR(" -0.5e+3 "), NULL), AZ_OK);
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR("[1e ,\"\\u00e9\"]"), NULL), AZ_OK);
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR("{\"a\":nul"), NULL), AZ_ERROR_UNEXPECTED_END);
+  assert_int_equal(
+      az_json_validate(AZ_SPAN_FROM_STR("[\"\\u00g9\"]"), NULL), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_validate(AZ_SPAN_FROM_STR("{\"a\":1,}"), NULL), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR("[01]"), NULL), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR("[1]]"), NULL), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR("[1.]"), NULL), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_json_validate(AZ_SPAN_FROM_STR("1e"), NULL), AZ_ERROR_UNEXPECTED_END);
+
+  // The validator supports the same 64 levels of nesting as the reader.
+  int32_t const max_depth = 64;
+  uint8_t nested[2 * (64 + 1)] = { 0 };
+  memset(nested, '[', (size_t)max_depth + 1);
+  memset(nested + max_depth + 1, ']', (size_t)max_depth + 1);
+  assert_int_equal(az_json_validate(az_span_create(nested + 1, 2 * max_depth), NULL), AZ_OK);
+  assert_int_equal(
+      az_json_validate(AZ_SPAN_FROM_BUFFER(nested), NULL), AZ_ERROR_JSON_NESTING_OVERFLOW);
+
+  // Validated once, appended any number of times.
+  TEST_EXPECT_SUCCESS(az_json_validate(AZ_SPAN_FROM_STR("{\"a\": [1, true]}"), &validated_text));
+
+  uint8_t array[200] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_validated_json_text(&writer, &validated_text));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_validated_json_text(&writer, &validated_text));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&writer));
+
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&writer),
+      AZ_SPAN_FROM_STR("[{\"a\": [1, true]},{\"a\": [1, true]}]")));
+
+  // The state of the writer is still validated.
+  assert_int_equal(
+      az_json_writer_append_validated_json_text(&writer, &validated_text),
+      AZ_ERROR_JSON_INVALID_STATE);
+}
+
 static uint8_t json_array[200] = { 0 };
 
 typedef struct
@@ -1078,6 +1240,121 @@ az_result test_allocator_chunked(
   return AZ_OK;
 }
 
+typedef struct
+{
+  az_span output;
+  int32_t number_of_chunks;
+  uint8_t const* previous_chunk;
+  bool fail;
+} _az_json_writer_sink_test_context;
+
+static az_result _az_json_writer_sink_test_flush(void* user_context, az_span json_chunk)
+{
+  _az_json_writer_sink_test_context* context = (_az_json_writer_sink_test_context*)user_context;
+  if (context->fail)
+  {
+    return AZ_ERROR_CANCELED;
+  }
+
+  // The writer must never flush an empty chunk, and must write into each buffer in turn.
+  assert_true(az_span_size(json_chunk) > 0);
+  assert_true(az_span_ptr(json_chunk) != context->previous_chunk);
+  context->previous_chunk = az_span_ptr(json_chunk);
+  context->number_of_chunks++;
+
+  context->output = az_span_copy(context->output, json_chunk);
+  return AZ_OK;
+}
+
+// Writes the same JSON using any az_json_writer.
+static az_result _az_json_writer_sink_test_write(az_json_writer* ref_json_writer)
+{
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(ref_json_writer));
+  _az_RETURN_IF_FAILED(
+      az_json_writer_append_property_name(ref_json_writer, AZ_SPAN_FROM_STR("values")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_array(ref_json_writer));
+  for (int32_t i = 0; i < 40; i++)
+  {
+    _az_RETURN_IF_FAILED(az_json_writer_append_int32(ref_json_writer, i * 1000003));
+    _az_RETURN_IF_FAILED(az_json_writer_append_double(ref_json_writer, i / 7.0, 6));
+    _az_RETURN_IF_FAILED(az_json_writer_append_bool(ref_json_writer, i % 2 == 0));
+  }
+  _az_RETURN_IF_FAILED(az_json_writer_append_end_array(ref_json_writer));
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(
+      ref_json_writer,
+      AZ_SPAN_FROM_STR("a property name which is longer than the buffers, to split it across")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_string(
+      ref_json_writer,
+      AZ_SPAN_FROM_STR("a \"string\" which is longer than the buffers,\nwith characters to escape "
+                       "and \\ more text after them, so that it is split across the buffers")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(ref_json_writer, AZ_SPAN_FROM_STR("t")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_json_text(
+      ref_json_writer,
+      AZ_SPAN_FROM_STR("{\"json\":\"text\",\"which\":[\"is\",\"also\",\"longer\",\"than\",\"the\","
+                       "\"buffers\"]}")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(ref_json_writer, AZ_SPAN_FROM_STR("n")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_number_text(
+      ref_json_writer,
+      AZ_SPAN_FROM_STR("-1234567890123456789012345678901234567890.1234567890123456789012345678901"
+                       "234567890123456789e-308")));
+  return az_json_writer_append_end_object(ref_json_writer);
+}
+
+static void test_json_writer_sink(void** state)
+{
+  (void)state;
+
+  uint8_t expected_array[2048] = { 0 };
+  az_json_writer writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(expected_array), NULL));
+  TEST_EXPECT_SUCCESS(_az_json_writer_sink_test_write(&writer));
+  az_span const expected = az_json_writer_get_bytes_used_in_destination(&writer);
+
+  uint8_t first_buffer[64] = { 0 };
+  uint8_t second_buffer[80] = { 0 };
+  uint8_t output_array[2048] = { 0 };
+  _az_json_writer_sink_test_context context = {
+    .output = AZ_SPAN_FROM_BUFFER(output_array),
+    .number_of_chunks = 0,
+    .previous_chunk = NULL,
+    .fail = false,
+  };
+
+  az_json_writer_sink sink = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_sink_init(
+      &writer,
+      &sink,
+      AZ_SPAN_FROM_BUFFER(first_buffer),
+      AZ_SPAN_FROM_BUFFER(second_buffer),
+      _az_json_writer_sink_test_flush,
+      &context,
+      NULL));
+  TEST_EXPECT_SUCCESS(_az_json_writer_sink_test_write(&writer));
+  assert_true(context.number_of_chunks > az_span_size(expected) / 80);
+
+  // Nothing is flushed until the buffers are full, or the writer is flushed explicitly.
+  assert_true(az_span_ptr(context.output) - output_array < az_span_size(expected));
+  TEST_EXPECT_SUCCESS(az_json_writer_sink_flush(&writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_sink_flush(&writer));
+  assert_int_equal(writer.total_bytes_written, az_span_size(expected));
+
+  int32_t const output_size = (int32_t)(az_span_ptr(context.output) - output_array);
+  assert_true(az_span_is_content_equal(az_span_create(output_array, output_size), expected));
+
+  // A failure to flush is reported as a lack of space by the write that needed it.
+  context.fail = true;
+  TEST_EXPECT_SUCCESS(az_json_writer_sink_init(
+      &writer,
+      &sink,
+      AZ_SPAN_FROM_BUFFER(first_buffer),
+      AZ_SPAN_FROM_BUFFER(second_buffer),
+      _az_json_writer_sink_test_flush,
+      &context,
+      NULL));
+  assert_int_equal(_az_json_writer_sink_test_write(&writer), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_json_writer_sink_flush(&writer), AZ_ERROR_CANCELED);
+}
+
 static void test_json_writer_large_string_chunked(void** state)
 {
   (void)state;
@@ -1117,6 +1394,81 @@ static void test_json_writer_large_string_chunked(void** state)
   }
 }
 
+static void test_json_writer_escape_across_blocks(void** state)
+{
+  (void)state;
+
+  // Put a character which needs to be escaped at every position of strings, both shorter and
+  // longer than the blocks scanned at once, and check the output against escaping them by hand.
+  uint8_t const to_escape[] = { '"', '\\', '\n', 0x01, 0x1F };
+  az_span const escaped[] = {
+    AZ_SPAN_LITERAL_FROM_STR("\\\""),
+    AZ_SPAN_LITERAL_FROM_STR("\\\\"),
+    AZ_SPAN_LITERAL_FROM_STR("\\n"),
+    AZ_SPAN_LITERAL_FROM_STR("\\u0001"),
+    AZ_SPAN_LITERAL_FROM_STR("\\u001F"),
+  };
+
+  for (int32_t size = 1; size <= 40; size++)
+  {
+    for (int32_t position = 0; position < size; position++)
+    {
+      int32_t const kind = (size + position) % (int32_t)sizeof(to_escape);
+
+      uint8_t value_buffer[40] = { 0 };
+      for (int32_t i = 0; i < size; i++)
+      {
+        value_buffer[i] = (uint8_t)('a' + (i % 26));
+      }
+      value_buffer[position] = to_escape[kind];
+      // Also escape the last character, so a run of characters to copy can end in between.
+      value_buffer[size - 1] = size > 1 ? '\t' : value_buffer[size - 1];
+      az_span const value = az_span_create(value_buffer, size);
+
+      uint8_t escaped_buffer[128] = { 0 };
+      az_span remainder = az_span_copy_u8(AZ_SPAN_FROM_BUFFER(escaped_buffer), '"');
+      for (int32_t i = 0; i < size; i++)
+      {
+        if (i == size - 1 && size > 1)
+        {
+          remainder = az_span_copy(remainder, AZ_SPAN_FROM_STR("\\t"));
+        }
+        else if (i == position)
+        {
+          remainder = az_span_copy(remainder, escaped[kind]);
+        }
+        else
+        {
+          remainder = az_span_copy_u8(remainder, value_buffer[i]);
+        }
+      }
+      remainder = az_span_copy_u8(remainder, '"');
+      az_span const escaped_value = az_span_create(
+          escaped_buffer, (int32_t)(az_span_ptr(remainder) - escaped_buffer));
+
+      uint8_t array[512] = { 0 };
+      az_json_writer writer = { 0 };
+      TEST_EXPECT_SUCCESS(az_json_writer_init(&writer, AZ_SPAN_FROM_BUFFER(array), NULL));
+      TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&writer));
+      TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&writer, value));
+      TEST_EXPECT_SUCCESS(az_json_writer_append_string(&writer, value));
+      TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&writer));
+
+      uint8_t expected_buffer[512] = { 0 };
+      remainder = az_span_copy_u8(AZ_SPAN_FROM_BUFFER(expected_buffer), '{');
+      remainder = az_span_copy(remainder, escaped_value);
+      remainder = az_span_copy_u8(remainder, ':');
+      remainder = az_span_copy(remainder, escaped_value);
+      remainder = az_span_copy_u8(remainder, '}');
+      az_span const expected = az_span_create(
+          expected_buffer, (int32_t)(az_span_ptr(remainder) - expected_buffer));
+
+      assert_true(az_span_is_content_equal(
+          az_json_writer_get_bytes_used_in_destination(&writer), expected));
+    }
+  }
+}
+
 /** Json reader **/
 az_result read_write(az_span input, az_span* output, int32_t* o);
 az_result read_write_token(
@@ -2981,6 +3333,969 @@ static void test_az_json_reader_chunked(void** state)
   assert_true(az_span_is_content_equal(expected, az_span_create_from_str(m.name_string)));
 }
 
+// Reads json using fragments of fragment_size bytes, and checks that every token matches the one
+// read by az_json_reader from a single buffer.
+static void _az_json_push_reader_check_fragments(az_span json, int32_t fragment_size)
+{
+  az_json_reader expected = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&expected, json, NULL));
+
+  uint8_t carry[32] = { 0 };
+  az_json_push_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+
+  int32_t offset = 0;
+  while (true)
+  {
+    az_result result = az_json_push_reader_next_token(&reader);
+    if (result == AZ_ERROR_JSON_READER_NEED_MORE_INPUT)
+    {
+      int32_t const end = offset + fragment_size < az_span_size(json) ? offset + fragment_size
+                                                                      : az_span_size(json);
+      TEST_EXPECT_SUCCESS(az_json_push_reader_feed(
+          &reader, az_span_slice(json, offset, end), end == az_span_size(json)));
+      offset = end;
+      continue;
+    }
+
+    az_result const expected_result = az_json_reader_next_token(&expected);
+    assert_int_equal(result, expected_result);
+    if (az_result_failed(result))
+    {
+      break;
+    }
+
+    assert_int_equal(reader.token.kind, expected.token.kind);
+    assert_int_equal(reader.current_depth, expected.current_depth);
+    assert_true(az_span_is_content_equal(reader.token.slice, expected.token.slice));
+    assert_int_equal(
+        reader.token._internal.string_has_escaped_chars,
+        expected.token._internal.string_has_escaped_chars);
+  }
+}
+
+static void test_az_json_push_reader(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      " { \"name\" : \"th\\\"ermo\\u00e9stat\" , \"values\": [ 1, -2.5e+3, 0, true, false, null,"
+      " {}, [] ], \"nested\": { \"a\": { \"b\": [ 12345678, \"\" ] } } , \"t\":21.5} \n");
+
+  for (int32_t fragment_size = 1; fragment_size <= az_span_size(json); fragment_size++)
+  {
+    _az_json_push_reader_check_fragments(json, fragment_size);
+  }
+
+  // A single value, outside of any object or array, can be split as well.
+  _az_json_push_reader_check_fragments(AZ_SPAN_FROM_STR("-1234.5e-6"), 1);
+  _az_json_push_reader_check_fragments(AZ_SPAN_FROM_STR(" \"abc\" "), 2);
+  _az_json_push_reader_check_fragments(AZ_SPAN_FROM_STR("true"), 3);
+
+  // The reader waits for the final fragment to know whether a number has ended.
+  uint8_t carry[8] = { 0 };
+  az_json_push_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_JSON_READER_NEED_MORE_INPUT);
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("12"), false));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_JSON_READER_NEED_MORE_INPUT);
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("3"), false));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_JSON_READER_NEED_MORE_INPUT);
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_EMPTY, true));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&reader));
+  int32_t value = 0;
+  TEST_EXPECT_SUCCESS(az_json_token_get_int32(&reader.token, &value));
+  assert_int_equal(value, 123);
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+  assert_int_equal(
+      az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR(" "), true), AZ_ERROR_JSON_INVALID_STATE);
+}
+
+static void test_az_json_push_reader_invalid(void** state)
+{
+  (void)state;
+
+  uint8_t carry[8] = { 0 };
+  az_json_push_reader reader = { 0 };
+
+  // A fragment can't be replaced before it has been read in full.
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("[1,"), false));
+  assert_int_equal(
+      az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("2]"), true), AZ_ERROR_JSON_INVALID_STATE);
+
+  // A token split across fragments must fit within the carry-over buffer.
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("[\"0123456789"), false));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&reader));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("[\"0123"), false));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&reader));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_JSON_READER_NEED_MORE_INPUT);
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("456789\"]"), true));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // Errors within the JSON text are reported as soon as they are read.
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("{\"a\" 1"), false));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&reader));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+  // The final fragment must complete the JSON text.
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("[tr"), false));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&reader));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_JSON_READER_NEED_MORE_INPUT);
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("ue"), true));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_TRUE);
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_END);
+
+  TEST_EXPECT_SUCCESS(az_json_push_reader_init(&reader, AZ_SPAN_FROM_BUFFER(carry)));
+  TEST_EXPECT_SUCCESS(az_json_push_reader_feed(&reader, AZ_SPAN_FROM_STR("  "), true));
+  assert_int_equal(az_json_push_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_END);
+}
+
+static void test_az_json_reader_long_string(void** state)
+{
+  (void)state;
+
+  // Long strings are scanned in blocks, so place the interesting characters at every offset to
+  // cover both the start, the middle, and the tail end of a block.
+  uint8_t json_buffer[72] = { 0 };
+  az_span json = AZ_SPAN_FROM_BUFFER(json_buffer);
+  az_span buffers_half[2] = { 0 };
+  az_span buffers72_one[72] = { 0 };
+
+  for (int32_t i = 1; i < az_span_size(json) - 2; i++)
+  {
+    // "aaa...\naaa..."
+    memset(json_buffer, 'a', sizeof(json_buffer));
+    json_buffer[0] = '"';
+    json_buffer[i] = '\\';
+    json_buffer[i + 1] = 'n';
+    json_buffer[sizeof(json_buffer) - 1] = '"';
+
+    az_json_reader reader = { 0 };
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+    assert_int_equal(reader.token.size, 70);
+    assert_true(reader.token._internal.string_has_escaped_chars);
+    assert_true(az_span_is_content_equal(reader.token.slice, az_span_slice(json, 1, 71)));
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_JSON_READER_DONE);
+
+    _az_split_buffers(json, buffers_half);
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers_half, 2, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+    assert_int_equal(reader.token.size, 70);
+    assert_true(reader.token._internal.string_has_escaped_chars);
+
+    _az_split_buffers_single_byte(json, buffers72_one);
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers72_one, 72, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+    assert_int_equal(reader.token.size, 70);
+    assert_true(reader.token._internal.string_has_escaped_chars);
+
+    // "aaa...\taaa...", where \t is an unescaped control character.
+    memset(json_buffer, 'a', sizeof(json_buffer));
+    json_buffer[0] = '"';
+    json_buffer[i] = '\t';
+    json_buffer[sizeof(json_buffer) - 1] = '"';
+
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+    _az_split_buffers(json, buffers_half);
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers_half, 2, NULL));
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+    // "aaa..."aaa...", where the string ends early.
+    memset(json_buffer, 'a', sizeof(json_buffer));
+    json_buffer[0] = '"';
+    json_buffer[i] = '"';
+    json_buffer[sizeof(json_buffer) - 1] = '"';
+
+    TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+    assert_int_equal(reader.token.size, i - 1);
+    assert_false(reader.token._internal.string_has_escaped_chars);
+
+    _az_split_buffers(json, buffers_half);
+    TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers_half, 2, NULL));
+    TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+    assert_int_equal(reader.token.size, i - 1);
+  }
+
+  // Non-ASCII UTF-8 bytes are regular string characters.
+  az_span utf8_json
+      = AZ_SPAN_FROM_STR("\"\xC3\xA9\xE2\x82\xAC abcdefghijklmnopqrstuvwxyz \xF0\x9F\x98\x80\"");
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, utf8_json, NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_STRING);
+  assert_int_equal(reader.token.size, az_span_size(utf8_json) - 2);
+  assert_false(reader.token._internal.string_has_escaped_chars);
+
+  // Unterminated long string.
+  memset(json_buffer, 'a', sizeof(json_buffer));
+  json_buffer[0] = '"';
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  assert_int_equal(az_json_reader_next_token(&reader), AZ_ERROR_UNEXPECTED_END);
+}
+
+static void _az_json_reader_structural_index_helper(az_span json, int32_t index_length)
+{
+  int32_t index[128] = { 0 };
+  assert_true(index_length <= 128);
+
+  az_json_reader_options options = az_json_reader_options_default();
+  options.structural_index = index;
+  options.structural_index_length = index_length;
+
+  az_json_reader expected_reader = { 0 };
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&expected_reader, json, NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, &options));
+
+  while (true)
+  {
+    az_result const expected_result = az_json_reader_next_token(&expected_reader);
+    assert_int_equal(az_json_reader_next_token(&reader), expected_result);
+    if (az_result_failed(expected_result))
+    {
+      break;
+    }
+
+    assert_int_equal(reader.token.kind, expected_reader.token.kind);
+    assert_int_equal(reader.current_depth, expected_reader.current_depth);
+    assert_int_equal(reader.token.size, expected_reader.token.size);
+    assert_ptr_equal(az_span_ptr(reader.token.slice), az_span_ptr(expected_reader.token.slice));
+    assert_int_equal(
+        reader._internal.total_bytes_consumed, expected_reader._internal.total_bytes_consumed);
+  }
+}
+
+static void test_az_json_reader_structural_index(void** state)
+{
+  (void)state;
+
+  az_span json = AZ_SPAN_FROM_STR("{\n"
+                                  "  \"desired\": {\n"
+                                  "    \"name\": \"a b\\\\\\\" c { } [ ] : , \\\\\",\n"
+                                  "    \"numbers\": [ 1 , -2.5e3,3, 0 ],\n"
+                                  "    \"flags\": [true,false, null ],\n"
+                                  "    \"empty\": {  },\n"
+                                  "    \"\\u00e9\\n\": \"        x        \",\n"
+                                  "    \"$version\": 42\n"
+                                  "  }\n"
+                                  "}\n\t\r ");
+
+  // Make sure the index is actually used, by checking its contents directly.
+  int32_t index[128] = { 0 };
+  az_json_reader_options options = az_json_reader_options_default();
+  options.structural_index = index;
+  options.structural_index_length = 128;
+
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, &options));
+  assert_int_equal(reader._internal.structural_index_count, 44);
+  assert_int_equal(index[0], 0); // {
+  assert_int_equal(index[1], 4); // "desired"
+  assert_int_equal(index[2], 13); // :
+  assert_int_equal(index[3], 15); // {
+  assert_int_equal(index[4], 21); // "name"
+  assert_int_equal(index[5], 27); // :
+  assert_int_equal(index[6], 29); // "a b\\\" c { } [ ] : , \\"
+  assert_int_equal(index[7], 55); // ,
+
+  for (int32_t i = 1; i <= 128; i++)
+  {
+    _az_json_reader_structural_index_helper(json, i);
+  }
+
+  // Whitespace-only payloads, and primitive values.
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("   "), 128);
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("  123  "), 128);
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("\"  \"   "), 128);
+
+  // Invalid JSON should fail the same way, with or without the index.
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("{ \"a\" : 1   2 }"), 128);
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("[ 1 ,   ]"), 128);
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("[ \"abc\"   x ]"), 128);
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("[ \"abc   ]"), 128);
+  _az_json_reader_structural_index_helper(AZ_SPAN_FROM_STR("[ 1 ]   ]"), 128);
+
+  // Backslashes and quotes straddling the 64 byte blocks.
+  uint8_t buffer[200] = { 0 };
+  for (int32_t i = 2; i < 190; i++)
+  {
+    memset(buffer, ' ', sizeof(buffer));
+    buffer[0] = '[';
+    buffer[1] = '"';
+    buffer[i] = '\\';
+    buffer[i + 1] = '"';
+    buffer[i + 2] = '"';
+    buffer[i + 4] = ',';
+    buffer[i + 6] = '1';
+    buffer[i + 7] = ']';
+    _az_json_reader_structural_index_helper(az_span_create(buffer, i + 9), 128);
+
+    buffer[i] = ' ';
+    buffer[i + 1] = '"';
+    buffer[i + 2] = ' ';
+    _az_json_reader_structural_index_helper(az_span_create(buffer, i + 9), 128);
+  }
+}
+
+static void _az_json_reader_assert_same_state(
+    az_json_reader const* actual,
+    az_json_reader const* expected)
+{
+  assert_int_equal(actual->token.kind, expected->token.kind);
+  assert_int_equal(actual->token.size, expected->token.size);
+  assert_ptr_equal(az_span_ptr(actual->token.slice), az_span_ptr(expected->token.slice));
+  assert_int_equal(actual->current_depth, expected->current_depth);
+  assert_int_equal(actual->_internal.buffer_index, expected->_internal.buffer_index);
+  assert_int_equal(actual->_internal.bytes_consumed, expected->_internal.bytes_consumed);
+  assert_int_equal(
+      actual->_internal.total_bytes_consumed, expected->_internal.total_bytes_consumed);
+}
+
+// Skips the children of every container and property within the JSON, both with and without
+// validation, and makes sure that the reader ends up in the same state either way.
+static void _az_json_reader_fast_skip_children_helper(az_json_reader reader)
+{
+  reader._internal.options.fast_skip_children = false;
+
+  while (az_result_succeeded(az_json_reader_next_token(&reader)))
+  {
+    az_json_token_kind const kind = reader.token.kind;
+    if (kind != AZ_JSON_TOKEN_BEGIN_OBJECT && kind != AZ_JSON_TOKEN_BEGIN_ARRAY
+        && kind != AZ_JSON_TOKEN_PROPERTY_NAME)
+    {
+      continue;
+    }
+
+    az_json_reader expected = reader;
+    az_json_reader actual = reader;
+    actual._internal.options.fast_skip_children = true;
+
+    TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&expected));
+    TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&actual));
+    _az_json_reader_assert_same_state(&actual, &expected);
+
+    az_result result = AZ_OK;
+    do
+    {
+      result = az_json_reader_next_token(&expected);
+      assert_int_equal(az_json_reader_next_token(&actual), result);
+      if (az_result_succeeded(result))
+      {
+        _az_json_reader_assert_same_state(&actual, &expected);
+      }
+    } while (az_result_succeeded(result));
+  }
+}
+
+static void test_json_skip_children_fast(void** state)
+{
+  (void)state;
+
+  az_span json = AZ_SPAN_FROM_STR(
+      "{\"desired\":{\"$version\":5,\"thermostat1\":{\"__t\":\"c\",\"targetTemperature\":21.5},"
+      "\"tricky\":\"} ] \\\" [ {\\\\\",\"array\":[[],[{}],{\"a\":[1,2,\"]\"]}],\"e\":{}},"
+      "\"reported\":{ \"$version\" : 1 , \"manufacturer\" : \"Contoso\\u0021\" , \"list\" : "
+      "[ true , false , null ] } }");
+
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  _az_json_reader_fast_skip_children_helper(reader);
+
+  int32_t index[128] = { 0 };
+  az_json_reader_options options = az_json_reader_options_default();
+  options.structural_index = index;
+  options.structural_index_length = 128;
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, &options));
+  assert_true(reader._internal.structural_index_count > 0);
+  _az_json_reader_fast_skip_children_helper(reader);
+
+  az_span buffers_half[2] = { 0 };
+  _az_split_buffers(json, buffers_half);
+  TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers_half, 2, NULL));
+  _az_json_reader_fast_skip_children_helper(reader);
+
+  az_span buffers_one[256] = { 0 };
+  assert_true(az_span_size(json) <= 256);
+  _az_split_buffers_single_byte(json, buffers_one);
+  TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers_one, az_span_size(json), NULL));
+  _az_json_reader_fast_skip_children_helper(reader);
+
+  options = az_json_reader_options_default();
+  options.fast_skip_children = true;
+
+  // Invalid JSON nested within the skipped container isn't validated.
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("[{\"a\" 1 2 x : ,}, 3]"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+  assert_int_equal(reader.current_depth, 1);
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_NUMBER);
+
+  // Mismatched brackets, unterminated strings and containers, and overly nested JSON are still
+  // detected.
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("[{\"a\":[1}]"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":[1]]"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_UNEXPECTED_CHAR);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("[\"]\\\"]"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_UNEXPECTED_END);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("[[[]]"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_UNEXPECTED_END);
+
+  // The maximum supported depth is 64.
+  uint8_t nested[65] = { 0 };
+  memset(nested, '[', sizeof(nested));
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_BUFFER(nested), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(az_json_reader_skip_children(&reader), AZ_ERROR_JSON_NESTING_OVERFLOW);
+
+  // Primitive values don't move the reader.
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":1}"), &options));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_NUMBER);
+  TEST_EXPECT_SUCCESS(az_json_reader_skip_children(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_NUMBER);
+}
+
+static void test_az_json_path_set_init(void** state)
+{
+  (void)state;
+
+  az_json_path_set path_set = { 0 };
+
+  az_span valid_paths[] = {
+    AZ_SPAN_LITERAL_FROM_STR(""),
+    AZ_SPAN_LITERAL_FROM_STR("/"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/$version"),
+    AZ_SPAN_LITERAL_FROM_STR("/a/0/b//c"),
+    AZ_SPAN_LITERAL_FROM_STR("/1/2/3/4/5/6/7/8/9/10/11/12/13/14/15/16"),
+  };
+  TEST_EXPECT_SUCCESS(az_json_path_set_init(&path_set, valid_paths, 5));
+  assert_int_equal(path_set._internal.paths_ending_at_depth[0], 0x1);
+  assert_int_equal(path_set._internal.paths_ending_at_depth[1], 0x2);
+  assert_int_equal(path_set._internal.paths_ending_at_depth[2], 0x4);
+  assert_int_equal(path_set._internal.paths_ending_at_depth[5], 0x8);
+  assert_int_equal(path_set._internal.paths_ending_at_depth[16], 0x10);
+
+  az_span invalid_path = AZ_SPAN_FROM_STR("desired/$version");
+  assert_int_equal(az_json_path_set_init(&path_set, &invalid_path, 1), AZ_ERROR_ARG);
+
+  az_span escaped_path = AZ_SPAN_FROM_STR("/a~1b");
+  assert_int_equal(az_json_path_set_init(&path_set, &escaped_path, 1), AZ_ERROR_NOT_SUPPORTED);
+
+  az_span deep_path = AZ_SPAN_FROM_STR("/1/2/3/4/5/6/7/8/9/10/11/12/13/14/15/16/17");
+  assert_int_equal(az_json_path_set_init(&path_set, &deep_path, 1), AZ_ERROR_NOT_SUPPORTED);
+}
+
+static void _az_json_find_paths_helper(az_json_reader* ref_json_reader, bool fast_skip_children)
+{
+  az_span paths[] = {
+    AZ_SPAN_LITERAL_FROM_STR("/desired/$version"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/thermostat1/targetTemperature"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/list/1"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/list/2/name"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/thermostat1"),
+    AZ_SPAN_LITERAL_FROM_STR("/reported/missing"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/list/01"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/escaped\n"),
+    AZ_SPAN_LITERAL_FROM_STR("/desired/list/1/name"),
+  };
+
+  az_json_path_set path_set = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_path_set_init(&path_set, paths, 9));
+
+  ref_json_reader->_internal.options.fast_skip_children = fast_skip_children;
+
+  az_json_token tokens[9] = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_find_paths(ref_json_reader, &path_set, tokens));
+
+  int32_t version = 0;
+  assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NUMBER);
+  TEST_EXPECT_SUCCESS(az_json_token_get_int32(&tokens[0], &version));
+  assert_int_equal(version, 7);
+
+  double temperature = 0;
+  assert_int_equal(tokens[1].kind, AZ_JSON_TOKEN_NUMBER);
+  TEST_EXPECT_SUCCESS(az_json_token_get_double(&tokens[1], &temperature));
+  assert_true(fabs(temperature - 21.5) < 1e-9);
+
+  assert_int_equal(tokens[2].kind, AZ_JSON_TOKEN_TRUE);
+  assert_int_equal(tokens[3].kind, AZ_JSON_TOKEN_STRING);
+  assert_true(az_json_token_is_text_equal(&tokens[3], AZ_SPAN_FROM_STR("third")));
+  assert_int_equal(tokens[4].kind, AZ_JSON_TOKEN_BEGIN_OBJECT);
+  assert_int_equal(tokens[5].kind, AZ_JSON_TOKEN_NONE);
+  assert_int_equal(tokens[6].kind, AZ_JSON_TOKEN_NONE);
+  assert_int_equal(tokens[7].kind, AZ_JSON_TOKEN_NULL);
+  assert_int_equal(tokens[8].kind, AZ_JSON_TOKEN_NONE);
+
+  // The whole document has been read.
+  assert_int_equal(ref_json_reader->token.kind, AZ_JSON_TOKEN_END_OBJECT);
+  assert_int_equal(ref_json_reader->current_depth, 0);
+  assert_int_equal(az_json_reader_next_token(ref_json_reader), AZ_ERROR_JSON_READER_DONE);
+}
+
+static void test_az_json_reader_find_paths(void** state)
+{
+  (void)state;
+
+  az_span json = AZ_SPAN_FROM_STR(
+      "{\"desired\":{\"other\":{\"$version\":1,\"list\":[1,2]},\"thermostat1\":{\"__t\":\"c\","
+      "\"targetTemperature\":21.5},\"$version\":7,\"list\":[{\"name\":\"first\"},true,"
+      "{\"name\":\"third\"}],\"escaped\\n\":null,\"escaped\\n\":false},"
+      "\"reported\":{\"$version\":3,\"thermostat1\":{\"targetTemperature\":1}}}");
+
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  _az_json_find_paths_helper(&reader, false);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+  _az_json_find_paths_helper(&reader, true);
+
+  az_span buffers_one[512] = { 0 };
+  assert_true(az_span_size(json) <= 512);
+  _az_split_buffers_single_byte(json, buffers_one);
+  TEST_EXPECT_SUCCESS(az_json_reader_chunked_init(&reader, buffers_one, az_span_size(json), NULL));
+  _az_json_find_paths_helper(&reader, true);
+
+  az_json_token tokens[2] = { 0 };
+  az_json_path_set path_set = { 0 };
+
+  // Stop reading as soon as all paths are found.
+  az_span paths[] = {
+    AZ_SPAN_LITERAL_FROM_STR("/reported"),
+    AZ_SPAN_LITERAL_FROM_STR(""),
+  };
+  TEST_EXPECT_SUCCESS(az_json_path_set_init(&path_set, paths, 2));
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"reported\":5,\"x\":1 2}"), NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, &path_set, tokens));
+  assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NUMBER);
+  assert_int_equal(tokens[1].kind, AZ_JSON_TOKEN_BEGIN_OBJECT);
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_NUMBER);
+
+  // Paths are relative to the value of the current property.
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":{\"reported\":5},\"b\":1}"), NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  TEST_EXPECT_SUCCESS(az_json_path_set_init(&path_set, paths, 1));
+  TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, &path_set, tokens));
+  assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NUMBER);
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_END_OBJECT);
+  assert_int_equal(reader.current_depth, 1);
+
+  // Primitive values don't contain any paths.
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("\"reported\""), NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_find_paths(&reader, &path_set, tokens));
+  assert_int_equal(tokens[0].kind, AZ_JSON_TOKEN_NONE);
+
+  // Invalid JSON is reported.
+  TEST_EXPECT_SUCCESS(
+      az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":[1,2,],\"reported\":1}"), NULL));
+  assert_int_equal(
+      az_json_reader_find_paths(&reader, &path_set, tokens), AZ_ERROR_UNEXPECTED_CHAR);
+
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("{\"a\":1"), NULL));
+  assert_int_equal(az_json_reader_find_paths(&reader, &path_set, tokens), AZ_ERROR_UNEXPECTED_END);
+}
+
+static void test_az_json_template(void** state)
+{
+  (void)state;
+
+  az_span const skeleton = AZ_SPAN_FROM_STR(
+      " {\"id\":null,\"sensor\":{\"temp\":null,\"unit\":\"C\"},\"ok\":null,\"values\":[null,null],"
+      "\"ts\":null,\"note\":null} ");
+
+  int32_t slot_offsets[8] = { 0 };
+  az_json_template json_template = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_template_init(&json_template, skeleton, slot_offsets, 8));
+  assert_int_equal(az_json_template_get_slot_count(&json_template), 7);
+
+  uint8_t array[200] = { 0 };
+  az_json_template_writer writer = { 0 };
+  assert_int_equal(
+      az_json_template_writer_init(&writer, &json_template, AZ_SPAN_FROM_BUFFER(array)), AZ_OK);
+
+  az_span json = AZ_SPAN_EMPTY;
+  assert_int_equal(az_json_template_writer_get_json(&writer, &json), AZ_ERROR_JSON_INVALID_STATE);
+
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_string(&writer, AZ_SPAN_FROM_STR("dev\"1")));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_double(&writer, 21.5, 2));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_bool(&writer, true));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int32(&writer, INT32_MIN));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_null(&writer));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int64(&writer, 1700000000123LL));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_string(&writer, AZ_SPAN_EMPTY));
+  assert_int_equal(
+      az_json_template_writer_append_bool(&writer, false), AZ_ERROR_JSON_INVALID_STATE);
+
+  az_span const expected = AZ_SPAN_FROM_STR(
+      " {\"id\":\"dev\\\"1\",\"sensor\":{\"temp\":21.5,\"unit\":\"C\"},\"ok\":true,"
+      "\"values\":[-2147483648,null],\"ts\":1700000000123,\"note\":\"\"} ");
+  TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&writer, &json));
+  assert_true(az_span_is_content_equal(json, expected));
+  assert_ptr_equal(az_span_ptr(json), array);
+
+  // Getting the JSON again gives the same result.
+  TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&writer, &json));
+  assert_true(az_span_is_content_equal(json, expected));
+
+  // The same template writes the same output as the equivalent az_json_writer calls.
+  assert_int_equal(
+      az_json_template_writer_init(&writer, &json_template, AZ_SPAN_FROM_BUFFER(array)), AZ_OK);
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_string(&writer, AZ_SPAN_FROM_STR("a\nb")));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_double(&writer, -0.125, 3));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_bool(&writer, false));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int32(&writer, 0));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int32(&writer, 42));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int64(&writer, INT64_MIN));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_null(&writer));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&writer, &json));
+
+  uint8_t expected_array[200] = { 0 };
+  az_json_writer json_writer = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_writer_init(&json_writer, AZ_SPAN_FROM_BUFFER(expected_array), NULL));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&json_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("id")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_string(&json_writer, AZ_SPAN_FROM_STR("a\nb")));
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("sensor")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_object(&json_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("temp")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_double(&json_writer, -0.125, 3));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("unit")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_string(&json_writer, AZ_SPAN_FROM_STR("C")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&json_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("ok")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_bool(&json_writer, false));
+  TEST_EXPECT_SUCCESS(
+      az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("values")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_begin_array(&json_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int32(&json_writer, 0));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int32(&json_writer, 42));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_array(&json_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("ts")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_int64(&json_writer, INT64_MIN));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_property_name(&json_writer, AZ_SPAN_FROM_STR("note")));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_null(&json_writer));
+  TEST_EXPECT_SUCCESS(az_json_writer_append_end_object(&json_writer));
+
+  // The template keeps the whitespace of the skeleton.
+  assert_true(az_span_is_content_equal(
+      az_span_slice(json, 1, az_span_size(json) - 1),
+      az_json_writer_get_bytes_used_in_destination(&json_writer)));
+
+  // A skeleton without any slots is copied as is.
+  TEST_EXPECT_SUCCESS(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("[1,\"null\"]"), NULL, 0));
+  assert_int_equal(az_json_template_get_slot_count(&json_template), 0);
+  assert_int_equal(
+      az_json_template_writer_init(&writer, &json_template, AZ_SPAN_FROM_BUFFER(array)), AZ_OK);
+  assert_int_equal(az_json_template_writer_append_null(&writer), AZ_ERROR_JSON_INVALID_STATE);
+  TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&writer, &json));
+  assert_true(az_span_is_content_equal(json, AZ_SPAN_FROM_STR("[1,\"null\"]")));
+
+  // A single slot can be the whole skeleton.
+  TEST_EXPECT_SUCCESS(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("null"), slot_offsets, 1));
+  assert_int_equal(
+      az_json_template_writer_init(&writer, &json_template, AZ_SPAN_FROM_BUFFER(array)), AZ_OK);
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int32(&writer, 7));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_get_json(&writer, &json));
+  assert_true(az_span_is_content_equal(json, AZ_SPAN_FROM_STR("7")));
+}
+
+static void test_az_json_template_invalid(void** state)
+{
+  (void)state;
+
+  int32_t slot_offsets[2] = { 0 };
+  az_json_template json_template = { 0 };
+
+  assert_int_equal(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("[null,null,null]"), slot_offsets, 2),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("{\"a\":null"), slot_offsets, 2),
+      AZ_ERROR_UNEXPECTED_END);
+  assert_int_equal(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("{\"a\":nul}"), slot_offsets, 2),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("{null:1}"), slot_offsets, 2),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_template_init(&json_template, AZ_SPAN_FROM_STR("[null] null"), slot_offsets, 2),
+      AZ_ERROR_UNEXPECTED_CHAR);
+
+  // On failure, the slot is left unfilled and can be written again with a larger buffer.
+  TEST_EXPECT_SUCCESS(az_json_template_init(
+      &json_template, AZ_SPAN_FROM_STR("{\"name\":null,\"count\":null}"), slot_offsets, 2));
+
+  uint8_t array[32] = { 0 };
+  az_json_template_writer writer = { 0 };
+  assert_int_equal(
+      az_json_template_writer_init(&writer, &json_template, az_span_create(array, 12)), AZ_OK);
+  assert_int_equal(
+      az_json_template_writer_append_string(&writer, AZ_SPAN_FROM_STR("abc")),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_string(&writer, AZ_SPAN_FROM_STR("a")));
+  assert_int_equal(
+      az_json_template_writer_append_int32(&writer, 123456), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_json_template_writer_append_double(&writer, 1.5, 1), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  assert_int_equal(
+      az_json_template_writer_init(&writer, &json_template, az_span_create(array, 22)), AZ_OK);
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_string(&writer, AZ_SPAN_FROM_STR("a")));
+  TEST_EXPECT_SUCCESS(az_json_template_writer_append_int32(&writer, 12));
+
+  // The text after the last slot doesn't fit.
+  az_span json = AZ_SPAN_EMPTY;
+  assert_int_equal(az_json_template_writer_get_json(&writer, &json), AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
+static void test_az_json_document(void** state)
+{
+  (void)state;
+
+  az_span const json = AZ_SPAN_FROM_STR(
+      "{ \"desired\": { \"thermostat1\": { \"__t\": \"c\", \"targetTemperature\": 21.5 },"
+      " \"modes\": [ \"eco\", { \"name\": \"boost\" }, [ 1, 2 ], null ],"
+      " \"enabled\": true, \"$version\": 42 }, \"reported\": {} }");
+
+  az_json_document_node nodes[40];
+  az_json_document document = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_document_init(&document, json, nodes, 40, NULL));
+  assert_int_equal(az_json_document_get_node_count(&document), 32);
+  assert_int_equal(az_json_document_get_next_index(&document, 0), 32);
+  assert_int_equal(az_json_document_get_token(&document, 31)->kind, AZ_JSON_TOKEN_END_OBJECT);
+
+  // Read $version first, and then the rest of the document, in any order.
+  int32_t desired = 0;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_get_property(&document, 0, AZ_SPAN_FROM_STR("desired"), &desired));
+  assert_int_equal(
+      az_json_document_get_token(&document, desired)->kind, AZ_JSON_TOKEN_BEGIN_OBJECT);
+
+  int32_t index = 0;
+  int32_t version = 0;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_get_property(&document, desired, AZ_SPAN_FROM_STR("$version"), &index));
+  TEST_EXPECT_SUCCESS(
+      az_json_token_get_int32(az_json_document_get_token(&document, index), &version));
+  assert_int_equal(version, 42);
+
+  int32_t thermostat = 0;
+  double temperature = 0;
+  TEST_EXPECT_SUCCESS(az_json_document_get_property(
+      &document, desired, AZ_SPAN_FROM_STR("thermostat1"), &thermostat));
+  TEST_EXPECT_SUCCESS(az_json_document_get_property(
+      &document, thermostat, AZ_SPAN_FROM_STR("targetTemperature"), &index));
+  TEST_EXPECT_SUCCESS(
+      az_json_token_get_double(az_json_document_get_token(&document, index), &temperature));
+  assert_true(temperature > 21.49 && temperature < 21.51);
+
+  bool enabled = false;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_get_property(&document, desired, AZ_SPAN_FROM_STR("enabled"), &index));
+  TEST_EXPECT_SUCCESS(
+      az_json_token_get_boolean(az_json_document_get_token(&document, index), &enabled));
+  assert_true(enabled);
+
+  // Nested names are not matched, only the ones of the object itself.
+  assert_int_equal(
+      az_json_document_get_property(&document, desired, AZ_SPAN_FROM_STR("name"), &index),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(
+      az_json_document_get_property(&document, 0, AZ_SPAN_FROM_STR("$version"), &index),
+      AZ_ERROR_ITEM_NOT_FOUND);
+
+  int32_t reported = 0;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_get_property(&document, 0, AZ_SPAN_FROM_STR("reported"), &reported));
+  assert_int_equal(
+      az_json_document_get_property(&document, reported, AZ_SPAN_FROM_STR("desired"), &index),
+      AZ_ERROR_ITEM_NOT_FOUND);
+  assert_int_equal(az_json_document_get_next_index(&document, reported), reported + 2);
+
+  // Array elements are skipped over in the same way.
+  int32_t modes = 0;
+  TEST_EXPECT_SUCCESS(
+      az_json_document_get_property(&document, desired, AZ_SPAN_FROM_STR("modes"), &modes));
+  TEST_EXPECT_SUCCESS(az_json_document_get_array_element(&document, modes, 0, &index));
+  assert_true(az_json_token_is_text_equal(
+      az_json_document_get_token(&document, index), AZ_SPAN_FROM_STR("eco")));
+  TEST_EXPECT_SUCCESS(az_json_document_get_array_element(&document, modes, 2, &index));
+  assert_int_equal(az_json_document_get_token(&document, index)->kind, AZ_JSON_TOKEN_BEGIN_ARRAY);
+  int32_t element = 0;
+  TEST_EXPECT_SUCCESS(az_json_document_get_array_element(&document, index, 1, &element));
+  TEST_EXPECT_SUCCESS(
+      az_json_token_get_int32(az_json_document_get_token(&document, element), &version));
+  assert_int_equal(version, 2);
+  assert_int_equal(
+      az_json_document_get_array_element(&document, index, 2, &element), AZ_ERROR_ITEM_NOT_FOUND);
+  TEST_EXPECT_SUCCESS(az_json_document_get_array_element(&document, modes, 3, &index));
+  assert_int_equal(az_json_document_get_token(&document, index)->kind, AZ_JSON_TOKEN_NULL);
+  assert_int_equal(
+      az_json_token_get_int32(az_json_document_get_token(&document, index), &version),
+      AZ_ERROR_JSON_INVALID_STATE);
+  assert_int_equal(
+      az_json_document_get_array_element(&document, modes, 4, &index), AZ_ERROR_ITEM_NOT_FOUND);
+
+  // The value of the root can also be a single token.
+  TEST_EXPECT_SUCCESS(az_json_document_init(&document, AZ_SPAN_FROM_STR(" 12 "), nodes, 1, NULL));
+  assert_int_equal(az_json_document_get_node_count(&document), 1);
+  assert_int_equal(az_json_document_get_next_index(&document, 0), 1);
+
+  // Reading with a structural index gives the same document.
+  int32_t structural_index[64] = { 0 };
+  az_json_reader_options options = az_json_reader_options_default();
+  options.structural_index = structural_index;
+  options.structural_index_length = 64;
+  TEST_EXPECT_SUCCESS(az_json_document_init(&document, json, nodes, 40, &options));
+  assert_int_equal(az_json_document_get_node_count(&document), 32);
+  TEST_EXPECT_SUCCESS(
+      az_json_document_get_property(&document, 0, AZ_SPAN_FROM_STR("reported"), &index));
+  assert_int_equal(index, reported);
+}
+
+static void test_az_json_document_invalid(void** state)
+{
+  (void)state;
+
+  az_json_document_node nodes[4];
+  az_json_document document = { 0 };
+
+  assert_int_equal(
+      az_json_document_init(&document, AZ_SPAN_FROM_STR("[1,2,3]"), nodes, 4, NULL),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  TEST_EXPECT_SUCCESS(az_json_document_init(&document, AZ_SPAN_FROM_STR("[1,2]"), nodes, 4, NULL));
+  assert_int_equal(
+      az_json_document_init(&document, AZ_SPAN_FROM_STR("[1,2"), nodes, 4, NULL),
+      AZ_ERROR_UNEXPECTED_END);
+  assert_int_equal(
+      az_json_document_init(&document, AZ_SPAN_FROM_STR("{\"a\":}"), nodes, 4, NULL),
+      AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(
+      az_json_document_init(&document, AZ_SPAN_FROM_STR("1 2"), nodes, 4, NULL),
+      AZ_ERROR_UNEXPECTED_CHAR);
+}
+
+static void test_az_json_name_table(void** state)
+{
+  (void)state;
+
+  az_span names[] = {
+    AZ_SPAN_LITERAL_FROM_STR("thermostat1"), AZ_SPAN_LITERAL_FROM_STR("thermostat2"),
+    AZ_SPAN_LITERAL_FROM_STR("deviceInformation"), AZ_SPAN_LITERAL_FROM_STR(""),
+    AZ_SPAN_LITERAL_FROM_STR("a\"b"), AZ_SPAN_LITERAL_FROM_STR("thermostat1"),
+    AZ_SPAN_LITERAL_FROM_STR("t"), AZ_SPAN_LITERAL_FROM_STR("thermostat9"),
+    AZ_SPAN_LITERAL_FROM_STR("/"),
+  };
+  int32_t const number_of_names = sizeof(names) / sizeof(names[0]);
+
+  az_span json = AZ_SPAN_FROM_STR("{\"thermostat1\":1,\"thermostat2\":2,\"deviceInformation\":3,"
+                                  "\"\":4,\"a\\\"b\":5,\"t\":6,\"thermostat9\":7,\"\\/\":8,"
+                                  "\"thermostat3\":9,\"thermostat\":10,\"unknown\":11}");
+  int32_t const expected_indices[] = { 0, 1, 2, 3, 4, 6, 7, 8, -1, -1, -1 };
+
+  // Use a small and a larger table, to make sure collisions are handled.
+  uint16_t buckets[64] = { 0 };
+  int32_t const bucket_counts[] = { 16, 64 };
+
+  for (int32_t b = 0; b < 2; b++)
+  {
+    az_json_name_table name_table = { 0 };
+    TEST_EXPECT_SUCCESS(
+        az_json_name_table_init(&name_table, names, number_of_names, buckets, bucket_counts[b]));
+
+    az_span buffers_one[256] = { 0 };
+    assert_true(az_span_size(json) <= 256);
+    _az_split_buffers_single_byte(json, buffers_one);
+
+    for (int32_t chunked = 0; chunked < 2; chunked++)
+    {
+      az_json_reader reader = { 0 };
+      if (chunked == 0)
+      {
+        TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, json, NULL));
+      }
+      else
+      {
+        TEST_EXPECT_SUCCESS(
+            az_json_reader_chunked_init(&reader, buffers_one, az_span_size(json), NULL));
+      }
+
+      TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+
+      for (int32_t i = 0; i < (int32_t)(sizeof(expected_indices) / sizeof(expected_indices[0]));
+           i++)
+      {
+        TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+        assert_int_equal(reader.token.kind, AZ_JSON_TOKEN_PROPERTY_NAME);
+
+        int32_t index = -1;
+        az_result const result = az_json_name_table_find(&name_table, &reader.token, &index);
+        if (expected_indices[i] == -1)
+        {
+          assert_int_equal(result, AZ_ERROR_ITEM_NOT_FOUND);
+        }
+        else
+        {
+          TEST_EXPECT_SUCCESS(result);
+          assert_int_equal(index, expected_indices[i]);
+        }
+
+        // Property values are numbers, which never match.
+        TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+        assert_int_equal(
+            az_json_name_table_find(&name_table, &reader.token, &index), AZ_ERROR_ITEM_NOT_FOUND);
+      }
+    }
+  }
+
+  // An empty table never matches.
+  az_json_name_table name_table = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_name_table_init(&name_table, NULL, 0, buckets, 1));
+  az_json_reader reader = { 0 };
+  TEST_EXPECT_SUCCESS(az_json_reader_init(&reader, AZ_SPAN_FROM_STR("\"\""), NULL));
+  TEST_EXPECT_SUCCESS(az_json_reader_next_token(&reader));
+  int32_t index = 0;
+  assert_int_equal(
+      az_json_name_table_find(&name_table, &reader.token, &index), AZ_ERROR_ITEM_NOT_FOUND);
+}
+
 static void _az_span_free(az_span* p)
 {
   if (p == NULL)
@@ -3226,6 +4541,63 @@ static void test_az_json_string_unescape_same_buffer(void** state)
   }
 }
 
+static void test_az_json_string_unescape_across_blocks(void** state)
+{
+  (void)state;
+
+  // Escaped characters at, and around, the 16 byte block boundaries.
+  uint8_t escaped[]
+      = "\\nbcdefghijklmn\\\"p\\tqrstuvwxyzABC\\\\\\/DEFGHIJKLMNOPQRSTUVWXYZ012345678\\r";
+  uint8_t unescaped[]
+      = "\nbcdefghijklmn\"p\tqrstuvwxyzABC\\/DEFGHIJKLMNOPQRSTUVWXYZ012345678\r";
+  az_span const expected = az_span_create(unescaped, sizeof(unescaped) - 1);
+
+  uint8_t buffer[sizeof(escaped)] = { 0 };
+  az_span const json_string = az_span_create(escaped, sizeof(escaped) - 1);
+  assert_true(az_span_is_content_equal(
+      az_json_string_unescape(json_string, AZ_SPAN_FROM_BUFFER(buffer)), expected));
+
+  // In place.
+  az_span in_place = az_span_create(buffer, az_span_size(json_string));
+  az_span_copy(in_place, json_string);
+  assert_true(az_span_is_content_equal(az_json_string_unescape(in_place, in_place), expected));
+
+  // Split across any number of segments, including in between a backslash and the character it
+  // escapes.
+  uint8_t json[sizeof(escaped) + 2] = { 0 };
+  az_span_copy_u8(
+      az_span_copy(az_span_copy_u8(AZ_SPAN_FROM_BUFFER(json), '"'), json_string), '"');
+
+  for (int32_t segment_size = 1; segment_size < (int32_t)sizeof(json); segment_size++)
+  {
+    az_span segments[sizeof(json)];
+    int32_t number_of_segments = 0;
+    for (int32_t i = 0; i < (int32_t)sizeof(json); i += segment_size)
+    {
+      int32_t const end = i + segment_size < (int32_t)sizeof(json) ? i + segment_size
+                                                                     : (int32_t)sizeof(json);
+      segments[number_of_segments++] = az_span_slice(AZ_SPAN_FROM_BUFFER(json), i, end);
+    }
+
+    az_json_reader reader = { 0 };
+    assert_int_equal(
+        az_json_reader_chunked_init(&reader, segments, number_of_segments, NULL), AZ_OK);
+    assert_int_equal(az_json_reader_next_token(&reader), AZ_OK);
+
+    char destination[sizeof(unescaped)] = { 0 };
+    int32_t length = 0;
+    assert_int_equal(
+        az_json_token_get_string(&reader.token, destination, sizeof(destination), &length), AZ_OK);
+    assert_int_equal(length, sizeof(unescaped) - 1);
+    assert_string_equal(destination, (char const*)unescaped);
+
+    // Not enough space for the null terminator.
+    assert_int_equal(
+        az_json_token_get_string(&reader.token, destination, sizeof(destination) - 1, &length),
+        AZ_ERROR_NOT_ENOUGH_SPACE);
+  }
+}
+
 int test_az_json()
 {
   const struct CMUnitTest tests[]
@@ -3233,15 +4605,21 @@ int test_az_json()
           cmocka_unit_test(test_json_reader_current_depth_array),
           cmocka_unit_test(test_json_reader_current_depth_object),
           cmocka_unit_test(test_json_writer),
+          cmocka_unit_test(test_json_writer_append_double_round_trip),
+          cmocka_unit_test(test_json_writer_append_64bit_and_number_text),
           cmocka_unit_test(test_json_writer_append_nested),
           cmocka_unit_test(test_json_writer_append_nested_invalid),
+          cmocka_unit_test(test_json_writer_append_validated_json_text),
           cmocka_unit_test(test_json_writer_chunked),
           cmocka_unit_test(test_json_writer_chunked_no_callback),
           cmocka_unit_test(test_json_writer_large_string_chunked),
+          cmocka_unit_test(test_json_writer_sink),
+          cmocka_unit_test(test_json_writer_escape_across_blocks),
           cmocka_unit_test(test_json_reader),
           cmocka_unit_test(test_json_reader_invalid),
           cmocka_unit_test(test_json_reader_incomplete),
           cmocka_unit_test(test_json_skip_children),
+          cmocka_unit_test(test_json_skip_children_fast),
           cmocka_unit_test(test_json_value),
           cmocka_unit_test(test_az_json_token_get_string_and_text_equal),
           cmocka_unit_test(test_az_json_token_get_string_and_text_equal_discontiguous),
@@ -3250,7 +4628,19 @@ int test_az_json()
           cmocka_unit_test(test_az_json_token_literal),
           cmocka_unit_test(test_az_json_token_copy),
           cmocka_unit_test(test_az_json_reader_chunked),
+          cmocka_unit_test(test_az_json_push_reader),
+          cmocka_unit_test(test_az_json_push_reader_invalid),
+          cmocka_unit_test(test_az_json_reader_long_string),
+          cmocka_unit_test(test_az_json_reader_structural_index),
+          cmocka_unit_test(test_az_json_path_set_init),
+          cmocka_unit_test(test_az_json_reader_find_paths),
+          cmocka_unit_test(test_az_json_name_table),
+          cmocka_unit_test(test_az_json_template),
+          cmocka_unit_test(test_az_json_template_invalid),
+          cmocka_unit_test(test_az_json_document),
+          cmocka_unit_test(test_az_json_document_invalid),
           cmocka_unit_test(test_az_json_string_unescape),
-          cmocka_unit_test(test_az_json_string_unescape_same_buffer) };
+          cmocka_unit_test(test_az_json_string_unescape_same_buffer),
+          cmocka_unit_test(test_az_json_string_unescape_across_blocks) };
   return cmocka_run_group_tests_name("az_core_json", tests, NULL, NULL);
 }
@@ -0,0 +1,191 @@
+// Copyright (c) Microsoft Corporation. All rights reserved.
+// SPDX-License-Identifier: MIT
+
+#include "az_test_definitions.h"
+#include <azure/core/az_sha256.h>
+
+#include <setjmp.h>
+#include <stdarg.h>
+#include <stddef.h>
+#include <stdint.h>
+#include <string.h>
+
+#include <cmocka.h>
+
+#include <azure/core/_az_cfg.h>
+
+static void _az_sha256_assert_hash(az_span data, uint8_t const expected[AZ_SHA256_HASH_SIZE])
+{
+  uint8_t hash[AZ_SHA256_HASH_SIZE] = { 0 };
+  az_sha256 sha256;
+
+  assert_int_equal(az_sha256_init(&sha256), AZ_OK);
+  assert_int_equal(az_sha256_update(&sha256, data), AZ_OK);
+  assert_int_equal(az_sha256_final(&sha256, AZ_SPAN_FROM_BUFFER(hash)), AZ_OK);
+  assert_memory_equal(hash, expected, AZ_SHA256_HASH_SIZE);
+
+  // The result doesn't depend on how the data is split into chunks.
+  for (int32_t chunk_size = 1; chunk_size <= 65; chunk_size += 7)
+  {
+    memset(hash, 0, sizeof(hash));
+    assert_int_equal(az_sha256_init(&sha256), AZ_OK);
+    for (int32_t offset = 0; offset < az_span_size(data); offset += chunk_size)
+    {
+      int32_t const remaining = az_span_size(data) - offset;
+      int32_t const size = remaining < chunk_size ? remaining : chunk_size;
+      assert_int_equal(
+          az_sha256_update(&sha256, az_span_slice(data, offset, offset + size)), AZ_OK);
+    }
+    assert_int_equal(az_sha256_final(&sha256, AZ_SPAN_FROM_BUFFER(hash)), AZ_OK);
+    assert_memory_equal(hash, expected, AZ_SHA256_HASH_SIZE);
+  }
+}
+
+static void az_sha256_test(void** state)
+{
+  (void)state;
+
+  // Test vectors from FIPS 180-4 examples.
+  uint8_t const empty_hash[] = {
+    0xE3, 0xB0, 0xC4, 0x42, 0x98, 0xFC, 0x1C, 0x14, 0x9A, 0xFB, 0xF4, 0xC8, 0x99, 0x6F, 0xB9, 0x24,
+    0x27, 0xAE, 0x41, 0xE4, 0x64, 0x9B, 0x93, 0x4C, 0xA4, 0x95, 0x99, 0x1B, 0x78, 0x52, 0xB8, 0x55,
+  };
+  _az_sha256_assert_hash(AZ_SPAN_EMPTY, empty_hash);
+
+  uint8_t const abc_hash[] = {
+    0xBA, 0x78, 0x16, 0xBF, 0x8F, 0x01, 0xCF, 0xEA, 0x41, 0x41, 0x40, 0xDE, 0x5D, 0xAE, 0x22, 0x23,
+    0xB0, 0x03, 0x61, 0xA3, 0x96, 0x17, 0x7A, 0x9C, 0xB4, 0x10, 0xFF, 0x61, 0xF2, 0x00, 0x15, 0xAD,
+  };
+  _az_sha256_assert_hash(AZ_SPAN_FROM_STR("abc"), abc_hash);
+
+  // 56 bytes, so the length doesn't fit in the last block and padding takes a block of its own.
+  uint8_t const two_block_hash[] = {
+    0x24, 0x8D, 0x6A, 0x61, 0xD2, 0x06, 0x38, 0xB8, 0xE5, 0xC0, 0x26, 0x93, 0x0C, 0x3E, 0x60, 0x39,
+    0xA3, 0x3C, 0xE4, 0x59, 0x64, 0xFF, 0x21, 0x67, 0xF6, 0xEC, 0xED, 0xD4, 0x19, 0xDB, 0x06, 0xC1,
+  };
+  _az_sha256_assert_hash(
+      AZ_SPAN_FROM_STR("abcdbcdecdefdefgefghfghighijhijkijkljklmklmnlmnomnopnopq"), two_block_hash);
+
+  uint8_t data[768];
+  for (int32_t i = 0; i < (int32_t)sizeof(data); i++)
+  {
+    data[i] = (uint8_t)i;
+  }
+  uint8_t const data_hash[] = {
+    0xF3, 0xA2, 0x5A, 0xA9, 0x3A, 0xA2, 0xFB, 0xBA, 0x28, 0xD7, 0x92, 0x60, 0x53, 0x5B, 0xBD, 0x6A,
+    0x5E, 0xB0, 0xFC, 0x1C, 0x24, 0xA8, 0xB0, 0xF0, 0x4E, 0x12, 0xB4, 0x84, 0xC1, 0xDF, 0xE3, 0x63,
+  };
+  _az_sha256_assert_hash(AZ_SPAN_FROM_BUFFER(data), data_hash);
+}
+
+static void az_sha256_million_a_test(void** state)
+{
+  (void)state;
+
+  uint8_t const expected[] = {
+    0xCD, 0xC7, 0x6E, 0x5C, 0x99, 0x14, 0xFB, 0x92, 0x81, 0xA1, 0xC7, 0xE2, 0x84, 0xD7, 0x3E, 0x67,
+    0xF1, 0x80, 0x9A, 0x48, 0xA4, 0x97, 0x20, 0x0E, 0x04, 0x6D, 0x39, 0xCC, 0xC7, 0x11, 0x2C, 0xD0,
+  };
+
+  uint8_t chunk[1000];
+  memset(chunk, 'a', sizeof(chunk));
+
+  az_sha256 sha256;
+  assert_int_equal(az_sha256_init(&sha256), AZ_OK);
+  for (int32_t i = 0; i < 1000; i++)
+  {
+    assert_int_equal(az_sha256_update(&sha256, AZ_SPAN_FROM_BUFFER(chunk)), AZ_OK);
+  }
+
+  uint8_t hash[AZ_SHA256_HASH_SIZE] = { 0 };
+  assert_int_equal(az_sha256_final(&sha256, AZ_SPAN_FROM_BUFFER(hash)), AZ_OK);
+  assert_memory_equal(hash, expected, AZ_SHA256_HASH_SIZE);
+}
+
+static void az_sha256_destination_small_test(void** state)
+{
+  (void)state;
+
+  uint8_t hash[AZ_SHA256_HASH_SIZE - 1];
+  az_sha256 sha256;
+  assert_int_equal(az_sha256_init(&sha256), AZ_OK);
+  assert_int_equal(
+      az_sha256_final(&sha256, AZ_SPAN_FROM_BUFFER(hash)), AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
+static void az_hmac_sha256_test(void** state)
+{
+  (void)state;
+
+  uint8_t hmac[AZ_SHA256_HASH_SIZE] = { 0 };
+  az_hmac_sha256_key key;
+
+  // Test vectors from RFC 4231.
+  uint8_t key1[] = { 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B,
+                     0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B, 0x0B };
+  uint8_t const expected1[] = {
+    0xB0, 0x34, 0x4C, 0x61, 0xD8, 0xDB, 0x38, 0x53, 0x5C, 0xA8, 0xAF, 0xCE, 0xAF, 0x0B, 0xF1, 0x2B,
+    0x88, 0x1D, 0xC2, 0x00, 0xC9, 0x83, 0x3D, 0xA7, 0x26, 0xE9, 0x37, 0x6C, 0x2E, 0x32, 0xCF, 0xF7,
+  };
+  assert_int_equal(az_hmac_sha256_key_init(&key, AZ_SPAN_FROM_BUFFER(key1)), AZ_OK);
+  assert_int_equal(
+      az_hmac_sha256_compute(&key, AZ_SPAN_FROM_STR("Hi There"), AZ_SPAN_FROM_BUFFER(hmac)),
+      AZ_OK);
+  assert_memory_equal(hmac, expected1, AZ_SHA256_HASH_SIZE);
+
+  uint8_t const expected2[] = {
+    0x5B, 0xDC, 0xC1, 0x46, 0xBF, 0x60, 0x75, 0x4E, 0x6A, 0x04, 0x24, 0x26, 0x08, 0x95, 0x75, 0xC7,
+    0x5A, 0x00, 0x3F, 0x08, 0x9D, 0x27, 0x39, 0x83, 0x9D, 0xEC, 0x58, 0xB9, 0x64, 0xEC, 0x38, 0x43,
+  };
+  assert_int_equal(az_hmac_sha256_key_init(&key, AZ_SPAN_FROM_STR("Jefe")), AZ_OK);
+  assert_int_equal(
+      az_hmac_sha256_compute(
+          &key, AZ_SPAN_FROM_STR("what do ya want for nothing?"), AZ_SPAN_FROM_BUFFER(hmac)),
+      AZ_OK);
+  assert_memory_equal(hmac, expected2, AZ_SHA256_HASH_SIZE);
+
+  // Keys longer than a block are hashed first, and the same key can sign several messages.
+  uint8_t long_key[131];
+  memset(long_key, 0xAA, sizeof(long_key));
+  assert_int_equal(az_hmac_sha256_key_init(&key, AZ_SPAN_FROM_BUFFER(long_key)), AZ_OK);
+
+  uint8_t const expected6[] = {
+    0x60, 0xE4, 0x31, 0x59, 0x1E, 0xE0, 0xB6, 0x7F, 0x0D, 0x8A, 0x26, 0xAA, 0xCB, 0xF5, 0xB7, 0x7F,
+    0x8E, 0x0B, 0xC6, 0x21, 0x37, 0x28, 0xC5, 0x14, 0x05, 0x46, 0x04, 0x0F, 0x0E, 0xE3, 0x7F, 0x54,
+  };
+  assert_int_equal(
+      az_hmac_sha256_compute(
+          &key,
+          AZ_SPAN_FROM_STR("Test Using Larger Than Block-Size Key - Hash Key First"),
+          AZ_SPAN_FROM_BUFFER(hmac)),
+      AZ_OK);
+  assert_memory_equal(hmac, expected6, AZ_SHA256_HASH_SIZE);
+
+  uint8_t const expected7[] = {
+    0x9B, 0x09, 0xFF, 0xA7, 0x1B, 0x94, 0x2F, 0xCB, 0x27, 0x63, 0x5F, 0xBC, 0xD5, 0xB0, 0xE9, 0x44,
+    0xBF, 0xDC, 0x63, 0x64, 0x4F, 0x07, 0x13, 0x93, 0x8A, 0x7F, 0x51, 0x53, 0x5C, 0x3A, 0x35, 0xE2,
+  };
+  az_span const long_message
+      = AZ_SPAN_FROM_STR("This is a test using a larger than block-size key and a larger than "
+                         "block-size data. The key needs to be hashed before being used by the "
+                         "HMAC algorithm.");
+  assert_int_equal(
+      az_hmac_sha256_compute(&key, long_message, AZ_SPAN_FROM_BUFFER(hmac)), AZ_OK);
+  assert_memory_equal(hmac, expected7, AZ_SHA256_HASH_SIZE);
+
+  assert_int_equal(
+      az_hmac_sha256_compute(
+          &key, AZ_SPAN_FROM_STR("Hi There"), az_span_slice(AZ_SPAN_FROM_BUFFER(hmac), 0, 31)),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
+int test_az_sha256()
+{
+  const struct CMUnitTest tests[] = {
+    cmocka_unit_test(az_sha256_test),
+    cmocka_unit_test(az_sha256_million_a_test),
+    cmocka_unit_test(az_sha256_destination_small_test),
+    cmocka_unit_test(az_hmac_sha256_test),
+  };
+  return cmocka_run_group_tests_name("az_core_sha256", tests, NULL, NULL);
+}
@@ -8,12 +8,14 @@
 #include <azure/core/internal/az_span_internal.h>
 
 #include <stdarg.h>
+#include <stdbool.h>
 #include <stddef.h>
 
 #include <limits.h>
 #include <math.h>
 #include <setjmp.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <cmocka.h>
 
@@ -92,6 +94,55 @@ static void az_span_to_lower_test(void** state)
   assert_false(az_span_is_content_equal_ignoring_case(a, d));
 }
 
+static void az_span_is_content_equal_ignoring_case_long_test(void** state)
+{
+  (void)state;
+
+  // Spans longer than a 16 byte block, which differ at every position in turn, so that the
+  // vectorized comparison is covered when SIMD is enabled.
+  static char const text[] = "Content-Type: Application/JSON; Charset=UTF-8 Zz9 @[`{ ~\x7F";
+
+  for (int32_t position = 0; position < (int32_t)sizeof(text) - 1; position++)
+  {
+    uint8_t buffer1[sizeof(text) - 1];
+    uint8_t buffer2[sizeof(text) - 1];
+    memcpy(buffer1, text, sizeof(buffer1));
+    memcpy(buffer2, text, sizeof(buffer2));
+    az_span const span1 = AZ_SPAN_FROM_BUFFER(buffer1);
+    az_span const span2 = AZ_SPAN_FROM_BUFFER(buffer2);
+
+    uint8_t const c = buffer1[position];
+    bool const is_letter = (c >= 'A' && c <= 'Z') || (c >= 'a' && c <= 'z');
+
+    // Flipping the case bit only matches for letters.
+    buffer2[position] = (uint8_t)(c ^ 0x20);
+    assert_true(az_span_is_content_equal_ignoring_case(span1, span2) == is_letter);
+    assert_true(az_span_is_content_equal_ignoring_case(span2, span1) == is_letter);
+
+    buffer2[position] = (uint8_t)(c ^ 0x01);
+    assert_false(az_span_is_content_equal_ignoring_case(span1, span2));
+
+    // Bytes outside of ASCII are compared as is.
+    buffer1[position] = 0xC1;
+    buffer2[position] = 0xE1;
+    assert_false(az_span_is_content_equal_ignoring_case(span1, span2));
+    buffer2[position] = 0xC1;
+    assert_true(az_span_is_content_equal_ignoring_case(span1, span2));
+  }
+}
+
+static void test_az_span_secure_zero(void** state)
+{
+  (void)state;
+
+  uint8_t buffer[] = { 1, 2, 3, 4, 5 };
+  _az_span_secure_zero(az_span_slice(AZ_SPAN_FROM_BUFFER(buffer), 1, 4));
+  uint8_t const expected[] = { 1, 0, 0, 0, 5 };
+  assert_memory_equal(buffer, expected, sizeof(expected));
+
+  _az_span_secure_zero(AZ_SPAN_EMPTY);
+}
+
 static void test_az_span_is_content_equal(void** state)
 {
   (void)state;
@@ -638,6 +689,45 @@ static void az_span_atod_test(void** state)
   assert_true(value == 0);
 }
 
+static void az_span_atod_fast_path_boundaries(void** state)
+{
+  (void)state;
+  double value = 0;
+
+  // Numbers just within, and just outside, of what can be parsed without sscanf, must give the same
+  // correctly rounded results.
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("9007199254740992"), &value), AZ_OK);
+  assert_true(value == 9007199254740992.0);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("9007199254740993"), &value), AZ_OK);
+  assert_true(value == 9007199254740992.0);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1234567890123456789"), &value), AZ_OK);
+  assert_true(value == 1234567890123456789.0);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("12345678901234567890"), &value), AZ_OK);
+  assert_true(value == 12345678901234567890.0);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e22"), &value), AZ_OK);
+  assert_true(value == 1e22);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e23"), &value), AZ_OK);
+  assert_true(value == 1e23);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e-22"), &value), AZ_OK);
+  assert_true(value == 1e-22);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1e-23"), &value), AZ_OK);
+  assert_true(value == 1e-23);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0.000000000000000000001"), &value), AZ_OK);
+  assert_true(value == 1e-21);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0.30000000000000004"), &value), AZ_OK);
+  assert_true(value == 0.30000000000000004);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("0e400"), &value), AZ_OK);
+  assert_true(value == 0);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("-0.0"), &value), AZ_OK);
+  assert_true(value == 0 && signbit(value));
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1E+2"), &value), AZ_OK);
+  assert_true(value == 100);
+
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("1.2.3"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("-"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+  assert_int_equal(az_span_atod(AZ_SPAN_FROM_STR("12a"), &value), AZ_ERROR_UNEXPECTED_CHAR);
+}
+
 #ifdef __GNUC__
 #pragma GCC diagnostic pop
 #endif // __GNUC__
@@ -922,6 +1012,73 @@ static void az_span_find_capacity_checks_success(void** state)
   assert_int_equal(az_span_find(az_span_create(buffer + 2, 2), az_span_create(buffer, 2)), 0);
 }
 
+static int32_t _naive_find(az_span source, az_span target)
+{
+  for (int32_t i = 0; i + az_span_size(target) <= az_span_size(source); i++)
+  {
+    if (az_span_is_content_equal(az_span_slice(source, i, i + az_span_size(target)), target))
+    {
+      return i;
+    }
+  }
+
+  return -1;
+}
+
+static void az_span_find_pathological_success(void** state)
+{
+  (void)state;
+
+  uint8_t source[1000];
+  uint8_t target[300];
+
+  // Long runs of the same byte make every position a candidate, so that the search ends up using
+  // the Two-Way algorithm, with both periodic and non-periodic targets.
+  memset(source, 'a', sizeof(source));
+  memset(target, 'a', sizeof(target));
+  target[150] = 'b';
+  assert_int_equal(az_span_find(AZ_SPAN_FROM_BUFFER(source), AZ_SPAN_FROM_BUFFER(target)), -1);
+  source[300] = 'b';
+  assert_int_equal(az_span_find(AZ_SPAN_FROM_BUFFER(source), AZ_SPAN_FROM_BUFFER(target)), 150);
+  target[150] = 'a';
+  assert_int_equal(az_span_find(AZ_SPAN_FROM_BUFFER(source), AZ_SPAN_FROM_BUFFER(target)), 0);
+  assert_int_equal(
+      az_span_find(az_span_create(source + 200, 250), az_span_create(target, 250)), -1);
+  assert_int_equal(
+      az_span_find(az_span_create(source + 250, 750), az_span_create(target, 250)), 51);
+
+  // Periodic sources and targets, at every offset and length, compared to a naive search.
+  for (int32_t i = 0; i < (int32_t)sizeof(source); i++)
+  {
+    source[i] = (uint8_t)("abaabaab"[i % 8] + (i % 97 == 96 ? 1 : 0));
+  }
+
+  az_span const periodic = AZ_SPAN_FROM_BUFFER(source);
+  for (int32_t size = 1; size < 40; size++)
+  {
+    for (int32_t offset = 0; offset < 120; offset += 7)
+    {
+      az_span const needle = az_span_slice(periodic, offset, offset + size);
+      assert_int_equal(az_span_find(periodic, needle), _naive_find(periodic, needle));
+      assert_int_equal(
+          az_span_find(az_span_slice_to_end(periodic, 500), needle),
+          _naive_find(az_span_slice_to_end(periodic, 500), needle));
+    }
+
+    az_span const missing = az_span_slice(periodic, 96 - size / 2, 96 - size / 2 + size);
+    assert_int_equal(
+        az_span_find(az_span_slice(periodic, 100, 190), missing),
+        _naive_find(az_span_slice(periodic, 100, 190), missing));
+  }
+
+  az_span const topic = AZ_SPAN_FROM_STR("$iothub/twin/res/204/?$rid=1234567890&$version=16");
+  assert_int_equal(az_span_find(topic, AZ_SPAN_FROM_STR("$version=")), 38);
+  assert_int_equal(az_span_find(topic, AZ_SPAN_FROM_STR("$rid=")), 22);
+  assert_int_equal(az_span_find(topic, AZ_SPAN_FROM_STR("&")), 37);
+  assert_int_equal(az_span_find(topic, AZ_SPAN_FROM_STR("16")), 47);
+  assert_int_equal(az_span_find(topic, AZ_SPAN_FROM_STR("17")), -1);
+}
+
 static void az_span_find_overlapping_checks_success(void** state)
 {
   (void)state;
@@ -1187,6 +1344,52 @@ static void az_span_u32toa_overflow_fails(void** state)
   assert_true(az_span_u32toa(buffer, v, &out_span) == AZ_ERROR_NOT_ENOUGH_SPACE);
 }
 
+static void az_span_u64toa_digit_count_boundaries(void** state)
+{
+  (void)state;
+  uint8_t raw_buffer[20];
+  az_span out_span;
+
+  // Check the numbers on either side of every change in the number of digits, written into a
+  // buffer which is exactly large enough, and one which is one byte too small.
+  uint64_t power_of_10 = 1;
+  for (int32_t digit_count = 1; digit_count <= 20; digit_count++)
+  {
+    uint64_t const numbers[]
+        = { power_of_10, digit_count < 20 ? power_of_10 * 10 - 1 : UINT64_MAX };
+    for (size_t i = 0; i < sizeof(numbers) / sizeof(numbers[0]); i++)
+    {
+      assert_int_equal(_az_span_u64toa_size(numbers[i]), digit_count);
+
+      az_span const buffer = az_span_create(raw_buffer, digit_count);
+      assert_int_equal(az_span_u64toa(buffer, numbers[i], &out_span), AZ_OK);
+      assert_int_equal(az_span_size(out_span), 0);
+
+      uint64_t round_trip = 0;
+      assert_int_equal(az_span_atou64(buffer, &round_trip), AZ_OK);
+      assert_true(round_trip == numbers[i]);
+
+      assert_int_equal(
+          az_span_u64toa(az_span_slice(buffer, 1, digit_count), numbers[i], &out_span),
+          AZ_ERROR_NOT_ENOUGH_SPACE);
+    }
+
+    power_of_10 *= 10;
+  }
+
+  assert_int_equal(_az_span_u64toa_size(0), 1);
+  assert_int_equal(az_span_u64toa(AZ_SPAN_FROM_BUFFER(raw_buffer), 0, &out_span), AZ_OK);
+  assert_int_equal(raw_buffer[0], '0');
+
+  assert_int_equal(az_span_i64toa(AZ_SPAN_FROM_BUFFER(raw_buffer), INT64_MIN, &out_span), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      AZ_SPAN_FROM_BUFFER(raw_buffer), AZ_SPAN_FROM_STR("-9223372036854775808")));
+
+  assert_int_equal(az_span_i32toa(AZ_SPAN_FROM_BUFFER(raw_buffer), INT32_MIN, &out_span), AZ_OK);
+  assert_true(az_span_is_content_equal(
+      az_span_create(raw_buffer, 11), AZ_SPAN_FROM_STR("-2147483648")));
+}
+
 #define AZ_SPAN_DTOA_SUCCEEDS_HELPER(v, fractional_digits, expected)                         \
   do                                                                                         \
   {                                                                                          \
@@ -1493,6 +1696,91 @@ static void az_span_dtoa_too_large(void** state)
   assert_int_equal(az_span_dtoa(buff, 1.7e308, 15, &o), AZ_ERROR_NOT_SUPPORTED);
 }
 
+#define AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(v, expected)                            \
+  do                                                                                    \
+  {                                                                                     \
+    az_span buffer = AZ_SPAN_FROM_BUFFER(raw_buffer);                                   \
+    az_span out_span = AZ_SPAN_EMPTY;                                                   \
+    assert_int_equal(az_span_dtoa_round_trip(buffer, v, &out_span), AZ_OK);             \
+    az_span output = az_span_slice(buffer, 0, _az_span_diff(out_span, buffer));         \
+    assert_int_equal(az_span_size(output), az_span_size(expected));                     \
+    assert_memory_equal(                                                                \
+        az_span_ptr(output), az_span_ptr(expected), (size_t)az_span_size(expected));    \
+    double const expected_value = v;                                                    \
+    double round_trip = 0;                                                              \
+    assert_int_equal(az_span_atod(output, &round_trip), AZ_OK);                         \
+    assert_memory_equal(&round_trip, &expected_value, sizeof(double));                  \
+  } while (0)
+
+static void az_span_dtoa_round_trip_succeeds(void** state)
+{
+  (void)state;
+
+  uint8_t raw_buffer[25] = { 0 };
+
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(0, AZ_SPAN_FROM_STR("0"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(-0.0, AZ_SPAN_FROM_STR("-0"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1, AZ_SPAN_FROM_STR("1"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(-1, AZ_SPAN_FROM_STR("-1"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(12345, AZ_SPAN_FROM_STR("12345"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1.e3, AZ_SPAN_FROM_STR("1000"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(0.1, AZ_SPAN_FROM_STR("0.1"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(0.1 + 0.2, AZ_SPAN_FROM_STR("0.30000000000000004"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(123.123, AZ_SPAN_FROM_STR("123.123"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(-9876.54321, AZ_SPAN_FROM_STR("-9876.54321"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(987654.0000321, AZ_SPAN_FROM_STR("987654.0000321"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(0.0012, AZ_SPAN_FROM_STR("0.0012"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1e-6, AZ_SPAN_FROM_STR("0.000001"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(
+      -1.2345678901234567e-6, AZ_SPAN_FROM_STR("-0.0000012345678901234567"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1e-7, AZ_SPAN_FROM_STR("1e-7"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1.5e-7, AZ_SPAN_FROM_STR("1.5e-7"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(9007199254740991, AZ_SPAN_FROM_STR("9007199254740991"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(9007199254740992, AZ_SPAN_FROM_STR("9007199254740992"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1e20, AZ_SPAN_FROM_STR("100000000000000000000"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(
+      -123456789012345678901.0, AZ_SPAN_FROM_STR("-123456789012345680000"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1e21, AZ_SPAN_FROM_STR("1e+21"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(
+      1.7976931348623157e308, AZ_SPAN_FROM_STR("1.7976931348623157e+308"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(
+      -2.2250738585072014e-308, AZ_SPAN_FROM_STR("-2.2250738585072014e-308"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(5e-324, AZ_SPAN_FROM_STR("5e-324"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1e100, AZ_SPAN_FROM_STR("1e+100"));
+  AZ_SPAN_DTOA_ROUND_TRIP_SUCCEEDS_HELPER(1.25e-10, AZ_SPAN_FROM_STR("1.25e-10"));
+}
+
+static void az_span_dtoa_round_trip_overflow_fails(void** state)
+{
+  (void)state;
+
+  uint8_t raw_buffer[25];
+  az_span buff = AZ_SPAN_FROM_BUFFER(raw_buffer);
+  az_span o;
+
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 0), 0, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 1), -1, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 6), 123.123, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 7), 1e-6, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 20), 1e20, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 5), 1.5e-7, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 5), 1e100, &o), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(
+      az_span_dtoa_round_trip(az_span_slice(buff, 0, 24), -1.2345678901234567e-6, &o),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // On failure, out_span is left as the whole destination.
+  assert_true(az_span_ptr(o) == az_span_ptr(buff));
+  assert_int_equal(az_span_size(o), 24);
+}
+
 static void az_span_copy_empty(void** state)
 {
   (void)state;
@@ -1756,6 +2044,8 @@ int test_az_span()
     cmocka_unit_test(test_az_span_getters),
     cmocka_unit_test(az_single_char_ascii_lower_test),
     cmocka_unit_test(az_span_to_lower_test),
+    cmocka_unit_test(az_span_is_content_equal_ignoring_case_long_test),
+    cmocka_unit_test(test_az_span_secure_zero),
     cmocka_unit_test(az_span_to_str_test),
     cmocka_unit_test(test_az_span_is_content_equal),
     cmocka_unit_test(az_span_find_beginning_success),
@@ -1770,6 +2060,7 @@ int test_az_span()
     cmocka_unit_test(az_span_find_overlapping_target_success),
     cmocka_unit_test(az_span_find_embedded_NULLs_success),
     cmocka_unit_test(az_span_find_capacity_checks_success),
+    cmocka_unit_test(az_span_find_pathological_success),
     cmocka_unit_test(az_span_find_overlapping_checks_success),
     cmocka_unit_test(az_span_atox_return_errors),
     cmocka_unit_test(az_span_atou32_test),
@@ -1795,9 +2086,13 @@ int test_az_span()
     cmocka_unit_test(az_span_u32toa_zero_succeeds),
     cmocka_unit_test(az_span_u32toa_max_uint_succeeds),
     cmocka_unit_test(az_span_u32toa_overflow_fails),
+    cmocka_unit_test(az_span_u64toa_digit_count_boundaries),
     cmocka_unit_test(az_span_dtoa_succeeds),
     cmocka_unit_test(az_span_dtoa_overflow_fails),
     cmocka_unit_test(az_span_dtoa_too_large),
+    cmocka_unit_test(az_span_atod_fast_path_boundaries),
+    cmocka_unit_test(az_span_dtoa_round_trip_succeeds),
+    cmocka_unit_test(az_span_dtoa_round_trip_overflow_fails),
     cmocka_unit_test(az_span_copy_empty),
     cmocka_unit_test(test_az_span_is_valid),
     cmocka_unit_test(test_az_span_overlap),
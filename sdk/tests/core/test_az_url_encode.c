@@ -12,6 +12,7 @@
 #include <limits.h>
 #include <setjmp.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <cmocka.h>
 
@@ -475,6 +476,80 @@ static void test_url_encode_full(void** state)
                        "****")));
 }
 
+static void test_url_encode_long(void** state)
+{
+  (void)state;
+
+  // Bytes around the bounds of the unreserved ranges, at every position of a string spanning
+  // several 16 byte blocks, so that the vectorized scan is covered when SIMD is enabled.
+  uint8_t const reserved[] = { '/', ' ', '@', '[', '`', '{', '}', 0x7F, 0x80, 0xC1, 0xDA, 0xFF };
+  uint8_t const unreserved[] = { 'A', 'Z', 'a', 'z', '0', '9', '-', '.', '_', '~' };
+
+  for (size_t r = 0; r < sizeof(reserved); r++)
+  {
+    for (int32_t position = 0; position < 48; position++)
+    {
+      uint8_t source[48];
+      for (int32_t i = 0; i < (int32_t)sizeof(source); i++)
+      {
+        source[i] = unreserved[(size_t)i % sizeof(unreserved)];
+      }
+      source[position] = reserved[r];
+
+      uint8_t expected[50];
+      memcpy(expected, source, (size_t)position);
+      expected[position] = '%';
+      expected[position + 1] = (uint8_t)"0123456789ABCDEF"[reserved[r] >> 4];
+      expected[position + 2] = (uint8_t)"0123456789ABCDEF"[reserved[r] & 0xF];
+      memcpy(expected + position + 3, source + position + 1, sizeof(source) - (size_t)position - 1);
+
+      uint8_t buffer[64];
+      int32_t url_length = 0;
+      assert_true(az_result_succeeded(_az_span_url_encode(
+          AZ_SPAN_FROM_BUFFER(buffer), AZ_SPAN_FROM_BUFFER(source), &url_length)));
+      assert_int_equal(url_length, sizeof(expected));
+      assert_memory_equal(buffer, expected, sizeof(expected));
+
+      assert_int_equal(
+          _az_span_url_encode_calc_length(AZ_SPAN_FROM_BUFFER(source)), sizeof(expected));
+    }
+  }
+}
+
+static void test_url_encode_and_get_length(void** state)
+{
+  (void)state;
+
+  az_span const source = AZ_SPAN_FROM_STR("https://vault.azure.net/keys?api-version=7.0");
+  az_span const expected
+      = AZ_SPAN_FROM_STR("https%3A%2F%2Fvault.azure.net%2Fkeys%3Fapi-version%3D7.0");
+
+  uint8_t buf[64] = { 0 };
+  int32_t url_length = 0;
+  assert_int_equal(
+      _az_span_url_encode_and_get_length(AZ_SPAN_FROM_BUFFER(buf), source, &url_length), AZ_OK);
+  assert_int_equal(url_length, az_span_size(expected));
+  az_span const encoded = az_span_slice(AZ_SPAN_FROM_BUFFER(buf), 0, url_length);
+  assert_true(az_span_is_content_equal(encoded, expected));
+
+  // When the destination is too small, the full encoded length is still reported, whether the
+  // destination ends within a run of unreserved bytes, within an encoded byte, or is empty.
+  for (int32_t size = 0; size < az_span_size(expected); size++)
+  {
+    url_length = 0;
+    assert_int_equal(
+        _az_span_url_encode_and_get_length(
+            az_span_slice(AZ_SPAN_FROM_BUFFER(buf), 0, size), source, &url_length),
+        AZ_ERROR_NOT_ENOUGH_SPACE);
+    assert_int_equal(url_length, az_span_size(expected));
+  }
+
+  url_length = 0xFF;
+  assert_int_equal(
+      _az_span_url_encode_and_get_length(AZ_SPAN_EMPTY, AZ_SPAN_EMPTY, &url_length), AZ_OK);
+  assert_int_equal(url_length, 0);
+}
+
 int test_az_url_encode()
 {
   struct CMUnitTest const tests[] = {
@@ -482,6 +557,8 @@ int test_az_url_encode()
     cmocka_unit_test(test_url_encode_preconditions),
     cmocka_unit_test(test_url_encode_usage),
     cmocka_unit_test(test_url_encode_full),
+    cmocka_unit_test(test_url_encode_long),
+    cmocka_unit_test(test_url_encode_and_get_length),
   };
 
   return cmocka_run_group_tests_name("az_core_encode", tests, NULL, NULL);
@@ -35,6 +35,9 @@
 #define TEST_KEY_VALUE_SAME "key_one=key&key=value_two"
 #define TEST_KEY_VALUE_THREE "key_one=value_one&key_two=value_two&key_three=value_three"
 
+// SAS token manager
+#define TEST_SAS_TOKEN_DEVICE_KEY "AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8="
+
 static const az_span test_key = AZ_SPAN_LITERAL_FROM_STR(TEST_KEY);
 static const az_span test_key_one = AZ_SPAN_LITERAL_FROM_STR(TEST_KEY_ONE);
 static const az_span test_key_two = AZ_SPAN_LITERAL_FROM_STR(TEST_KEY_TWO);
@@ -46,6 +49,9 @@ static const az_span test_value_three = AZ_SPAN_LITERAL_FROM_STR(TEST_VALUE_THRE
 static const char test_correct_one_key_value[] = "key_one=value_one";
 static const char test_correct_two_key_value[] = "key_one=value_one&key_two=value_two";
 
+static const az_span test_sas_token_device_key
+    = AZ_SPAN_LITERAL_FROM_STR(TEST_SAS_TOKEN_DEVICE_KEY);
+
 #ifndef AZ_NO_PRECONDITION_CHECKING
 ENABLE_PRECONDITION_CHECK_TESTS()
 
@@ -207,6 +213,34 @@ static void test_az_iot_message_properties_next_written_less_than_size_succeed(v
       az_iot_message_properties_next(&props, &name, &value), AZ_ERROR_IOT_END_OF_PROPERTIES);
 }
 
+static void test_az_iot_sas_token_manager_init_NULL_manager_fails()
+{
+  uint8_t password[TEST_SPAN_BUFFER_SIZE];
+
+  ASSERT_PRECONDITION_CHECKED(az_iot_sas_token_manager_init(
+      NULL, test_sas_token_device_key, AZ_SPAN_FROM_BUFFER(password), NULL));
+}
+
+static void test_az_iot_sas_token_manager_init_EMPTY_key_fails()
+{
+  az_iot_sas_token_manager manager;
+  uint8_t password[TEST_SPAN_BUFFER_SIZE];
+
+  ASSERT_PRECONDITION_CHECKED(
+      az_iot_sas_token_manager_init(&manager, AZ_SPAN_EMPTY, AZ_SPAN_FROM_BUFFER(password), NULL));
+}
+
+static void test_az_iot_sas_token_manager_init_margin_not_less_than_duration_fails()
+{
+  az_iot_sas_token_manager manager;
+  uint8_t password[TEST_SPAN_BUFFER_SIZE];
+  az_iot_sas_token_manager_options options = az_iot_sas_token_manager_options_default();
+  options.renewal_margin_seconds = options.token_duration_seconds;
+
+  ASSERT_PRECONDITION_CHECKED(az_iot_sas_token_manager_init(
+      &manager, test_sas_token_device_key, AZ_SPAN_FROM_BUFFER(password), &options));
+}
+
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 static void test_az_iot_u32toa_size_success()
@@ -378,6 +412,12 @@ static void test_az_span_copy_url_encode_insufficient_size_fail()
   assert_int_equal(
       _az_span_copy_url_encode(url_encoded_span, url_decoded_span, &remaining),
       AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  // The destination can also be smaller than the source.
+  assert_int_equal(
+      _az_span_copy_url_encode(
+          az_span_slice(url_encoded_span, 0, 4), url_decoded_span, &remaining),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
 }
 
 static void test_az_iot_message_properties_init_succeed(void** state)
@@ -764,6 +804,54 @@ static void test_az_iot_message_properties_next_empty_succeed(void** state)
       az_iot_message_properties_next(&props, &name, &value), AZ_ERROR_IOT_END_OF_PROPERTIES);
 }
 
+static void test_az_iot_sas_token_manager_options_default_succeed()
+{
+  az_iot_sas_token_manager_options options = az_iot_sas_token_manager_options_default();
+
+  assert_int_equal(az_span_size(options.key_name), 0);
+  assert_int_equal(options.token_duration_seconds, AZ_IOT_SAS_TOKEN_DEFAULT_DURATION_SECONDS);
+  assert_int_equal(
+      options.renewal_margin_seconds, AZ_IOT_SAS_TOKEN_DEFAULT_RENEWAL_MARGIN_SECONDS);
+  assert_null(options.hmac_sha256);
+  assert_null(options.hmac_sha256_context);
+}
+
+static void test_az_iot_sas_token_manager_sign_succeed()
+{
+  az_iot_sas_token_manager manager;
+  uint8_t password[TEST_SPAN_BUFFER_SIZE];
+  assert_int_equal(
+      az_iot_sas_token_manager_init(
+          &manager, test_sas_token_device_key, AZ_SPAN_FROM_BUFFER(password), NULL),
+      AZ_OK);
+
+  assert_true(az_iot_sas_token_manager_is_renewal_due(&manager, 1));
+  assert_int_equal(az_iot_sas_token_manager_get_expiration(&manager), 0);
+
+  uint8_t signature_buffer[_az_IOT_SAS_TOKEN_BASE64_SIGNATURE_SIZE];
+  az_span signature;
+  assert_int_equal(
+      _az_iot_sas_token_manager_sign(
+          &manager,
+          AZ_SPAN_FROM_STR("myiothub.azure-devices.net%2Fdevices%2Fmy_device\n1578941692"),
+          AZ_SPAN_FROM_BUFFER(signature_buffer),
+          &signature),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(
+      signature, AZ_SPAN_FROM_STR("6BQpP0VpyZ0mTIlMbvjlP/xyeadWxB24Mp9J8uADz8w=")));
+}
+
+static void test_az_iot_sas_token_manager_init_invalid_key_fail()
+{
+  az_iot_sas_token_manager manager;
+  uint8_t password[TEST_SPAN_BUFFER_SIZE];
+
+  assert_int_equal(
+      az_iot_sas_token_manager_init(
+          &manager, AZ_SPAN_FROM_STR("AAEC*wQF"), AZ_SPAN_FROM_BUFFER(password), NULL),
+      AZ_ERROR_UNEXPECTED_CHAR);
+}
+
 #ifdef _MSC_VER
 // warning C4113: 'void (__cdecl *)()' differs in parameter lists from 'CMUnitTestFunction'
 #pragma warning(disable : 4113)
@@ -790,6 +878,9 @@ int test_az_iot_common()
     cmocka_unit_test(test_az_iot_message_properties_next_NULL_out_name_fail),
     cmocka_unit_test(test_az_iot_message_properties_next_NULL_out_value_fail),
     cmocka_unit_test(test_az_iot_message_properties_next_written_less_than_size_succeed),
+    cmocka_unit_test(test_az_iot_sas_token_manager_init_NULL_manager_fails),
+    cmocka_unit_test(test_az_iot_sas_token_manager_init_EMPTY_key_fails),
+    cmocka_unit_test(test_az_iot_sas_token_manager_init_margin_not_less_than_duration_fails),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test(test_az_iot_u32toa_size_success),
     cmocka_unit_test(test_az_iot_u64toa_size_success),
@@ -822,6 +913,9 @@ int test_az_iot_common()
     cmocka_unit_test(test_az_iot_message_properties_next_succeed),
     cmocka_unit_test(test_az_iot_message_properties_next_twice_succeed),
     cmocka_unit_test(test_az_iot_message_properties_next_empty_succeed),
+    cmocka_unit_test(test_az_iot_sas_token_manager_options_default_succeed),
+    cmocka_unit_test(test_az_iot_sas_token_manager_sign_succeed),
+    cmocka_unit_test(test_az_iot_sas_token_manager_init_invalid_key_fail),
   };
   return cmocka_run_group_tests_name("az_iot_common", tests, NULL, NULL);
 }
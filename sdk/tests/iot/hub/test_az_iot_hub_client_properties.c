@@ -996,6 +996,316 @@ static void test_az_iot_hub_client_properties_writer_end_response_status_succeed
       "{\"targetTemperature\":{\"ac\":200,\"av\":29,\"ad\":\"success\",\"value\":50}}");
 }
 
+static int32_t test_write_reported_patch(
+    az_iot_hub_client const* client,
+    az_iot_hub_client_properties_reported_state* state,
+    char* json_buffer,
+    int32_t temperature,
+    az_span request_id)
+{
+  az_json_writer jw;
+  assert_int_equal(
+      az_json_writer_init(&jw, az_span_create((uint8_t*)json_buffer, 127), NULL), AZ_OK);
+
+  assert_int_equal(az_iot_hub_client_properties_reported_begin_patch(state, &jw), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_begin_property(
+          state, &jw, AZ_SPAN_FROM_STR("firmware")),
+      AZ_OK);
+  assert_int_equal(az_json_writer_append_string(&jw, AZ_SPAN_FROM_STR("1.0")), AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_reported_end_property(state, &jw), AZ_OK);
+
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_begin_component(
+          client, state, &jw, test_component_one),
+      AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_begin_property(
+          state, &jw, AZ_SPAN_FROM_STR("temperature")),
+      AZ_OK);
+  assert_int_equal(az_json_writer_append_int32(&jw, temperature), AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_reported_end_property(state, &jw), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_begin_property(
+          state, &jw, AZ_SPAN_FROM_STR("location")),
+      AZ_OK);
+  assert_int_equal(az_json_writer_append_begin_object(&jw), AZ_OK);
+  assert_int_equal(az_json_writer_append_property_name(&jw, AZ_SPAN_FROM_STR("lat")), AZ_OK);
+  assert_int_equal(az_json_writer_append_int32(&jw, 47), AZ_OK);
+  assert_int_equal(az_json_writer_append_end_object(&jw), AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_reported_end_property(state, &jw), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_end_component(client, state, &jw), AZ_OK);
+
+  int32_t property_count = -1;
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_end_patch(state, &jw, request_id, &property_count),
+      AZ_OK);
+
+  // Removed properties leave their text past the end of the patch.
+  json_buffer[jw.total_bytes_written] = '\0';
+  return property_count;
+}
+
+static void test_az_iot_hub_client_properties_reported_patch_succeed()
+{
+  az_iot_hub_client_options options = az_iot_hub_client_options_default();
+  options.component_names = test_components;
+  options.component_names_length = test_components_length;
+
+  az_iot_hub_client client;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, &options), AZ_OK);
+
+  az_iot_hub_client_properties_reported_entry entries[4];
+  az_iot_hub_client_properties_reported_state state;
+  assert_int_equal(az_iot_hub_client_properties_reported_state_init(&state, entries, 4), AZ_OK);
+
+  char json_buffer[128];
+  az_iot_hub_client_properties_message message = {
+    .message_type = AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_ACKNOWLEDGEMENT,
+    .status = AZ_IOT_STATUS_NO_CONTENT,
+  };
+
+  // Nothing was acknowledged yet, so every property is sent, even twice.
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 20, AZ_SPAN_FROM_STR("1")), 3);
+  assert_string_equal(
+      json_buffer,
+      "{\"firmware\":\"1.0\",\"component_one\":{\"__t\":\"c\",\"temperature\":20,"
+      "\"location\":{\"lat\":47}}}");
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 20, AZ_SPAN_FROM_STR("2")), 3);
+
+  // The second patch replaces the first one.
+  message.request_id = AZ_SPAN_FROM_STR("1");
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_confirm(&state, &message), AZ_ERROR_ITEM_NOT_FOUND);
+  message.request_id = AZ_SPAN_FROM_STR("2");
+  assert_int_equal(az_iot_hub_client_properties_reported_confirm(&state, &message), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_confirm(&state, &message), AZ_ERROR_ITEM_NOT_FOUND);
+
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 20, AZ_SPAN_FROM_STR("3")), 0);
+  assert_string_equal(json_buffer, "{}");
+
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 21, test_device_request_id), 1);
+  assert_string_equal(json_buffer, "{\"component_one\":{\"__t\":\"c\",\"temperature\":21}}");
+  assert_int_equal(
+      az_iot_hub_client_properties_parse_received_topic(
+          &client, test_property_reported_props_success_message, &message),
+      AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_reported_confirm(&state, &message), AZ_OK);
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 21, AZ_SPAN_FROM_STR("4")), 0);
+
+  // A rejected patch is sent again.
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 22, AZ_SPAN_FROM_STR("5")), 1);
+  message.message_type = AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_ERROR;
+  message.status = AZ_IOT_STATUS_BAD_REQUEST;
+  message.request_id = AZ_SPAN_FROM_STR("5");
+  assert_int_equal(az_iot_hub_client_properties_reported_confirm(&state, &message), AZ_OK);
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 22, AZ_SPAN_FROM_STR("6")), 1);
+
+  // Going back to the acknowledged value is sent too, since the patch in flight would replace it.
+  assert_int_equal(
+      test_write_reported_patch(&client, &state, json_buffer, 21, AZ_SPAN_FROM_STR("7")), 1);
+  assert_string_equal(json_buffer, "{\"component_one\":{\"__t\":\"c\",\"temperature\":21}}");
+}
+
+static void test_az_iot_hub_client_properties_reported_patch_no_entries_left_fails()
+{
+  az_iot_hub_client_properties_reported_entry entries[1];
+  az_iot_hub_client_properties_reported_state state;
+  assert_int_equal(az_iot_hub_client_properties_reported_state_init(&state, entries, 1), AZ_OK);
+
+  az_json_writer jw;
+  char json_buffer[64] = { 0 };
+  assert_int_equal(az_json_writer_init(&jw, AZ_SPAN_FROM_BUFFER(json_buffer), NULL), AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_reported_begin_patch(&state, &jw), AZ_OK);
+
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_begin_property(&state, &jw, AZ_SPAN_FROM_STR("a")),
+      AZ_OK);
+  assert_int_equal(az_json_writer_append_int32(&jw, 1), AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_reported_end_property(&state, &jw), AZ_OK);
+
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_begin_property(&state, &jw, AZ_SPAN_FROM_STR("b")),
+      AZ_OK);
+  assert_int_equal(az_json_writer_append_int32(&jw, 2), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_end_property(&state, &jw), AZ_ERROR_NOT_ENOUGH_SPACE);
+
+  int32_t property_count = -1;
+  assert_int_equal(
+      az_iot_hub_client_properties_reported_end_patch(
+          &state, &jw, test_device_request_id, &property_count),
+      AZ_OK);
+  assert_int_equal(property_count, 1);
+  assert_true(az_span_is_content_equal(
+      az_json_writer_get_bytes_used_in_destination(&jw), AZ_SPAN_FROM_STR("{\"a\":1}")));
+}
+
+static void test_az_iot_hub_client_properties_desired_state_update_succeed()
+{
+  az_iot_hub_client client;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL), AZ_OK);
+
+  uint8_t buffer[400];
+  az_iot_hub_client_properties_desired_state state;
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_init(&state, AZ_SPAN_FROM_BUFFER(buffer)), AZ_OK);
+
+  az_span const get_response = AZ_SPAN_FROM_STR(
+      "{\"desired\":{\"targetTemperature\":20,\"thermostat\":{\"__t\":\"c\",\"mode\":\"heat\","
+      "\"limits\":{\"low\":10,\"high\":30}},\"$version\":4},\"reported\":{\"mode\":\"off\"}}");
+  az_span const patch = AZ_SPAN_FROM_STR(
+      "{\"targetTemperature\":null,\"thermostat\":{\"mode\":\"cool\",\"limits\":{\"high\":null,"
+      "\"max\":35},\"fan\":{\"speed\":2,\"off\":null}},\"tags\":[\"a\", null],\"$version\":5}");
+
+  // Updates can't be applied until the document is received.
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client, &state, AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED, patch),
+      AZ_ERROR_IOT_PROPERTIES_VERSION_GAP);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 0);
+  assert_int_equal(
+      az_span_size(az_iot_hub_client_properties_desired_state_get_document(&state)), 0);
+
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client, &state, AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE, get_response),
+      AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 4);
+  assert_true(az_span_is_content_equal(
+      az_iot_hub_client_properties_desired_state_get_document(&state),
+      AZ_SPAN_FROM_STR("{\"targetTemperature\":20,\"thermostat\":{\"__t\":\"c\",\"mode\":\"heat\","
+                       "\"limits\":{\"low\":10,\"high\":30}},\"$version\":4}")));
+
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client, &state, AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED, patch),
+      AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 5);
+  az_span const merged = AZ_SPAN_FROM_STR(
+      "{\"thermostat\":{\"__t\":\"c\",\"mode\":\"cool\",\"limits\":{\"low\":10,\"max\":35},"
+      "\"fan\":{\"speed\":2}},\"$version\":5,\"tags\":[\"a\", null]}");
+  assert_true(az_span_is_content_equal(
+      az_iot_hub_client_properties_desired_state_get_document(&state), merged));
+
+  // An update which was already applied is ignored, and a missing one is detected.
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client, &state, AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED, patch),
+      AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client,
+          &state,
+          AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED,
+          AZ_SPAN_FROM_STR("{\"mode\":\"off\",\"$version\":7}")),
+      AZ_ERROR_IOT_PROPERTIES_VERSION_GAP);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 5);
+  assert_true(az_span_is_content_equal(
+      az_iot_hub_client_properties_desired_state_get_document(&state), merged));
+
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client,
+          &state,
+          AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED,
+          AZ_SPAN_FROM_STR("{ \"thermostat\" : \"off\", \"$version\" : 6 }")),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(
+      az_iot_hub_client_properties_desired_state_get_document(&state),
+      AZ_SPAN_FROM_STR("{\"thermostat\":\"off\",\"$version\":6,\"tags\":[\"a\", null]}")));
+}
+
+static void test_az_iot_hub_client_properties_desired_state_update_not_enough_space_fails()
+{
+  az_iot_hub_client client;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL), AZ_OK);
+
+  uint8_t buffer[60];
+  az_iot_hub_client_properties_desired_state state;
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_init(&state, AZ_SPAN_FROM_BUFFER(buffer)), AZ_OK);
+
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client,
+          &state,
+          AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE,
+          AZ_SPAN_FROM_STR("{\"desired\":{\"mode\":\"heat\",\"$version\":1},\"reported\":{}}")),
+      AZ_OK);
+
+  az_span const document = AZ_SPAN_FROM_STR("{\"mode\":\"heat\",\"$version\":1}");
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client,
+          &state,
+          AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED,
+          AZ_SPAN_FROM_STR("{\"description\":\"living room\",\"$version\":2}")),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 1);
+  assert_true(az_span_is_content_equal(
+      az_iot_hub_client_properties_desired_state_get_document(&state), document));
+}
+
+static void test_az_iot_hub_client_properties_desired_state_update_nesting_overflow_fails()
+{
+  az_iot_hub_client client;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL), AZ_OK);
+
+  uint8_t buffer[512];
+  az_iot_hub_client_properties_desired_state state;
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_init(&state, AZ_SPAN_FROM_BUFFER(buffer)), AZ_OK);
+
+  // 10 levels of nested objects below the desired properties are accepted, including objects
+  // within arrays, which aren't merged.
+  az_span const deepest = AZ_SPAN_FROM_STR(
+      "{\"desired\":{\"a\":{\"b\":{\"c\":{\"d\":{\"e\":"
+      "{\"f\":{\"g\":{\"h\":{\"i\":{\"j\":{}}}}}}}}}},"
+      "\"l\":[{\"m\":{\"n\":{\"o\":{\"p\":{\"q\":{\"r\":{\"s\":{\"t\":{\"u\":{\"v\":{}}}}}}}}}}}],"
+      "\"$version\":1}}");
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client, &state, AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE, deepest),
+      AZ_OK);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 1);
+
+  az_span const too_deep = AZ_SPAN_FROM_STR(
+      "{\"desired\":{\"a\":{\"b\":{\"c\":{\"d\":{\"e\":"
+      "{\"f\":{\"g\":{\"h\":{\"i\":{\"j\":{\"k\":{}}}}}}}}}}},"
+      "\"$version\":2}}");
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client, &state, AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_GET_RESPONSE, too_deep),
+      AZ_ERROR_JSON_NESTING_OVERFLOW);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 1);
+
+  az_span const too_deep_patch = AZ_SPAN_FROM_STR(
+      "{\"a\":{\"b\":{\"c\":{\"d\":{\"e\":{\"f\":{\"g\":{\"h\":{\"i\":{\"j\":{\"k\":{}}}}}}}}}}},"
+      "\"$version\":2}");
+  assert_int_equal(
+      az_iot_hub_client_properties_desired_state_update(
+          &client,
+          &state,
+          AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED,
+          too_deep_patch),
+      AZ_ERROR_JSON_NESTING_OVERFLOW);
+  assert_int_equal(az_iot_hub_client_properties_desired_state_get_version(&state), 1);
+}
+
 static void test_az_iot_hub_client_properties_writer_begin_response_status_with_component_succeed()
 {
   az_iot_hub_client_options options = az_iot_hub_client_options_default();
@@ -1307,6 +1617,69 @@ static void test_az_iot_hub_client_properties_get_next_component_property_succee
       AZ_ERROR_IOT_END_OF_PROPERTIES);
 }
 
+static void test_az_iot_hub_client_properties_get_next_component_property_with_lookup_buffer_succeed()
+{
+  az_iot_hub_client client;
+  az_iot_hub_client_options options = az_iot_hub_client_options_default();
+  options.component_names = test_components;
+  options.component_names_length = test_components_length;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, &options), AZ_OK);
+
+  uint16_t lookup_buffer[8];
+  assert_int_equal(
+      az_iot_hub_client_properties_index_component_names(&client, lookup_buffer, 8), AZ_OK);
+
+  az_json_reader jr;
+  assert_int_equal(az_json_reader_init(&jr, test_property_payload, NULL), AZ_OK);
+
+  az_iot_hub_client_properties_message_type message_type
+      = AZ_IOT_HUB_CLIENT_PROPERTIES_MESSAGE_TYPE_WRITABLE_UPDATED;
+  az_span component_name;
+
+  test_get_next_component_property(
+      &comp1_prop1_expected,
+      message_type,
+      AZ_IOT_HUB_CLIENT_PROPERTY_WRITABLE,
+      &client,
+      &jr,
+      &component_name);
+  test_get_next_component_property(
+      &comp1_prop2_expected,
+      message_type,
+      AZ_IOT_HUB_CLIENT_PROPERTY_WRITABLE,
+      &client,
+      &jr,
+      &component_name);
+  test_get_next_component_property(
+      &comp2_prop3_expected,
+      message_type,
+      AZ_IOT_HUB_CLIENT_PROPERTY_WRITABLE,
+      &client,
+      &jr,
+      &component_name);
+  test_get_next_component_property(
+      &comp2_prop4_expected,
+      message_type,
+      AZ_IOT_HUB_CLIENT_PROPERTY_WRITABLE,
+      &client,
+      &jr,
+      &component_name);
+  test_get_next_component_property(
+      &not_component_expected,
+      message_type,
+      AZ_IOT_HUB_CLIENT_PROPERTY_WRITABLE,
+      &client,
+      &jr,
+      &component_name);
+
+  // End of components (skipping version)
+  assert_int_equal(
+      az_iot_hub_client_properties_get_next_component_property(
+          &client, &jr, message_type, AZ_IOT_HUB_CLIENT_PROPERTY_WRITABLE, &component_name),
+      AZ_ERROR_IOT_END_OF_PROPERTIES);
+}
+
 static void test_az_iot_hub_client_properties_get_next_component_property_user_not_advance_fail()
 {
   az_iot_hub_client client;
@@ -1930,6 +2303,8 @@ int test_az_iot_hub_client_properties()
     cmocka_unit_test(test_az_iot_hub_client_properties_get_properties_version_long_succeed),
     cmocka_unit_test(test_az_iot_hub_client_properties_get_properties_version_out_of_order_succeed),
     cmocka_unit_test(test_az_iot_hub_client_properties_get_next_component_property_succeed),
+    cmocka_unit_test(
+        test_az_iot_hub_client_properties_get_next_component_property_with_lookup_buffer_succeed),
     cmocka_unit_test(
         test_az_iot_hub_client_properties_get_next_component_property_user_not_advance_fail),
     cmocka_unit_test(
@@ -1956,6 +2331,13 @@ int test_az_iot_hub_client_properties()
     cmocka_unit_test(
         test_az_iot_hub_client_properties_writer_begin_response_status_with_component_multiple_values_succeed),
     cmocka_unit_test(test_az_iot_hub_client_properties_writer_end_response_status_succeed),
+    cmocka_unit_test(test_az_iot_hub_client_properties_reported_patch_succeed),
+    cmocka_unit_test(test_az_iot_hub_client_properties_reported_patch_no_entries_left_fails),
+    cmocka_unit_test(test_az_iot_hub_client_properties_desired_state_update_succeed),
+    cmocka_unit_test(
+        test_az_iot_hub_client_properties_desired_state_update_not_enough_space_fails),
+    cmocka_unit_test(
+        test_az_iot_hub_client_properties_desired_state_update_nesting_overflow_fails),
   };
 
   return cmocka_run_group_tests_name("az_iot_hub_client_property", tests, NULL, NULL);
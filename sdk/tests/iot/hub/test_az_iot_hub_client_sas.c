@@ -15,6 +15,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <cmocka.h>
 
@@ -33,6 +34,8 @@ static const az_span test_device_id = AZ_SPAN_LITERAL_FROM_STR(TEST_DEVICE_ID_ST
 static const az_span test_module_id = AZ_SPAN_LITERAL_FROM_STR(TEST_MODULE_ID_STR);
 static const uint32_t test_sas_expiry_time_secs = 1578941692;
 static const az_span test_signature = AZ_SPAN_LITERAL_FROM_STR(TEST_SIG);
+static const az_span test_device_key
+    = AZ_SPAN_LITERAL_FROM_STR("AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8=");
 
 #ifndef AZ_NO_PRECONDITION_CHECKING
 ENABLE_PRECONDITION_CHECK_TESTS()
@@ -121,6 +124,17 @@ static void az_iot_hub_client_sas_get_password_empty_password_buffer_span_fails(
       &client, test_sas_expiry_time_secs, test_signature, key_name, password, 0, &length));
 }
 
+static void az_iot_hub_client_sas_token_get_password_NULL_manager_fails()
+{
+  az_iot_hub_client client;
+  assert_true(az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL) == AZ_OK);
+
+  az_span password;
+
+  ASSERT_PRECONDITION_CHECKED(az_iot_hub_client_sas_token_get_password(
+      &client, NULL, test_sas_expiry_time_secs, &password));
+}
+
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 static void az_iot_hub_client_sas_get_signature_device_succeeds()
@@ -501,6 +515,139 @@ static void test_az_iot_hub_client_sas_no_logging_succeed()
   az_log_set_classification_filter_callback(NULL);
 }
 
+static void _az_assert_password_equal(az_span password, char const* expected)
+{
+  assert_int_equal(az_span_size(password), (int32_t)strlen(expected));
+  assert_memory_equal(az_span_ptr(password), expected, strlen(expected));
+}
+
+static void az_iot_hub_client_sas_token_get_password_device_succeeds()
+{
+  az_iot_hub_client client;
+  assert_true(az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL) == AZ_OK);
+
+  uint8_t password_buffer[TEST_SPAN_BUFFER_SIZE];
+  az_iot_sas_token_manager manager;
+  assert_int_equal(
+      az_iot_sas_token_manager_init(
+          &manager, test_device_key, AZ_SPAN_FROM_BUFFER(password_buffer), NULL),
+      AZ_OK);
+
+  const char expected_password[]
+      = "SharedAccessSignature sr=" TEST_DEVICE_HOSTNAME_STR "%2Fdevices%2F" TEST_DEVICE_ID_STR
+        "&sig=6BQpP0VpyZ0mTIlMbvjlP%2FxyeadWxB24Mp9J8uADz8w%3D&se=" TEST_EXPIRATION_STR;
+
+  // The password is valid for the default duration, and is null-terminated.
+  uint64_t const now = test_sas_expiry_time_secs - AZ_IOT_SAS_TOKEN_DEFAULT_DURATION_SECONDS;
+  az_span password;
+  assert_int_equal(
+      az_iot_hub_client_sas_token_get_password(&client, &manager, now, &password), AZ_OK);
+  _az_assert_password_equal(password, expected_password);
+  assert_int_equal(az_span_ptr(password)[az_span_size(password)], '\0');
+  assert_int_equal(az_iot_sas_token_manager_get_expiration(&manager), test_sas_expiry_time_secs);
+
+  // Until the renewal margin, the cached password is returned.
+  uint64_t const later
+      = test_sas_expiry_time_secs - AZ_IOT_SAS_TOKEN_DEFAULT_RENEWAL_MARGIN_SECONDS - 1;
+  assert_false(az_iot_sas_token_manager_is_renewal_due(&manager, later));
+  assert_int_equal(
+      az_iot_hub_client_sas_token_get_password(&client, &manager, later, &password), AZ_OK);
+  _az_assert_password_equal(password, expected_password);
+
+  // Then, a new one is generated.
+  assert_true(az_iot_sas_token_manager_is_renewal_due(&manager, later + 1));
+  assert_int_equal(
+      az_iot_hub_client_sas_token_get_password(
+          &client, &manager, test_sas_expiry_time_secs, &password),
+      AZ_OK);
+  _az_assert_password_equal(
+      password,
+      "SharedAccessSignature sr=" TEST_DEVICE_HOSTNAME_STR "%2Fdevices%2F" TEST_DEVICE_ID_STR
+      "&sig=OmsvRY24hMQeJkjEB7paG2vHr8W%2FfbLsE%2F7gWWGDW8A%3D&se=1578945292");
+  assert_int_equal(
+      az_iot_sas_token_manager_get_expiration(&manager),
+      test_sas_expiry_time_secs + AZ_IOT_SAS_TOKEN_DEFAULT_DURATION_SECONDS);
+}
+
+static int _hmac_sha256_calls;
+
+static az_result _hmac_sha256_fixed(void* context, az_span message, az_span destination)
+{
+  (void)message;
+  _hmac_sha256_calls++;
+  az_span_fill(destination, *(uint8_t*)context);
+  return AZ_OK;
+}
+
+static void az_iot_hub_client_sas_token_get_password_module_custom_hmac_succeeds()
+{
+  az_iot_hub_client_options client_options = az_iot_hub_client_options_default();
+  client_options.module_id = test_module_id;
+  az_iot_hub_client client;
+  assert_true(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, &client_options)
+      == AZ_OK);
+
+  uint8_t hmac_byte = 0xFF;
+  az_iot_sas_token_manager_options options = az_iot_sas_token_manager_options_default();
+  options.key_name = AZ_SPAN_FROM_STR(TEST_KEY_NAME);
+  options.token_duration_seconds = 60;
+  options.renewal_margin_seconds = 10;
+  options.hmac_sha256 = _hmac_sha256_fixed;
+  options.hmac_sha256_context = &hmac_byte;
+
+  uint8_t password_buffer[TEST_SPAN_BUFFER_SIZE * 2];
+  az_iot_sas_token_manager manager;
+  assert_int_equal(
+      az_iot_sas_token_manager_init(
+          &manager, AZ_SPAN_EMPTY, AZ_SPAN_FROM_BUFFER(password_buffer), &options),
+      AZ_OK);
+
+  // 32 bytes of 0xFF are Base64 encoded as 42 '/', followed by "8=".
+  const char expected_password[]
+      = "SharedAccessSignature sr=" TEST_DEVICE_HOSTNAME_STR "%2Fdevices%2F" TEST_DEVICE_ID_STR
+        "%2Fmodules%2F" TEST_MODULE_ID_STR "&sig="
+        "%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F"
+        "%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F"
+        "%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F%2F"
+        "8%3D&se=" TEST_EXPIRATION_STR "&skn=" TEST_KEY_NAME;
+
+  _hmac_sha256_calls = 0;
+  az_span password;
+  assert_int_equal(
+      az_iot_hub_client_sas_token_get_password(
+          &client, &manager, test_sas_expiry_time_secs - 60, &password),
+      AZ_OK);
+  _az_assert_password_equal(password, expected_password);
+  assert_int_equal(
+      az_iot_hub_client_sas_token_get_password(
+          &client, &manager, test_sas_expiry_time_secs - 11, &password),
+      AZ_OK);
+  _az_assert_password_equal(password, expected_password);
+  assert_int_equal(_hmac_sha256_calls, 1);
+}
+
+static void az_iot_hub_client_sas_token_get_password_overflow_fails()
+{
+  az_iot_hub_client client;
+  assert_true(az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL) == AZ_OK);
+
+  // Large enough for the signature, but not for the expiration.
+  uint8_t password_buffer[130];
+  az_iot_sas_token_manager manager;
+  assert_int_equal(
+      az_iot_sas_token_manager_init(
+          &manager, test_device_key, AZ_SPAN_FROM_BUFFER(password_buffer), NULL),
+      AZ_OK);
+
+  az_span password;
+  assert_int_equal(
+      az_iot_hub_client_sas_token_get_password(
+          &client, &manager, test_sas_expiry_time_secs, &password),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_true(az_iot_sas_token_manager_is_renewal_due(&manager, test_sas_expiry_time_secs));
+}
+
 #ifdef _MSC_VER
 // warning C4113: 'void (__cdecl *)()' differs in parameter lists from 'CMUnitTestFunction'
 #pragma warning(disable : 4113)
@@ -520,6 +667,7 @@ int test_az_iot_hub_client_sas_token()
     cmocka_unit_test(az_iot_hub_client_sas_get_password_EMPTY_signature_fails),
     cmocka_unit_test(az_iot_hub_client_sas_get_password_NULL_password_span_fails),
     cmocka_unit_test(az_iot_hub_client_sas_get_password_empty_password_buffer_span_fails),
+    cmocka_unit_test(az_iot_hub_client_sas_token_get_password_NULL_manager_fails),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test(az_iot_hub_client_sas_get_signature_device_succeeds),
     cmocka_unit_test(az_iot_hub_client_sas_get_password_device_no_out_length_succeeds),
@@ -535,6 +683,9 @@ int test_az_iot_hub_client_sas_token()
     cmocka_unit_test(az_iot_hub_client_sas_get_signature_module_signature_overflow_fails),
     cmocka_unit_test(test_az_iot_hub_client_sas_logging_succeed),
     cmocka_unit_test(test_az_iot_hub_client_sas_no_logging_succeed),
+    cmocka_unit_test(az_iot_hub_client_sas_token_get_password_device_succeeds),
+    cmocka_unit_test(az_iot_hub_client_sas_token_get_password_module_custom_hmac_succeeds),
+    cmocka_unit_test(az_iot_hub_client_sas_token_get_password_overflow_fails),
   };
   return cmocka_run_group_tests_name("az_iot_hub_client_sas", tests, NULL, NULL);
 }
@@ -5,8 +5,10 @@
 #include <az_test_span.h>
 #include <azure/iot/az_iot_hub_client.h>
 
+#include <azure/core/az_json.h>
 #include <azure/core/az_precondition.h>
 #include <azure/core/internal/az_precondition_internal.h>
+#include <azure/core/internal/az_result_internal.h>
 
 #include <setjmp.h>
 #include <stdarg.h>
@@ -34,6 +36,8 @@ static const char g_test_correct_topic_no_options_with_props[]
       "key=value&key_two=value2";
 static const char g_test_correct_topic_with_options_module_id_with_props[]
     = "devices/my_device/modules/my_module_id/messages/events/key=value&key_two=value2";
+static const char g_test_correct_topic_batch[]
+    = "devices/my_device/messages/events/%24.ct=application%2Fjson&%24.ce=utf-8";
 
 #ifndef AZ_NO_PRECONDITION_CHECKING
 ENABLE_PRECONDITION_CHECK_TESTS()
@@ -79,6 +83,17 @@ static void test_az_iot_hub_client_telemetry_get_publish_topic_NULL_out_mqtt_top
       az_iot_hub_client_telemetry_get_publish_topic(&client, NULL, test_buf, 0, &test_length));
 }
 
+static void test_az_iot_hub_client_telemetry_batch_init_small_buffer_fails(void** state)
+{
+  (void)state;
+
+  az_iot_hub_client_telemetry_batch batch;
+  uint8_t payload_buf[1];
+
+  ASSERT_PRECONDITION_CHECKED(
+      az_iot_hub_client_telemetry_batch_init(&batch, AZ_SPAN_FROM_BUFFER(payload_buf)));
+}
+
 #endif // AZ_NO_PRECONDITION_CHECKING
 
 static void test_az_iot_hub_client_telemetry_get_publish_topic_no_options_no_props_succeed(
@@ -318,6 +333,141 @@ test_az_iot_hub_client_telemetry_get_publish_topic_with_options_module_id_with_p
       == AZ_ERROR_NOT_ENOUGH_SPACE);
 }
 
+static az_result _test_az_iot_hub_client_telemetry_batch_add_record(
+    az_iot_hub_client_telemetry_batch* batch,
+    int32_t value)
+{
+  az_json_writer* record_writer = az_iot_hub_client_telemetry_batch_begin_record(batch);
+  _az_RETURN_IF_FAILED(az_json_writer_append_begin_object(record_writer));
+  _az_RETURN_IF_FAILED(az_json_writer_append_property_name(record_writer, AZ_SPAN_FROM_STR("t")));
+  _az_RETURN_IF_FAILED(az_json_writer_append_int32(record_writer, value));
+  _az_RETURN_IF_FAILED(az_json_writer_append_end_object(record_writer));
+  return az_iot_hub_client_telemetry_batch_end_record(batch);
+}
+
+static void test_az_iot_hub_client_telemetry_batch_succeed(void** state)
+{
+  (void)state;
+
+  az_iot_hub_client client;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL), AZ_OK);
+
+  // Only fits two records, since the writer needs room for the largest int32 value.
+  uint8_t payload_buf[26];
+  az_iot_hub_client_telemetry_batch batch;
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_init(&batch, AZ_SPAN_FROM_BUFFER(payload_buf)), AZ_OK);
+
+  uint8_t props_buf[TEST_SPAN_BUFFER_SIZE];
+  az_iot_message_properties props;
+  assert_int_equal(
+      az_iot_message_properties_init(&props, AZ_SPAN_FROM_BUFFER(props_buf), 0), AZ_OK);
+
+  char test_buf[TEST_SPAN_BUFFER_SIZE];
+  size_t test_length;
+  az_span payload;
+
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_get_publish_message(
+          &client, &batch, &props, test_buf, sizeof(test_buf), &test_length, &payload),
+      AZ_OK);
+  assert_int_equal(az_iot_hub_client_telemetry_batch_get_record_count(&batch), 0);
+  assert_true(az_span_is_content_equal(payload, AZ_SPAN_FROM_STR("[]")));
+
+  assert_int_equal(_test_az_iot_hub_client_telemetry_batch_add_record(&batch, 1), AZ_OK);
+  assert_int_equal(_test_az_iot_hub_client_telemetry_batch_add_record(&batch, 2), AZ_OK);
+  assert_int_equal(
+      _test_az_iot_hub_client_telemetry_batch_add_record(&batch, 3), AZ_ERROR_NOT_ENOUGH_SPACE);
+  assert_int_equal(az_iot_hub_client_telemetry_batch_get_record_count(&batch), 2);
+
+  // The properties are only appended once, however many times the message is retrieved.
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_get_publish_message(
+          &client, &batch, &props, test_buf, sizeof(test_buf), &test_length, &payload),
+      AZ_OK);
+  assert_string_equal(g_test_correct_topic_batch, test_buf);
+  assert_int_equal(sizeof(g_test_correct_topic_batch) - 1, test_length);
+  assert_true(az_span_is_content_equal(payload, AZ_SPAN_FROM_STR("[{\"t\":1},{\"t\":2}]")));
+
+  // The record that didn't fit is added to the next batch instead.
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_init(&batch, AZ_SPAN_FROM_BUFFER(payload_buf)), AZ_OK);
+  assert_int_equal(_test_az_iot_hub_client_telemetry_batch_add_record(&batch, 3), AZ_OK);
+  assert_int_equal(az_iot_hub_client_telemetry_batch_get_record_count(&batch), 1);
+
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_get_publish_message(
+          &client, &batch, &props, test_buf, sizeof(test_buf), NULL, &payload),
+      AZ_OK);
+  assert_true(az_span_is_content_equal(payload, AZ_SPAN_FROM_STR("[{\"t\":3}]")));
+}
+
+static void test_az_iot_hub_client_telemetry_batch_invalid_record_fails(void** state)
+{
+  (void)state;
+
+  uint8_t payload_buf[TEST_SPAN_BUFFER_SIZE];
+  az_iot_hub_client_telemetry_batch batch;
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_init(&batch, AZ_SPAN_FROM_BUFFER(payload_buf)), AZ_OK);
+
+  // Nothing was written.
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_end_record(&batch), AZ_ERROR_JSON_INVALID_STATE);
+  az_json_writer* record_writer = az_iot_hub_client_telemetry_batch_begin_record(&batch);
+  assert_non_null(record_writer);
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_end_record(&batch), AZ_ERROR_JSON_INVALID_STATE);
+
+  // The object isn't closed.
+  record_writer = az_iot_hub_client_telemetry_batch_begin_record(&batch);
+  assert_int_equal(az_json_writer_append_begin_object(record_writer), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_end_record(&batch), AZ_ERROR_JSON_INVALID_STATE);
+
+  // A record which is ended twice is only added once.
+  record_writer = az_iot_hub_client_telemetry_batch_begin_record(&batch);
+  assert_int_equal(az_json_writer_append_bool(record_writer, true), AZ_OK);
+  assert_int_equal(az_iot_hub_client_telemetry_batch_end_record(&batch), AZ_OK);
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_end_record(&batch), AZ_ERROR_JSON_INVALID_STATE);
+  assert_int_equal(az_iot_hub_client_telemetry_batch_get_record_count(&batch), 1);
+
+  // Any property already set is left as is.
+  uint8_t props_buf[TEST_SPAN_BUFFER_SIZE];
+  az_iot_message_properties props;
+  assert_int_equal(
+      az_iot_message_properties_init(&props, AZ_SPAN_FROM_BUFFER(props_buf), 0), AZ_OK);
+  assert_int_equal(
+      az_iot_message_properties_append(
+          &props,
+          AZ_SPAN_FROM_STR(AZ_IOT_MESSAGE_PROPERTIES_CONTENT_TYPE),
+          AZ_SPAN_FROM_STR("application%2Fvnd.batch%2Bjson")),
+      AZ_OK);
+
+  az_iot_hub_client client;
+  assert_int_equal(
+      az_iot_hub_client_init(&client, test_device_hostname, test_device_id, NULL), AZ_OK);
+
+  char test_buf[TEST_SPAN_BUFFER_SIZE];
+  az_span payload;
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_get_publish_message(
+          &client, &batch, &props, test_buf, sizeof(test_buf), NULL, &payload),
+      AZ_OK);
+  assert_string_equal(
+      "devices/my_device/messages/events/%24.ct=application%2Fvnd.batch%2Bjson&%24.ce=utf-8",
+      test_buf);
+  assert_true(az_span_is_content_equal(payload, AZ_SPAN_FROM_STR("[true]")));
+
+  // Not enough space for the topic.
+  assert_int_equal(
+      az_iot_hub_client_telemetry_batch_get_publish_message(
+          &client, &batch, &props, test_buf, 16, NULL, &payload),
+      AZ_ERROR_NOT_ENOUGH_SPACE);
+}
+
 int test_az_iot_hub_client_telemetry()
 {
 #ifndef AZ_NO_PRECONDITION_CHECKING
@@ -329,6 +479,7 @@ int test_az_iot_hub_client_telemetry()
     cmocka_unit_test(test_az_iot_hub_client_telemetry_get_publish_topic_NULL_client_fails),
     cmocka_unit_test(test_az_iot_hub_client_telemetry_get_publish_topic_NULL_mqtt_topic_fails),
     cmocka_unit_test(test_az_iot_hub_client_telemetry_get_publish_topic_NULL_out_mqtt_topic_fails),
+    cmocka_unit_test(test_az_iot_hub_client_telemetry_batch_init_small_buffer_fails),
 #endif // AZ_NO_PRECONDITION_CHECKING
     cmocka_unit_test(
         test_az_iot_hub_client_telemetry_get_publish_topic_no_options_no_props_succeed),
@@ -348,6 +499,8 @@ int test_az_iot_hub_client_telemetry()
         test_az_iot_hub_client_telemetry_get_publish_topic_with_options_module_id_with_props_succeed),
     cmocka_unit_test(
         test_az_iot_hub_client_telemetry_get_publish_topic_with_options_module_id_with_props_small_buffer_fails),
+    cmocka_unit_test(test_az_iot_hub_client_telemetry_batch_succeed),
+    cmocka_unit_test(test_az_iot_hub_client_telemetry_batch_invalid_record_fails),
   };
 
   return cmocka_run_group_tests_name("az_iot_hub_client_telemetry", tests, NULL, NULL);
@@ -15,6 +15,7 @@
 #include <stdarg.h>
 #include <stddef.h>
 #include <stdint.h>
+#include <string.h>
 
 #include <cmocka.h>
 
@@ -351,6 +352,49 @@ static void test_az_iot_provisioning_client_sas_no_logging_succeed()
   az_log_set_classification_filter_callback(NULL);
 }
 
+static void az_iot_provisioning_client_sas_token_get_password_device_succeeds()
+{
+  az_iot_provisioning_client client;
+  assert_int_equal(
+      az_iot_provisioning_client_init(
+          &client, test_global_device_hostname, test_id_scope, test_registration_id, NULL),
+      AZ_OK);
+
+  uint8_t password_buffer[TEST_SPAN_BUFFER_SIZE];
+  az_iot_sas_token_manager_options options = az_iot_sas_token_manager_options_default();
+  options.key_name = AZ_SPAN_FROM_STR(TEST_KEY_NAME);
+  az_iot_sas_token_manager manager;
+  assert_int_equal(
+      az_iot_sas_token_manager_init(
+          &manager,
+          AZ_SPAN_FROM_STR("AAECAwQFBgcICQoLDA0ODxAREhMUFRYXGBkaGxwdHh8="),
+          AZ_SPAN_FROM_BUFFER(password_buffer),
+          &options),
+      AZ_OK);
+
+  const char expected_password[] = "SharedAccessSignature sr=" TEST_URL_ENCODED_RESOURCE_URI
+                                   "&sig=Q7gu5e8hwpVc8rL%2FEsHIJZrz6oZD%2B3JtvoxdgXfX1kw%3D"
+                                   "&se=" TEST_EXPIRATION_STR "&skn=" TEST_KEY_NAME;
+
+  uint64_t const now = test_sas_expiry_time_secs - AZ_IOT_SAS_TOKEN_DEFAULT_DURATION_SECONDS;
+  az_span password;
+  assert_int_equal(
+      az_iot_provisioning_client_sas_token_get_password(&client, &manager, now, &password),
+      AZ_OK);
+  assert_int_equal(az_span_size(password), (int32_t)strlen(expected_password));
+  assert_memory_equal(az_span_ptr(password), expected_password, strlen(expected_password));
+  assert_int_equal(az_span_ptr(password)[az_span_size(password)], '\0');
+
+  // The cached password is returned until it is due for renewal.
+  password = AZ_SPAN_EMPTY;
+  assert_int_equal(
+      az_iot_provisioning_client_sas_token_get_password(&client, &manager, now + 60, &password),
+      AZ_OK);
+  assert_int_equal(az_span_size(password), (int32_t)strlen(expected_password));
+  assert_memory_equal(az_span_ptr(password), expected_password, strlen(expected_password));
+  assert_int_equal(az_iot_sas_token_manager_get_expiration(&manager), test_sas_expiry_time_secs);
+}
+
 #ifdef _MSC_VER
 // warning C4113: 'void (__cdecl *)()' differs in parameter lists from 'CMUnitTestFunction'
 #pragma warning(disable : 4113)
@@ -378,6 +422,7 @@ int test_az_iot_provisioning_client_sas_token()
     cmocka_unit_test(az_iot_provisioning_client_sas_get_signature_device_signature_overflow_fails),
     cmocka_unit_test(test_az_iot_provisioning_client_sas_logging_succeed),
     cmocka_unit_test(test_az_iot_provisioning_client_sas_no_logging_succeed),
+    cmocka_unit_test(az_iot_provisioning_client_sas_token_get_password_device_succeeds),
   };
   return cmocka_run_group_tests_name("az_iot_provisioning_client_sas", tests, NULL, NULL);
 }